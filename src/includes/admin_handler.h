@@ -28,6 +28,7 @@ void admin_htp_get_admin_core_modules_detail(evhtp_request_t *req, void *data);
 void admin_htp_post_admin_core_modules_detail(evhtp_request_t *req, void *data);
 void admin_htp_put_admin_core_modules_detail(evhtp_request_t *req, void *data);
 void admin_htp_delete_admin_core_modules_detail(evhtp_request_t *req, void *data);
+void admin_htp_get_admin_core_reloads(evhtp_request_t *req, void *data);
 void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data);
 void admin_htp_get_admin_core_systems_detail(evhtp_request_t *req, void *data);
 
@@ -124,6 +125,10 @@ void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data
 void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void *data);
 void admin_htp_get_admin_pjsip_registration_outbounds_detail(evhtp_request_t *req, void *data);
 
+void admin_htp_get_admin_pjsip_sync(evhtp_request_t *req, void *data);
+
+void admin_htp_post_admin_pjsip_batch(evhtp_request_t *req, void *data);
+
 
 //// ^/admin/queue
 void admin_htp_get_admin_queue_entries(evhtp_request_t *req, void *data);
@@ -133,6 +138,15 @@ void admin_htp_delete_admin_queue_entries_detail(evhtp_request_t *req, void *dat
 void admin_htp_get_admin_queue_queues(evhtp_request_t *req, void *data);
 void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data);
 
+void admin_htp_get_admin_queue_stats(evhtp_request_t *req, void *data);
+void admin_htp_get_admin_queue_stats_detail(evhtp_request_t *req, void *data);
+
+//// ^/admin/resource
+void admin_htp_get_admin_resource_stats(evhtp_request_t *req, void *data);
+
+//// ^/admin/chat
+void admin_htp_get_admin_chat_retention(evhtp_request_t *req, void *data);
+
 void admin_htp_get_admin_queue_members(evhtp_request_t *req, void *data);
 void admin_htp_post_admin_queue_members(evhtp_request_t *req, void *data);
 
@@ -32,24 +32,28 @@ bool chat_delete_room(const char* uuid);
 bool chat_delete_info_by_useruuid(const char* uuid_user);
 
 json_t* chat_get_userrooms_by_useruuid(const char* user_uuid);
+json_t* chat_get_userrooms_summary_by_useruuid(const char* uuid_user);
 
 json_t* chat_get_userroom(const char* uuid);
 json_t* chat_get_userrooms_by_roomuuid(const char* uuid);
 bool chat_create_userroom(const char* uuid_user, const char* uuid_userroom, const json_t* j_data);
 bool chat_update_userroom(const char* uuid_userroom, const json_t* j_data);
 bool chat_delete_userroom(const char* uuid_userroom);
+bool chat_mark_read_userroom(const char* uuid_userroom);
 
 bool chat_create_message_to_userroom(const char* uuid_message, const char* uuid_userroom, const char* uuid_user, const json_t* message);
 json_t* chat_get_userroom_messages_newest(const char* uuid_userroom, const char* timestamp, const unsigned int count);
 
 json_t* chat_get_messages_newest_of_room(const char* uuid_room, const char* timestamp, const unsigned int count);
 json_t* chat_get_message_info_by_userroom(const char* uuid_message, const char* uuid_userroom);
-json_t* chat_get_message_info(const char* table_name, const char* uuid);
+json_t* chat_get_message_info(const char* uuid);
 
 char* chat_get_uuidroom_by_uuiduserroom(const char* uuid_userroom);
 json_t* chat_get_members_by_userroom(const char* uuid_userroom);
 
 bool chat_is_user_userroom_owned(const char* uuid_user, const char* uuid_userroom);
 
+json_t* chat_get_retention_status(void);
+
 
 #endif /* SRC_INCLUDES_CHAT_HANDLER_H_ */
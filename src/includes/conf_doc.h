@@ -0,0 +1,39 @@
+/*
+ * conf_doc.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef SRC_INCLUDES_CONF_DOC_H_
+#define SRC_INCLUDES_CONF_DOC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Asterisk config document.
+ * Keeps every line of the file as it is, so the edit changes only the affected lines.
+ * The comments, directives and section templates are preserved.
+ */
+typedef struct _conf_doc conf_doc;
+
+conf_doc* conf_doc_load(const char* filename);
+conf_doc* conf_doc_parse(const char* data, size_t len);
+void conf_doc_free(conf_doc* doc);
+
+bool conf_doc_has_section(conf_doc* doc, const char* section);
+bool conf_doc_has_key(conf_doc* doc, const char* section, const char* key);
+
+bool conf_doc_add_section(conf_doc* doc, const char* section);
+bool conf_doc_delete_section(conf_doc* doc, const char* section);
+
+bool conf_doc_set_items(conf_doc* doc, const char* section, const char* key, const char** values, int count);
+bool conf_doc_retain_keys(conf_doc* doc, const char* section, const char** keys, int count);
+bool conf_doc_replace_items(conf_doc* doc, const char* section, const char** keys, const char** values, int count);
+
+int conf_doc_get_changes(conf_doc* doc);
+char* conf_doc_get_text(conf_doc* doc, size_t* len);
+bool conf_doc_save(conf_doc* doc, const char* filename);
+
+#endif /* SRC_INCLUDES_CONF_DOC_H_ */
@@ -11,7 +11,10 @@
 #include <stdbool.h>
 #include <jansson.h>
 
+#include "conf_doc.h"
+
 bool conf_init_handler(void);
+void conf_term_handler(void);
 
 // object
 json_t* conf_get_ast_current_config_info(const char* filename);
@@ -50,9 +53,16 @@ bool conf_update_ast_current_config_info_text_data(const char* filename, const c
 
 json_t* conf_get_ast_backup_config_info_text(const char* filename);
 json_t* conf_get_ast_backup_config_info_text_valid(const char* filename, const char* valid);
+char* conf_get_ast_config_filename(const char* name, const char* current);
+
+// edit
+conf_doc* conf_open_ast_current_config(const char* filename);
+bool conf_commit_ast_current_config(const char* filename, conf_doc* doc);
+bool conf_set_doc_section_data(conf_doc* doc, const char* section, const json_t* j_data);
 
 // etc
 bool conf_add_external_config_file(const char* filename, const char* external_filename);
 bool conf_is_exist_config_file(const char* filename);
+json_t* conf_get_cache_stats(void);
 
 #endif /* SRC_CONF_HANDLER_H_ */
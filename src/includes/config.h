@@ -14,4 +14,7 @@
 bool config_init(void);
 bool config_update_filename(const char* filename);
 
+const char* config_get_value(const char* section, const char* key);
+long long config_get_value_number(const char* section, const char* key, long long min);
+
 #endif /* BACKEND_SRC_CONFIG_H_ */
@@ -24,7 +24,9 @@ bool core_register_callback_db_system(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES
 
 // channel
 json_t* core_get_channels_all(void);
+json_t* core_get_channels_page(const char* cursor, int count);
 json_t* core_get_channels_by_devicename(const char* device_name);
+json_t* core_get_channels_by_devicenames(const json_t* j_device_names);
 json_t* core_get_channel_info(const char* unique_id);
 bool core_create_channel_info(const json_t* j_data);
 int core_update_channel_info(const json_t* j_tmp);
@@ -32,12 +34,14 @@ int core_delete_channel_info(const char* key);
 
 // module
 json_t* core_get_modules_all(void);
+json_t* core_get_modules_page(const char* cursor, int count);
 json_t* core_get_module_info(const char* key);
 bool core_create_module(json_t* j_tmp);
 bool core_update_module_info(const json_t* j_data);
 
 // system
 json_t* core_get_systems_all(void);
+json_t* core_get_systems_page(const char* cursor, int count);
 json_t* core_get_system_info(const char* id);
 bool core_create_system_info(const json_t* j_data);
 bool core_update_system_info(const json_t* j_data);
@@ -46,6 +50,8 @@ bool core_update_system_info(const json_t* j_data);
 bool core_module_load(const char* name);
 bool core_module_reload(const char* name);
 bool core_module_unload(const char* name);
+bool core_module_reload_delayed(const char* name);
+json_t* core_get_module_reload_status(void);
 
 
 #endif /* SRC_CORE_HANDLER_H_ */
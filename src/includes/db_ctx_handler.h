@@ -17,6 +17,8 @@ typedef struct _db_ctx_t
   struct sqlite3* db;
 
   struct sqlite3_stmt* stmt;
+
+  unsigned long query_count;  ///< count of executed queries
 } db_ctx_t;
 
 db_ctx_t* db_ctx_init(const char* name);
@@ -24,6 +26,7 @@ void db_ctx_term(db_ctx_t* ctx);
 
 bool db_ctx_exec(db_ctx_t* ctx, const char* query);
 bool db_ctx_query(db_ctx_t* ctx, const char* query);
+int db_ctx_get_changes(db_ctx_t* ctx);
 json_t* db_ctx_get_record(db_ctx_t* ctx);
 
 bool db_ctx_insert(db_ctx_t* ctx, const char* table, const json_t* j_data);
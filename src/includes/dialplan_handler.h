@@ -20,6 +20,7 @@ bool dialplan_reload_asterisk(void);
 
 // dpma
 json_t* dialplan_get_dpmas_all(void);
+json_t* dialplan_get_dpmas_page(const char* cursor, int count);
 json_t* dialplan_get_dpma_info(const char* key);
 bool dialplan_create_dpma_info(const json_t* j_data);
 bool dialplan_update_dpma_info(const json_t* j_data);
@@ -27,6 +28,7 @@ bool dialplan_delete_dpma_info(const char* uuid);
 
 // dialplan
 json_t* dialplan_get_dialplans_all(void);
+json_t* dialplan_get_dialplans_page(const char* cursor, int count);
 json_t* dialplan_get_dialplans_by_dpma_uuid_order_sequence(const char* dpma_uuid);
 json_t* dialplan_get_dialplan_info(const char* key);
 json_t* dialplan_get_dialplan_info_by_dpma_seq(const char* dpma_uuid, int seq);
@@ -49,6 +51,7 @@ bool dialplan_delete_sdialplan_info(const char* name);
 // configuration
 json_t* dialplan_get_configurations_all(void);
 json_t* dialplan_get_configuration_info(const char* name);
+char* dialplan_get_configuration_filename(const char* name);
 bool dialplan_update_configuration_info(const json_t* j_data);
 bool dialplan_delete_configuration_info(const char* name);
 
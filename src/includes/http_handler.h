@@ -11,6 +11,9 @@
 #include <evhtp.h>
 #include <stdbool.h>
 #include <jansson.h>
+#include <time.h>
+
+#include "http_page.h"
 
 #define DEF_REG_UUID "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}"
 
@@ -22,6 +25,12 @@ enum EN_HTTP_PERMS {
 #define DEF_USER_PERM_ADMIN    "admin"
 #define DEF_USER_PERM_USER     "user"
 
+/**
+ * Returns the items of the page ordered by the key column.
+ * cursor: key of the last item of the previous page. NULL for the first page.
+ */
+typedef json_t* (*http_page_func)(const char* cursor, int count);
+
 bool http_init_handler(void);
 void http_term_handler(void);
 
@@ -29,6 +38,9 @@ json_t* http_create_default_result(int code);
 
 void http_simple_response_error(evhtp_request_t *req, int status_code, int err_code, const char* err_msg);
 void http_simple_response_normal(evhtp_request_t *req, json_t* j_msg);
+void http_simple_response_list(evhtp_request_t *req, const json_t* j_list, const http_page* page, const char* key);
+void http_simple_response_page(evhtp_request_t *req, http_page_func func, const char* key);
+void http_simple_response_file(evhtp_request_t *req, const char* filename, const char* content_type);
 
 json_t* http_get_json_from_request_data(evhtp_request_t* req);
 char* http_get_text_from_request_data(evhtp_request_t* req);
@@ -38,9 +50,11 @@ char* http_get_parsed_detail_start(evhtp_request_t* req);
 bool http_get_htp_id_pass(evhtp_request_t* req, char** agent_uuid, char** agent_pass);
 char* http_get_authtoken(evhtp_request_t* req);
 char* http_get_parameter(evhtp_request_t* req, const char* key);
+bool http_get_page(evhtp_request_t* req, http_page* page);
 json_t* http_get_userinfo(evhtp_request_t *req);
 
 bool http_is_request_has_permission(evhtp_request_t *req, enum EN_HTTP_PERMS perm);
+bool http_is_request_not_modified(evhtp_request_t* req, const char* etag, time_t mtime);
 
 
 #endif /* BACKEND_SRC_HTTP_HANDLER_H_ */
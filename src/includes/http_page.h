@@ -0,0 +1,31 @@
+/*
+ * http_page.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef SRC_INCLUDES_HTTP_PAGE_H_
+#define SRC_INCLUDES_HTTP_PAGE_H_
+
+#include <stdbool.h>
+
+#define DEF_HTTP_PAGE_LIMIT_DEFAULT   100     ///< page size if the request has cursor only.
+#define DEF_HTTP_PAGE_LIMIT_MAX       1000    ///< max page size. the bigger limit is clamped.
+#define DEF_HTTP_PAGE_CURSOR_MAX      1024    ///< max length of the cursor string.
+
+/**
+ * Cursor pagination parameters of the list request.
+ */
+typedef struct _http_page {
+  bool enable;    ///< true if the request has any of limit or cursor.
+  int limit;      ///< page size.
+  char* cursor;   ///< key of the last item of the previous page. NULL for the first page.
+} http_page;
+
+int http_page_parse_limit(const char* str);
+char* http_page_create_cursor(const char* key);
+char* http_page_parse_cursor(const char* str);
+void http_page_clear(http_page* page);
+
+#endif /* SRC_INCLUDES_HTTP_PAGE_H_ */
@@ -0,0 +1,33 @@
+/*
+ * http_range.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef SRC_INCLUDES_HTTP_RANGE_H_
+#define SRC_INCLUDES_HTTP_RANGE_H_
+
+#include <stdbool.h>
+#include <sys/types.h>
+#include <time.h>
+
+#define DEF_HTTP_RANGE_MAX  16    ///< max count of ranges in a request. the more is ignored.
+
+/**
+ * Byte range. RFC7233.
+ */
+typedef struct _http_range {
+  off_t start;  ///< first byte position
+  off_t end;    ///< last byte position. inclusive.
+} http_range;
+
+int http_range_parse(const char* str, off_t size, http_range* ranges, int max);
+
+char* http_range_create_etag(off_t size, time_t mtime_sec, long mtime_nsec);
+bool http_range_is_etag_match(const char* str, const char* etag, bool weak);
+
+char* http_range_create_date(time_t t);
+time_t http_range_parse_date(const char* str);
+
+#endif /* SRC_INCLUDES_HTTP_RANGE_H_ */
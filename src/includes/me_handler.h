@@ -16,6 +16,7 @@ void me_term_handler(void);
 
 
 json_t* me_get_subscribable_topics_all(const json_t* j_user);
+json_t* me_get_joinable_groups_all(const json_t* j_user);
 
 
 // http handlers
@@ -44,6 +45,8 @@ void me_htp_delete_me_chats_detail(evhtp_request_t *req, void *data);
 void me_htp_post_me_chats_detail_messages(evhtp_request_t *req, void *data);
 void me_htp_get_me_chats_detail_messages(evhtp_request_t *req, void *data);
 
+void me_htp_post_me_chats_detail_read(evhtp_request_t *req, void *data);
+
 void me_htp_post_me_login(evhtp_request_t *req, void *data);
 void me_htp_delete_me_login(evhtp_request_t *req, void *data);
 
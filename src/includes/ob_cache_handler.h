@@ -0,0 +1,31 @@
+/*
+ * ob_cache_handler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef BACKEND_SRC_OB_CACHE_HANDLER_H_
+#define BACKEND_SRC_OB_CACHE_HANDLER_H_
+
+#include <stdbool.h>
+#include <jansson.h>
+
+typedef enum _E_OB_CACHE_TYPE
+{
+  E_OB_CACHE_CAMPAIGN     = 0,
+  E_OB_CACHE_PLAN         = 1,
+  E_OB_CACHE_DESTINATION  = 2,
+  E_OB_CACHE_DLMA         = 3,
+} E_OB_CACHE_TYPE;
+
+bool ob_cache_init_handler(void);
+void ob_cache_term_handler(void);
+
+json_t* ob_cache_get(E_OB_CACHE_TYPE type, const char* uuid);
+bool ob_cache_set(E_OB_CACHE_TYPE type, const json_t* j_data);
+void ob_cache_invalidate(E_OB_CACHE_TYPE type, const char* uuid);
+void ob_cache_invalidate_all(E_OB_CACHE_TYPE type);
+unsigned long ob_cache_get_version(E_OB_CACHE_TYPE type);
+
+#endif /* BACKEND_SRC_OB_CACHE_HANDLER_H_ */
@@ -44,9 +44,8 @@ json_t* ob_get_campaign(const char* uuid);
 json_t* ob_get_campaign_for_dialing(void);
 json_t* ob_get_campaign_stat(const char* uuid);
 json_t* ob_get_campaigns_all(void);
+json_t* ob_get_campaigns_page(const char* cursor, int count);
 json_t* ob_get_campaigns_all_uuid(void);
-json_t* ob_get_campaigns_schedule_start(void);
-json_t* ob_get_campaigns_schedule_end(void);
 json_t* ob_get_campaigns_by_status(E_CAMP_STATUS_T status);
 json_t* ob_get_campaigns_stat_all(void);
 
@@ -63,4 +62,8 @@ bool ob_is_startable_campgain(json_t* j_camp);
 bool ob_is_exist_campaign(const char* uuid);
 bool ob_validate_campaign(json_t* j_data);
 
+bool ob_init_campaign_schedule(void);
+void ob_term_campaign_schedule(void);
+bool ob_reschedule_campaign(const char* uuid);
+
 #endif /* SRC_CAMPAIGN_HANDLER_H_ */
@@ -22,6 +22,7 @@ json_t* ob_create_destination(json_t* j_dest);
 json_t* ob_delete_destination(const char* uuid);
 json_t* ob_get_destination(const char* uuid);
 json_t* ob_get_destinations_all(void);
+json_t* ob_get_destinations_page(const char* cursor, int count);
 json_t* ob_get_destinations_all_uuid(void);
 json_t* ob_update_destination(const json_t* j_dest);
 
@@ -46,6 +46,9 @@ typedef struct _rb_dialing{
   json_t* j_events;    ///< event info(json array).
 } rb_dialing;
 
+bool ob_init_dialing_timeout(void);
+void ob_term_dialing_timeout(void);
+
 json_t* ob_create_dialing(const char* dialing_uuid, json_t* j_camp, json_t* j_plan, json_t* j_dlma, json_t* j_dest, json_t* j_dl_list, json_t* j_dial);
 bool ob_delete_dialing(const char* uuid);
 bool ob_insert_dialing(json_t* j_dialing);
@@ -60,9 +63,9 @@ bool ob_update_dialing_timestamp(const char* uuid);
 json_t* ob_get_dialings_uuid_all(void);
 json_t* ob_get_dialings_all_uuid(void);
 json_t* ob_get_dialings_all(void);
+json_t* ob_get_dialings_page(const char* cursor, int count);
 json_t* ob_get_dialing_by_action_id(const char* action_id);
 json_t* ob_get_dialing(const char* uuid);
-json_t* ob_get_dialings_timeout(void);
 json_t* ob_get_dialings_hangup(void);
 json_t* ob_get_dialings_error(void);
 int ob_get_dialing_count_by_camp_uuid(const char* camp_uuid);
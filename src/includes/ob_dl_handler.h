@@ -31,6 +31,7 @@ int ob_get_dial_try_cnt(json_t* j_dl_list, int dial_num_point);
 json_t* ob_get_dl(const char* uuid);
 json_t* ob_get_dls_uuid_by_dlma_count(const char* dlma_uuid, int count);
 json_t* ob_get_dls_by_dlma_count(const char* dlma_uuid, int count);
+json_t* ob_get_dls_by_dlma_page(const char* dlma_uuid, const char* cursor, int count);
 json_t* ob_get_dls_by_count(int count);
 json_t* ob_get_dls_by_status(E_DL_STATUS_T status);
 json_t* ob_get_dls_error(void);
@@ -19,6 +19,7 @@ json_t* ob_get_dlma(const char* uuid);
 json_t* ob_get_deleted_dlma(const char* uuid);
 
 json_t* ob_get_dlmas_all(void);
+json_t* ob_get_dlmas_page(const char* cursor, int count);
 json_t* ob_get_dlmas_all_uuid(void);
 char* ob_get_dlma_table_name(const char* dlma_uuid);
 
@@ -36,6 +36,7 @@ json_t* ob_delete_plan(const char* uuid);
 json_t* ob_update_plan(const json_t* j_plan);
 json_t* ob_get_plan(const char* uuid);
 json_t* ob_get_plans_all(void);
+json_t* ob_get_plans_page(const char* cursor, int count);
 json_t* ob_get_plans_all_uuid(void);
 
 json_t* ob_create_dial_plan_info(json_t* j_plan);
@@ -0,0 +1,21 @@
+/*
+ * ob_result_handler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef BACKEND_SRC_OB_RESULT_HANDLER_H_
+#define BACKEND_SRC_OB_RESULT_HANDLER_H_
+
+#include <stdbool.h>
+#include <jansson.h>
+
+bool ob_result_init_handler(void);
+void ob_result_term_handler(void);
+
+bool ob_result_write(const json_t* j_res);
+bool ob_result_flush(void);
+bool ob_result_reopen(void);
+
+#endif /* BACKEND_SRC_OB_RESULT_HANDLER_H_ */
@@ -0,0 +1,32 @@
+/*
+ * ob_schedule.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef BACKEND_SRC_OB_SCHEDULE_H_
+#define BACKEND_SRC_OB_SCHEDULE_H_
+
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * Campaign schedule.
+ * All of the items are optional(NULL).
+ */
+typedef struct _ob_schedule {
+  const char* date_start;       ///< "YYYY-MM-DD"
+  const char* date_end;         ///< "YYYY-MM-DD"
+  const char* date_list;        ///< "YYYY-MM-DD, YYYY-MM-DD, ..."
+  const char* date_list_except; ///< "YYYY-MM-DD, YYYY-MM-DD, ..."
+  const char* time_start;       ///< "HH:MM:SS"
+  const char* time_end;         ///< "HH:MM:SS"
+  const char* day_list;         ///< "0, 1, ..., 6" 0=Sunday, 1=Monday, ... 6=Saturday
+  const char* timezone;         ///< tz database name. ex) "Asia/Seoul". UTC if not set.
+} ob_schedule;
+
+bool ob_schedule_is_open(const ob_schedule* sc, time_t t);
+time_t ob_schedule_get_next_transition(const ob_schedule* sc, time_t t);
+
+#endif /* BACKEND_SRC_OB_SCHEDULE_H_ */
@@ -19,11 +19,13 @@ bool park_register_callback_db_parkedcall(bool (*func)(enum EN_RESOURCE_UPDATE_T
 
 // parkinglot
 json_t* park_get_parkinglots_all(void);
+json_t* park_get_parkinglots_page(const char* cursor, int count);
 json_t* park_get_parkinglot_info(const char* name);
 bool park_create_parkinglot_info(const json_t* j_tmp);
 
 // parkedcall
 json_t* park_get_parkedcalls_all();
+json_t* park_get_parkedcalls_page(const char* cursor, int count);
 json_t* park_get_parkedcall_info(const char* key);
 bool park_create_parkedcall_info(const json_t* j_data);
 bool park_update_parkedcall_info(const json_t* j_data);
@@ -40,6 +42,7 @@ bool park_cfg_delete_parkinglot_info(const char* parkinglot);
 // configuration
 json_t* park_get_configurations_all(void);
 json_t* park_get_configuration_info(const char* name);
+char* park_get_configuration_filename(const char* name);
 bool park_update_configuration_info(const json_t* j_data);
 bool park_delete_configuration_info(const char* name);
 
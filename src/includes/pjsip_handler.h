@@ -24,20 +24,25 @@ bool pjsip_create_endpoint_info(const json_t* j_data);
 bool pjsip_update_endpoint_info(const json_t* j_data);
 bool pjsip_delete_endpoint_info(const char* key);
 json_t* pjsip_get_endpoints_all(void);
+json_t* pjsip_get_endpoints_page(const char* cursor, int count);
 json_t* pjsip_get_endpoint_info(const char* name);
+json_t* pjsip_get_endpoints_info_by_names(const json_t* j_names);
 
 // auth
 bool pjsip_create_auth_info(const json_t* j_data);
 bool pjsip_update_auth_info(const json_t* j_data);
 bool pjsip_delete_auth_info(const char* key);
 json_t* pjsip_get_auths_all(void);
+json_t* pjsip_get_auths_page(const char* cursor, int count);
 json_t* pjsip_get_auth_info(const char* key);
+json_t* pjsip_get_auths_info_by_names(const json_t* j_names);
 
 // aor
 bool pjsip_create_aor_info(const json_t* j_data);
 bool pjsip_update_aor_info(const json_t* j_data);
 bool pjsip_delete_aor_info(const char* key);
 json_t* pjsip_get_aors_all(void);
+json_t* pjsip_get_aors_page(const char* cursor, int count);
 json_t* pjsip_get_aor_info(const char* key);
 
 // contact
@@ -45,6 +50,7 @@ bool pjsip_create_contact_info(const json_t* j_data);
 bool pjsip_update_contact_info(const json_t* j_data);
 bool pjsip_delete_contact_info(const char* key);
 json_t* pjsip_get_contacts_all(void);
+json_t* pjsip_get_contacts_page(const char* cursor, int count);
 json_t* pjsip_get_contact_info(const char* key);
 
 // registration_inbound
@@ -54,17 +60,33 @@ bool pjsip_delete_registration_inbound_info(const char* key);
 
 // registration outbound
 json_t* pjsip_get_registration_outbounds_all(void);
+json_t* pjsip_get_registration_outbounds_page(const char* cursor, int count);
 json_t* pjsip_get_registration_outbound_info(const char* key);
 bool pjsip_create_registration_outbound_info(const json_t* j_data);
 bool pjsip_update_registration_outbound_info(const json_t* j_data);
 bool pjsip_delete_registration_outbound_info(const char* key);
 
+// sync
+bool pjsip_sync_endpoint_info(const json_t* j_data);
+bool pjsip_sync_aor_info(const json_t* j_data);
+bool pjsip_sync_auth_info(const json_t* j_data);
+bool pjsip_sync_contact_info(const json_t* j_data);
+bool pjsip_sync_registration_inbound_info(const json_t* j_data);
+bool pjsip_sync_registration_outbound_info(const json_t* j_data);
+bool pjsip_sync_endpoint_list_info(const json_t* j_data);
+void pjsip_complete_endpoint_list(void);
+void pjsip_complete_endpoint_detail(void);
+void pjsip_complete_registration_inbound_list(void);
+void pjsip_complete_registration_outbound_list(void);
+json_t* pjsip_get_detail_sync_status(void);
+
 // account(aor, auth, endpoint)
 bool pjsip_create_account_with_default_setting(const char* target, const char* context);
 bool pjsip_delete_account(const char* target_name);
 
 bool pjsip_is_exist_endpoint(const char* target);
 bool pjsip_reload_config(void);
+json_t* pjsip_cfg_create_batch_info(const json_t* j_data);
 
 json_t* pjsip_cfg_get_aor_info_data(const char* name);
 bool pjsip_cfg_create_aor_info(const char* name, const char* contact);
@@ -107,6 +129,7 @@ bool pjsip_cfg_delete_transport_info(const char* name);
 // configurations
 json_t* pjsip_get_configurations_all(void);
 json_t* pjsip_get_configuration_info(const char* name);
+char* pjsip_get_configuration_filename(const char* name);
 bool pjsip_update_configuration_info(const json_t* j_data);
 bool pjsip_delete_configuration_info(const char* name);
 
@@ -12,6 +12,18 @@
 #include <stdbool.h>
 #include <jansson.h>
 
+/**
+ * Queue stat counters.
+ */
+typedef struct _queue_stat {
+  int ready;      ///< not in use and not paused member count
+  int paused;     ///< paused member count
+  int in_use;     ///< in use member count
+  int total;      ///< total member count
+
+  double service_level_perf;  ///< service level performance(%)
+} queue_stat;
+
 bool queue_init_handler(void);
 bool queue_reload_handler(void);
 bool queue_term_handler(void);
@@ -19,19 +31,27 @@ bool queue_term_handler(void);
 // param
 json_t* queue_get_queue_param_info(const char* name);
 json_t* queue_get_queue_params_all(void);
+json_t* queue_get_queue_params_page(const char* cursor, int count);
 bool queue_create_param_info(const json_t* j_tmp);
 
 // member
 json_t* queue_get_members_all(void);
+json_t* queue_get_members_page(const char* cursor, int count);
 json_t* queue_get_members_all_by_queuename(const char* name);
 json_t* queue_get_member_info(const char* id);
 bool queue_create_member_info(const json_t* j_data);
 bool queue_update_member_info(const json_t* j_data);
 bool queue_delete_member_info(const char* key);
 
+// stat
+bool queue_get_stat(const char* name, queue_stat* stat);
+json_t* queue_get_stat_info(const char* name);
+json_t* queue_get_stats_all(void);
+
 // entry
 json_t* queue_get_entries_all_by_queuename(const char* name);
 json_t* queue_get_entries_all(void);
+json_t* queue_get_entries_page(const char* cursor, int count);
 json_t* queue_get_entry_info(const char* key);
 bool queue_create_entry_info(const json_t* j_tmp);
 bool queue_delete_entry_info(const char* key);
@@ -46,6 +66,7 @@ bool queue_cfg_delete_queue_info(const char* name);
 // configuration
 json_t* queue_get_configurations_all(void);
 json_t* queue_get_configuration_info(const char* name);
+char* queue_get_configuration_filename(const char* name);
 bool queue_update_configuration_info(const json_t* j_data);
 bool queue_delete_configuration_info(const char* name);
 
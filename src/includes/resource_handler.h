@@ -11,6 +11,8 @@
 #include <stdbool.h>
 #include <jansson.h>
 
+#include "db_ctx_handler.h"
+
 enum EN_SORT_TYPES {
   EN_SORT_ASC,
   EN_SORT_DESC,
@@ -27,28 +29,38 @@ bool resource_insert_mem_item(const char* table, const json_t* j_data);
 bool resource_insrep_mem_item(const char* table, const json_t* j_data);
 bool resource_update_mem_item(const char* table, const char* key_column, const json_t* j_data);
 json_t* resource_get_mem_items(const char* table, const char* item);
+json_t* resource_get_mem_items_page(const char* table, const char* key, const char* cursor, int count);
 json_t* resource_get_mem_detail_item_key_string(const char* table, const char* key, const char* val);
 json_t* resource_get_mem_detail_items_by_condtion(const char* table, const char* condition);
 json_t* resource_get_mem_detail_items_key_string(const char* table, const char* key, const char* val);
+json_t* resource_get_mem_detail_items_key_strings(const char* table, const char* key, const json_t* j_vals);
 bool resource_delete_mem_items_string(const char* table, const char* key, const char* val);
 
 // file
 bool resource_exec_file_sql(const char* sql);
+int resource_exec_file_sql_changes(const char* sql);
 bool resource_insert_file_item(const char* table, const json_t* j_data);
 bool resource_insrep_file_item(const char* table, const json_t* j_data);
 bool resource_update_file_item(const char* table, const char* key_column, const json_t* j_data);
 bool resource_delete_file_items_string(const char* table, const char* key, const char* val);
 bool resource_delete_file_items_by_obj(const char* table, json_t* j_obj);
 json_t* resource_get_file_items(const char* table, const char* item);
+json_t* resource_get_file_items_page(const char* table, const char* key, const char* cursor, int count);
 json_t* resource_get_file_detail_item_key_string(const char* table, const char* key, const char* val);
 json_t* resource_get_file_detail_item_by_obj(const char* table, json_t* j_obj);
 json_t* resource_get_file_detail_items_key_string(const char* table, const char* key, const char* val);
+json_t* resource_get_file_detail_items_key_strings(const char* table, const char* key, const json_t* j_vals);
 json_t* resource_get_file_detail_items_by_obj(const char* table, json_t* j_obj);
 json_t* resource_get_file_detail_items_by_obj_order(const char* table, json_t* j_obj, const char* order);
 json_t* resource_get_file_detail_items_by_condtion(const char* table, const char* condition);
+json_t* resource_get_file_items_by_sql(const char* sql);
+bool resource_add_file_column(const char* table, const char* column, const char* type);
 
 // etc
+bool resource_add_db_column(db_ctx_t* ctx, const char* table, const char* column, const char* type);
+json_t* resource_get_db_items_page(db_ctx_t* ctx, const char* table, const char* where, const char* key, const char* cursor, int count);
 json_t* resource_sort_json_array_string(const json_t* j_data, enum EN_SORT_TYPES type);
+json_t* resource_get_stats(void);
 
 
 
@@ -59,6 +71,7 @@ bool update_agent_agent_info(const json_t* j_data);
 bool delete_agent_agent_info(const char* key);
 json_t* get_agent_agents_all_id(void);
 json_t* get_agent_agents_all(void);
+json_t* get_agent_agents_page(const char* cursor, int count);
 json_t* get_agent_agent_info(const char* id);
 
 
@@ -93,6 +106,7 @@ json_t* get_device_state_info(const char* device);
 bool create_voicemail_user_info(json_t* j_tmp);
 json_t* get_voicemail_user_info(const char* key);
 json_t* get_voicemail_users_all();
+json_t* get_voicemail_users_page(const char* cursor, int count);
 
 
 #endif /* BACKEND_SRC_RESOURCE_HANDLER_H_ */
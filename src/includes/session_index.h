@@ -0,0 +1,39 @@
+/*
+ * session_index.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef SRC_INCLUDES_SESSION_INDEX_H_
+#define SRC_INCLUDES_SESSION_INDEX_H_
+
+#include <stdbool.h>
+
+/**
+ * In-memory index of the connected sessions.
+ * user: connected sessions of the user.
+ * group: member sessions of the group. ex) /me/chats/<uuid_room>
+ * The session is an opaque pointer of the caller.
+ */
+typedef struct _session_index session_index;
+
+typedef void (*session_index_cb)(void* session, void* data);
+
+session_index* session_index_create(void);
+void session_index_destroy(session_index* idx);
+
+bool session_index_set_user(session_index* idx, void* session, const char* uuid_user);
+void session_index_remove_session(session_index* idx, void* session);
+
+bool session_index_join_group(session_index* idx, void* session, const char* group);
+void session_index_leave_group(session_index* idx, void* session, const char* group);
+int session_index_join_group_user(session_index* idx, const char* uuid_user, const char* group);
+int session_index_leave_group_user(session_index* idx, const char* uuid_user, const char* group);
+
+int session_index_foreach_group(const session_index* idx, const char* group, session_index_cb cb, void* data);
+bool session_index_is_member(const session_index* idx, const void* session, const char* group);
+int session_index_get_user_count(const session_index* idx);
+int session_index_get_group_count(const session_index* idx);
+
+#endif /* SRC_INCLUDES_SESSION_INDEX_H_ */
@@ -41,7 +41,10 @@ bool sip_update_peer_info(const json_t* j_data);
 bool sip_delete_peer_info(const char* key);
 json_t* sip_get_peers_all_peer(void);
 json_t* sip_get_peers_all(void);
+json_t* sip_get_peers_page(const char* cursor, int count);
 json_t* sip_get_peer_info(const char* name);
+bool sip_sync_peer_info(const json_t* j_data);
+void sip_complete_peer_list(void);
 
 // sip_registry
 bool sip_create_registry_info(const json_t* j_data);
@@ -49,7 +52,10 @@ bool sip_update_registry_info(const json_t* j_data);
 bool sip_delete_registry_info(const char* key);
 json_t* sip_get_registries_all_account(void);
 json_t* sip_get_registries_all(void);
+json_t* sip_get_registries_page(const char* cursor, int count);
 json_t* sip_get_registry_info(const char* account);
+bool sip_sync_registry_info(const json_t* j_data);
+void sip_complete_registry_list(void);
 
 // sip_peeraccount
 bool sip_create_peeraccount_info(const json_t* j_data);
@@ -20,5 +20,8 @@ bool subscription_subscribe_topic(const char* authtoken, const char* topic);
 
 bool subscription_unsubscribe_topic(const char* authtoken, const char* topic);
 
+bool subscription_join_group_user(const char* uuid_user, const char* group);
+bool subscription_leave_group_user(const char* uuid_user, const char* group);
+
 
 #endif /* SRC_INCLUDES_SUBSCRIPTION_HANDLER_H_ */
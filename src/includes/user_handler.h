@@ -25,9 +25,11 @@ bool user_reload_handler(void);
 bool user_register_callback_db_userinfo(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*));
 bool user_register_callback_db_permission(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*));
 bool user_reigster_callback_db_buddy(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*));
+bool user_register_callback_db_contact(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*));
 
 // userinfo
 json_t* user_get_userinfo_info(const char* key);
+json_t* user_get_userinfos_info_by_uuids(const json_t* j_uuids);
 json_t* user_get_userinfo_info_by_username(const char* key);
 json_t* user_get_userinfo_info_by_username_password(const char* username, const char* pass);
 json_t* user_get_userinfo_by_authtoken(const char* authtoken);
@@ -36,6 +38,7 @@ bool user_update_userinfo_info(const char* uuid_user, const json_t* j_data);
 bool user_delete_userinfo_info(const char* key);
 bool user_delete_related_info_by_useruuid(const char* uuid_user);
 json_t* user_get_userinfos_all(void);
+json_t* user_get_userinfos_page(const char* cursor, int count);
 
 // authtoken
 json_t* user_get_authtokens_all(void);
@@ -46,6 +49,7 @@ bool user_delete_authtoken_info(const char* key);
 
 // permission
 json_t* user_get_permissions_all(void);
+json_t* user_get_permissions_page(const char* cursor, int count);
 json_t* user_get_permissions_by_useruuid(const char* uuid_user);
 bool user_create_permission_info(const json_t* j_data);
 json_t* user_get_permission_info(const char* uuid_permission);
@@ -55,6 +59,7 @@ bool user_delete_permissions_by_useruuid(const char* uuid_user);
 
 // contact
 json_t* user_get_contacts_all(void);
+json_t* user_get_contacts_page(const char* cursor, int count);
 json_t* user_get_contacts_by_user_uuid(const char* user_uuid);
 json_t* user_get_contact_info(const char* key);
 bool user_create_contact_info(const json_t* j_data);
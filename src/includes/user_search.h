@@ -0,0 +1,31 @@
+/*
+ * user_search.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#ifndef SRC_INCLUDES_USER_SEARCH_H_
+#define SRC_INCLUDES_USER_SEARCH_H_
+
+#include <stdbool.h>
+
+/**
+ * In-memory user search index.
+ * Every 1, 2 and 3 byte gram of the indexed fields has a list of the entries,
+ * so the search doesn't need to scan all of the users.
+ * Case insensitive for the ASCII characters.
+ */
+typedef struct _user_search user_search;
+
+user_search* user_search_create(void);
+void user_search_destroy(user_search* idx);
+
+bool user_search_set(user_search* idx, const char* uuid, const char* const* fields, int count);
+bool user_search_remove(user_search* idx, const char* uuid);
+void user_search_clear(user_search* idx);
+
+int user_search_find(const user_search* idx, const char* query, const char** res, int max);
+int user_search_get_count(const user_search* idx);
+
+#endif /* SRC_INCLUDES_USER_SEARCH_H_ */
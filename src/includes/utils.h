@@ -54,9 +54,13 @@ char* utils_strip_ext(char *fname);
 bool utils_is_string_exist_in_file(const char* filename, const char* str);
 bool utils_append_string_to_file_end(const char* filename, const char* str);
 bool utils_create_empty_file(const char* filename);
+bool utils_copy_file(const char* src, const char* dst);
+bool utils_is_file_same(const char* filename1, const char* filename2);
 
 char* utils_string_replace_char(const char* str, const char org, const char target);
 
+bool utils_is_item_changed(const json_t* j_old, const json_t* j_data);
+
 bool utils_register_callback(struct st_callback* callback, bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*));
 struct st_callback* utils_create_callback(void);
 void utils_terminate_callback(struct st_callback* callback);
@@ -8,8 +8,12 @@
 #ifndef SRC_VOICEMAIL_HANDLER_H_
 #define SRC_VOICEMAIL_HANDLER_H_
 
+#include <stdbool.h>
 #include <evhtp.h>
 
+bool voicemail_init_handler(void);
+void voicemail_term_handler(void);
+
 void voicemail_htp_get_voicemail_users(evhtp_request_t *req, void *data);
 void voicemail_htp_post_voicemail_users(evhtp_request_t *req, void *data);
 void voicemail_htp_get_voicemail_users_detail(evhtp_request_t *req, void *data);
@@ -46,20 +46,25 @@ static void ami_event_devicestatechange(json_t* j_msg);
 static void ami_event_dialbegin(json_t* j_msg);
 static void ami_event_dialend(json_t* j_msg);
 static void ami_event_endpointdetail(json_t* j_msg);
+static void ami_event_endpointdetailcomplete(json_t* j_msg);
 static void ami_event_endpointlist(json_t* j_msg);
+static void ami_event_endpointlistcomplete(json_t* j_msg);
 static void ami_event_hangup(json_t* j_msg);
 static void ami_event_inboundregisterationdetail(json_t* j_msg);
+static void ami_event_inboundregisterationdetailcomplete(json_t* j_msg);
 static void ami_event_newchannel(json_t* j_msg);
 static void ami_event_newexten(json_t* j_msg);
 static void ami_event_newstate(json_t* j_msg);
 static void ami_event_originateresponse(json_t* j_msg);
 static void ami_event_outboundregisterationdetail(json_t* j_msg);
+static void ami_event_outboundregisterationdetailcomplete(json_t* j_msg);
 static void ami_event_parkedcall(json_t* j_msg);
 static void ami_event_parkedcallgiveup(json_t* j_msg);
 static void ami_event_parkedcallswap(json_t* j_msg);
 static void ami_event_parkedcalltimeout(json_t* j_msg);
 static void ami_event_parkinglot(json_t* j_msg);
 static void ami_event_peerentry(json_t* j_msg);
+static void ami_event_peerlistcomplete(json_t* j_msg);
 static void ami_event_peerstatus(json_t* j_msg);
 static void ami_event_queuecallerabandon(json_t* j_msg);
 static void ami_event_queuecallerjoin(json_t* j_msg);
@@ -73,6 +78,7 @@ static void ami_event_queuememberpenalty(json_t* j_msg);
 static void ami_event_queuememberremoved(json_t* j_msg);
 static void ami_event_queuememberringinuse(json_t* j_msg);
 static void ami_event_queueparams(json_t* j_msg);
+static void ami_event_registrationscomplete(json_t* j_msg);
 static void ami_event_registryentry(json_t* j_msg);
 static void ami_event_rename(json_t* j_msg);
 static void ami_event_reload(json_t* j_msg);
@@ -173,15 +179,24 @@ void ami_message_handler(const char* msg)
   else if(strcasecmp(event, "EndpointDetail") == 0) {
     ami_event_endpointdetail(j_msg);
   }
+  else if(strcasecmp(event, "EndpointDetailComplete") == 0) {
+    ami_event_endpointdetailcomplete(j_msg);
+  }
   else if(strcasecmp(event, "EndpointList") == 0) {
     ami_event_endpointlist(j_msg);
   }
+  else if(strcasecmp(event, "EndpointListComplete") == 0) {
+    ami_event_endpointlistcomplete(j_msg);
+  }
   else if(strcasecmp(event, "Hangup") == 0) {
     ami_event_hangup(j_msg);
   }
   else if(strcasecmp(event, "InboundRegistrationDetail") == 0) {
     ami_event_inboundregisterationdetail(j_msg);
   }
+  else if(strcasecmp(event, "InboundRegistrationDetailComplete") == 0) {
+    ami_event_inboundregisterationdetailcomplete(j_msg);
+  }
   else if(strcasecmp(event, "NewChannel") == 0) {
     ami_event_newchannel(j_msg);
   }
@@ -197,6 +212,9 @@ void ami_message_handler(const char* msg)
   else if(strcasecmp(event, "OutboundRegistrationDetail") == 0) {
     ami_event_outboundregisterationdetail(j_msg);
   }
+  else if(strcasecmp(event, "OutboundRegistrationDetailComplete") == 0) {
+    ami_event_outboundregisterationdetailcomplete(j_msg);
+  }
   else if(strcasecmp(event, "ParkedCall") == 0) {
     ami_event_parkedcall(j_msg);
   }
@@ -215,6 +233,9 @@ void ami_message_handler(const char* msg)
   else if(strcasecmp(event, "PeerEntry") == 0) {
     ami_event_peerentry(j_msg);
   }
+  else if(strcasecmp(event, "PeerlistComplete") == 0) {
+    ami_event_peerlistcomplete(j_msg);
+  }
   else if(strcasecmp(event, "PeerStatus") == 0) {
     ami_event_peerstatus(j_msg);
   }
@@ -254,6 +275,9 @@ void ami_message_handler(const char* msg)
   else if(strcasecmp(event, "QueueParams") == 0) {
     ami_event_queueparams(j_msg);
   }
+  else if(strcasecmp(event, "RegistrationsComplete") == 0) {
+    ami_event_registrationscomplete(j_msg);
+  }
   else if(strcasecmp(event, "RegistryEntry") == 0) {
     ami_event_registryentry(j_msg);
   }
@@ -423,13 +447,31 @@ static void ami_event_peerentry(json_t* j_msg)
     return;
   }
 
-  // create info
-  ret = sip_create_peer_info(j_tmp);
+  // sync info
+  ret = sip_sync_peer_info(j_tmp);
   json_decref(j_tmp);
   if(ret == false) {
-    slog(LOG_ERR, "Could not insert destination.");
+    slog(LOG_ERR, "Could not sync sip peer info.");
+    return;
+  }
+
+  return;
+}
+
+/**
+ * AMI event handler.
+ * Event: PeerlistComplete
+ * @param j_msg
+ */
+static void ami_event_peerlistcomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
+  slog(LOG_DEBUG, "Fired ami_event_peerlistcomplete.");
+
+  sip_complete_peer_list();
 
   return;
 }
@@ -1307,7 +1349,7 @@ static void ami_event_outboundregisterationdetail(json_t* j_msg)
       );
   sfree(timestamp);
 
-  ret = pjsip_create_registration_outbound_info(j_tmp);
+  ret = pjsip_sync_registration_outbound_info(j_tmp);
   json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_WARNING, "Could not create pjsip registration oubound info.");
@@ -1317,6 +1359,24 @@ static void ami_event_outboundregisterationdetail(json_t* j_msg)
   return;
 }
 
+/**
+ * AMI event handler.
+ * Event: OutboundRegistrationDetailComplete
+ * @param j_msg
+ */
+static void ami_event_outboundregisterationdetailcomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired ami_event_outboundregisterationdetailcomplete.");
+
+  pjsip_complete_registration_outbound_list();
+
+  return;
+}
+
 /**
  * AMI event handler.
  * Event: Hangup
@@ -1470,7 +1530,7 @@ static void ami_event_inboundregisterationdetail(json_t* j_msg)
       );
   sfree(timestamp);
 
-  ret = pjsip_create_registration_inbound_info(j_tmp);
+  ret = pjsip_sync_registration_inbound_info(j_tmp);
   json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_WARNING, "Could not create pjsip registration inbound info.");
@@ -1480,6 +1540,24 @@ static void ami_event_inboundregisterationdetail(json_t* j_msg)
   return;
 }
 
+/**
+ * AMI event handler.
+ * Event: InboundRegistrationDetailComplete
+ * @param j_msg
+ */
+static void ami_event_inboundregisterationdetailcomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired ami_event_inboundregisterationdetailcomplete.");
+
+  pjsip_complete_registration_inbound_list();
+
+  return;
+}
+
 /**
  * AMI event handler.
  * Event: NewChannel
@@ -1546,6 +1624,24 @@ static void ami_event_newchannel(json_t* j_msg)
   return;
 }
 
+/**
+ * AMI event handler.
+ * Event: RegistrationsComplete
+ * @param j_msg
+ */
+static void ami_event_registrationscomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired ami_event_registrationscomplete.");
+
+  sip_complete_registry_list();
+
+  return;
+}
+
 /**
  * AMI event handler.
  * Event: RegistryEntry
@@ -1596,11 +1692,11 @@ static void ami_event_registryentry(json_t* j_msg)
     return;
   }
 
-  // create info
-  ret = sip_create_registry_info(j_tmp);
+  // sync info
+  ret = sip_sync_registry_info(j_tmp);
   json_decref(j_tmp);
   if(ret == false) {
-    slog(LOG_ERR, "Could not insert to registry.");
+    slog(LOG_ERR, "Could not sync sip registry info.");
     return;
   }
 
@@ -2301,9 +2397,7 @@ static void ami_event_varset(json_t* j_msg)
 static void ami_event_endpointlist(json_t* j_msg)
 {
   json_t* j_data;
-  json_t* j_tmp;
   char* timestamp;
-  const char* name;
   int ret;
 
   if(j_msg == NULL) {
@@ -2331,25 +2425,31 @@ static void ami_event_endpointlist(json_t* j_msg)
       );
   sfree(timestamp);
 
-  // create info
-  ret = pjsip_create_endpoint_info(j_data);
+  // sync info. the detail is requested if the endpoint has been changed.
+  ret = pjsip_sync_endpoint_list_info(j_data);
   json_decref(j_data);
   if(ret == false) {
-    slog(LOG_ERR, "Could not create endpoint info.");
+    slog(LOG_ERR, "Could not sync endpoint info.");
+    return;
   }
 
-  // send request for detail info
-  name = json_string_value(json_object_get(j_msg, "ObjectName"));
-  j_tmp = json_pack("{s:s, s:s}",
-      "Action", "PJSIPShowEndpoint",
-      "Endpoint", name
-      );
-  ret = ami_send_cmd(j_tmp);
-  json_decref(j_tmp);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowEndpoint");
+  return;
+}
+
+/**
+ * AMI event handler.
+ * Event: EndpointListComplete
+ * @param j_msg
+ */
+static void ami_event_endpointlistcomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
+  slog(LOG_DEBUG, "Fired ami_event_endpointlistcomplete.");
+
+  pjsip_complete_endpoint_list();
 
   return;
 }
@@ -2623,7 +2723,7 @@ static void ami_event_endpointdetail(json_t* j_msg)
   }
 
   // update info
-  ret = pjsip_update_endpoint_info(j_tmp);
+  ret = pjsip_sync_endpoint_info(j_tmp);
   json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert to pjsip_endpoint.");
@@ -2633,6 +2733,24 @@ static void ami_event_endpointdetail(json_t* j_msg)
   return;
 }
 
+/**
+ * AMI event handler.
+ * Event: EndpointDetailComplete
+ * @param j_msg
+ */
+static void ami_event_endpointdetailcomplete(json_t* j_msg)
+{
+  if(j_msg == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired ami_event_endpointdetailcomplete.");
+
+  pjsip_complete_endpoint_detail();
+
+  return;
+}
+
 /**
  * AMI event handler.
  * Event: ContactStatus
@@ -2784,7 +2902,7 @@ static void ami_event_contactstatusdetail(json_t* j_msg)
   sfree(timestamp);
 
   // create info
-  ret = pjsip_create_contact_info(j_data);
+  ret = pjsip_sync_contact_info(j_data);
   json_decref(j_data);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert to pjsip_contact.");
@@ -2861,7 +2979,7 @@ static void ami_event_aordetail(json_t* j_msg)
       );
   sfree(timestamp);
 
-  ret = pjsip_create_aor_info(j_data);
+  ret = pjsip_sync_aor_info(j_data);
   json_decref(j_data);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert to pjsip_aor.");
@@ -2924,7 +3042,7 @@ static void ami_event_authdetail(json_t* j_msg)
   sfree(timestamp);
 
   // create info
-  ret = pjsip_create_auth_info(j_data);
+  ret = pjsip_sync_auth_info(j_data);
   json_decref(j_data);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert to pjsip_aor.");
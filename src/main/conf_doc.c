@@ -0,0 +1,1068 @@
+/*
+ * conf_doc.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Asterisk config document.
+ *  The document is a list of the lines. The unchanged line refers to the
+ *  original data, so the output has the exact bytes of the untouched lines.
+ *  The edit replaces only the value span of the item line, or adds/removes lines.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/stat.h>
+
+#include "bsd_queue.h"
+#include "bsd_tree.h"
+#include "conf_doc.h"
+
+enum EN_CONF_LINE_TYPES {
+  EN_CONF_LINE_ETC = 0,     ///< blank, comment, directive or unknown.
+  EN_CONF_LINE_SECTION,
+  EN_CONF_LINE_ITEM,
+};
+
+struct conf_section;
+
+struct conf_line {
+  TAILQ_ENTRY(conf_line) entries;
+
+  enum EN_CONF_LINE_TYPES type;
+  struct conf_section* section;   ///< owner section. NULL if it's before the first section.
+
+  const char* text;   ///< line text with the line terminator.
+  size_t len;
+  char* buf;          ///< owned text if the line has been changed or added.
+
+  // item only. offsets in the text.
+  size_t key_start;
+  size_t key_len;
+  size_t value_start;
+  size_t value_len;
+};
+
+struct conf_section {
+  RB_ENTRY(conf_section) linkage;
+
+  char* name;
+  struct conf_line* header;
+  struct conf_section* next;    ///< next section which has the same name.
+};
+
+TAILQ_HEAD(conf_line_head, conf_line);
+RB_HEAD(conf_section_entries, conf_section);
+
+struct _conf_doc {
+  char* data;   ///< original data.
+  size_t len;
+
+  const char* eol;    ///< line terminator for the new lines. follows the first line.
+
+  struct conf_line_head lines;
+  struct conf_section_entries sections;   ///< first section of each name.
+
+  int changes;
+};
+
+static int compare_conf_section(struct conf_section *e1, struct conf_section *e2);
+
+RB_PROTOTYPE(conf_section_entries, conf_section, linkage, compare_conf_section);
+RB_GENERATE(conf_section_entries, conf_section, linkage, compare_conf_section);
+
+static void parse_line(conf_doc* doc, struct conf_line* line, struct conf_section** section, bool* in_block);
+static size_t get_content_len(const struct conf_line* line);
+static bool is_blank_line(const struct conf_line* line);
+static bool is_key_equal(const struct conf_line* line, const char* key);
+
+static struct conf_section* find_section(conf_doc* doc, const char* name);
+static struct conf_section* create_section(conf_doc* doc, const char* name, size_t len, struct conf_line* header);
+static struct conf_line* get_section_last_item(struct conf_section* section);
+
+static struct conf_line* create_line(const char* text, size_t len);
+static struct conf_line* create_item_line(conf_doc* doc, struct conf_section* section, const char* key, const char* value);
+static void set_line_text(struct conf_line* line, char* buf, size_t len);
+static bool set_line_value(struct conf_line* line, const char* value);
+static bool set_line_item(conf_doc* doc, struct conf_line* line, const char* key, const char* value);
+static bool insert_line_after(conf_doc* doc, struct conf_line* prev, struct conf_line* line);
+static void remove_line(conf_doc* doc, struct conf_line* line);
+
+static bool write_file_atomic(const char* filename, const char* data, size_t len);
+
+
+/**
+ * Load the config document from the file.
+ * @param filename
+ * @return NULL if could not read the file.
+ */
+conf_doc* conf_doc_load(const char* filename)
+{
+  conf_doc* doc;
+  FILE* fp;
+  char* data;
+  size_t size;
+  size_t len;
+  size_t ret;
+
+  if(filename == NULL) {
+    return NULL;
+  }
+
+  fp = fopen(filename, "r");
+  if(fp == NULL) {
+    return NULL;
+  }
+
+  size = 65536;
+  len = 0;
+  data = malloc(size);
+  while(1) {
+    if(len == size) {
+      size *= 2;
+      data = realloc(data, size);
+    }
+
+    ret = fread(data + len, 1, size - len, fp);
+    if(ret == 0) {
+      break;
+    }
+    len += ret;
+  }
+
+  if(ferror(fp) != 0) {
+    fclose(fp);
+    free(data);
+    return NULL;
+  }
+  fclose(fp);
+
+  doc = conf_doc_parse(data, len);
+  free(data);
+
+  return doc;
+}
+
+/**
+ * Parse the config document.
+ * @param data
+ * @param len
+ * @return
+ */
+conf_doc* conf_doc_parse(const char* data, size_t len)
+{
+  conf_doc* doc;
+  struct conf_line* line;
+  struct conf_section* section;
+  const char* end;
+  size_t line_len;
+  size_t pos;
+  bool in_block;
+
+  if(data == NULL) {
+    return NULL;
+  }
+
+  doc = calloc(1, sizeof(conf_doc));
+  doc->data = malloc(len + 1);
+  memcpy(doc->data, data, len);
+  doc->data[len] = '\0';
+  doc->len = len;
+  doc->eol = "\n";
+  TAILQ_INIT(&doc->lines);
+  RB_INIT(&doc->sections);
+
+  section = NULL;
+  in_block = false;
+  pos = 0;
+  while(pos < len) {
+    end = memchr(doc->data + pos, '\n', len - pos);
+    line_len = (end == NULL)? len - pos : (size_t)(end - (doc->data + pos)) + 1;
+
+    if((pos == 0) && (end != NULL) && (end > doc->data) && (*(end - 1) == '\r')) {
+      doc->eol = "\r\n";
+    }
+
+    line = create_line(doc->data + pos, line_len);
+    parse_line(doc, line, &section, &in_block);
+    TAILQ_INSERT_TAIL(&doc->lines, line, entries);
+
+    pos += line_len;
+  }
+
+  return doc;
+}
+
+void conf_doc_free(conf_doc* doc)
+{
+  struct conf_line* line;
+
+  if(doc == NULL) {
+    return;
+  }
+
+  while(1) {
+    line = TAILQ_FIRST(&doc->lines);
+    if(line == NULL) {
+      break;
+    }
+
+    TAILQ_REMOVE(&doc->lines, line, entries);
+    if(line->type == EN_CONF_LINE_SECTION) {
+      free(line->section->name);
+      free(line->section);
+    }
+    free(line->buf);
+    free(line);
+  }
+
+  free(doc->data);
+  free(doc);
+}
+
+bool conf_doc_has_section(conf_doc* doc, const char* section)
+{
+  if((doc == NULL) || (section == NULL)) {
+    return false;
+  }
+
+  if(find_section(doc, section) == NULL) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Returns true if any of the sections of the given name has the key.
+ */
+bool conf_doc_has_key(conf_doc* doc, const char* section, const char* key)
+{
+  struct conf_section* sec;
+  struct conf_line* line;
+
+  if((doc == NULL) || (section == NULL) || (key == NULL)) {
+    return false;
+  }
+
+  for(sec = find_section(doc, section); sec != NULL; sec = sec->next) {
+    for(line = TAILQ_NEXT(sec->header, entries); (line != NULL) && (line->section == sec); line = TAILQ_NEXT(line, entries)) {
+      if((line->type == EN_CONF_LINE_ITEM) && (is_key_equal(line, key) == true)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Add the empty section at the end of the document.
+ * @param doc
+ * @param section
+ * @return
+ */
+bool conf_doc_add_section(conf_doc* doc, const char* section)
+{
+  struct conf_line* last;
+  struct conf_line* line;
+  char* buf;
+  int len;
+
+  if((doc == NULL) || (section == NULL) || (strchr(section, ']') != NULL)) {
+    return false;
+  }
+
+  len = asprintf(&buf, "[%s]%s", section, doc->eol);
+  if(len < 0) {
+    return false;
+  }
+
+  // separate with the blank line
+  last = TAILQ_LAST(&doc->lines, conf_line_head);
+  if((last != NULL) && (is_blank_line(last) == false)) {
+    line = create_line(NULL, 0);
+    set_line_text(line, strdup(doc->eol), strlen(doc->eol));
+    line->section = last->section;
+    if(insert_line_after(doc, last, line) == false) {
+      free(line->buf);
+      free(line);
+      free(buf);
+      return false;
+    }
+    last = line;
+  }
+
+  line = create_line(NULL, 0);
+  set_line_text(line, buf, len);
+  line->type = EN_CONF_LINE_SECTION;
+  if(insert_line_after(doc, last, line) == false) {
+    free(line->buf);
+    free(line);
+    return false;
+  }
+  line->section = create_section(doc, section, strlen(section), line);
+
+  doc->changes++;
+
+  return true;
+}
+
+/**
+ * Delete all of the sections of the given name.
+ * The comments after the last item of the section are left for the next section.
+ * @param doc
+ * @param section
+ * @return false if there's no such section.
+ */
+bool conf_doc_delete_section(conf_doc* doc, const char* section)
+{
+  struct conf_section* sec;
+  struct conf_section* sec_next;
+  struct conf_line* line;
+  struct conf_line* prev;
+  struct conf_line* last;
+  struct conf_line* tmp;
+  struct conf_section* owner;
+
+  if((doc == NULL) || (section == NULL)) {
+    return false;
+  }
+
+  sec = find_section(doc, section);
+  if(sec == NULL) {
+    return false;
+  }
+  RB_REMOVE(conf_section_entries, &doc->sections, sec);
+
+  for(; sec != NULL; sec = sec_next) {
+    sec_next = sec->next;
+
+    prev = TAILQ_PREV(sec->header, conf_line_head, entries);
+    owner = (prev == NULL)? NULL : prev->section;
+    last = get_section_last_item(sec);
+
+    // remove header to the last item
+    line = sec->header;
+    while(1) {
+      tmp = TAILQ_NEXT(line, entries);
+      remove_line(doc, line);
+      if(line == last) {
+        break;
+      }
+      line = tmp;
+    }
+
+    // the rest belongs to the previous section
+    for(line = tmp; (line != NULL) && (line->section == sec); line = TAILQ_NEXT(line, entries)) {
+      line->section = owner;
+    }
+
+    // do not leave the double blank lines
+    if((prev != NULL) && (is_blank_line(prev) == true) && ((tmp == NULL) || (is_blank_line(tmp) == true))) {
+      remove_line(doc, prev);
+    }
+
+    free(sec->name);
+    free(sec);
+    doc->changes++;
+  }
+
+  return true;
+}
+
+/**
+ * Set the values of the key in the section.
+ * The existing lines of the key are reused in order, the rest of them are removed,
+ * and the missing values are added after the last line of the key.
+ * The count 0 removes the key.
+ * @param doc
+ * @param section
+ * @param key
+ * @param values
+ * @param count
+ * @return false if there's no such section.
+ */
+bool conf_doc_set_items(conf_doc* doc, const char* section, const char* key, const char** values, int count)
+{
+  struct conf_section* sec;
+  struct conf_section* first;
+  struct conf_line* line;
+  struct conf_line* tmp;
+  struct conf_line* last;
+  int idx;
+
+  if((doc == NULL) || (section == NULL) || (key == NULL) || ((values == NULL) && (count > 0))) {
+    return false;
+  }
+
+  first = find_section(doc, section);
+  if(first == NULL) {
+    return false;
+  }
+
+  idx = 0;
+  last = NULL;
+  for(sec = first; sec != NULL; sec = sec->next) {
+    for(line = TAILQ_NEXT(sec->header, entries); (line != NULL) && (line->section == sec); line = tmp) {
+      tmp = TAILQ_NEXT(line, entries);
+      if((line->type != EN_CONF_LINE_ITEM) || (is_key_equal(line, key) == false)) {
+        continue;
+      }
+
+      if(idx >= count) {
+        remove_line(doc, line);
+        doc->changes++;
+        continue;
+      }
+
+      if(set_line_value(line, values[idx]) == true) {
+        doc->changes++;
+      }
+      last = line;
+      idx++;
+    }
+  }
+
+  if(last == NULL) {
+    last = get_section_last_item(first);
+  }
+
+  for(; idx < count; idx++) {
+    line = create_item_line(doc, last->section, key, values[idx]);
+    if(line == NULL) {
+      return false;
+    }
+    if(insert_line_after(doc, last, line) == false) {
+      free(line->buf);
+      free(line);
+      return false;
+    }
+    last = line;
+    doc->changes++;
+  }
+
+  return true;
+}
+
+/**
+ * Remove the items of the section which are not in the given keys.
+ * @param doc
+ * @param section
+ * @param keys
+ * @param count
+ * @return false if there's no such section.
+ */
+bool conf_doc_retain_keys(conf_doc* doc, const char* section, const char** keys, int count)
+{
+  struct conf_section* sec;
+  struct conf_line* line;
+  struct conf_line* tmp;
+  bool found;
+  int i;
+
+  if((doc == NULL) || (section == NULL) || ((keys == NULL) && (count > 0))) {
+    return false;
+  }
+
+  sec = find_section(doc, section);
+  if(sec == NULL) {
+    return false;
+  }
+
+  for(; sec != NULL; sec = sec->next) {
+    for(line = TAILQ_NEXT(sec->header, entries); (line != NULL) && (line->section == sec); line = tmp) {
+      tmp = TAILQ_NEXT(line, entries);
+      if(line->type != EN_CONF_LINE_ITEM) {
+        continue;
+      }
+
+      found = false;
+      for(i = 0; i < count; i++) {
+        if(is_key_equal(line, keys[i]) == true) {
+          found = true;
+          break;
+        }
+      }
+      if(found == true) {
+        continue;
+      }
+
+      remove_line(doc, line);
+      doc->changes++;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Replace the items of the section with the given ordered items.
+ * The existing item lines are reused by the position.
+ * @param doc
+ * @param section
+ * @param keys
+ * @param values
+ * @param count
+ * @return false if there's no such section.
+ */
+bool conf_doc_replace_items(conf_doc* doc, const char* section, const char** keys, const char** values, int count)
+{
+  struct conf_section* sec;
+  struct conf_section* first;
+  struct conf_line* line;
+  struct conf_line* tmp;
+  struct conf_line* last;
+  int idx;
+
+  if((doc == NULL) || (section == NULL) || (((keys == NULL) || (values == NULL)) && (count > 0))) {
+    return false;
+  }
+
+  first = find_section(doc, section);
+  if(first == NULL) {
+    return false;
+  }
+
+  idx = 0;
+  last = NULL;
+  for(sec = first; sec != NULL; sec = sec->next) {
+    for(line = TAILQ_NEXT(sec->header, entries); (line != NULL) && (line->section == sec); line = tmp) {
+      tmp = TAILQ_NEXT(line, entries);
+      if(line->type != EN_CONF_LINE_ITEM) {
+        continue;
+      }
+
+      if(idx >= count) {
+        remove_line(doc, line);
+        doc->changes++;
+        continue;
+      }
+
+      if(is_key_equal(line, keys[idx]) == true) {
+        if(set_line_value(line, values[idx]) == true) {
+          doc->changes++;
+        }
+      }
+      else {
+        if(set_line_item(doc, line, keys[idx], values[idx]) == false) {
+          return false;
+        }
+        doc->changes++;
+      }
+      last = line;
+      idx++;
+    }
+  }
+
+  if(last == NULL) {
+    last = get_section_last_item(first);
+  }
+
+  for(; idx < count; idx++) {
+    line = create_item_line(doc, last->section, keys[idx], values[idx]);
+    if(line == NULL) {
+      return false;
+    }
+    if(insert_line_after(doc, last, line) == false) {
+      free(line->buf);
+      free(line);
+      return false;
+    }
+    last = line;
+    doc->changes++;
+  }
+
+  return true;
+}
+
+/**
+ * Returns count of the changes since the document was loaded.
+ */
+int conf_doc_get_changes(conf_doc* doc)
+{
+  if(doc == NULL) {
+    return 0;
+  }
+
+  return doc->changes;
+}
+
+/**
+ * Returns the text of the document.
+ * The return value should be freed after use.
+ * @param doc
+ * @param len: length of the text. Could be NULL.
+ * @return
+ */
+char* conf_doc_get_text(conf_doc* doc, size_t* len)
+{
+  struct conf_line* line;
+  char* res;
+  size_t size;
+  size_t pos;
+
+  if(doc == NULL) {
+    return NULL;
+  }
+
+  size = 0;
+  TAILQ_FOREACH(line, &doc->lines, entries) {
+    size += line->len;
+  }
+
+  res = malloc(size + 1);
+  pos = 0;
+  TAILQ_FOREACH(line, &doc->lines, entries) {
+    memcpy(res + pos, line->text, line->len);
+    pos += line->len;
+  }
+  res[pos] = '\0';
+
+  if(len != NULL) {
+    *len = pos;
+  }
+
+  return res;
+}
+
+/**
+ * Write the document to the file.
+ * Writes to the temp file in the same directory and renames it,
+ * so the readers see the old or the new file only.
+ * @param doc
+ * @param filename
+ * @return
+ */
+bool conf_doc_save(conf_doc* doc, const char* filename)
+{
+  char* text;
+  size_t len;
+  bool ret;
+
+  if((doc == NULL) || (filename == NULL)) {
+    return false;
+  }
+
+  text = conf_doc_get_text(doc, &len);
+  ret = write_file_atomic(filename, text, len);
+  free(text);
+
+  return ret;
+}
+
+static int compare_conf_section(struct conf_section *e1, struct conf_section *e2)
+{
+  return strcmp(e1->name, e2->name);
+}
+
+/**
+ * Parse the line type.
+ * Asterisk config syntax.
+ *   [section](template)
+ *   key = value ; comment
+ *   key => value
+ *   ;-- block comment --;
+ *   #include "file"
+ */
+static void parse_line(conf_doc* doc, struct conf_line* line, struct conf_section** section, bool* in_block)
+{
+  const char* text;
+  const char* close;
+  size_t len;
+  size_t pos;
+  size_t end;
+
+  text = line->text;
+  len = get_content_len(line);
+  line->type = EN_CONF_LINE_ETC;
+  line->section = *section;
+
+  if(*in_block == true) {
+    if(memmem(text, len, "--;", 3) != NULL) {
+      *in_block = false;
+    }
+    return;
+  }
+
+  for(pos = 0; (pos < len) && ((text[pos] == ' ') || (text[pos] == '\t')); pos++);
+  if(pos == len) {
+    return;
+  }
+
+  // comment
+  if(text[pos] == ';') {
+    if((len - pos >= 3) && (strncmp(text + pos, ";--", 3) == 0) && (memmem(text + pos + 3, len - pos - 3, "--;", 3) == NULL)) {
+      *in_block = true;
+    }
+    return;
+  }
+
+  // directive
+  if(text[pos] == '#') {
+    return;
+  }
+
+  // section
+  if(text[pos] == '[') {
+    close = memchr(text + pos + 1, ']', len - pos - 1);
+    if(close == NULL) {
+      return;
+    }
+
+    line->type = EN_CONF_LINE_SECTION;
+    line->section = create_section(doc, text + pos + 1, close - (text + pos + 1), line);
+    *section = line->section;
+    return;
+  }
+
+  // item
+  close = memchr(text + pos, '=', len - pos);
+  if(close == NULL) {
+    return;
+  }
+
+  line->key_start = pos;
+  for(end = close - text; (end > pos) && ((text[end - 1] == ' ') || (text[end - 1] == '\t')); end--);
+  if(end == pos) {
+    return;
+  }
+  line->key_len = end - pos;
+
+  pos = close - text + 1;
+  if((pos < len) && (text[pos] == '>')) {
+    pos++;
+  }
+  for(; (pos < len) && ((text[pos] == ' ') || (text[pos] == '\t')); pos++);
+  line->value_start = pos;
+
+  // the value ends at the comment. "\;" is not a comment.
+  for(end = pos; end < len; end++) {
+    if((text[end] == ';') && ((end == pos) || (text[end - 1] != '\\'))) {
+      break;
+    }
+  }
+  for(; (end > pos) && ((text[end - 1] == ' ') || (text[end - 1] == '\t')); end--);
+  line->value_len = end - pos;
+
+  line->type = EN_CONF_LINE_ITEM;
+}
+
+/**
+ * Returns length of the line without the line terminator.
+ */
+static size_t get_content_len(const struct conf_line* line)
+{
+  size_t len;
+
+  len = line->len;
+  if((len > 0) && (line->text[len - 1] == '\n')) {
+    len--;
+  }
+  if((len > 0) && (line->text[len - 1] == '\r')) {
+    len--;
+  }
+
+  return len;
+}
+
+static bool is_blank_line(const struct conf_line* line)
+{
+  size_t len;
+  size_t i;
+
+  len = get_content_len(line);
+  for(i = 0; i < len; i++) {
+    if((line->text[i] != ' ') && (line->text[i] != '\t')) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool is_key_equal(const struct conf_line* line, const char* key)
+{
+  if((strlen(key) != line->key_len) || (strncmp(line->text + line->key_start, key, line->key_len) != 0)) {
+    return false;
+  }
+
+  return true;
+}
+
+static struct conf_section* find_section(conf_doc* doc, const char* name)
+{
+  struct conf_section find;
+
+  find.name = (char*)name;
+
+  return RB_FIND(conf_section_entries, &doc->sections, &find);
+}
+
+/**
+ * Create the section and add it to the index.
+ * The section of the same name is chained to the first one.
+ */
+static struct conf_section* create_section(conf_doc* doc, const char* name, size_t len, struct conf_line* header)
+{
+  struct conf_section* section;
+  struct conf_section* tmp;
+
+  section = calloc(1, sizeof(struct conf_section));
+  section->name = strndup(name, len);
+  section->header = header;
+
+  tmp = find_section(doc, section->name);
+  if(tmp == NULL) {
+    RB_INSERT(conf_section_entries, &doc->sections, section);
+    return section;
+  }
+
+  while(tmp->next != NULL) {
+    tmp = tmp->next;
+  }
+  tmp->next = section;
+
+  return section;
+}
+
+/**
+ * Returns the last item line of the section.
+ * Returns the header if the section has no item.
+ */
+static struct conf_line* get_section_last_item(struct conf_section* section)
+{
+  struct conf_line* line;
+  struct conf_line* res;
+
+  res = section->header;
+  for(line = TAILQ_NEXT(section->header, entries); (line != NULL) && (line->section == section); line = TAILQ_NEXT(line, entries)) {
+    if(line->type == EN_CONF_LINE_ITEM) {
+      res = line;
+    }
+  }
+
+  return res;
+}
+
+static struct conf_line* create_line(const char* text, size_t len)
+{
+  struct conf_line* line;
+
+  line = calloc(1, sizeof(struct conf_line));
+  line->text = text;
+  line->len = len;
+
+  return line;
+}
+
+static struct conf_line* create_item_line(conf_doc* doc, struct conf_section* section, const char* key, const char* value)
+{
+  struct conf_line* line;
+
+  line = create_line(NULL, 0);
+  line->section = section;
+  if(set_line_item(doc, line, key, value) == false) {
+    free(line);
+    return NULL;
+  }
+
+  return line;
+}
+
+static void set_line_text(struct conf_line* line, char* buf, size_t len)
+{
+  free(line->buf);
+  line->buf = buf;
+  line->text = buf;
+  line->len = len;
+}
+
+/**
+ * Replace the value span of the item line.
+ * The key and the comment of the line are kept.
+ * @return false if the value is same.
+ */
+static bool set_line_value(struct conf_line* line, const char* value)
+{
+  size_t value_len;
+  size_t len;
+  char* buf;
+
+  value_len = strlen(value);
+  if((value_len == line->value_len) && (memcmp(line->text + line->value_start, value, value_len) == 0)) {
+    return false;
+  }
+
+  len = line->len - line->value_len + value_len;
+  buf = malloc(len + 1);
+  memcpy(buf, line->text, line->value_start);
+  memcpy(buf + line->value_start, value, value_len);
+  memcpy(buf + line->value_start + value_len, line->text + line->value_start + line->value_len, line->len - line->value_start - line->value_len);
+  buf[len] = '\0';
+
+  set_line_text(line, buf, len);
+  line->value_len = value_len;
+
+  return true;
+}
+
+/**
+ * Rewrite the whole line with the given item.
+ * Keeps the line terminator of the line.
+ */
+static bool set_line_item(conf_doc* doc, struct conf_line* line, const char* key, const char* value)
+{
+  const char* eol;
+  int eol_len;
+  char* buf;
+  int len;
+
+  eol = doc->eol;
+  eol_len = strlen(doc->eol);
+  if(line->len > get_content_len(line)) {
+    eol = line->text + get_content_len(line);
+    eol_len = line->len - get_content_len(line);
+  }
+  len = asprintf(&buf, "%s=%s%.*s", key, value, eol_len, eol);
+  if(len < 0) {
+    return false;
+  }
+
+  set_line_text(line, buf, len);
+  line->type = EN_CONF_LINE_ITEM;
+  line->key_start = 0;
+  line->key_len = strlen(key);
+  line->value_start = line->key_len + 1;
+  line->value_len = strlen(value);
+
+  return true;
+}
+
+/**
+ * Insert the line after the given line. Inserts at the end if prev is NULL.
+ * @return false if the line is not inserted.
+ */
+static bool insert_line_after(conf_doc* doc, struct conf_line* prev, struct conf_line* line)
+{
+  char* buf;
+  int len;
+
+  if(prev == NULL) {
+    TAILQ_INSERT_TAIL(&doc->lines, line, entries);
+    return true;
+  }
+
+  // the last line of the file could not have the terminator
+  if((prev->len == 0) || (prev->text[prev->len - 1] != '\n')) {
+    len = asprintf(&buf, "%.*s%s", (int)prev->len, prev->text, doc->eol);
+    if(len < 0) {
+      return false;
+    }
+    set_line_text(prev, buf, len);
+  }
+
+  TAILQ_INSERT_AFTER(&doc->lines, prev, line, entries);
+
+  return true;
+}
+
+/**
+ * Remove the line from the document.
+ * The section of the header line should be released by the caller.
+ */
+static void remove_line(conf_doc* doc, struct conf_line* line)
+{
+  TAILQ_REMOVE(&doc->lines, line, entries);
+  free(line->buf);
+  free(line);
+}
+
+static bool write_file_atomic(const char* filename, const char* data, size_t len)
+{
+  struct stat sb;
+  char* path;
+  char* tmp;
+  char* dir;
+  size_t pos;
+  ssize_t ret;
+  int fd;
+
+  // writes to the link target
+  path = realpath(filename, NULL);
+  if(path == NULL) {
+    if(errno != ENOENT) {
+      return false;
+    }
+    path = strdup(filename);
+  }
+
+  if(asprintf(&tmp, "%s.XXXXXX", path) < 0) {
+    free(path);
+    return false;
+  }
+  fd = mkstemp(tmp);
+  if(fd < 0) {
+    free(tmp);
+    free(path);
+    return false;
+  }
+
+  // keeps the permission of the original file
+  if(stat(path, &sb) == 0) {
+    fchmod(fd, sb.st_mode & 07777);
+    if(fchown(fd, sb.st_uid, sb.st_gid) != 0) {
+      // not permitted. the file is owned by the process user.
+    }
+  }
+  else {
+    fchmod(fd, 0644);
+  }
+
+  for(pos = 0; pos < len; pos += ret) {
+    ret = write(fd, data + pos, len - pos);
+    if(ret < 0) {
+      if(errno == EINTR) {
+        ret = 0;
+        continue;
+      }
+      break;
+    }
+  }
+
+  if((pos != len) || (fsync(fd) != 0)) {
+    close(fd);
+    unlink(tmp);
+    free(tmp);
+    free(path);
+    return false;
+  }
+  close(fd);
+
+  if(rename(tmp, path) != 0) {
+    unlink(tmp);
+    free(tmp);
+    free(path);
+    return false;
+  }
+  free(tmp);
+
+  // makes the rename durable
+  dir = dirname(path);
+  fd = open(dir, O_RDONLY | O_DIRECTORY);
+  if(fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+  free(path);
+
+  return true;
+}
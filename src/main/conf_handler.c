@@ -8,15 +8,20 @@
 #define _GNU_SOURCE
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <string.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #include "slog.h"
 #include "common.h"
 #include "utils.h"
 #include "minIni.h"
+#include "bsd_tree.h"
+#include "conf_doc.h"
 #include "conf_handler.h"
 
 extern app* g_app;
@@ -24,7 +29,46 @@ extern app* g_app;
 #define DEF_JADE_LIB_DIR          "/opt/var/lib/jade"
 #define DEF_AST_CONF_BACKUP_DIR   "confs"
 
-#define MAX_CONF_BUF    1048576   // 10 Mb(1024 * 1024)
+enum EN_CONF_CACHE_TYPES {
+  EN_CONF_CACHE_OBJECT = 1,
+  EN_CONF_CACHE_ARRAY,
+};
+
+/**
+ * Parsed asterisk config file.
+ * Valid while the file has the same stat info.
+ */
+struct conf_cache {
+  RB_ENTRY(conf_cache) linkage;
+
+  char* filename;   ///< full path
+
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  struct timespec mtim;
+  struct timespec ctim;
+
+  json_t* j_object;   ///< parsed as object. NULL if not parsed yet.
+  json_t* j_array;    ///< parsed as array. NULL if not parsed yet.
+};
+
+/**
+ * Backup file of the asterisk config file.
+ */
+struct conf_backup_file {
+  char* name;   ///< <filename>.<timestamp>
+  struct timespec mtim;
+};
+
+/**
+ * Counters of the config cache.
+ */
+struct conf_cache_stats {
+  unsigned long hit;
+  unsigned long miss;
+  unsigned long invalidate;   ///< count of the dropped cache by the file change.
+};
 
 static bool write_ast_config_info(const char* filename, json_t* j_conf);
 static bool write_ast_config_info_raw(const char* filename, const char* data);
@@ -37,6 +81,10 @@ static int parse_ast_conf_handler_as_object(const mTCHAR *section, const mTCHAR
 static int parse_ast_conf_handler_as_array(const mTCHAR *section, const mTCHAR *key, const mTCHAR *value, void *data);
 
 static int backup_ast_config_info(const char* filename);
+static int get_ast_backup_files(const char* filename, struct conf_backup_file** files);
+static void free_ast_backup_files(struct conf_backup_file* files, int count);
+static int compare_ast_backup_file(const void* a, const void* b);
+static void remove_ast_backup_expired(const char* filename);
 static bool create_jade_dirs(void);
 
 static json_t* get_ast_config_info_object(const char* filename);
@@ -53,6 +101,22 @@ static bool create_ast_current_config_section_data_array(const char* filename, c
 static bool update_ast_current_config_section_data_array(const char* filename, const char* section, const json_t* j_data);
 static bool delete_ast_current_config_section_array(const char* filename, const char* section);
 
+static bool set_conf_doc_section_data_array(conf_doc* doc, const char* section, const json_t* j_data);
+
+static json_t* get_ast_config_info_cache(const char* filename, enum EN_CONF_CACHE_TYPES type);
+static json_t* get_ast_current_config_info_cache(const char* filename);
+static struct conf_cache* find_conf_cache(const char* filename);
+static void remove_conf_cache(const char* filename);
+static void delete_conf_cache(struct conf_cache* cache);
+static bool is_conf_cache_valid(const struct conf_cache* cache, const struct stat* sb);
+static int compare_conf_cache(struct conf_cache *e1, struct conf_cache *e2);
+
+RB_HEAD(conf_cache_entries, conf_cache) g_conf_caches = RB_INITIALIZER(&g_conf_caches);
+RB_PROTOTYPE(conf_cache_entries, conf_cache, linkage, compare_conf_cache);
+RB_GENERATE(conf_cache_entries, conf_cache, linkage, compare_conf_cache);
+
+static struct conf_cache_stats g_conf_cache_stats = {0, 0, 0};
+
 
 bool conf_init_handler(void)
 {
@@ -67,6 +131,48 @@ bool conf_init_handler(void)
   return true;
 }
 
+void conf_term_handler(void)
+{
+  struct conf_cache* cache;
+
+  while(1) {
+    cache = RB_MIN(conf_cache_entries, &g_conf_caches);
+    if(cache == NULL) {
+      break;
+    }
+
+    RB_REMOVE(conf_cache_entries, &g_conf_caches, cache);
+    delete_conf_cache(cache);
+  }
+
+  return;
+}
+
+/**
+ * Returns the config cache counters.
+ * @return
+ */
+json_t* conf_get_cache_stats(void)
+{
+  json_t* j_res;
+  struct conf_cache* cache;
+  int count;
+
+  count = 0;
+  RB_FOREACH(cache, conf_cache_entries, &g_conf_caches) {
+    count++;
+  }
+
+  j_res = json_pack("{s:I, s:I, s:I, s:i}",
+      "conf_cache_hit",         (json_int_t)g_conf_cache_stats.hit,
+      "conf_cache_miss",        (json_int_t)g_conf_cache_stats.miss,
+      "conf_cache_invalidate",  (json_int_t)g_conf_cache_stats.invalidate,
+      "conf_cache_file_count",  count
+      );
+
+  return j_res;
+}
+
 static bool write_ast_config_info(const char* filename, json_t* j_conf)
 {
   const char* section;
@@ -84,6 +190,8 @@ static bool write_ast_config_info(const char* filename, json_t* j_conf)
   }
   slog(LOG_DEBUG, "Fired write_ast_config_info. filename[%s]", filename);
 
+  remove_conf_cache(filename);
+
   fp = fopen(filename, "w+");
   if(fp == NULL) {
     slog(LOG_ERR, "Could not open the conf file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
@@ -133,6 +241,8 @@ static bool write_ast_config_info_array(const char* filename, json_t* j_conf)
   }
   slog(LOG_DEBUG, "Fired write_ast_config_info_array. filename[%s]", filename);
 
+  remove_conf_cache(filename);
+
   fp = fopen(filename, "w+");
   if(fp == NULL) {
     slog(LOG_ERR, "Could not open the conf file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
@@ -179,6 +289,8 @@ static bool write_ast_config_info_raw(const char* filename, const char* data)
   }
   slog(LOG_DEBUG, "Fired write_ast_config_info_raw. filename[%s]", filename);
 
+  remove_conf_cache(filename);
+
   fp = fopen(filename, "w+");
   if(fp == NULL) {
     slog(LOG_ERR, "Could not open the conf file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
@@ -245,7 +357,7 @@ static json_t* get_ast_backup_filenames(const char* filename)
   // get file info
   for(i = 0; i < cnt; i++) {
     ret = strncmp(namelist[i]->d_name, filename, strlen(filename));
-    if(ret == 0) {
+    if((ret == 0) && (namelist[i]->d_name[strlen(filename)] == '.')) {
       json_array_append_new(j_res, json_string(namelist[i]->d_name));
     }
     free(namelist[i]);
@@ -353,16 +465,20 @@ static int parse_ast_conf_handler_as_array(const mTCHAR *section, const mTCHAR *
 
 /**
  * backup the given asterisk configuration file.
+ * Skips the backup if the content is same as the last backup.
+ * The old backups are removed by the retention options.
  * @param filename
  * @return
  */
 static int backup_ast_config_info(const char* filename)
 {
+  struct conf_backup_file* files;
   char* target;
   char* timestamp;
   char* backup_dir;
-  char* cmd;
+  char* last;
   char* tmp;
+  int count;
   int ret;
 
   if(filename == NULL) {
@@ -371,31 +487,202 @@ static int backup_ast_config_info(const char* filename)
   }
   slog(LOG_DEBUG, "Fired backup_ast_config_info. filename[%s]", filename);
 
-  timestamp = utils_get_utc_timestamp();
+  tmp = basename(filename);
   backup_dir = get_ast_backup_conf_dir();
 
+  // check the last backup
+  count = get_ast_backup_files(tmp, &files);
+  if(count > 0) {
+    asprintf(&last, "%s/%s", backup_dir, files[0].name);
+    ret = utils_is_file_same(filename, last);
+    sfree(last);
+    if(ret == true) {
+      slog(LOG_DEBUG, "The config file has not been changed since the last backup. filename[%s], backup[%s]", filename, files[0].name);
+      free_ast_backup_files(files, count);
+      sfree(backup_dir);
+      return true;
+    }
+  }
+  free_ast_backup_files(files, count);
+
   // create full target filename
-  tmp = basename(filename);
+  timestamp = utils_get_utc_timestamp();
   asprintf(&target, "%s/%s.%s", backup_dir, tmp, timestamp);
   sfree(backup_dir);
   sfree(timestamp);
 
-  // create cmd for copy config file to backdup dir
-  asprintf(&cmd, "cp -r %s %s", filename, target);
+  ret = utils_copy_file(filename, target);
   sfree(target);
-  slog(LOG_DEBUG, "Copy config file. cmd[%s]", cmd);
-
-  // execute
-  ret = system(cmd);
-  sfree(cmd);
-  if(ret != EXIT_SUCCESS) {
-    slog(LOG_ERR, "Could not backup the config file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+  if(ret == false) {
+    slog(LOG_ERR, "Could not backup the config file. filename[%s]", filename);
     return false;
   }
 
+  remove_ast_backup_expired(tmp);
+
   return true;
 }
 
+/**
+ * Get the backup files of the given config filename.
+ * The result is sorted by the modified time. The latest one is the first.
+ * The result should be freed by the free_ast_backup_files().
+ * @param filename: config filename without the directory.
+ * @param files
+ * @return count of the files. -1 if failed.
+ */
+static int get_ast_backup_files(const char* filename, struct conf_backup_file** files)
+{
+  struct conf_backup_file* res;
+  struct dirent* entry;
+  struct stat sb;
+  char* backup_dir;
+  char* tmp;
+  DIR* dir;
+  size_t len;
+  int size;
+  int count;
+  int ret;
+
+  *files = NULL;
+  if(filename == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return -1;
+  }
+
+  backup_dir = get_ast_backup_conf_dir();
+  dir = opendir(backup_dir);
+  if(dir == NULL) {
+    slog(LOG_ERR, "Could not open the backup directory. dir[%s], err[%d:%s]", backup_dir, errno, strerror(errno));
+    sfree(backup_dir);
+    return -1;
+  }
+
+  len = strlen(filename);
+  size = 0;
+  count = 0;
+  res = NULL;
+  while(1) {
+    entry = readdir(dir);
+    if(entry == NULL) {
+      break;
+    }
+
+    // <filename>.<timestamp>
+    if((strncmp(entry->d_name, filename, len) != 0) || (entry->d_name[len] != '.')) {
+      continue;
+    }
+
+    asprintf(&tmp, "%s/%s", backup_dir, entry->d_name);
+    ret = stat(tmp, &sb);
+    sfree(tmp);
+    if((ret != 0) || (S_ISREG(sb.st_mode) == 0)) {
+      continue;
+    }
+
+    if(count == size) {
+      size = (size == 0)? 16 : size * 2;
+      res = realloc(res, sizeof(struct conf_backup_file) * size);
+    }
+    res[count].name = strdup(entry->d_name);
+    res[count].mtim = sb.st_mtim;
+    count++;
+  }
+  closedir(dir);
+  sfree(backup_dir);
+
+  if(count > 1) {
+    qsort(res, count, sizeof(struct conf_backup_file), compare_ast_backup_file);
+  }
+  *files = res;
+
+  return count;
+}
+
+static void free_ast_backup_files(struct conf_backup_file* files, int count)
+{
+  int i;
+
+  if(files == NULL) {
+    return;
+  }
+
+  for(i = 0; i < count; i++) {
+    sfree(files[i].name);
+  }
+  free(files);
+}
+
+/**
+ * The latest one is the first.
+ */
+static int compare_ast_backup_file(const void* a, const void* b)
+{
+  const struct conf_backup_file* file1;
+  const struct conf_backup_file* file2;
+
+  file1 = a;
+  file2 = b;
+
+  if(file1->mtim.tv_sec != file2->mtim.tv_sec) {
+    return (file1->mtim.tv_sec < file2->mtim.tv_sec)? 1 : -1;
+  }
+  if(file1->mtim.tv_nsec != file2->mtim.tv_nsec) {
+    return (file1->mtim.tv_nsec < file2->mtim.tv_nsec)? 1 : -1;
+  }
+
+  return strcmp(file2->name, file1->name);
+}
+
+/**
+ * Remove the backups of the given config filename over the retention options.
+ * general.conf_backup_count: max backups per file. 0 is unlimited.
+ * general.conf_backup_days: days to keep the backups. 0 is unlimited.
+ * The latest backup is always kept.
+ * @param filename: config filename without the directory.
+ */
+static void remove_ast_backup_expired(const char* filename)
+{
+  struct conf_backup_file* files;
+  json_t* j_general;
+  const char* tmp_const;
+  char* backup_dir;
+  char* tmp;
+  time_t expire;
+  int max_count;
+  int max_days;
+  int count;
+  int i;
+
+  j_general = json_object_get(g_app->j_conf, "general");
+  tmp_const = json_string_value(json_object_get(j_general, "conf_backup_count"));
+  max_count = (tmp_const == NULL)? 0 : atoi(tmp_const);
+  tmp_const = json_string_value(json_object_get(j_general, "conf_backup_days"));
+  max_days = (tmp_const == NULL)? 0 : atoi(tmp_const);
+  if((max_count <= 0) && (max_days <= 0)) {
+    return;
+  }
+
+  count = get_ast_backup_files(filename, &files);
+  if(count <= 1) {
+    free_ast_backup_files(files, count);
+    return;
+  }
+
+  expire = time(NULL) - ((time_t)max_days * 86400);
+  backup_dir = get_ast_backup_conf_dir();
+  for(i = 1; i < count; i++) {
+    if(((max_count > 0) && (i >= max_count)) || ((max_days > 0) && (files[i].mtim.tv_sec < expire))) {
+      slog(LOG_DEBUG, "Remove the expired backup. filename[%s]", files[i].name);
+      asprintf(&tmp, "%s/%s", backup_dir, files[i].name);
+      unlink(tmp);
+      sfree(tmp);
+    }
+  }
+  sfree(backup_dir);
+  free_ast_backup_files(files, count);
+}
+
 static bool create_jade_dirs(void)
 {
   int ret;
@@ -470,16 +757,19 @@ static json_t* get_ast_config_info_array(const char* filename)
 
 
 /**
- * Get config file in a raw format
+ * Get config file in a raw format.
+ * Reads the whole file regardless of the size.
  * @param filename
  * @return
  */
 static char* get_ast_config_info_text(const char* filename)
 {
   FILE* fp;
-  char buf[MAX_CONF_BUF];
+  struct stat sb;
   char* res;
-  int ret;
+  size_t size;
+  size_t len;
+  size_t ret;
 
   if(filename == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -492,16 +782,34 @@ static char* get_ast_config_info_text(const char* filename)
     return NULL;
   }
 
-  ret = fread(buf, 1, MAX_CONF_BUF, fp);
-  if(ret == 0) {
+  // one more byte for the terminator and one more to hit the eof without growing.
+  // the buffer grows if the file grew after the stat.
+  size = 65536;
+  if((fstat(fileno(fp), &sb) == 0) && (sb.st_size > 0)) {
+    size = sb.st_size + 2;
+  }
+
+  len = 0;
+  res = malloc(size);
+  while(1) {
+    ret = fread(res + len, 1, size - len - 1, fp);
+    len += ret;
+    if(len < size - 1) {
+      break;
+    }
+
+    size *= 2;
+    res = realloc(res, size);
+  }
+
+  if(ferror(fp) != 0) {
+    slog(LOG_ERR, "Could not read conf file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
     fclose(fp);
-    slog(LOG_ERR, "Could not read conf file. err[%d:%s]", errno, strerror(errno));
+    sfree(res);
     return NULL;
   }
-  buf[ret] = '\0';
   fclose(fp);
-
-  res = strdup(buf);
+  res[len] = '\0';
 
   return res;
 }
@@ -520,6 +828,7 @@ static char* get_ast_config_info_text(const char* filename)
  */
 json_t* conf_get_ast_current_config_info(const char* filename)
 {
+  json_t* j_res;
   json_t* j_conf;
   const char* dir;
   char* target;
@@ -533,14 +842,18 @@ json_t* conf_get_ast_current_config_info(const char* filename)
   dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
   asprintf(&target, "%s/%s", dir, filename);
 
-  j_conf = get_ast_config_info_object(target);
+  j_conf = get_ast_config_info_cache(target, EN_CONF_CACHE_OBJECT);
   sfree(target);
   if(j_conf == NULL) {
     slog(LOG_ERR, "Could not get config file info.");
     return NULL;
   }
 
-  return j_conf;
+  // the caller could modify it
+  j_res = json_deep_copy(j_conf);
+  json_decref(j_conf);
+
+  return j_res;
 }
 
 /**
@@ -557,6 +870,7 @@ json_t* conf_get_ast_current_config_info(const char* filename)
  */
 json_t* conf_get_ast_current_config_info_array(const char* filename)
 {
+  json_t* j_res;
   json_t* j_conf;
   const char* dir;
   char* target;
@@ -570,14 +884,18 @@ json_t* conf_get_ast_current_config_info_array(const char* filename)
   dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
   asprintf(&target, "%s/%s", dir, filename);
 
-  j_conf = get_ast_config_info_array(target);
+  j_conf = get_ast_config_info_cache(target, EN_CONF_CACHE_ARRAY);
   sfree(target);
   if(j_conf == NULL) {
     slog(LOG_ERR, "Could not get config file info.");
     return NULL;
   }
 
-  return j_conf;
+  // the caller could modify it
+  j_res = json_deep_copy(j_conf);
+  json_decref(j_conf);
+
+  return j_res;
 }
 
 /**
@@ -834,6 +1152,54 @@ json_t* conf_get_ast_backup_config_info(const char* filename)
   return j_conf;
 }
 
+/**
+ * Returns the full path of the given config name.
+ * The name should be the current config name or the backup name of it.
+ * @param name config name. ex) pjsip.conf, pjsip.conf.2018-01-21T...
+ * @param current current config name. ex) pjsip.conf
+ * @return
+ */
+char* conf_get_ast_config_filename(const char* name, const char* current)
+{
+  const char* dir;
+  char* res;
+  char* tmp;
+  int len;
+
+  if((name == NULL) || (current == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  if(strchr(name, '/') != NULL) {
+    slog(LOG_NOTICE, "Wrong config name. name[%s]", name);
+    return NULL;
+  }
+
+  // current
+  if(strcmp(name, current) == 0) {
+    dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
+    if(dir == NULL) {
+      slog(LOG_ERR, "Could not get conf directory info.");
+      return NULL;
+    }
+    asprintf(&res, "%s/%s", dir, name);
+    return res;
+  }
+
+  // backup
+  len = strlen(current);
+  if((strncmp(name, current, len) != 0) || (name[len] != '.')) {
+    slog(LOG_NOTICE, "Wrong backup config name. name[%s], current[%s]", name, current);
+    return NULL;
+  }
+  tmp = get_ast_backup_conf_dir();
+  asprintf(&res, "%s/%s", tmp, name);
+  sfree(tmp);
+
+  return res;
+}
+
 /**
  * Get config info from given filename.
  * @param filename
@@ -1024,8 +1390,7 @@ bool conf_remove_ast_backup_config_info_valid(const char* filename, const char*
 bool conf_update_ast_current_config_content(const char* filename, const char* section, const char* key, const char* val)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_section;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (key == NULL) || (val == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1033,25 +1398,22 @@ bool conf_update_ast_current_config_content(const char* filename, const char* se
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
-  // get section, if not, return false.
-  j_section = json_object_get(j_conf, section);
-  if(j_section == NULL) {
-    json_decref(j_conf);
+  // update or insert. if no section, return false.
+  ret = conf_doc_set_items(doc, section, key, &val, 1);
+  if(ret == false) {
+    conf_doc_free(doc);
     return false;
   }
 
-  // update or insert
-  json_object_set_new(j_section, key, json_string(val));
-
   // write conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1070,9 +1432,7 @@ bool conf_update_ast_current_config_content(const char* filename, const char* se
 bool conf_create_ast_current_config_content(const char* filename, const char* section, const char* key, const char* val)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_section;
-  json_t* j_tmp;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (key == NULL) || (val == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1080,33 +1440,42 @@ bool conf_create_ast_current_config_content(const char* filename, const char* se
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
-  // get section, if not, create new.
-  j_section = json_object_get(j_conf, section);
-  if(j_section == NULL) {
-    j_section = json_object();
-    json_object_set_new(j_conf, section, j_section);
-  }
-
   // check existence
-  j_tmp = json_object_get(j_section, key);
-  if(j_tmp != NULL) {
-    json_decref(j_conf);
+  ret = conf_doc_has_key(doc, section, key);
+  if(ret == true) {
+    conf_doc_free(doc);
     slog(LOG_NOTICE, "The content is already exist.");
     return false;
   }
 
+  // get section, if not, create new.
+  ret = conf_doc_has_section(doc, section);
+  if(ret == false) {
+    ret = conf_doc_add_section(doc, section);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not add the section. section[%s]", section);
+      conf_doc_free(doc);
+      return false;
+    }
+  }
+
   // insert
-  json_object_set_new(j_section, key, json_string(val));
+  ret = conf_doc_set_items(doc, section, key, &val, 1);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not set the item. section[%s], key[%s]", section, key);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1125,7 +1494,7 @@ bool conf_create_ast_current_config_content(const char* filename, const char* se
 bool conf_delete_ast_current_config_content(const char* filename, const char* section, const char* key)
 {
   int ret;
-  json_t* j_conf;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (key == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1133,18 +1502,23 @@ bool conf_delete_ast_current_config_content(const char* filename, const char* se
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // delete key
-  json_object_del(json_object_get(j_conf, section), key);
+  ret = conf_doc_set_items(doc, section, key, NULL, 0);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not delete the item. section[%s], key[%s]", section, key);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1153,6 +1527,205 @@ bool conf_delete_ast_current_config_content(const char* filename, const char* se
   return true;
 }
 
+/**
+ * Open the asterisk configuration file for the edit.
+ * The edits should be written by the conf_commit_ast_current_config().
+ * The return value should be freed by the conf_doc_free() after use.
+ * @param filename
+ * @return
+ */
+conf_doc* conf_open_ast_current_config(const char* filename)
+{
+  conf_doc* doc;
+  const char* dir;
+  char* target;
+
+  if(filename == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired conf_open_ast_current_config. filename[%s]", filename);
+
+  dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
+  if(dir == NULL) {
+    slog(LOG_ERR, "Could not get conf directory info.");
+    return NULL;
+  }
+  asprintf(&target, "%s/%s", dir, filename);
+
+  doc = conf_doc_load(target);
+  if(doc == NULL) {
+    slog(LOG_ERR, "Could not load the config file. filename[%s], err[%d:%s]", target, errno, strerror(errno));
+    sfree(target);
+    return NULL;
+  }
+  sfree(target);
+
+  return doc;
+}
+
+/**
+ * Write the edited asterisk configuration file.
+ * Backups the current file once, and replaces it atomically.
+ * Does nothing if there's no change.
+ * @param filename
+ * @param doc
+ * @return
+ */
+bool conf_commit_ast_current_config(const char* filename, conf_doc* doc)
+{
+  int ret;
+  const char* dir;
+  char* target;
+
+  if((filename == NULL) || (doc == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired conf_commit_ast_current_config. filename[%s], changes[%d]", filename, conf_doc_get_changes(doc));
+
+  if(conf_doc_get_changes(doc) == 0) {
+    return true;
+  }
+
+  dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
+  if(dir == NULL) {
+    slog(LOG_ERR, "Could not get conf directory info.");
+    return false;
+  }
+  asprintf(&target, "%s/%s", dir, filename);
+
+  // backup current config
+  ret = backup_ast_config_info(target);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not backup current config file. filename[%s]", filename);
+    sfree(target);
+    return false;
+  }
+
+  remove_conf_cache(target);
+
+  ret = conf_doc_save(doc, target);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not write the config file. filename[%s], err[%d:%s]", target, errno, strerror(errno));
+    sfree(target);
+    return false;
+  }
+  sfree(target);
+
+  return true;
+}
+
+/**
+ * Set the given object data to the section of the document.
+ * The keys which are not in the data are removed.
+ * The value could be a string or an array of strings.
+ * @param doc
+ * @param section
+ * @param j_data
+ * @return
+ */
+bool conf_set_doc_section_data(conf_doc* doc, const char* section, const json_t* j_data)
+{
+  const char* key;
+  const char** keys;
+  const char** values;
+  json_t* j_val;
+  json_t* j_tmp;
+  int count;
+  int idx;
+  int i;
+  int ret;
+
+  if((doc == NULL) || (section == NULL) || (j_data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  // remove the keys not in the data
+  keys = calloc(json_object_size(j_data) + 1, sizeof(char*));
+  count = 0;
+  json_object_foreach((json_t*)j_data, key, j_val) {
+    keys[count] = key;
+    count++;
+  }
+  ret = conf_doc_retain_keys(doc, section, keys, count);
+  sfree(keys);
+  if(ret == false) {
+    return false;
+  }
+
+  // set the values
+  json_object_foreach((json_t*)j_data, key, j_val) {
+    if(json_is_array(j_val) == true) {
+      values = calloc(json_array_size(j_val) + 1, sizeof(char*));
+      i = 0;
+      json_array_foreach(j_val, idx, j_tmp) {
+        values[i] = json_string_value(j_tmp)? : "";
+        i++;
+      }
+    }
+    else {
+      values = calloc(1, sizeof(char*));
+      values[0] = json_string_value(j_val)? : "";
+      i = 1;
+    }
+
+    ret = conf_doc_set_items(doc, section, key, values, i);
+    sfree(values);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not set the item. section[%s], key[%s]", section, key);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Replace the items of the section with the given array data.
+ * [{"key": "value"}, ...]
+ * @param doc
+ * @param section
+ * @param j_data
+ * @return
+ */
+static bool set_conf_doc_section_data_array(conf_doc* doc, const char* section, const json_t* j_data)
+{
+  const char** keys;
+  const char** values;
+  json_t* j_item;
+  void* iter;
+  int count;
+  int idx;
+  int ret;
+
+  if((doc == NULL) || (section == NULL) || (j_data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  keys = calloc(json_array_size(j_data) + 1, sizeof(char*));
+  values = calloc(json_array_size(j_data) + 1, sizeof(char*));
+  count = 0;
+  json_array_foreach(j_data, idx, j_item) {
+    iter = json_object_iter(j_item);
+    if(iter == NULL) {
+      continue;
+    }
+
+    keys[count] = json_object_iter_key(iter);
+    values[count] = json_string_value(json_object_iter_value(iter))? : "";
+    count++;
+  }
+
+  ret = conf_doc_replace_items(doc, section, keys, values, count);
+  sfree(keys);
+  sfree(values);
+
+  return ret;
+}
+
 /**
  * Create asterisk configuration file section with given data.
  * If already exist, return false.
@@ -1163,9 +1736,7 @@ bool conf_delete_ast_current_config_content(const char* filename, const char* se
 static bool create_ast_current_config_section_data(const char* filename, const char* section, const json_t* j_data)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_section;
-  json_t* j_data_tmp;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (j_data == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1173,27 +1744,38 @@ static bool create_ast_current_config_section_data(const char* filename, const c
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // get section, if exists return false
-  j_section = json_object_get(j_conf, section);
-  if(j_section != NULL) {
+  ret = conf_doc_has_section(doc, section);
+  if(ret == true) {
     slog(LOG_ERR, "Section is already exist.");
-    json_decref(j_conf);
+    conf_doc_free(doc);
     return false;
   }
 
   // set data
-  j_data_tmp = json_deep_copy(j_data);
-  json_object_set_new(j_conf, section, j_data_tmp);
+  ret = conf_doc_add_section(doc, section);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not add the section. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
+
+  ret = conf_set_doc_section_data(doc, section, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not set the section data. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1212,9 +1794,7 @@ static bool create_ast_current_config_section_data(const char* filename, const c
 static bool update_ast_current_config_section_data(const char* filename, const char* section, const json_t* j_data)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_data_tmp;
-  json_t* j_section;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (j_data == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1223,27 +1803,31 @@ static bool update_ast_current_config_section_data(const char* filename, const c
   slog(LOG_DEBUG, "Fired update_ast_current_config_section_data. filename[%s]", filename);
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // get section, if not exists return false
-  j_section = json_object_get(j_conf, section);
-  if(j_section == NULL) {
+  ret = conf_doc_has_section(doc, section);
+  if(ret == false) {
     slog(LOG_ERR, "Section is not exist.");
-    json_decref(j_conf);
+    conf_doc_free(doc);
     return false;
   }
 
   // set data
-  j_data_tmp = json_deep_copy(j_data);
-  json_object_set_new(j_conf, section, j_data_tmp);
+  ret = conf_set_doc_section_data(doc, section, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not set the section data. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1262,7 +1846,7 @@ static bool update_ast_current_config_section_data(const char* filename, const c
 static bool delete_ast_current_config_section(const char* filename, const char* section)
 {
   int ret;
-  json_t* j_conf;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1271,18 +1855,18 @@ static bool delete_ast_current_config_section(const char* filename, const char*
   slog(LOG_DEBUG, "Fired delete_ast_current_config_section. filename[%s], section[%s]", filename, section);
 
   // get config
-  j_conf = conf_get_ast_current_config_info(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // delete section
-  json_object_del(j_conf, section);
+  conf_doc_delete_section(doc, section);
 
   // update conf
-  ret = conf_update_ast_current_config_info(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1301,9 +1885,7 @@ static bool delete_ast_current_config_section(const char* filename, const char*
 static bool create_ast_current_config_section_data_array(const char* filename, const char* section, const json_t* j_data)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_section;
-  json_t* j_data_tmp;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (j_data == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1316,27 +1898,38 @@ static bool create_ast_current_config_section_data_array(const char* filename, c
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info_array(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // get section, if exists return false
-  j_section = json_object_get(j_conf, section);
-  if(j_section != NULL) {
+  ret = conf_doc_has_section(doc, section);
+  if(ret == true) {
     slog(LOG_ERR, "Section is already exist.");
-    json_decref(j_conf);
+    conf_doc_free(doc);
     return false;
   }
 
   // set data
-  j_data_tmp = json_deep_copy(j_data);
-  json_object_set_new(j_conf, section, j_data_tmp);
+  ret = conf_doc_add_section(doc, section);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not add the section. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
+
+  ret = set_conf_doc_section_data_array(doc, section, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not set the section data. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info_array(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1355,9 +1948,7 @@ static bool create_ast_current_config_section_data_array(const char* filename, c
 static bool update_ast_current_config_section_data_array(const char* filename, const char* section, const json_t* j_data)
 {
   int ret;
-  json_t* j_conf;
-  json_t* j_data_tmp;
-  json_t* j_section;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL) || (j_data == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1371,27 +1962,31 @@ static bool update_ast_current_config_section_data_array(const char* filename, c
   }
 
   // get config
-  j_conf = conf_get_ast_current_config_info_array(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // get section, if not exists return false
-  j_section = json_object_get(j_conf, section);
-  if(j_section == NULL) {
+  ret = conf_doc_has_section(doc, section);
+  if(ret == false) {
     slog(LOG_ERR, "Section is not exist.");
-    json_decref(j_conf);
+    conf_doc_free(doc);
     return false;
   }
 
   // set data
-  j_data_tmp = json_deep_copy(j_data);
-  json_object_set_new(j_conf, section, j_data_tmp);
+  ret = set_conf_doc_section_data_array(doc, section, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not set the section data. section[%s]", section);
+    conf_doc_free(doc);
+    return false;
+  }
 
   // update conf
-  ret = conf_update_ast_current_config_info_array(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1410,7 +2005,7 @@ static bool update_ast_current_config_section_data_array(const char* filename, c
 static bool delete_ast_current_config_section_array(const char* filename, const char* section)
 {
   int ret;
-  json_t* j_conf;
+  conf_doc* doc;
 
   if((filename == NULL) || (section == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1419,18 +2014,18 @@ static bool delete_ast_current_config_section_array(const char* filename, const
   slog(LOG_DEBUG, "Fired delete_ast_current_config_section_array. filename[%s], section[%s]", filename, section);
 
   // get config
-  j_conf = conf_get_ast_current_config_info_array(filename);
-  if(j_conf == NULL) {
+  doc = conf_open_ast_current_config(filename);
+  if(doc == NULL) {
     slog(LOG_ERR, "Could not get config info.");
     return false;
   }
 
   // delete section
-  json_object_del(j_conf, section);
+  conf_doc_delete_section(doc, section);
 
   // update conf
-  ret = conf_update_ast_current_config_info_array(filename, j_conf);
-  json_decref(j_conf);
+  ret = conf_commit_ast_current_config(filename, doc);
+  conf_doc_free(doc);
   if(ret == false) {
     slog(LOG_ERR, "Could not update current ast config info.");
     return false;
@@ -1553,7 +2148,7 @@ json_t* conf_get_ast_sections_all(const char* filename)
 		return NULL;
 	}
 
-	j_conf = conf_get_ast_current_config_info(filename);
+	j_conf = get_ast_current_config_info_cache(filename);
 	if(j_conf == NULL) {
 		slog(LOG_ERR, "Could not get setting info.");
 		return NULL;
@@ -1561,9 +2156,9 @@ json_t* conf_get_ast_sections_all(const char* filename)
 
 	j_res = json_array();
 	json_object_foreach(j_conf, key, j_val) {
-		j_setting = json_pack("{s:s, s:O}",
+		j_setting = json_pack("{s:s, s:o}",
 				"name",			key,
-				"data",	    j_val
+				"data",	    json_deep_copy(j_val)
 				);
 		if(j_setting == NULL) {
 			slog(LOG_ERR, "Could not create setting info. key[%s]", key);
@@ -1593,12 +2188,12 @@ json_t* conf_get_ast_section(const char* filename, const char* name)
     return NULL;
   }
 
-  j_conf = conf_get_ast_current_config_info(filename);
+  j_conf = get_ast_current_config_info_cache(filename);
   j_tmp = json_object_get(j_conf, name);
 
-  j_res = json_pack("{s:s, s:O}",
+  j_res = json_pack("{s:s, s:o}",
       "name",   name,
-      "data",   j_tmp
+      "data",   json_deep_copy(j_tmp)
       );
 
   json_decref(j_conf);
@@ -1622,7 +2217,7 @@ json_t* conf_get_ast_section_data(const char* filename, const char* name)
 		return NULL;
 	}
 
-	j_conf = conf_get_ast_current_config_info(filename);
+	j_conf = get_ast_current_config_info_cache(filename);
 	j_setting = json_object_get(j_conf, name);
 	j_res = json_deep_copy(j_setting);
 	json_decref(j_conf);
@@ -1834,3 +2429,179 @@ bool conf_add_external_config_file(const char* filename, const char* external_fi
   return true;
 }
 
+/**
+ * Get the parsed config info of the given full path filename.
+ * Parses the file only if the cached one is not valid.
+ * The return value is shared with the cache. Do not modify it.
+ * The return value should be decref after use.
+ * @param filename
+ * @param type
+ * @return
+ */
+static json_t* get_ast_config_info_cache(const char* filename, enum EN_CONF_CACHE_TYPES type)
+{
+  struct conf_cache* cache;
+  struct timespec now;
+  struct stat sb;
+  json_t** j_cache;
+  json_t* j_res;
+  int ret;
+
+  if(filename == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  ret = stat(filename, &sb);
+  if(ret != 0) {
+    slog(LOG_ERR, "Could not get the conf file stat. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+    remove_conf_cache(filename);
+    return NULL;
+  }
+
+  // check cache
+  cache = find_conf_cache(filename);
+  if((cache != NULL) && (is_conf_cache_valid(cache, &sb) == false)) {
+    slog(LOG_DEBUG, "The conf file has been changed. filename[%s]", filename);
+    g_conf_cache_stats.invalidate++;
+    RB_REMOVE(conf_cache_entries, &g_conf_caches, cache);
+    delete_conf_cache(cache);
+    cache = NULL;
+  }
+
+  if(cache != NULL) {
+    j_res = (type == EN_CONF_CACHE_ARRAY)? cache->j_array : cache->j_object;
+    if(j_res != NULL) {
+      g_conf_cache_stats.hit++;
+      return json_incref(j_res);
+    }
+  }
+  g_conf_cache_stats.miss++;
+
+  // parse
+  if(type == EN_CONF_CACHE_ARRAY) {
+    j_res = get_ast_config_info_array(filename);
+  }
+  else {
+    j_res = get_ast_config_info_object(filename);
+  }
+  if(j_res == NULL) {
+    return NULL;
+  }
+
+  // the file could be changed again in the same timestamp tick.
+  // caches it only if the file has not been changed in the last second.
+  clock_gettime(CLOCK_REALTIME, &now);
+  if(sb.st_mtim.tv_sec >= now.tv_sec - 1) {
+    return j_res;
+  }
+
+  if(cache == NULL) {
+    cache = calloc(1, sizeof(struct conf_cache));
+    cache->filename = strdup(filename);
+    cache->dev = sb.st_dev;
+    cache->ino = sb.st_ino;
+    cache->size = sb.st_size;
+    cache->mtim = sb.st_mtim;
+    cache->ctim = sb.st_ctim;
+    RB_INSERT(conf_cache_entries, &g_conf_caches, cache);
+  }
+
+  j_cache = (type == EN_CONF_CACHE_ARRAY)? &cache->j_array : &cache->j_object;
+  *j_cache = json_incref(j_res);
+
+  return j_res;
+}
+
+/**
+ * Get the parsed config info of the given filename in the config directory.
+ * The return value is shared with the cache. Do not modify it.
+ * The return value should be decref after use.
+ * @param filename
+ * @return
+ */
+static json_t* get_ast_current_config_info_cache(const char* filename)
+{
+  json_t* j_res;
+  const char* dir;
+  char* target;
+
+  dir = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "directory_conf"));
+  asprintf(&target, "%s/%s", dir, filename);
+
+  j_res = get_ast_config_info_cache(target, EN_CONF_CACHE_OBJECT);
+  sfree(target);
+
+  return j_res;
+}
+
+static struct conf_cache* find_conf_cache(const char* filename)
+{
+  struct conf_cache find;
+
+  if(filename == NULL) {
+    return NULL;
+  }
+
+  find.filename = (char*)filename;
+
+  return RB_FIND(conf_cache_entries, &g_conf_caches, &find);
+}
+
+/**
+ * Remove the cache of the given full path filename.
+ * @param filename
+ */
+static void remove_conf_cache(const char* filename)
+{
+  struct conf_cache* cache;
+
+  cache = find_conf_cache(filename);
+  if(cache == NULL) {
+    return;
+  }
+
+  RB_REMOVE(conf_cache_entries, &g_conf_caches, cache);
+  delete_conf_cache(cache);
+
+  return;
+}
+
+static void delete_conf_cache(struct conf_cache* cache)
+{
+  if(cache == NULL) {
+    return;
+  }
+
+  json_decref(cache->j_object);
+  json_decref(cache->j_array);
+  sfree(cache->filename);
+  sfree(cache);
+
+  return;
+}
+
+/**
+ * Returns true if the file has not been changed since the cache was created.
+ * The ctime catches the change which restored the mtime.
+ */
+static bool is_conf_cache_valid(const struct conf_cache* cache, const struct stat* sb)
+{
+  if((cache->dev != sb->st_dev)
+      || (cache->ino != sb->st_ino)
+      || (cache->size != sb->st_size)
+      || (cache->mtim.tv_sec != sb->st_mtim.tv_sec)
+      || (cache->mtim.tv_nsec != sb->st_mtim.tv_nsec)
+      || (cache->ctim.tv_sec != sb->st_ctim.tv_sec)
+      || (cache->ctim.tv_nsec != sb->st_ctim.tv_nsec)
+      ) {
+    return false;
+  }
+
+  return true;
+}
+
+static int compare_conf_cache(struct conf_cache *e1, struct conf_cache *e2)
+{
+  return strcmp(e1->filename, e2->filename);
+}
@@ -42,21 +42,41 @@
 #define DEF_GENERAL_EVENT_TIME_SLOW "3000000"
 #define DEF_GENERAL_DIR_CONF	"/etc/asterisk"
 #define DEF_GENERAL_DIR_MODULE   "/usr/lib/asterisk/modules"
+#define DEF_GENERAL_CONF_BACKUP_COUNT   "100"   // max backups per config file. 0 is unlimited.
+#define DEF_GENERAL_CONF_BACKUP_DAYS    "0"     // days to keep the config backups. 0 is unlimited.
+#define DEF_GENERAL_MODULE_RELOAD_DELAY       "1000000"   // quiet period before the module reload. usec
+#define DEF_GENERAL_MODULE_RELOAD_MAX_DELAY   "10000000"  // max wait of the module reload from the first request. usec
 
 #define DEF_VOICEMAIL_DIRECTORY "/var/spool/asterisk/voicemail"
 
 #define DEF_OB_DIALING_RESULT_FILENAME  "./outbound_result.json"
 #define DEF_OB_DIALING_TIMEOUT          "30"
 #define DEF_OB_DATABASE_NAME  "./outbound_database.db"
+#define DEF_OB_DIALING_RESULT_FLUSH_SIZE      "65536"
+#define DEF_OB_DIALING_RESULT_FLUSH_INTERVAL  "1000000"
+#define DEF_OB_DIALING_RESULT_ROTATE_SIZE     "0"
+#define DEF_OB_DIALING_RESULT_ROTATE_DAILY    "0"
+#define DEF_OB_DIALING_RESULT_RETENTION       "7"
 
 #define DEF_DIALPLA_DEFAULT_ORIGINATE_TO_DEVICE   "72ebc4b8-ac5e-4863-a7d3-55ffdfef43ee"
 #define DEF_DIALPLA_DEFAULT_ORIGINATE_TO_NUMBER   "a922cf23-c650-426a-9ba0-a35ebc68a464"
 
 #define DEF_PJSIP_CONTEXT           "demo"
 #define DEF_PJSIP_DTLS_CERT_FILE    "/opt/bin/jade.pem"
+#define DEF_PJSIP_DETAIL_CONCURRENCY      "10"    // max PJSIPShowEndpoint in flight
+#define DEF_PJSIP_DETAIL_TIMEOUT          "5"     // sec. releases the in flight requests if there is no progress.
+#define DEF_PJSIP_DETAIL_SKIP_UNCHANGED   "0"     // 1 does not request the detail of the unchanged endpoint.
+
+#define DEF_CHAT_RETENTION_DAYS         "0"         // days to keep the messages. 0 disables.
+#define DEF_CHAT_RETENTION_COUNT        "0"         // max messages to keep per room. 0 disables.
+#define DEF_CHAT_RETENTION_INTERVAL     "1000000"   // micro seconds between the retention steps
+#define DEF_CHAT_RETENTION_BATCH_SIZE   "500"       // max deleted messages per step
+#define DEF_CHAT_RETENTION_ROOM_COUNT   "20"        // max checked rooms per step for the count policy
+#define DEF_CHAT_VACUUM_PAGES           "200"       // max released pages per step. 0 disables.
 
 extern app* g_app;
 static char g_config_filename[1024] = "";
+static json_t* g_conf_def = NULL;   // default config. fallback of the wrong config values.
 
 static bool load_config(void);
 static bool write_config(void);
@@ -136,6 +156,64 @@ bool config_update_filename(const char* filename)
   return true;
 }
 
+/**
+ * Get the config value of the given section and key.
+ * Returns the default value if the config does not have it.
+ * @param section
+ * @param key
+ * @return
+ */
+const char* config_get_value(const char* section, const char* key)
+{
+  const char* tmp_const;
+
+  if((section == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  tmp_const = json_string_value(json_object_get(json_object_get(g_app->j_conf, section), key));
+  if(tmp_const == NULL) {
+    tmp_const = json_string_value(json_object_get(json_object_get(g_conf_def, section), key));
+  }
+
+  return tmp_const;
+}
+
+/**
+ * Get the config value of the given section and key as a number.
+ * Returns the default value if the config value is less than the given min.
+ * @param section
+ * @param key
+ * @param min
+ * @return
+ */
+long long config_get_value_number(const char* section, const char* key, long long min)
+{
+  const char* tmp_const;
+  long long ret;
+
+  tmp_const = config_get_value(section, key);
+  if(tmp_const == NULL) {
+    slog(LOG_ERR, "Could not get config value. section[%s], key[%s]", section, key);
+    return min;
+  }
+
+  ret = strtoll(tmp_const, NULL, 10);
+  if(ret >= min) {
+    return ret;
+  }
+
+  tmp_const = json_string_value(json_object_get(json_object_get(g_conf_def, section), key));
+  slog(LOG_WARNING, "Wrong config value. Use default value. section[%s], key[%s], value[%lld], default[%s]",
+      section, key, ret, tmp_const? : "");
+  if(tmp_const == NULL) {
+    return min;
+  }
+
+  return strtoll(tmp_const, NULL, 10);
+}
+
 /**
  * Load configuration file and update
  * @return
@@ -159,12 +237,18 @@ static bool load_config(void)
       	"s:s, s:s, s:s, "
         "s:s, s:s, s:s, "
       	"s:s, s:s, "
-      	"s:s, s:s "
+      	"s:s, s:s, "
+        "s:s, s:s, "
+        "s:s, s:s "
 			"},"	// general
       "s:{s:s}, "	            // voicemail
-      "s:{s:s, s:s, s:s},"    // ob
-      "s:{s:s, s:s},"         // pjsip
-      "s:{s:s, s:s}"          // dialplan
+      "s:{s:s, s:s, s:s, "
+        "s:s, s:s, s:s, s:s, s:s},"    // ob
+      "s:{s:s, s:s, "
+        "s:s, s:s, s:s},"     // pjsip
+      "s:{s:s, s:s},"         // dialplan
+      "s:{s:s, s:s, s:s, "
+        "s:s, s:s, s:s}"      // chat
       "}",
       "general",
         "ast_serv_addr",    DEF_GENERAL_AST_SERV_ADDR,
@@ -191,6 +275,12 @@ static bool load_config(void)
 				"directory_conf",		DEF_GENERAL_DIR_CONF,
 				"directory_module", DEF_GENERAL_DIR_MODULE,
 
+        "conf_backup_count",  DEF_GENERAL_CONF_BACKUP_COUNT,
+        "conf_backup_days",   DEF_GENERAL_CONF_BACKUP_DAYS,
+
+        "module_reload_delay",      DEF_GENERAL_MODULE_RELOAD_DELAY,
+        "module_reload_max_delay",  DEF_GENERAL_MODULE_RELOAD_MAX_DELAY,
+
       "voicemail",
         "dicretory",        DEF_VOICEMAIL_DIRECTORY,
 
@@ -199,19 +289,41 @@ static bool load_config(void)
         "dialing_timeout",          DEF_OB_DIALING_TIMEOUT,
         "database_name",            DEF_OB_DATABASE_NAME,
 
+        "dialing_result_flush_size",      DEF_OB_DIALING_RESULT_FLUSH_SIZE,
+        "dialing_result_flush_interval",  DEF_OB_DIALING_RESULT_FLUSH_INTERVAL,
+        "dialing_result_rotate_size",     DEF_OB_DIALING_RESULT_ROTATE_SIZE,
+        "dialing_result_rotate_daily",    DEF_OB_DIALING_RESULT_ROTATE_DAILY,
+        "dialing_result_retention",       DEF_OB_DIALING_RESULT_RETENTION,
+
       "pjsip",
         "context",          DEF_PJSIP_CONTEXT,
         "dtls_cert_file",   DEF_PJSIP_DTLS_CERT_FILE,
 
+        "detail_concurrency",     DEF_PJSIP_DETAIL_CONCURRENCY,
+        "detail_timeout",         DEF_PJSIP_DETAIL_TIMEOUT,
+        "detail_skip_unchanged",  DEF_PJSIP_DETAIL_SKIP_UNCHANGED,
+
       "dialplan",
         "default_dpma_originate_to_device",     DEF_DIALPLA_DEFAULT_ORIGINATE_TO_DEVICE,
-        "default_dpma_originate_to_number",     DEF_DIALPLA_DEFAULT_ORIGINATE_TO_NUMBER
+        "default_dpma_originate_to_number",     DEF_DIALPLA_DEFAULT_ORIGINATE_TO_NUMBER,
+
+      "chat",
+        "retention_days",         DEF_CHAT_RETENTION_DAYS,
+        "retention_count",        DEF_CHAT_RETENTION_COUNT,
+        "retention_interval",     DEF_CHAT_RETENTION_INTERVAL,
+        "retention_batch_size",   DEF_CHAT_RETENTION_BATCH_SIZE,
+        "retention_room_count",   DEF_CHAT_RETENTION_ROOM_COUNT,
+        "vacuum_pages",           DEF_CHAT_VACUUM_PAGES
       );
   if(j_conf_def == NULL) {
     printf("Could not create default config.\n");
     return false;
   }
 
+  if(g_conf_def == NULL) {
+    g_conf_def = json_deep_copy(j_conf_def);
+  }
+
   j_conf = json_load_file(g_config_filename, JSON_DECODE_ANY, NULL);
 
   // update conf
@@ -2,15 +2,22 @@
 #define _GNU_SOURCE
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <jansson.h>
+#include <event2/event.h>
 
+#include "common.h"
 #include "slog.h"
+#include "event_handler.h"
 #include "resource_handler.h"
 #include "http_handler.h"
 #include "ami_action_handler.h"
 #include "utils.h"
 #include "call_handler.h"
 #include "publication_handler.h"
+#include "config.h"
 
 #include "core_handler.h"
 
@@ -18,6 +25,26 @@
 #define DEF_DB_TABLE_MODULE "core_module"
 #define DEF_DB_TABLE_SYSTEM "core_system"
 
+/**
+ * Delayed module reloads.
+ * The reload requests of the same module are coalesced
+ * until no more request comes in the delay.
+ */
+struct core_module_reload {
+  struct event* ev;
+  json_t* j_pendings;   // module name -> {"name", "requests", "tm_first", "tm_due"}
+
+  int delay;        // usec
+  int max_delay;    // usec
+
+  int requested;
+  int coalesced;
+  int sent;
+  int failed;
+};
+
+extern app* g_app;
+
 static struct st_callback* g_callback_module;
 
 static struct st_callback* g_callback_db_channel;
@@ -37,6 +64,8 @@ static bool term_callbacks(void);
 static bool db_create_channel_info(const json_t* j_data);
 static bool db_update_channel_info(const json_t* j_data);
 static bool db_delete_channel_info(const char* key);
+static json_t* create_channel_db_data(const json_t* j_data);
+static char* get_channel_device_name(const char* channel);
 
 static bool db_create_module_info(const json_t* j_data);
 static bool db_update_module_info(const json_t* j_data);
@@ -49,6 +78,14 @@ static void execute_callbacks_db_channel(enum EN_RESOURCE_UPDATE_TYPES type, con
 static void execute_callbacks_db_module(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static void execute_callbacks_db_system(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 
+static bool init_module_reload(void);
+static void term_module_reload(void);
+static void cb_module_reload(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static void schedule_module_reload(void);
+static double get_monotonic_time(void);
+static char* create_module_name(const char* name);
+
+static struct core_module_reload g_module_reload;
 
 bool core_init_handler(void)
 {
@@ -72,6 +109,12 @@ bool core_init_handler(void)
     return false;
   }
 
+  ret = init_module_reload();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate module reload.");
+    return false;
+  }
+
   return true;
 }
 
@@ -79,6 +122,7 @@ bool core_term_handler(void)
 {
 
   term_callbacks();
+  term_module_reload();
 
   return true;
 }
@@ -155,6 +199,7 @@ static bool init_database_channel(void)
 
       // channel info
       "   channel             varchar(255),"    ///< channel name
+      "   device_name         varchar(255),"    ///< device name parsed from the channel name. TECH/<device_name>-xxxx
       "   channel_state       int,"
       "   channel_state_desc  varchar(255),"
 
@@ -207,6 +252,13 @@ static bool init_database_channel(void)
     return false;
   }
 
+  // index for the device lookup
+  ret = resource_exec_mem_sql("create index idx_channel_device_name on " DEF_DB_TABLE_CALL_CHANNEL "(device_name);");
+  if(ret == false) {
+    slog(LOG_ERR, "Could not create index. database[%s]", DEF_DB_TABLE_CALL_CHANNEL);
+    return false;
+  }
+
   return true;
 }
 
@@ -362,7 +414,9 @@ static bool db_create_channel_info(const json_t* j_data)
   slog(LOG_DEBUG, "Fired db_create_channel_info.");
 
   // insert item
-  ret = resource_insert_mem_item(DEF_DB_TABLE_CALL_CHANNEL, j_data);
+  j_tmp = create_channel_db_data(j_data);
+  ret = resource_insert_mem_item(DEF_DB_TABLE_CALL_CHANNEL, j_tmp);
+  json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert core_channel.");
     return false;
@@ -400,7 +454,9 @@ static bool db_update_channel_info(const json_t* j_data)
     return false;
   }
 
-  ret = resource_update_mem_item(DEF_DB_TABLE_CALL_CHANNEL, "unique_id", j_data);
+  j_tmp = create_channel_db_data(j_data);
+  ret = resource_update_mem_item(DEF_DB_TABLE_CALL_CHANNEL, "unique_id", j_tmp);
+  json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_ERR, "Could not update core_channel info.");
     return false;
@@ -459,6 +515,69 @@ static bool db_delete_channel_info(const char* key)
   return true;
 }
 
+/**
+ * Returns the channel db data with the device_name.
+ * The device_name is always re-parsed from the channel name,
+ * so the index follows the Rename.
+ * @param j_data
+ * @return
+ */
+static json_t* create_channel_db_data(const json_t* j_data)
+{
+  json_t* j_res;
+  const char* channel;
+  char* device_name;
+
+  j_res = json_deep_copy(j_data);
+
+  channel = json_string_value(json_object_get(j_data, "channel"));
+  if(channel == NULL) {
+    return j_res;
+  }
+
+  device_name = get_channel_device_name(channel);
+  json_object_set_new(j_res, "device_name", device_name? json_string(device_name) : json_null());
+  sfree(device_name);
+
+  return j_res;
+}
+
+/**
+ * Parse the device name from the given channel name.
+ * ex) PJSIP/test-01-00000003 -> test-01
+ * @param channel
+ * @return
+ */
+static char* get_channel_device_name(const char* channel)
+{
+  const char* start;
+  const char* end;
+  char* res;
+
+  if(channel == NULL) {
+    return NULL;
+  }
+
+  start = strchr(channel, '/');
+  if(start == NULL) {
+    return NULL;
+  }
+  start++;
+
+  // strip the sequence suffix
+  end = strrchr(start, '-');
+  if(end == NULL) {
+    end = start + strlen(start);
+  }
+
+  if(end == start) {
+    return NULL;
+  }
+
+  res = strndup(start, end - start);
+  return res;
+}
+
 static bool db_create_module_info(const json_t* j_data)
 {
   int ret;
@@ -788,16 +907,30 @@ json_t* core_get_channels_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of channels ordered by unique_id.
+ * @param cursor: unique_id of the last channel of the previous page.
+ * @param count
+ * @return
+ */
+json_t* core_get_channels_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_CALL_CHANNEL, "unique_id", cursor, count);
+  return j_res;
+}
+
 /**
  * Returns all of channels info belongs to the given device_name.
- * Beware, the device_name should be like an uuid.
+ * The device_name is the channel name without technology and sequence.
+ * ex) PJSIP/test-01-00000003 -> test-01
  * @param devicename
  * @return
  */
 json_t* core_get_channels_by_devicename(const char* device_name)
 {
   json_t* j_res;
-  char* condition;
 
   if(device_name == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -805,12 +938,33 @@ json_t* core_get_channels_by_devicename(const char* device_name)
   }
   slog(LOG_DEBUG, "Fired call_get_channels_by_devicename. devicename[%s]", device_name);
 
-  asprintf(&condition, "where channel like '%%%s%%'", device_name);
+  j_res = resource_get_mem_detail_items_key_string(DEF_DB_TABLE_CALL_CHANNEL, "device_name", device_name);
+  if(j_res == NULL) {
+    slog(LOG_ERR, "Could not get channels info. device_name[%s]", device_name);
+    return NULL;
+  }
+
+  return j_res;
+}
+
+/**
+ * Returns all of channels info belongs to the given device_names.
+ * @param j_device_names: json array of device name strings.
+ * @return
+ */
+json_t* core_get_channels_by_devicenames(const json_t* j_device_names)
+{
+  json_t* j_res;
+
+  if(j_device_names == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired core_get_channels_by_devicenames.");
 
-  j_res = resource_get_mem_detail_items_by_condtion(DEF_DB_TABLE_CALL_CHANNEL, condition);
-  sfree(condition);
+  j_res = resource_get_mem_detail_items_key_strings(DEF_DB_TABLE_CALL_CHANNEL, "device_name", j_device_names);
   if(j_res == NULL) {
-    slog(LOG_ERR, "Could not get chat rooms info. user_uuid[%s]", device_name);
+    slog(LOG_ERR, "Could not get channels info.");
     return NULL;
   }
 
@@ -975,6 +1129,20 @@ json_t* core_get_modules_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of modules ordered by name.
+ * @param cursor: name of the last module of the previous page.
+ * @param count
+ * @return
+ */
+json_t* core_get_modules_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page("core_module", "name", cursor, count);
+  return j_res;
+}
+
 /**
  * Get given core_module info.
  * @return
@@ -1072,6 +1240,20 @@ json_t* core_get_systems_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of systems ordered by id.
+ * @param cursor: id of the last system of the previous page.
+ * @param count
+ * @return
+ */
+json_t* core_get_systems_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_SYSTEM, "id", cursor, count);
+  return j_res;
+}
+
 /**
  * Get corresponding system detail info.
  * @return
@@ -1162,6 +1344,7 @@ bool core_module_load(const char* name)
 bool core_module_reload(const char* name)
 {
   int ret;
+  char* tmp;
 
   if(name == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1173,6 +1356,243 @@ bool core_module_reload(const char* name)
     return false;
   }
 
+  // the pending reload is not needed anymore
+  tmp = create_module_name(name);
+  json_object_del(g_module_reload.j_pendings, tmp);
+  sfree(tmp);
+
   return true;
 }
 
+/**
+ * Request the reload of the given module after the config change.
+ * The requests are coalesced until no more request comes in the delay,
+ * then the module is reloaded once.
+ * The reload is not delayed more than the max delay from the first request.
+ * @param name module name
+ * @return
+ */
+bool core_module_reload_delayed(const char* name)
+{
+  json_t* j_pending;
+  double now;
+  double due;
+  double tm_first;
+  char* tmp;
+
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired core_module_reload_delayed. name[%s]", name);
+
+  if(g_module_reload.j_pendings == NULL) {
+    return core_module_reload(name);
+  }
+
+  g_module_reload.delay = config_get_value_number("general", "module_reload_delay", 0);
+  g_module_reload.max_delay = config_get_value_number("general", "module_reload_max_delay", 0);
+  g_module_reload.requested++;
+
+  now = get_monotonic_time();
+  due = now + (g_module_reload.delay / 1000000.0);
+
+  // the same module of the other name is coalesced. ex) res_pjsip, res_pjsip.so
+  tmp = create_module_name(name);
+  j_pending = json_object_get(g_module_reload.j_pendings, tmp);
+  if(j_pending == NULL) {
+    j_pending = json_pack("{s:s, s:i, s:f, s:f}",
+        "name",       tmp,
+        "requests",   0,
+        "tm_first",   now,
+        "tm_due",     due
+        );
+    json_object_set_new(g_module_reload.j_pendings, tmp, j_pending);
+  }
+  else {
+    g_module_reload.coalesced++;
+  }
+  sfree(tmp);
+
+  tm_first = json_real_value(json_object_get(j_pending, "tm_first"));
+  if(due > tm_first + (g_module_reload.max_delay / 1000000.0)) {
+    due = tm_first + (g_module_reload.max_delay / 1000000.0);
+  }
+  json_object_set_new(j_pending, "requests", json_integer(json_integer_value(json_object_get(j_pending, "requests")) + 1));
+  json_object_set_new(j_pending, "tm_due", json_real(due));
+
+  schedule_module_reload();
+
+  return true;
+}
+
+/**
+ * Returns the delayed module reload status.
+ * @return
+ */
+json_t* core_get_module_reload_status(void)
+{
+  json_t* j_res;
+  json_t* j_pendings;
+  json_t* j_pending;
+  const char* key;
+  double now;
+  double wait;
+
+  now = get_monotonic_time();
+  j_pendings = json_array();
+  json_object_foreach(g_module_reload.j_pendings, key, j_pending) {
+    wait = json_real_value(json_object_get(j_pending, "tm_due")) - now;
+    json_array_append_new(j_pendings, json_pack("{s:s, s:I, s:f}",
+        "name",       key,
+        "requests",   json_integer_value(json_object_get(j_pending, "requests")),
+        "wait",       (wait < 0)? 0 : wait
+        ));
+  }
+
+  j_res = json_pack("{s:i, s:i, s:o, s:i, s:i, s:i, s:i}",
+      "delay",      g_module_reload.delay,
+      "max_delay",  g_module_reload.max_delay,
+
+      "pendings",   j_pendings,
+
+      "requested",  g_module_reload.requested,
+      "coalesced",  g_module_reload.coalesced,
+      "sent",       g_module_reload.sent,
+      "failed",     g_module_reload.failed
+      );
+
+  return j_res;
+}
+
+static bool init_module_reload(void)
+{
+  if(g_module_reload.ev != NULL) {
+    return true;
+  }
+
+  memset(&g_module_reload, 0x00, sizeof(g_module_reload));
+  g_module_reload.delay = config_get_value_number("general", "module_reload_delay", 0);
+  g_module_reload.max_delay = config_get_value_number("general", "module_reload_max_delay", 0);
+
+  g_module_reload.ev = event_new(g_app->evt_base, -1, EV_TIMEOUT, cb_module_reload, NULL);
+  if(g_module_reload.ev == NULL) {
+    slog(LOG_ERR, "Could not create event for the module reload.");
+    return false;
+  }
+  event_add_handler(g_module_reload.ev);
+  g_module_reload.j_pendings = json_object();
+
+  return true;
+}
+
+static void term_module_reload(void)
+{
+  json_decref(g_module_reload.j_pendings);
+  g_module_reload.j_pendings = NULL;
+}
+
+/**
+ * Reloads the modules which reached the due time.
+ * The failed reload is tried again after the delay.
+ */
+static void cb_module_reload(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  json_t* j_dues;
+  json_t* j_pending;
+  json_t* j_tmp;
+  const char* key;
+  size_t idx;
+  double now;
+  int ret;
+
+  // get due modules
+  now = get_monotonic_time();
+  j_dues = json_array();
+  json_object_foreach(g_module_reload.j_pendings, key, j_pending) {
+    if(json_real_value(json_object_get(j_pending, "tm_due")) > now) {
+      continue;
+    }
+    json_array_append_new(j_dues, json_string(key));
+  }
+
+  json_array_foreach(j_dues, idx, j_tmp) {
+    key = json_string_value(j_tmp);
+    j_pending = json_object_get(g_module_reload.j_pendings, key);
+
+    slog(LOG_NOTICE, "Reload the module. name[%s], requests[%lld]",
+        key, json_integer_value(json_object_get(j_pending, "requests")));
+    ret = ami_action_moduleload(key, "reload");
+    if(ret == false) {
+      slog(LOG_ERR, "Could not reload the module. name[%s]", key);
+      g_module_reload.failed++;
+      json_object_set_new(j_pending, "tm_due", json_real(now + (g_module_reload.delay / 1000000.0)));
+      continue;
+    }
+
+    g_module_reload.sent++;
+    json_object_del(g_module_reload.j_pendings, key);
+  }
+  json_decref(j_dues);
+
+  schedule_module_reload();
+}
+
+/**
+ * Sets the timer to the earliest due time of the pending reloads.
+ */
+static void schedule_module_reload(void)
+{
+  struct timeval tm_wait;
+  json_t* j_pending;
+  const char* key;
+  double due;
+  double wait;
+
+  if(json_object_size(g_module_reload.j_pendings) == 0) {
+    event_del(g_module_reload.ev);
+    return;
+  }
+
+  due = 0;
+  json_object_foreach(g_module_reload.j_pendings, key, j_pending) {
+    if((due == 0) || (json_real_value(json_object_get(j_pending, "tm_due")) < due)) {
+      due = json_real_value(json_object_get(j_pending, "tm_due"));
+    }
+  }
+
+  wait = due - get_monotonic_time();
+  if(wait < 0) {
+    wait = 0;
+  }
+  tm_wait.tv_sec = (time_t)wait;
+  tm_wait.tv_usec = (suseconds_t)((wait - tm_wait.tv_sec) * 1000000);
+  event_add(g_module_reload.ev, &tm_wait);
+}
+
+/**
+ * Returns the module name without the .so suffix.
+ * The pending reloads are keyed by this name.
+ * @param name
+ * @return
+ */
+static char* create_module_name(const char* name)
+{
+  size_t len;
+
+  len = strlen(name);
+  if((len > 3) && (strcmp(name + len - 3, ".so") == 0)) {
+    len -= 3;
+  }
+
+  return strndup(name, len);
+}
+
+static double get_monotonic_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
@@ -38,6 +38,7 @@ static db_ctx_t* db_ctx_create(void)
   }
   ctx->db = NULL;
   ctx->stmt = NULL;
+  ctx->query_count = 0;
 
   return ctx;
 }
@@ -207,6 +208,7 @@ bool db_ctx_query(db_ctx_t* ctx, const char* query)
   // free ctx stmt if exists
   db_ctx_free(ctx);
 
+  ctx->query_count++;
   ret = sqlite3_prepare_v2(ctx->db, query, -1, &result, NULL);
   if(ret != SQLITE_OK) {
     slog(LOG_ERR, "Could not prepare query. query[%s], err[%s]", query, sqlite3_errmsg(ctx->db));
@@ -239,6 +241,7 @@ bool db_ctx_exec(db_ctx_t* ctx, const char* query)
   sqlite3_busy_handler(ctx->db, db_ctx_busy_handler, &bh_attr);
 
   // execute
+  ctx->query_count++;
   ret = sqlite3_exec(ctx->db, query, NULL, 0, &err);
   if(ret != SQLITE_OK) {
     slog(LOG_ERR, "Could not execute query. query[%s], err[%s]", query, err);
@@ -250,6 +253,21 @@ bool db_ctx_exec(db_ctx_t* ctx, const char* query)
   return true;
 }
 
+/**
+ * Return the count of changed rows by the last executed query.
+ * @param ctx
+ * @return -1 if failed.
+ */
+int db_ctx_get_changes(db_ctx_t* ctx)
+{
+  if((ctx == NULL) || (ctx->db == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return -1;
+  }
+
+  return sqlite3_changes(ctx->db);
+}
+
 /**
  * Return 1 record info by json.
  * If there's no more record or error happened, it will return NULL.
@@ -19,6 +19,7 @@
 #include "resource_handler.h"
 #include "publication_handler.h"
 #include "ami_action_handler.h"
+#include "core_handler.h"
 
 #include "dialplan_handler.h"
 
@@ -33,6 +34,14 @@
 #define DEF_DB_TABLE_DP_DIALPLANMASTER    "dp_dpma"
 #define DEF_DB_TABLE_DP_DIALPLAN          "dp_dialplan"
 
+/**
+ * Ordered dialplans of each dpma.
+ * dpma_uuid -> [dialplan, ...] ordered by sequence. Has the existing dpmas only.
+ * Refreshed from the database whenever the dpma or dialplan is changed,
+ * so the agi call does not query the database.
+ */
+static json_t* g_dpma_index = NULL;
+
 static bool init_databases(void);
 static bool init_database_dp_dialplan(void);
 static bool init_database_dp_dialplanmaster(void);
@@ -56,6 +65,10 @@ static bool is_default_dpma_originate_to_device(const char* agi_uuid);
 static bool is_exist_dialplan_info(const char* dpma_uuid, int seq);
 static bool is_exist_dialplan_info_uuid(const char* uuid);
 
+static bool init_dpma_index(void);
+static void update_dpma_index(const char* dpma_uuid);
+static json_t* get_dialplans_by_dpma_uuid_order_sequence_db(const char* dpma_uuid);
+
 // static dialplan
 static bool cfg_create_sdialplan_info(const char* name, const json_t* j_data);
 static bool cfg_update_sdialplan_info(const json_t* j_data);
@@ -87,6 +100,12 @@ bool dialplan_init_handler(void)
     return false;
   }
 
+  ret = init_dpma_index();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate dpma index.");
+    return false;
+  }
+
   ret = init_default_originate_to_device();
   if(ret == false) {
     slog(LOG_ERR, "Could not initiate default dialplans.");
@@ -98,6 +117,9 @@ bool dialplan_init_handler(void)
 
 bool dialplan_term_handler(void)
 {
+  json_decref(g_dpma_index);
+  g_dpma_index = NULL;
+
   return true;
 }
 
@@ -560,6 +582,8 @@ bool dialplan_update_dialplan_info(const json_t* j_data)
   json_object_del(j_tmp, "tm_create");
   json_object_del(j_tmp, "tm_update");
 
+  json_object_set_new(j_tmp, "uuid", json_string(uuid));
+
   timestamp = utils_get_utc_timestamp();
   json_object_set_new(j_tmp, "tm_update", json_string(timestamp));
   sfree(timestamp);
@@ -693,8 +717,8 @@ bool dialplan_add_cmds(const char* agi_uuid)
     return false;
   }
 
-  ret = is_exist_dpma_info(jade_dpma_uuid);
-  if(ret == false) {
+  // the index has the existing dpmas only
+  if(json_object_get(g_dpma_index, jade_dpma_uuid) == NULL) {
     slog(LOG_ERR, "The given agi_arg_2 is not exist.");
     json_decref(j_agi);
     return false;
@@ -816,6 +840,20 @@ json_t* dialplan_get_dpmas_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of dpmas ordered by uuid.
+ * @param cursor: uuid of the last dpma of the previous page.
+ * @param count
+ * @return
+ */
+json_t* dialplan_get_dpmas_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_file_items_page(DEF_DB_TABLE_DP_DIALPLANMASTER, "uuid", cursor, count);
+  return j_res;
+}
+
 /**
  * Get corresponding dp_dpma detail info.
  * @return
@@ -858,6 +896,7 @@ static bool db_create_dpma_info(const json_t* j_data)
     slog(LOG_ERR, "Could not insert dp_dpma info.");
     return false;
   }
+  update_dpma_index(json_string_value(json_object_get(j_data, "uuid")));
 
   // publish
   // get info
@@ -902,6 +941,7 @@ static bool db_update_dpma_info(const json_t* j_data)
     slog(LOG_ERR, "Could not update dp_dpma info.");
     return false;
   }
+  update_dpma_index(json_string_value(json_object_get(j_data, "uuid")));
 
   // publish
   // get info
@@ -952,6 +992,7 @@ static bool db_delete_dpma_info(const char* key)
     json_decref(j_tmp);
     return false;
   }
+  update_dpma_index(key);
 
   // publish
   // publish event
@@ -978,10 +1019,47 @@ json_t* dialplan_get_dialplans_all(void)
 }
 
 /**
- * Get all dp_dialplans by dpma_uuid order by sequence
+ * Returns the page of dialplans ordered by uuid.
+ * @param cursor: uuid of the last dialplan of the previous page.
+ * @param count
+ * @return
+ */
+json_t* dialplan_get_dialplans_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_file_items_page(DEF_DB_TABLE_DP_DIALPLAN, "uuid", cursor, count);
+  return j_res;
+}
+
+/**
+ * Get all dp_dialplans by dpma_uuid order by sequence.
+ * Returns from the dpma index without the database query.
  * @return
  */
 json_t* dialplan_get_dialplans_by_dpma_uuid_order_sequence(const char* dpma_uuid)
+{
+  json_t* j_res;
+
+  if(dpma_uuid == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = json_object_get(g_dpma_index, dpma_uuid);
+  if(j_res == NULL) {
+    return json_array();
+  }
+
+  // the caller could modify it
+  return json_deep_copy(j_res);
+}
+
+/**
+ * Get all dp_dialplans by dpma_uuid order by sequence from the database.
+ * @return
+ */
+static json_t* get_dialplans_by_dpma_uuid_order_sequence_db(const char* dpma_uuid)
 {
   json_t* j_res;
   json_t* j_obj;
@@ -999,6 +1077,64 @@ json_t* dialplan_get_dialplans_by_dpma_uuid_order_sequence(const char* dpma_uuid
   return j_res;
 }
 
+/**
+ * Build the dpma index from the database.
+ * @return
+ */
+static bool init_dpma_index(void)
+{
+  json_t* j_dpmas;
+  json_t* j_dpma;
+  int idx;
+
+  json_decref(g_dpma_index);
+  g_dpma_index = json_object();
+
+  j_dpmas = dialplan_get_dpmas_all();
+  if(j_dpmas == NULL) {
+    slog(LOG_ERR, "Could not get dpmas info.");
+    return false;
+  }
+
+  json_array_foreach(j_dpmas, idx, j_dpma) {
+    update_dpma_index(json_string_value(json_object_get(j_dpma, "uuid")));
+  }
+  json_decref(j_dpmas);
+  slog(LOG_DEBUG, "Initiated dpma index. count[%d]", (int)json_object_size(g_dpma_index));
+
+  return true;
+}
+
+/**
+ * Refresh the index of the given dpma from the database.
+ * The deleted dpma is removed from the index.
+ * @param dpma_uuid
+ */
+static void update_dpma_index(const char* dpma_uuid)
+{
+  json_t* j_dpma;
+  json_t* j_dps;
+
+  if((dpma_uuid == NULL) || (g_dpma_index == NULL)) {
+    return;
+  }
+
+  j_dpma = dialplan_get_dpma_info(dpma_uuid);
+  if(j_dpma == NULL) {
+    json_object_del(g_dpma_index, dpma_uuid);
+    return;
+  }
+  json_decref(j_dpma);
+
+  j_dps = get_dialplans_by_dpma_uuid_order_sequence_db(dpma_uuid);
+  if(j_dps == NULL) {
+    slog(LOG_ERR, "Could not get dialplans info. Remove from the index. dpma_uuid[%s]", dpma_uuid);
+    json_object_del(g_dpma_index, dpma_uuid);
+    return;
+  }
+  json_object_set_new(g_dpma_index, dpma_uuid, j_dps);
+}
+
 /**
  * Get corresponding dp_dialplan detail info.
  * @return
@@ -1070,6 +1206,7 @@ static bool db_create_dialplan_info(const json_t* j_data)
     slog(LOG_ERR, "Could not insert dp_dialplan contact.");
     return false;
   }
+  update_dpma_index(json_string_value(json_object_get(j_data, "dpma_uuid")));
 
   // publish
   // get info
@@ -1101,6 +1238,7 @@ static bool db_update_dialplan_info(const json_t* j_data)
   int ret;
   const char* tmp_const;
   json_t* j_tmp;
+  json_t* j_old;
 
   if(j_data == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1108,22 +1246,36 @@ static bool db_update_dialplan_info(const json_t* j_data)
   }
   slog(LOG_DEBUG, "Fired db_update_dialplan_info.");
 
+  // get old info. the dialplan could be moved to the other dpma.
+  tmp_const = json_string_value(json_object_get(j_data, "uuid"));
+  j_old = dialplan_get_dialplan_info(tmp_const);
+
   // update
   ret = resource_update_file_item(DEF_DB_TABLE_DP_DIALPLAN, "uuid", j_data);
   if(ret == false) {
     slog(LOG_ERR, "Could not update dp_dialplan info.");
+    json_decref(j_old);
     return false;
   }
 
-  // publish
   // get info
-  tmp_const = json_string_value(json_object_get(j_data, "uuid"));
   j_tmp = dialplan_get_dialplan_info(tmp_const);
   if(j_tmp == NULL) {
     slog(LOG_ERR, "Could not get dp_dialplan info. uuid[%s]", tmp_const);
+    json_decref(j_old);
     return false;
   }
 
+  // update index
+  update_dpma_index(json_string_value(json_object_get(j_tmp, "dpma_uuid")));
+  if(j_old != NULL) {
+    if(json_equal(json_object_get(j_old, "dpma_uuid"), json_object_get(j_tmp, "dpma_uuid")) != 1) {
+      update_dpma_index(json_string_value(json_object_get(j_old, "dpma_uuid")));
+    }
+    json_decref(j_old);
+  }
+
+  // publish
   // publish event
   ret = publication_publish_event_dp_dialplan(DEF_PUB_TYPE_UPDATE, j_tmp);
   json_decref(j_tmp);
@@ -1164,6 +1316,7 @@ static bool db_delete_dialplan_info(const char* key)
     json_decref(j_tmp);
     return false;
   }
+  update_dpma_index(json_string_value(json_object_get(j_tmp, "dpma_uuid")));
 
   // publish
   // publish event
@@ -1588,6 +1741,21 @@ json_t* dialplan_get_configuration_info(const char* name)
   return j_res;
 }
 
+/**
+ * Returns the config filename of the given name for the raw text.
+ * @param name current or backup config name
+ * @return
+ */
+char* dialplan_get_configuration_filename(const char* name)
+{
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  return conf_get_ast_config_filename(name, DEF_AST_DIALPLAN_CONFNAME);
+}
+
 bool dialplan_update_configuration_info(const json_t* j_data)
 {
   int ret;
@@ -1645,14 +1813,15 @@ bool dialplan_delete_configuration_info(const char* name)
 }
 
 /**
- * Reload asterisk dialplan module
+ * Reload asterisk dialplan module.
+ * The reload is delayed to coalesce the following config changes.
  * @return
  */
 bool dialplan_reload_asterisk(void)
 {
   int ret;
 
-  ret = ami_action_moduleload("pbx_config", "reload");
+  ret = core_module_reload_delayed("pbx_config");
   if(ret == false) {
     return false;
   }
@@ -12,11 +12,16 @@
 #include <event2/event.h>
 #include <evhtp.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include "common.h"
 #include "slog.h"
 #include "utils.h"
 #include "http_handler.h"
+#include "http_range.h"
 #include "resource_handler.h"
 #include "base64.h"
 
@@ -38,13 +43,43 @@
 
 #define DEF_REG_MSGNAME "msg[0-9]{4}"
 
+#define DEF_HTTP_CHUNK_SIZE       65536   ///< flush size of the chunked list response.
+#define DEF_HTTP_LIST_BATCH_SIZE  DEF_HTTP_PAGE_LIMIT_MAX   ///< item count of the batch of the whole list response.
+
 #define DEF_USER_PERM_ADMIN    "admin"
 #define DEF_USER_PERM_USER     "user"
 
+/**
+ * State of the chunked list response.
+ */
+struct http_list_stream {
+  evhtp_request_t* req;
+  json_t* j_list;       ///< items of the current batch.
+  struct evbuffer* buf;
+  size_t idx;           ///< index of the next item of the batch.
+  size_t count;         ///< item count to send of the batch.
+  size_t sent;          ///< sent item count.
+
+  http_page_func func;  ///< gets the next batch of the whole list. NULL for the single batch.
+  char* key;            ///< key column of the cursor.
+
+  bool paged;           ///< true if the response has the next_cursor.
+  char* cursor;         ///< next_cursor. NULL for the last page.
+  bool done;            ///< true if the reply has been ended.
+};
+
 static bool init_https(void);
 
 static char* get_data_from_request(evhtp_request_t* req);
 
+static struct http_list_stream* create_list_stream(evhtp_request_t* req, json_t* j_list, const char* key);
+static void send_list_stream(struct http_list_stream* stream);
+static bool send_list_stream_chunk(struct http_list_stream* stream);
+static bool load_list_stream_batch(struct http_list_stream* stream);
+static void destroy_list_stream(struct http_list_stream* stream);
+static evhtp_res cb_list_stream_write(evhtp_connection_t* conn, void* arg);
+static evhtp_res cb_list_stream_fini(evhtp_request_t* req, void* arg);
+
 // ping
 static void cb_htp_ping(evhtp_request_t *req, void *a);
 
@@ -53,6 +88,7 @@ static void cb_htp_admin_core_channels(evhtp_request_t *req, void *data);
 static void cb_htp_admin_core_channels_detail(evhtp_request_t *req, void *data);
 static void cb_htp_admin_core_modules(evhtp_request_t *req, void *data);
 static void cb_htp_admin_core_modules_detail(evhtp_request_t *req, void *data);
+static void cb_htp_admin_core_reloads(evhtp_request_t *req, void *data);
 static void cb_htp_admin_core_systems(evhtp_request_t *req, void *data);
 static void cb_htp_admin_core_systems_detail(evhtp_request_t *req, void *data);
 
@@ -91,6 +127,8 @@ static void cb_htp_admin_pjsip_endpoints(evhtp_request_t *req, void *data);
 static void cb_htp_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data);
 static void cb_htp_admin_pjsip_registration_outbounds(evhtp_request_t *req, void *data);
 static void cb_htp_admin_pjsip_registration_outbounds_detail(evhtp_request_t *req, void *data);
+static void cb_htp_admin_pjsip_sync(evhtp_request_t *req, void *data);
+static void cb_htp_admin_pjsip_batch(evhtp_request_t *req, void *data);
 
 static void cb_htp_admin_queue_cfg_queues(evhtp_request_t *req, void *data);
 static void cb_htp_admin_queue_cfg_queues_detail(evhtp_request_t *req, void *data);
@@ -102,6 +140,13 @@ static void cb_htp_admin_queue_members(evhtp_request_t *req, void *data);
 static void cb_htp_admin_queue_members_detail(evhtp_request_t *req, void *data);
 static void cb_htp_admin_queue_queues(evhtp_request_t *req, void *data);
 static void cb_htp_admin_queue_queues_detail(evhtp_request_t *req, void *data);
+static void cb_htp_admin_queue_stats(evhtp_request_t *req, void *data);
+static void cb_htp_admin_queue_stats_detail(evhtp_request_t *req, void *data);
+
+static void cb_htp_admin_resource_stats(evhtp_request_t *req, void *data);
+
+// chat
+static void cb_htp_admin_chat_retention(evhtp_request_t *req, void *data);
 
 static void cb_htp_admin_user_users(evhtp_request_t *req, void *data);
 static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data);
@@ -134,6 +179,7 @@ static void cb_htp_me_contacts(evhtp_request_t *req, void *data);
 static void cb_htp_me_chats(evhtp_request_t *req, void *data);
 static void cb_htp_me_chats_detail(evhtp_request_t *req, void *data);
 static void cb_htp_me_chats_detail_messages(evhtp_request_t *req, void *data);
+static void cb_htp_me_chats_detail_read(evhtp_request_t *req, void *data);
 static void cb_htp_me_info(evhtp_request_t *req, void *data);
 static void cb_htp_me_login(evhtp_request_t *req, void *data);
 static void cb_htp_me_search(evhtp_request_t *req, void *data);
@@ -186,6 +232,8 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/v1/admin/core/modules$", cb_htp_admin_core_modules, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/core/modules/(.*)", cb_htp_admin_core_modules_detail, NULL);
 
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/core/reloads$", cb_htp_admin_core_reloads, NULL);
+
   evhtp_set_regex_cb(g_htps, "^/v1/admin/core/systems$", cb_htp_admin_core_systems, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/core/systems/(.*)", cb_htp_admin_core_systems_detail, NULL);
 
@@ -230,6 +278,8 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/auths$", cb_htp_admin_pjsip_auths, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/auths/(.*)", cb_htp_admin_pjsip_auths_detail, NULL);
 
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/batch$", cb_htp_admin_pjsip_batch, NULL);
+
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/configurations$", cb_htp_admin_pjsip_configurations, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/configurations/(.*)", cb_htp_admin_pjsip_configurations_detail, NULL);
 
@@ -242,6 +292,8 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/registration_outbounds$", cb_htp_admin_pjsip_registration_outbounds, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/registration_outbounds/(.*)", cb_htp_admin_pjsip_registration_outbounds_detail, NULL);
 
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/pjsip/sync$", cb_htp_admin_pjsip_sync, NULL);
+
   // queue
   evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/cfg_queues$", cb_htp_admin_queue_cfg_queues, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/cfg_queues/(.*)", cb_htp_admin_queue_cfg_queues_detail, NULL);
@@ -258,6 +310,17 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/queues$", cb_htp_admin_queue_queues, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/queues/(.*)", cb_htp_admin_queue_queues_detail, NULL);
 
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/stats$", cb_htp_admin_queue_stats, NULL);
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/queue/stats/(.*)", cb_htp_admin_queue_stats_detail, NULL);
+
+
+  /// resource
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/resource/stats$", cb_htp_admin_resource_stats, NULL);
+
+
+  /// chat
+  evhtp_set_regex_cb(g_htps, "^/v1/admin/chat/retention$", cb_htp_admin_chat_retention, NULL);
+
 
   /// user
   evhtp_set_regex_cb(g_htps, "^/v1/admin/user/users$", cb_htp_admin_user_users, NULL);
@@ -315,6 +378,7 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/v1/me/chats$", cb_htp_me_chats, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/me/chats/("DEF_REG_UUID")$", cb_htp_me_chats_detail, NULL);
   evhtp_set_regex_cb(g_htps, "^/v1/me/chats/("DEF_REG_UUID")/messages$", cb_htp_me_chats_detail_messages, NULL);
+  evhtp_set_regex_cb(g_htps, "^/v1/me/chats/("DEF_REG_UUID")/read$", cb_htp_me_chats_detail_read, NULL);
 
   // info
   evhtp_set_regex_cb(g_htps, "^/v1/me/info$", cb_htp_me_info, NULL);
@@ -389,6 +453,7 @@ bool http_init_handler(void)
   evhtp_set_regex_cb(g_htps, "^/me/chats$", cb_htp_me_chats, NULL);
   evhtp_set_regex_cb(g_htps, "^/me/chats/("DEF_REG_UUID")$", cb_htp_me_chats_detail, NULL);
   evhtp_set_regex_cb(g_htps, "^/me/chats/("DEF_REG_UUID")/messages$", cb_htp_me_chats_detail_messages, NULL);
+  evhtp_set_regex_cb(g_htps, "^/me/chats/("DEF_REG_UUID")/read$", cb_htp_me_chats_detail_read, NULL);
 
   // info
   evhtp_set_regex_cb(g_htps, "^/me/info$", cb_htp_me_info, NULL);
@@ -573,6 +638,392 @@ void http_simple_response_normal(evhtp_request_t *req, json_t* j_msg)
   return;
 }
 
+/**
+ * Send the list response with chunked transfer encoding.
+ * The items are serialized up to DEF_HTTP_CHUNK_SIZE per chunk, and the next
+ * chunk is created when the connection's output buffer is drained.
+ * So the slow client does not make the whole response buffered.
+ * If the page is enabled, the given list should have page->limit + 1 items at most,
+ * and the next_cursor is created from the key of the last item of the page.
+ * result: {"list": [...], "next_cursor": "..."}
+ * @param req
+ * @param j_list
+ * @param page: NULL or disabled page sends all of the given items without next_cursor.
+ * @param key: key column of the cursor.
+ */
+void http_simple_response_list(evhtp_request_t *req, const json_t* j_list, const http_page* page, const char* key)
+{
+  struct http_list_stream* stream;
+  const char* tmp_const;
+
+  if((req == NULL) || (j_list == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired http_simple_response_list.");
+
+  stream = create_list_stream(req, (json_t*)j_list, key);
+
+  // cut the page
+  if((page != NULL) && (page->enable == true)) {
+    stream->paged = true;
+
+    if(stream->count > (size_t)page->limit) {
+      stream->count = page->limit;
+
+      tmp_const = json_string_value(json_object_get(json_array_get(j_list, stream->count - 1), key));
+      stream->cursor = http_page_create_cursor(tmp_const);
+      if(stream->cursor == NULL) {
+        slog(LOG_WARNING, "Could not create the cursor. key[%s]", key);
+      }
+    }
+  }
+
+  send_list_stream(stream);
+
+  return;
+}
+
+/**
+ * Send the list of the given func.
+ * If the request has any of limit and cursor, sends the page of the request
+ * with the next_cursor. The func gives one more item to see the next page.
+ * Otherwise, sends all of the items. The items are got from the func
+ * batch by batch while the response is sent, so the whole list is never loaded.
+ * @param req
+ * @param func
+ * @param key: key column of the cursor.
+ */
+void http_simple_response_page(evhtp_request_t *req, http_page_func func, const char* key)
+{
+  struct http_list_stream* stream;
+  json_t* j_tmp;
+  http_page page;
+  int ret;
+
+  if((req == NULL) || (func == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+
+  // get page
+  ret = http_get_page(req, &page);
+  if(ret == false) {
+    http_page_clear(&page);
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    return;
+  }
+
+  // get info. gets one more item to see the next page.
+  if(page.enable == true) {
+    j_tmp = func(page.cursor, page.limit + 1);
+  }
+  else {
+    j_tmp = func(NULL, DEF_HTTP_LIST_BATCH_SIZE);
+  }
+  if(j_tmp == NULL) {
+    slog(LOG_NOTICE, "Could not get info.");
+    http_page_clear(&page);
+    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
+    return;
+  }
+
+  // response
+  if(page.enable == true) {
+    http_simple_response_list(req, j_tmp, &page, key);
+  }
+  else {
+    stream = create_list_stream(req, j_tmp, key);
+    stream->func = func;
+    send_list_stream(stream);
+  }
+  json_decref(j_tmp);
+  http_page_clear(&page);
+
+  return;
+}
+
+static struct http_list_stream* create_list_stream(evhtp_request_t* req, json_t* j_list, const char* key)
+{
+  struct http_list_stream* stream;
+
+  stream = calloc(1, sizeof(struct http_list_stream));
+  stream->req = req;
+  stream->j_list = json_incref(j_list);
+  stream->count = json_array_size(j_list);
+  stream->key = strdup(key);
+  stream->buf = evbuffer_new();
+
+  return stream;
+}
+
+/**
+ * Start the chunked reply of the list stream.
+ * The stream is released after the reply.
+ * @param stream
+ */
+static void send_list_stream(struct http_list_stream* stream)
+{
+  evhtp_request_t* req;
+  json_t* j_res;
+  char* tmp;
+  size_t len;
+
+  req = stream->req;
+
+  // add default headers
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Headers", "x-requested-with, content-type, accept, origin, authorization", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Origin", "*", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Max-Age", "86400", 1, 1));
+
+  // create envelope. removes the closing bracket.
+  j_res = http_create_default_result(EVHTP_RES_OK);
+  tmp = json_dumps(j_res, JSON_ENCODE_ANY);
+  json_decref(j_res);
+  len = strlen(tmp);
+
+  evbuffer_add(stream->buf, tmp, len - 1);
+  evbuffer_add_printf(stream->buf, "%s\"result\": {\"list\": [", (len > 2)? ", " : "");
+  sfree(tmp);
+
+  evhtp_send_reply_chunk_start(req, EVHTP_RES_OK);
+  if(send_list_stream_chunk(stream) == true) {
+    // all sent
+    destroy_list_stream(stream);
+    return;
+  }
+
+  // rest of the chunks are sent by the connection's write hook.
+  // the request fini hook releases the stream, even if the client has gone.
+  evhtp_connection_set_hook(evhtp_request_get_connection(req), evhtp_hook_on_write, (evhtp_hook)cb_list_stream_write, stream);
+  evhtp_request_set_hook(req, evhtp_hook_on_request_fini, (evhtp_hook)cb_list_stream_fini, stream);
+
+  return;
+}
+
+/**
+ * Send the next chunk of the list stream.
+ * Sends the closing part and ends the chunked reply after the last item.
+ * @param stream
+ * @return true if the reply has been ended.
+ */
+static bool send_list_stream_chunk(struct http_list_stream* stream)
+{
+  char* tmp;
+
+  while(true) {
+    if(stream->idx >= stream->count) {
+      if(load_list_stream_batch(stream) == false) {
+        break;
+      }
+      continue;
+    }
+
+    tmp = json_dumps(json_array_get(stream->j_list, stream->idx), JSON_ENCODE_ANY);
+    evbuffer_add_printf(stream->buf, "%s%s", (stream->sent == 0)? "" : ", ", tmp);
+    sfree(tmp);
+    stream->idx++;
+    stream->sent++;
+
+    if(evbuffer_get_length(stream->buf) >= DEF_HTTP_CHUNK_SIZE) {
+      evhtp_send_reply_chunk(stream->req, stream->buf);
+      return false;
+    }
+  }
+
+  // close
+  evbuffer_add_printf(stream->buf, "]");
+  if((stream->paged == true) && (stream->cursor == NULL)) {
+    evbuffer_add_printf(stream->buf, ", \"next_cursor\": null");
+  }
+  else if(stream->paged == true) {
+    evbuffer_add_printf(stream->buf, ", \"next_cursor\": \"%s\"", stream->cursor);
+  }
+  evbuffer_add_printf(stream->buf, "}}");
+
+  evhtp_send_reply_chunk(stream->req, stream->buf);
+  evhtp_send_reply_chunk_end(stream->req);
+
+  return true;
+}
+
+/**
+ * Get the next batch of the whole list.
+ * The short batch is the last one.
+ * @param stream
+ * @return false if there is no more item.
+ */
+static bool load_list_stream_batch(struct http_list_stream* stream)
+{
+  json_t* j_tmp;
+  const char* cursor;
+
+  if((stream->func == NULL) || (json_array_size(stream->j_list) < DEF_HTTP_LIST_BATCH_SIZE)) {
+    return false;
+  }
+
+  cursor = json_string_value(json_object_get(json_array_get(stream->j_list, stream->count - 1), stream->key));
+  if(cursor == NULL) {
+    slog(LOG_WARNING, "Could not get the cursor of the batch. key[%s]", stream->key);
+    return false;
+  }
+
+  // the reply has been started already. just ends the list.
+  j_tmp = stream->func(cursor, DEF_HTTP_LIST_BATCH_SIZE);
+  if(j_tmp == NULL) {
+    slog(LOG_WARNING, "Could not get the next batch. key[%s], cursor[%s]", stream->key, cursor);
+    return false;
+  }
+
+  json_decref(stream->j_list);
+  stream->j_list = j_tmp;
+  stream->idx = 0;
+  stream->count = json_array_size(j_tmp);
+
+  return (stream->count > 0)? true : false;
+}
+
+static void destroy_list_stream(struct http_list_stream* stream)
+{
+  if(stream == NULL) {
+    return;
+  }
+
+  json_decref(stream->j_list);
+  evbuffer_free(stream->buf);
+  sfree(stream->key);
+  sfree(stream->cursor);
+  sfree(stream);
+}
+
+/**
+ * Connection's write hook of the list stream.
+ * Fired when the output buffer has been drained.
+ */
+static evhtp_res cb_list_stream_write(evhtp_connection_t* conn, void* arg)
+{
+  struct http_list_stream* stream;
+
+  stream = arg;
+  if((stream == NULL) || (stream->done == true)) {
+    return EVHTP_RES_OK;
+  }
+
+  if(send_list_stream_chunk(stream) == true) {
+    // the stream is released by the request fini hook.
+    stream->done = true;
+    evhtp_connection_unset_hook(conn, evhtp_hook_on_write);
+  }
+
+  return EVHTP_RES_OK;
+}
+
+/**
+ * Request fini hook of the list stream.
+ * Fired when the request has been freed. finished or disconnected.
+ */
+static evhtp_res cb_list_stream_fini(evhtp_request_t* req, void* arg)
+{
+  evhtp_connection_t* conn;
+
+  // the connection would be kept alive for the next request.
+  conn = evhtp_request_get_connection(req);
+  if(conn != NULL) {
+    evhtp_connection_unset_hook(conn, evhtp_hook_on_write);
+  }
+
+  destroy_list_stream(arg);
+
+  return EVHTP_RES_OK;
+}
+
+/**
+ * Send the given file as it is.
+ * The file is added to the response as a file segment,
+ * so it is sent without the copy(sendfile) if possible.
+ * Sends the 304 if the client has the same file.
+ * @param req
+ * @param filename
+ * @param content_type
+ */
+void http_simple_response_file(evhtp_request_t *req, const char* filename, const char* content_type)
+{
+  struct evbuffer_file_segment* seg;
+  struct stat sb;
+  char* etag;
+  char* last_modified;
+  char* tmp;
+  int fd;
+  int ret;
+
+  if((req == NULL) || (filename == NULL) || (content_type == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired http_simple_response_file. filename[%s]", filename);
+
+  fd = open(filename, O_RDONLY);
+  if(fd < 0) {
+    slog(LOG_NOTICE, "Could not open the file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+    http_simple_response_error(req, (errno == ENOENT)? EVHTP_RES_NOTFOUND : EVHTP_RES_SERVERR, 0, NULL);
+    return;
+  }
+
+  ret = fstat(fd, &sb);
+  if((ret < 0) || (S_ISREG(sb.st_mode) != 1)) {
+    slog(LOG_ERR, "Could not get the regular file info. filename[%s]", filename);
+    close(fd);
+    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+    return;
+  }
+
+  // add default headers
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Headers", "x-requested-with, content-type, accept, origin, authorization", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Origin", "*", 1, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Max-Age", "86400", 1, 1));
+
+  // validators
+  etag = http_range_create_etag(sb.st_size, sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+  last_modified = http_range_create_date(sb.st_mtim.tv_sec);
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("ETag", etag, 0, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Last-Modified", last_modified, 0, 1));
+  sfree(last_modified);
+
+  ret = http_is_request_not_modified(req, etag, sb.st_mtim.tv_sec);
+  sfree(etag);
+  if(ret == true) {
+    close(fd);
+    evhtp_send_reply(req, EVHTP_RES_NOTMOD);
+    return;
+  }
+
+  // add file. the fd is closed by the file segment.
+  seg = evbuffer_file_segment_new(fd, 0, sb.st_size, EVBUF_FS_CLOSE_ON_FREE);
+  if(seg == NULL) {
+    slog(LOG_ERR, "Could not create file segment.");
+    close(fd);
+    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+    return;
+  }
+  ret = evbuffer_add_file_segment(req->buffer_out, seg, 0, sb.st_size);
+  evbuffer_file_segment_free(seg);
+  if(ret != 0) {
+    slog(LOG_ERR, "Could not add the file. filename[%s]", filename);
+    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+    return;
+  }
+
+  asprintf(&tmp, "%lld", (long long)sb.st_size);
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Length", tmp, 0, 1));
+  sfree(tmp);
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Type", content_type, 0, 1));
+  evhtp_send_reply(req, EVHTP_RES_OK);
+
+  return;
+}
+
 void http_simple_response_error(evhtp_request_t *req, int status_code, int err_code, const char* err_msg)
 {
   char* res;
@@ -892,6 +1343,89 @@ char* http_get_parameter(evhtp_request_t* req, const char* key)
   return res;
 }
 
+/**
+ * Get the cursor pagination parameters of the request.
+ * The page is disabled if the request has none of limit and cursor.
+ * The page should be cleared with http_page_clear() after use.
+ * @param req
+ * @param page
+ * @return false if the given parameters are not valid.
+ */
+bool http_get_page(evhtp_request_t* req, http_page* page)
+{
+  const char* limit;
+  const char* cursor;
+
+  if((req == NULL) || (page == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  page->enable = false;
+  page->limit = DEF_HTTP_PAGE_LIMIT_DEFAULT;
+  page->cursor = NULL;
+
+  limit = evhtp_kv_find(req->uri->query, "limit");
+  cursor = evhtp_kv_find(req->uri->query, "cursor");
+  if((limit == NULL) && (cursor == NULL)) {
+    return true;
+  }
+  page->enable = true;
+
+  if(limit != NULL) {
+    page->limit = http_page_parse_limit(limit);
+    if(page->limit < 0) {
+      slog(LOG_NOTICE, "Wrong limit parameter. limit[%s]", limit);
+      return false;
+    }
+  }
+
+  // the cursor is hex string. no need to decode uri.
+  if(cursor != NULL) {
+    page->cursor = http_page_parse_cursor(cursor);
+    if(page->cursor == NULL) {
+      slog(LOG_NOTICE, "Wrong cursor parameter. cursor[%s]", cursor);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Returns true if the client has the same resource already.
+ * The If-None-Match precedes the If-Modified-Since.
+ * @param req
+ * @param etag
+ * @param mtime
+ * @return
+ */
+bool http_is_request_not_modified(evhtp_request_t* req, const char* etag, time_t mtime)
+{
+  const char* tmp_const;
+  time_t since;
+
+  if((req == NULL) || (etag == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  tmp_const = evhtp_header_find(req->headers_in, "If-None-Match");
+  if(tmp_const != NULL) {
+    return http_range_is_etag_match(tmp_const, etag, true);
+  }
+
+  tmp_const = evhtp_header_find(req->headers_in, "If-Modified-Since");
+  if(tmp_const != NULL) {
+    since = http_range_parse_date(tmp_const);
+    if((since != -1) && (mtime <= since)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * Check the request has given permission.
  * @param req
@@ -1904,6 +2438,43 @@ static void cb_htp_me_chats_detail_messages(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * http request handler
+ * ^/me/chats/<detail>/read
+ * @param req
+ * @param data
+ */
+static void cb_htp_me_chats_detail_read(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_me_chats_detail_read.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_USER);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if(method != htp_method_POST) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  me_htp_post_me_chats_detail_read(req, data);
+
+  return;
+}
+
 /**
  * http request handler.
  * ^/me/login
@@ -2718,21 +3289,235 @@ static void cb_htp_admin_login(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_login.");
+  slog(LOG_INFO, "Fired cb_htp_admin_login.");
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if((method != htp_method_POST) && (method != htp_method_DELETE)) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  if(method == htp_method_POST) {
+    admin_htp_post_admin_login(req, data);
+    return;
+  }
+  else if(method == htp_method_DELETE) {
+    admin_htp_delete_admin_login(req, data);
+    return;
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+
+  return;
+}
+
+/**
+ * http request handler
+ * ^/admin/user/users$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_user_users(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_users.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if((method != htp_method_GET) && (method != htp_method_POST)) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_user_users(req, data);
+    return;
+  }
+  else if(method == htp_method_POST) {
+    admin_htp_post_admin_user_users(req, data);
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
+/**
+ * http request handler
+ * ^/admin/user/users/<detail>$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_user_users_detail.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if((method != htp_method_GET) && (method != htp_method_PUT) && (method != htp_method_DELETE)) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_user_users_detail(req, data);
+    return;
+  }
+  else if(method == htp_method_PUT) {
+    admin_htp_put_admin_user_users_detail(req, data);
+    return;
+  }
+  else if(method == htp_method_DELETE) {
+    admin_htp_delete_admin_user_users_detail(req, data);
+    return;
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
+/**
+ * http request handler
+ * ^/admin/user/contacts$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_user_contacts(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_user_contacts.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if((method != htp_method_GET) && (method != htp_method_POST)) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_user_contacts(req, data);
+    return;
+  }
+  else if(method == htp_method_POST) {
+    admin_htp_post_admin_user_users(req, data);
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
+/**
+ * http request handler
+ * ^/admin/user/contacts/<detail>$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_user_contacts_detail(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_user_contacts_detail.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_POST) && (method != htp_method_DELETE)) {
+  if((method != htp_method_GET) && (method != htp_method_PUT) && (method != htp_method_DELETE)) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
-  if(method == htp_method_POST) {
-    admin_htp_post_admin_login(req, data);
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_user_contacts_detail(req, data);
+    return;
+  }
+  else if(method == htp_method_PUT) {
+    admin_htp_put_admin_user_contacts_detail(req, data);
     return;
   }
   else if(method == htp_method_DELETE) {
-    admin_htp_delete_admin_login(req, data);
+    admin_htp_delete_admin_user_contacts_detail(req, data);
     return;
   }
   else {
@@ -2742,18 +3527,18 @@ static void cb_htp_admin_login(evhtp_request_t *req, void *data)
   }
 
   // should not reach to here.
-  http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
 
   return;
 }
 
 /**
  * http request handler
- * ^/admin/user/users$
+ * ^/admin/user/permissions$
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_users(evhtp_request_t *req, void *data)
+static void cb_htp_admin_user_permissions(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -2762,7 +3547,7 @@ static void cb_htp_admin_user_users(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_users.");
+  slog(LOG_INFO, "Fired cb_htp_admin_user_permissions.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -2780,7 +3565,7 @@ static void cb_htp_admin_user_users(evhtp_request_t *req, void *data)
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_users(req, data);
+    admin_htp_get_admin_user_contacts(req, data);
     return;
   }
   else if(method == htp_method_POST) {
@@ -2800,11 +3585,11 @@ static void cb_htp_admin_user_users(evhtp_request_t *req, void *data)
 
 /**
  * http request handler
- * ^/admin/user/users/<detail>$
+ * ^/admin/user/permissions/<detail>$
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data)
+static void cb_htp_admin_user_permissions_detail(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -2813,7 +3598,7 @@ static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_user_users_detail.");
+  slog(LOG_INFO, "Fired cb_htp_admin_user_permissions_detail.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -2824,22 +3609,18 @@ static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data)
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_GET) && (method != htp_method_PUT) && (method != htp_method_DELETE)) {
+  if((method != htp_method_GET) && (method != htp_method_DELETE)) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_users_detail(req, data);
-    return;
-  }
-  else if(method == htp_method_PUT) {
-    admin_htp_put_admin_user_users_detail(req, data);
+    admin_htp_get_admin_user_permissions_detail(req, data);
     return;
   }
   else if(method == htp_method_DELETE) {
-    admin_htp_delete_admin_user_users_detail(req, data);
+    admin_htp_delete_admin_user_permissions_detail(req, data);
     return;
   }
   else {
@@ -2854,13 +3635,14 @@ static void cb_htp_admin_user_users_detail(evhtp_request_t *req, void *data)
   return;
 }
 
+
 /**
  * http request handler
- * ^/admin/user/contacts$
+ * ^/admin/queue/queues$
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_contacts(evhtp_request_t *req, void *data)
+static void cb_htp_admin_queue_queues(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -2869,7 +3651,7 @@ static void cb_htp_admin_user_contacts(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_user_contacts.");
+  slog(LOG_INFO, "Fired cb_htp_admin_queue_queues.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -2880,19 +3662,16 @@ static void cb_htp_admin_user_contacts(evhtp_request_t *req, void *data)
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_GET) && (method != htp_method_POST)) {
+  if(method != htp_method_GET) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_contacts(req, data);
+    admin_htp_get_admin_queue_queues(req, data);
     return;
   }
-  else if(method == htp_method_POST) {
-    admin_htp_post_admin_user_users(req, data);
-  }
   else {
     // should not reach to here.
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
@@ -2907,11 +3686,11 @@ static void cb_htp_admin_user_contacts(evhtp_request_t *req, void *data)
 
 /**
  * http request handler
- * ^/admin/user/contacts/<detail>$
+ * ^/admin/queue/queues/<detail>
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_contacts_detail(evhtp_request_t *req, void *data)
+static void cb_htp_admin_queue_queues_detail(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -2920,7 +3699,7 @@ static void cb_htp_admin_user_contacts_detail(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_user_contacts_detail.");
+  slog(LOG_INFO, "Fired cb_htp_admin_queue_queues_detail.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -2931,22 +3710,14 @@ static void cb_htp_admin_user_contacts_detail(evhtp_request_t *req, void *data)
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_GET) && (method != htp_method_PUT) && (method != htp_method_DELETE)) {
+  if(method != htp_method_GET) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_contacts_detail(req, data);
-    return;
-  }
-  else if(method == htp_method_PUT) {
-    admin_htp_put_admin_user_contacts_detail(req, data);
-    return;
-  }
-  else if(method == htp_method_DELETE) {
-    admin_htp_delete_admin_user_contacts_detail(req, data);
+    admin_htp_get_admin_queue_queues_detail(req, data);
     return;
   }
   else {
@@ -2963,11 +3734,11 @@ static void cb_htp_admin_user_contacts_detail(evhtp_request_t *req, void *data)
 
 /**
  * http request handler
- * ^/admin/user/permissions$
+ * ^/admin/queue/stats$
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_permissions(evhtp_request_t *req, void *data)
+static void cb_htp_admin_queue_stats(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -2976,7 +3747,7 @@ static void cb_htp_admin_user_permissions(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_user_permissions.");
+  slog(LOG_INFO, "Fired cb_htp_admin_queue_stats.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -2987,19 +3758,16 @@ static void cb_htp_admin_user_permissions(evhtp_request_t *req, void *data)
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_GET) && (method != htp_method_POST)) {
+  if(method != htp_method_GET) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_contacts(req, data);
+    admin_htp_get_admin_queue_stats(req, data);
     return;
   }
-  else if(method == htp_method_POST) {
-    admin_htp_post_admin_user_users(req, data);
-  }
   else {
     // should not reach to here.
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
@@ -3014,11 +3782,11 @@ static void cb_htp_admin_user_permissions(evhtp_request_t *req, void *data)
 
 /**
  * http request handler
- * ^/admin/user/permissions/<detail>$
+ * ^/admin/queue/stats/<detail>
  * @param req
  * @param data
  */
-static void cb_htp_admin_user_permissions_detail(evhtp_request_t *req, void *data)
+static void cb_htp_admin_queue_stats_detail(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -3027,7 +3795,7 @@ static void cb_htp_admin_user_permissions_detail(evhtp_request_t *req, void *dat
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_user_permissions_detail.");
+  slog(LOG_INFO, "Fired cb_htp_admin_queue_stats_detail.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -3038,18 +3806,14 @@ static void cb_htp_admin_user_permissions_detail(evhtp_request_t *req, void *dat
 
   // method check
   method = evhtp_request_get_method(req);
-  if((method != htp_method_GET) && (method != htp_method_DELETE)) {
+  if(method != htp_method_GET) {
     http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
     return;
   }
 
   // fire handlers
   if(method == htp_method_GET) {
-    admin_htp_get_admin_user_permissions_detail(req, data);
-    return;
-  }
-  else if(method == htp_method_DELETE) {
-    admin_htp_delete_admin_user_permissions_detail(req, data);
+    admin_htp_get_admin_queue_stats_detail(req, data);
     return;
   }
   else {
@@ -3064,14 +3828,13 @@ static void cb_htp_admin_user_permissions_detail(evhtp_request_t *req, void *dat
   return;
 }
 
-
 /**
  * http request handler
- * ^/admin/queue/queues$
+ * ^/admin/resource/stats
  * @param req
  * @param data
  */
-static void cb_htp_admin_queue_queues(evhtp_request_t *req, void *data)
+static void cb_htp_admin_resource_stats(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -3080,7 +3843,7 @@ static void cb_htp_admin_queue_queues(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_queue_queues.");
+  slog(LOG_INFO, "Fired cb_htp_admin_resource_stats.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -3097,29 +3860,18 @@ static void cb_htp_admin_queue_queues(evhtp_request_t *req, void *data)
   }
 
   // fire handlers
-  if(method == htp_method_GET) {
-    admin_htp_get_admin_queue_queues(req, data);
-    return;
-  }
-  else {
-    // should not reach to here.
-    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
-    return;
-  }
-
-  // should not reach to here.
-  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+  admin_htp_get_admin_resource_stats(req, data);
 
   return;
 }
 
 /**
  * http request handler
- * ^/admin/queue/queues/<detail>
+ * ^/admin/chat/retention$
  * @param req
  * @param data
  */
-static void cb_htp_admin_queue_queues_detail(evhtp_request_t *req, void *data)
+static void cb_htp_admin_chat_retention(evhtp_request_t *req, void *data)
 {
   int method;
   int ret;
@@ -3128,7 +3880,7 @@ static void cb_htp_admin_queue_queues_detail(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_INFO, "Fired cb_htp_admin_queue_queues_detail.");
+  slog(LOG_INFO, "Fired cb_htp_admin_chat_retention.");
 
   // check authorization
   ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
@@ -3145,18 +3897,7 @@ static void cb_htp_admin_queue_queues_detail(evhtp_request_t *req, void *data)
   }
 
   // fire handlers
-  if(method == htp_method_GET) {
-    admin_htp_get_admin_queue_queues_detail(req, data);
-    return;
-  }
-  else {
-    // should not reach to here.
-    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
-    return;
-  }
-
-  // should not reach to here.
-  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+  admin_htp_get_admin_chat_retention(req, data);
 
   return;
 }
@@ -4571,6 +5312,102 @@ static void cb_htp_admin_pjsip_registration_outbounds_detail(evhtp_request_t *re
   return;
 }
 
+/**
+ * http request handler
+ * ^/admin/pjsip/sync$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_pjsip_sync(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_pjsip_sync.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if(method != htp_method_GET) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_pjsip_sync(req, data);
+    return;
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
+/**
+ * http request handler
+ * ^/admin/pjsip/batch$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_pjsip_batch(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_pjsip_batch.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if(method != htp_method_POST) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_POST) {
+    admin_htp_post_admin_pjsip_batch(req, data);
+    return;
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
 /**
  * http request handler
  * ^/admin/core/channels$
@@ -4779,6 +5616,54 @@ static void cb_htp_admin_core_modules_detail(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * http request handler
+ * ^/admin/core/reloads$
+ * @param req
+ * @param data
+ */
+static void cb_htp_admin_core_reloads(evhtp_request_t *req, void *data)
+{
+  int method;
+  int ret;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_INFO, "Fired cb_htp_admin_core_reloads.");
+
+  // check authorization
+  ret = http_is_request_has_permission(req, EN_HTTP_PERM_ADMIN);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // method check
+  method = evhtp_request_get_method(req);
+  if(method != htp_method_GET) {
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // fire handlers
+  if(method == htp_method_GET) {
+    admin_htp_get_admin_core_reloads(req, data);
+    return;
+  }
+  else {
+    // should not reach to here.
+    http_simple_response_error(req, EVHTP_RES_METHNALLOWED, 0, NULL);
+    return;
+  }
+
+  // should not reach to here.
+  http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+
+  return;
+}
+
 /**
  * http request handler
  * ^/admin/core/systems$
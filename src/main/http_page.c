@@ -0,0 +1,138 @@
+/*
+ * http_page.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Cursor pagination helpers for the list requests.
+ *  The cursor is the hex encoded key of the last item of the page,
+ *  so the clients should treat it as an opaque string.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "http_page.h"
+
+static int hex_value(char c);
+
+
+/**
+ * Parse the limit parameter.
+ * The bigger value than DEF_HTTP_PAGE_LIMIT_MAX is clamped.
+ * @param str
+ * @return limit. -1 if the value is not valid.
+ */
+int http_page_parse_limit(const char* str)
+{
+  long val;
+  char* end;
+
+  if((str == NULL) || (isdigit((unsigned char)*str) == 0)) {
+    return -1;
+  }
+
+  val = strtol(str, &end, 10);
+  if((*end != '\0') || (val <= 0)) {
+    return -1;
+  }
+
+  if(val > DEF_HTTP_PAGE_LIMIT_MAX) {
+    val = DEF_HTTP_PAGE_LIMIT_MAX;
+  }
+
+  return (int)val;
+}
+
+/**
+ * Create the cursor string of the given key.
+ * The return value should be freed after use.
+ * @param key
+ * @return
+ */
+char* http_page_create_cursor(const char* key)
+{
+  static const char* hex = "0123456789abcdef";
+  char* res;
+  size_t len;
+  size_t i;
+
+  if(key == NULL) {
+    return NULL;
+  }
+
+  len = strlen(key);
+  res = calloc(len * 2 + 1, sizeof(char));
+  for(i = 0; i < len; i++) {
+    res[i * 2] = hex[((unsigned char)key[i]) >> 4];
+    res[i * 2 + 1] = hex[((unsigned char)key[i]) & 0x0f];
+  }
+
+  return res;
+}
+
+/**
+ * Parse the cursor string.
+ * The return value should be freed after use.
+ * @param str
+ * @return key of the cursor. NULL if the cursor is not valid.
+ */
+char* http_page_parse_cursor(const char* str)
+{
+  char* res;
+  size_t len;
+  size_t i;
+  int high;
+  int low;
+
+  if(str == NULL) {
+    return NULL;
+  }
+
+  len = strlen(str);
+  if((len == 0) || (len > DEF_HTTP_PAGE_CURSOR_MAX) || ((len % 2) != 0)) {
+    return NULL;
+  }
+
+  res = calloc(len / 2 + 1, sizeof(char));
+  for(i = 0; i < len / 2; i++) {
+    high = hex_value(str[i * 2]);
+    low = hex_value(str[i * 2 + 1]);
+
+    // the key could not have null character
+    if((high < 0) || (low < 0) || ((high == 0) && (low == 0))) {
+      free(res);
+      return NULL;
+    }
+    res[i] = (char)((high << 4) | low);
+  }
+
+  return res;
+}
+
+/**
+ * Release the allocated members of the page.
+ * @param page
+ */
+void http_page_clear(http_page* page)
+{
+  if(page == NULL) {
+    return;
+  }
+
+  free(page->cursor);
+  page->cursor = NULL;
+}
+
+static int hex_value(char c)
+{
+  if((c >= '0') && (c <= '9')) {
+    return c - '0';
+  }
+  if((c >= 'a') && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
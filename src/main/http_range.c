@@ -0,0 +1,380 @@
+/*
+ * http_range.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Range request(RFC7233) and the validators(RFC7232) helpers.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "http_range.h"
+
+#define DEF_HTTP_DATE_FORMAT  "%a, %d %b %Y %H:%M:%S GMT"   // IMF-fixdate
+#define DEF_HTTP_OFF_MAX      ((off_t)(((unsigned long long)1 << (sizeof(off_t) * 8 - 1)) - 1))
+
+static const char* skip_space(const char* str);
+static const char* parse_number(const char* str, off_t* res);
+static int compare_range(const void* a, const void* b);
+static int merge_ranges(http_range* ranges, int count);
+static bool is_etag_equal(const char* str, int len, const char* etag, bool weak);
+
+
+/**
+ * Parse the Range header value.
+ * The overlapped or adjacent ranges are merged in the order of the position.
+ * @param str: Range header value. ex) "bytes=0-99, -100"
+ * @param size: size of the representation.
+ * @param ranges: parsed ranges.
+ * @param max: max count of ranges.
+ * @return
+ *  count of the satisfiable ranges.
+ *  0 if the header should be ignored. Wrong syntax, unsupported unit or too many ranges.
+ *  -1 if there's no satisfiable range.
+ */
+int http_range_parse(const char* str, off_t size, http_range* ranges, int max)
+{
+  const char* ptr;
+  off_t start;
+  off_t end;
+  bool has_start;
+  bool has_end;
+  bool has_spec;
+  int cnt;
+
+  if((str == NULL) || (ranges == NULL) || (max <= 0) || (size < 0)) {
+    return 0;
+  }
+
+  ptr = skip_space(str);
+  if(strncasecmp(ptr, "bytes", 5) != 0) {
+    return 0;
+  }
+  ptr = skip_space(ptr + 5);
+  if(*ptr != '=') {
+    return 0;
+  }
+  ptr++;
+
+  cnt = 0;
+  has_spec = false;
+  while(1) {
+    ptr = skip_space(ptr);
+
+    // empty list element
+    if(*ptr == ',') {
+      ptr++;
+      continue;
+    }
+    if(*ptr == '\0') {
+      break;
+    }
+
+    // first-byte-pos
+    has_start = isdigit((unsigned char)*ptr)? true : false;
+    if(has_start == true) {
+      ptr = parse_number(ptr, &start);
+      if(ptr == NULL) {
+        return 0;
+      }
+    }
+
+    if(*ptr != '-') {
+      return 0;
+    }
+    ptr++;
+
+    // last-byte-pos or suffix-length
+    has_end = isdigit((unsigned char)*ptr)? true : false;
+    if(has_end == true) {
+      ptr = parse_number(ptr, &end);
+      if(ptr == NULL) {
+        return 0;
+      }
+    }
+
+    ptr = skip_space(ptr);
+    if((*ptr != ',') && (*ptr != '\0')) {
+      return 0;
+    }
+
+    if((has_start == false) && (has_end == false)) {
+      return 0;
+    }
+    if((has_start == true) && (has_end == true) && (end < start)) {
+      return 0;
+    }
+    has_spec = true;
+
+    if(has_start == false) {
+      // suffix-byte-range-spec
+      if((end == 0) || (size == 0)) {
+        continue;
+      }
+      start = (end > size)? 0 : size - end;
+      end = size - 1;
+    }
+    else {
+      if(start >= size) {
+        continue;
+      }
+      if((has_end == false) || (end >= size)) {
+        end = size - 1;
+      }
+    }
+
+    if(cnt >= max) {
+      return 0;
+    }
+    ranges[cnt].start = start;
+    ranges[cnt].end = end;
+    cnt++;
+  }
+
+  if(has_spec == false) {
+    return 0;
+  }
+  if(cnt == 0) {
+    return -1;
+  }
+
+  return merge_ranges(ranges, cnt);
+}
+
+/**
+ * Create the strong entity tag of the file.
+ * The return value should be freed after use.
+ * @param size
+ * @param mtime_sec
+ * @param mtime_nsec
+ * @return ex) "\"1326c-5f1a2b3c.1dcd6500\""
+ */
+char* http_range_create_etag(off_t size, time_t mtime_sec, long mtime_nsec)
+{
+  char* res;
+
+  asprintf(&res, "\"%llx-%llx.%lx\"", (unsigned long long)size, (unsigned long long)mtime_sec, mtime_nsec);
+
+  return res;
+}
+
+/**
+ * Returns true if the given entity tag list has the etag.
+ * @param str: If-None-Match or If-Range header value.
+ * @param etag
+ * @param weak: weak comparison if it's true.
+ * @return
+ */
+bool http_range_is_etag_match(const char* str, const char* etag, bool weak)
+{
+  const char* ptr;
+  const char* start;
+
+  if((str == NULL) || (etag == NULL)) {
+    return false;
+  }
+
+  ptr = skip_space(str);
+  if((*ptr == '*') && (*skip_space(ptr + 1) == '\0')) {
+    return true;
+  }
+
+  while(*ptr != '\0') {
+    ptr = skip_space(ptr);
+    if(*ptr == ',') {
+      ptr++;
+      continue;
+    }
+
+    start = ptr;
+    if(strncmp(ptr, "W/", 2) == 0) {
+      ptr += 2;
+    }
+    if(*ptr != '"') {
+      return false;
+    }
+
+    ptr = strchr(ptr + 1, '"');
+    if(ptr == NULL) {
+      return false;
+    }
+    ptr++;
+
+    if(is_etag_equal(start, ptr - start, etag, weak) == true) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Create the http date string. IMF-fixdate.
+ * The return value should be freed after use.
+ * @param t
+ * @return ex) "Sun, 06 Nov 1994 08:49:37 GMT"
+ */
+char* http_range_create_date(time_t t)
+{
+  static const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  static const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  struct tm tm;
+  char* res;
+
+  // locale independent
+  gmtime_r(&t, &tm);
+  asprintf(&res, "%s, %02d %s %04d %02d:%02d:%02d GMT",
+      days[tm.tm_wday],
+      tm.tm_mday,
+      months[tm.tm_mon],
+      tm.tm_year + 1900,
+      tm.tm_hour,
+      tm.tm_min,
+      tm.tm_sec
+      );
+
+  return res;
+}
+
+/**
+ * Parse the http date string. IMF-fixdate.
+ * @param str
+ * @return -1 if the string is not valid.
+ */
+time_t http_range_parse_date(const char* str)
+{
+  struct tm tm;
+  const char* ptr;
+
+  if(str == NULL) {
+    return -1;
+  }
+
+  memset(&tm, 0x00, sizeof(tm));
+  ptr = strptime(skip_space(str), DEF_HTTP_DATE_FORMAT, &tm);
+  if((ptr == NULL) || (*skip_space(ptr) != '\0')) {
+    return -1;
+  }
+
+  return timegm(&tm);
+}
+
+static const char* skip_space(const char* str)
+{
+  while((*str == ' ') || (*str == '\t')) {
+    str++;
+  }
+
+  return str;
+}
+
+/**
+ * Parse the decimal number.
+ * @return the next position. NULL if overflowed.
+ */
+static const char* parse_number(const char* str, off_t* res)
+{
+  off_t val;
+  int digit;
+
+  val = 0;
+  for(; isdigit((unsigned char)*str); str++) {
+    digit = *str - '0';
+
+    if(val > (DEF_HTTP_OFF_MAX - digit) / 10) {
+      return NULL;
+    }
+    val = (val * 10) + digit;
+  }
+  *res = val;
+
+  return str;
+}
+
+static int compare_range(const void* a, const void* b)
+{
+  const http_range* r1;
+  const http_range* r2;
+
+  r1 = a;
+  r2 = b;
+
+  if(r1->start < r2->start) {
+    return -1;
+  }
+  if(r1->start > r2->start) {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Merge the overlapped or adjacent ranges.
+ * @return count of merged ranges.
+ */
+static int merge_ranges(http_range* ranges, int count)
+{
+  int cnt;
+  int i;
+
+  if(count <= 1) {
+    return count;
+  }
+
+  qsort(ranges, count, sizeof(http_range), compare_range);
+
+  cnt = 0;
+  for(i = 1; i < count; i++) {
+    if(ranges[i].start <= ranges[cnt].end + 1) {
+      if(ranges[i].end > ranges[cnt].end) {
+        ranges[cnt].end = ranges[i].end;
+      }
+      continue;
+    }
+
+    cnt++;
+    ranges[cnt] = ranges[i];
+  }
+
+  return cnt + 1;
+}
+
+/**
+ * Compare the entity tags.
+ * The strong comparison fails if any of them is a weak tag.
+ */
+static bool is_etag_equal(const char* str, int len, const char* etag, bool weak)
+{
+  bool str_weak;
+  bool etag_weak;
+
+  str_weak = (strncmp(str, "W/", 2) == 0)? true : false;
+  etag_weak = (strncmp(etag, "W/", 2) == 0)? true : false;
+
+  if((weak == false) && ((str_weak == true) || (etag_weak == true))) {
+    return false;
+  }
+
+  if(str_weak == true) {
+    str += 2;
+    len -= 2;
+  }
+  if(etag_weak == true) {
+    etag += 2;
+  }
+
+  if((strlen(etag) != (size_t)len) || (strncmp(str, etag, len) != 0)) {
+    return false;
+  }
+
+  return true;
+}
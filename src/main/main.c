@@ -30,6 +30,7 @@
 #include "queue_handler.h"
 #include "pjsip_handler.h"
 #include "sip_handler.h"
+#include "voicemail_handler.h"
 
 #include "me_handler.h"
 #include "admin_handler.h"
@@ -177,6 +178,12 @@ bool init(void)
     return false;
   }
 
+  ret = voicemail_init_handler();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate voicemail_handler.");
+    return false;
+  }
+
   ret = me_init_handler();
   if(ret == false) {
     slog(LOG_ERR, "Could not initiate me_handler.");
@@ -217,7 +224,10 @@ bool terminate(void)
 
   resource_term_handler();
 
+  conf_term_handler();
+
   // terminate modules
+  voicemail_term_handler();
   me_term_handler();
   admin_term_handler();
   manager_term_handler();
@@ -506,6 +506,20 @@ json_t* park_get_parkedcalls_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of parkedcalls ordered by parkee_unique_id.
+ * @param cursor: parkee_unique_id of the last parkedcall of the previous page.
+ * @param count
+ * @return
+ */
+json_t* park_get_parkedcalls_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PARK_PARKEDCALL, "parkee_unique_id", cursor, count);
+  return j_res;
+}
+
 /**
  * Get corresponding parked call detail info.
  * @return
@@ -664,6 +678,20 @@ json_t* park_get_parkinglots_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of parkinglots ordered by name.
+ * @param cursor: name of the last parkinglot of the previous page.
+ * @param count
+ * @return
+ */
+json_t* park_get_parkinglots_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PARK_PARKINGLOT, "name", cursor, count);
+  return j_res;
+}
+
 /**
  * Get corresponding parking_lot detail info.
  * @return
@@ -999,6 +1027,21 @@ json_t* park_get_configuration_info(const char* name)
   return j_res;
 }
 
+/**
+ * Returns the config filename of the given name for the raw text.
+ * @param name current or backup config name
+ * @return
+ */
+char* park_get_configuration_filename(const char* name)
+{
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  return conf_get_ast_config_filename(name, DEF_PARK_CONFNAME);
+}
+
 bool park_update_configuration_info(const json_t* j_data)
 {
   int ret;
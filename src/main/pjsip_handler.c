@@ -8,18 +8,25 @@
 #define _GNU_SOURCE
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <jansson.h>
 #include <string.h>
+#include <time.h>
+#include <event2/event.h>
 
 #include "common.h"
 #include "slog.h"
 #include "utils.h"
+#include "bsd_queue.h"
+#include "event_handler.h"
 #include "resource_handler.h"
 #include "http_handler.h"
 #include "ami_handler.h"
 #include "ami_action_handler.h"
+#include "core_handler.h"
 #include "conf_handler.h"
 #include "publication_handler.h"
+#include "config.h"
 
 #include "pjsip_handler.h"
 
@@ -47,6 +54,8 @@
 #define DEF_TRANSPORT_NAME_TCP   "jade-transport-tcp"
 #define DEF_TRANSPORT_NAME_WSS   "jade-transport-wss"
 
+#define DEF_PJSIP_DETAIL_CHECK_INTERVAL   1       // sec
+
 
 enum EN_OBJ_TYPES {
   EN_TYPE_AOR            = 1,
@@ -65,6 +74,120 @@ static struct st_callback* g_callback_module;
 static struct st_callback* g_callback_db_registration_outbound;
 static struct st_callback* g_callback_cfg_endpoint;
 
+enum EN_PJSIP_SYNC_TYPES {
+  EN_PJSIP_SYNC_ENDPOINT = 0,
+  EN_PJSIP_SYNC_AOR,
+  EN_PJSIP_SYNC_AUTH,
+  EN_PJSIP_SYNC_CONTACT,
+  EN_PJSIP_SYNC_REGISTRATION_INBOUND,
+  EN_PJSIP_SYNC_REGISTRATION_OUTBOUND,
+
+  EN_PJSIP_SYNC_COUNT,
+};
+
+struct pjsip_sync_info {
+  const char* table;
+  const char* key;    ///< key column
+
+  bool (*func_create)(const json_t* j_data);
+  bool (*func_update)(const json_t* j_data);
+  bool (*func_delete)(const char* key);
+};
+
+static const struct pjsip_sync_info g_sync_infos[EN_PJSIP_SYNC_COUNT] = {
+  [EN_PJSIP_SYNC_ENDPOINT]              = {DEF_DB_TABLE_PJSIP_ENDPOINT, "object_name", pjsip_create_endpoint_info, pjsip_update_endpoint_info, pjsip_delete_endpoint_info},
+  [EN_PJSIP_SYNC_AOR]                   = {DEF_DB_TABLE_PJSIP_AOR, "object_name", pjsip_create_aor_info, pjsip_update_aor_info, pjsip_delete_aor_info},
+  [EN_PJSIP_SYNC_AUTH]                  = {DEF_DB_TABLE_PJSIP_AUTH, "object_name", pjsip_create_auth_info, pjsip_update_auth_info, pjsip_delete_auth_info},
+  [EN_PJSIP_SYNC_CONTACT]               = {DEF_DB_TABLE_PJSIP_CONTACT, "uri", pjsip_create_contact_info, pjsip_update_contact_info, pjsip_delete_contact_info},
+  [EN_PJSIP_SYNC_REGISTRATION_INBOUND]  = {DEF_DB_TABLE_PJSIP_REGISTRATION_INBOUND, "object_name", pjsip_create_registration_inbound_info, pjsip_update_registration_inbound_info, pjsip_delete_registration_inbound_info},
+  [EN_PJSIP_SYNC_REGISTRATION_OUTBOUND] = {DEF_DB_TABLE_PJSIP_REGISTRATION_OUTBOUND, "object_name", pjsip_create_registration_outbound_info, pjsip_update_registration_outbound_info, pjsip_delete_registration_outbound_info},
+};
+
+/**
+ * Reload snapshot.
+ * The reload keeps the current data, and deletes the objects
+ * which are not received until the list is complete.
+ */
+struct pjsip_reload {
+  json_t* j_seens[EN_PJSIP_SYNC_COUNT];   ///< received keys. {"<key>": true}. NULL if not in the reload.
+
+  bool endpoint_pending;    ///< waiting the endpoint list and details to sweep.
+  bool endpoint_listed;     ///< EndpointListComplete is received.
+
+  bool registration_inbound_pending;
+  bool registration_outbound_pending;
+};
+
+static struct pjsip_reload g_reload = {{0}};
+
+struct pjsip_detail_entry {
+  char* name;
+
+  TAILQ_ENTRY(pjsip_detail_entry) entries;
+};
+
+/**
+ * Endpoint detail sync.
+ * Sends the PJSIPShowEndpoint at most concurrency at once.
+ * The rest of the requests are waiting in the queue.
+ * The counters are for the current sync round.
+ */
+struct pjsip_detail_sync {
+  TAILQ_HEAD(, pjsip_detail_entry) queue;
+  json_t* j_queued;         ///< queued endpoint names. {"<name>": true}
+  int queued;
+  json_t* j_in_flight;      ///< sent endpoint names. {"<name>": <count of requests>}
+  json_t* j_details;        ///< endpoint names of the received EndpointDetail. waiting the complete in order.
+  int in_flight;
+
+  int concurrency;
+  int timeout;
+  bool skip_unchanged;
+
+  bool running;
+  bool listed;              ///< EndpointListComplete is received in the round.
+  time_t tm_progress;       ///< last send or complete. monotonic.
+  struct timespec tm_start;
+  struct timespec tm_end;
+
+  unsigned long long rounds;      ///< completed sync rounds since the start
+  unsigned long long endpoints;   ///< received endpoint list items
+  unsigned long long skipped;
+  unsigned long long sent;
+  unsigned long long completed;
+  unsigned long long timeouts;    ///< released in flight requests without complete
+  unsigned long long failed;
+};
+
+static struct pjsip_detail_sync g_detail;
+
+enum EN_PJSIP_BATCH_TYPES {
+  EN_PJSIP_BATCH_AOR = 0,
+  EN_PJSIP_BATCH_AUTH,
+  EN_PJSIP_BATCH_ENDPOINT,
+  EN_PJSIP_BATCH_IDENTIFY,
+
+  EN_PJSIP_BATCH_COUNT,
+};
+
+/**
+ * Batch create info.
+ * Listed in the dependency order. The latter one refers to the former ones.
+ */
+struct pjsip_batch_info {
+  const char* key;        ///< request key
+  const char* filename;
+  const char* type;       ///< type option of the section
+  const char* table;      ///< memory table of the asterisk objects. NULL if not referred.
+};
+
+static const struct pjsip_batch_info g_batch_infos[EN_PJSIP_BATCH_COUNT] = {
+  [EN_PJSIP_BATCH_AOR]      = {"aors",        DEF_PJSIP_CONFNAME_AOR,       "aor",      DEF_DB_TABLE_PJSIP_AOR},
+  [EN_PJSIP_BATCH_AUTH]     = {"auths",       DEF_PJSIP_CONFNAME_AUTH,      "auth",     DEF_DB_TABLE_PJSIP_AUTH},
+  [EN_PJSIP_BATCH_ENDPOINT] = {"endpoints",   DEF_PJSIP_CONFNAME_ENDPOINT,  "endpoint", DEF_DB_TABLE_PJSIP_ENDPOINT},
+  [EN_PJSIP_BATCH_IDENTIFY] = {"identifies",  DEF_PJSIP_CONFNAME_IDENTIFY,  "identify", NULL},
+};
+
 static bool init_callbacks(void);
 static bool term_callbacks(void);
 
@@ -145,6 +268,31 @@ static void execute_callbacks_module(enum EN_RESOURCE_UPDATE_TYPES type, const j
 static void execute_callbacks_db_registration_outbound(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static void execute_callbacks_cfg_endpoint(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 
+static bool sync_item(enum EN_PJSIP_SYNC_TYPES type, const json_t* j_data);
+static void begin_reload(void);
+static void clear_reload(void);
+static void sweep_items(enum EN_PJSIP_SYNC_TYPES type);
+static void sweep_endpoints(void);
+
+static bool init_detail_sync(void);
+static void term_detail_sync(void);
+static void load_detail_sync_config(void);
+static void cb_pjsip_detail_sync(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static void start_detail_sync(void);
+static void check_detail_sync(void);
+static void release_detail_in_flights(void);
+static bool enqueue_endpoint_detail(const char* name);
+static void dispatch_endpoint_details(void);
+static bool send_endpoint_detail(const char* name);
+static void mark_endpoint_related_seen(const json_t* j_endpoint);
+static void mark_seen_names(enum EN_PJSIP_SYNC_TYPES type, const char* names);
+static void expire_endpoint_detail(const char* name);
+static time_t get_monotonic_sec(void);
+
+static const char* validate_batch_item(enum EN_PJSIP_BATCH_TYPES type, const json_t* j_item, conf_doc** docs);
+static bool is_batch_string_valid(const char* str);
+static bool is_batch_refers_exist(enum EN_PJSIP_BATCH_TYPES type, const char* names, conf_doc** docs);
+
 
 bool pjsip_init_handler(void)
 {
@@ -172,6 +320,13 @@ bool pjsip_init_handler(void)
     return false;
   }
 
+  // init endpoint detail sync
+  ret = init_detail_sync();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate endpoint detail sync.");
+    return false;
+  }
+
   // init resources
   ret = init_resources();
   if(ret == false) {
@@ -196,6 +351,9 @@ bool pjsip_term_handler(void)
   execute_callbacks_module(EN_RESOURCE_UNLOAD, j_tmp);
   json_decref(j_tmp);
 
+  clear_reload();
+  term_detail_sync();
+
   ret = term_pjsip_databases();
   if(ret == false) {
     slog(LOG_ERR, "Could not clear pjsip info.");
@@ -232,12 +390,10 @@ bool pjsip_reload_handler(void)
     return false;
   }
 
-  // init database
-  ret = init_databases();
-  if(ret == false) {
-    slog(LOG_ERR, "Could not initiate pjsip database.");
-    return false;
-  }
+  load_detail_sync_config();
+
+  // keeps the current data until the new snapshot is complete
+  begin_reload();
 
   // init resources
   ret = init_resources();
@@ -389,50 +545,760 @@ static bool init_config_default_info(void)
       slog(LOG_ERR, "Could not create default config info.");
       return false;
     }
-  }
+  }
+
+  return true;
+}
+
+static bool init_resources(void)
+{
+  int ret;
+  json_t* j_tmp;
+
+  // send PJSIPShowEndpoints
+  j_tmp = json_pack("{s:s}",
+      "Action", "PJSIPShowEndpoints"
+      );
+  ret = ami_send_cmd(j_tmp);
+  json_decref(j_tmp);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowEndpoints");
+    return false;
+  }
+
+  // send PJSIPShowRegistrationsOutbound
+  j_tmp = json_pack("{s:s}",
+      "Action", "PJSIPShowRegistrationsOutbound"
+      );
+  ret = ami_send_cmd(j_tmp);
+  json_decref(j_tmp);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowRegistrationsOutbound");
+    return false;
+  }
+
+  // send PJSIPShowRegistrationsInbound
+  j_tmp = json_pack("{s:s}",
+      "Action", "PJSIPShowRegistrationsInbound"
+      );
+  ret = ami_send_cmd(j_tmp);
+  json_decref(j_tmp);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowRegistrationsInbound");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Create or update the pjsip info with the given data.
+ * Updates and publishes only if the data has been changed.
+ * The object is marked as seen if the reload is in progress.
+ * @param type
+ * @param j_data
+ * @return
+ */
+static bool sync_item(enum EN_PJSIP_SYNC_TYPES type, const json_t* j_data)
+{
+  const struct pjsip_sync_info* info;
+  const char* key;
+  json_t* j_tmp;
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  info = &g_sync_infos[type];
+  key = json_string_value(json_object_get(j_data, info->key));
+  if(key == NULL) {
+    slog(LOG_NOTICE, "Could not get key info. table[%s], key[%s]", info->table, info->key);
+    return false;
+  }
+
+  if(g_reload.j_seens[type] != NULL) {
+    json_object_set_new(g_reload.j_seens[type], key, json_true());
+  }
+
+  j_tmp = resource_get_mem_detail_item_key_string(info->table, info->key, key);
+  if(j_tmp == NULL) {
+    return info->func_create(j_data);
+  }
+
+  ret = utils_is_item_changed(j_tmp, j_data);
+  json_decref(j_tmp);
+  if(ret == false) {
+    return true;
+  }
+  slog(LOG_DEBUG, "The info has been changed. table[%s], key[%s]", info->table, key);
+
+  return info->func_update(j_data);
+}
+
+/**
+ * Start the reload snapshot.
+ * The objects not received until the list is complete are deleted.
+ */
+static void begin_reload(void)
+{
+  int i;
+
+  clear_reload();
+
+  for(i = 0; i < EN_PJSIP_SYNC_COUNT; i++) {
+    g_reload.j_seens[i] = json_object();
+  }
+  g_reload.endpoint_pending = true;
+  g_reload.registration_inbound_pending = true;
+  g_reload.registration_outbound_pending = true;
+
+  // the running sync round waits the new endpoint list
+  g_detail.listed = false;
+}
+
+static void clear_reload(void)
+{
+  int i;
+
+  for(i = 0; i < EN_PJSIP_SYNC_COUNT; i++) {
+    if(g_reload.j_seens[i] != NULL) {
+      json_decref(g_reload.j_seens[i]);
+    }
+  }
+  memset(&g_reload, 0x00, sizeof(g_reload));
+}
+
+/**
+ * Delete the objects which were not received in the reload snapshot.
+ * @param type
+ */
+static void sweep_items(enum EN_PJSIP_SYNC_TYPES type)
+{
+  const struct pjsip_sync_info* info;
+  json_t* j_items;
+  json_t* j_item;
+  const char* key;
+  int count;
+  int idx;
+
+  if(g_reload.j_seens[type] == NULL) {
+    return;
+  }
+
+  info = &g_sync_infos[type];
+  j_items = resource_get_mem_items(info->table, info->key);
+
+  count = 0;
+  json_array_foreach(j_items, idx, j_item) {
+    key = json_string_value(json_object_get(j_item, info->key));
+    if((key == NULL) || (json_object_get(g_reload.j_seens[type], key) != NULL)) {
+      continue;
+    }
+
+    info->func_delete(key);
+    count++;
+  }
+  json_decref(j_items);
+  slog(LOG_INFO, "Swept the pjsip info. table[%s], seen[%d], deleted[%d]", info->table, (int)json_object_size(g_reload.j_seens[type]), count);
+
+  json_decref(g_reload.j_seens[type]);
+  g_reload.j_seens[type] = NULL;
+}
+
+/**
+ * Sweep the endpoint and the related objects
+ * if the endpoint list and the every endpoint detail are complete.
+ * The related objects are kept if some of the endpoint details were lost.
+ */
+static void sweep_endpoints(void)
+{
+  if((g_reload.endpoint_pending == false) || (g_reload.endpoint_listed == false)) {
+    return;
+  }
+
+  if((g_detail.queued > 0) || (g_detail.in_flight > 0)) {
+    return;
+  }
+
+  sweep_items(EN_PJSIP_SYNC_ENDPOINT);
+  if((g_detail.timeouts > 0) || (g_detail.failed > 0)) {
+    slog(LOG_NOTICE, "Could not sweep the endpoint related info. Some of the endpoint details are not complete. timeouts[%llu], failed[%llu]",
+        g_detail.timeouts,
+        g_detail.failed
+        );
+    json_decref(g_reload.j_seens[EN_PJSIP_SYNC_AOR]);
+    json_decref(g_reload.j_seens[EN_PJSIP_SYNC_AUTH]);
+    json_decref(g_reload.j_seens[EN_PJSIP_SYNC_CONTACT]);
+    g_reload.j_seens[EN_PJSIP_SYNC_AOR] = NULL;
+    g_reload.j_seens[EN_PJSIP_SYNC_AUTH] = NULL;
+    g_reload.j_seens[EN_PJSIP_SYNC_CONTACT] = NULL;
+  }
+  else {
+    sweep_items(EN_PJSIP_SYNC_AOR);
+    sweep_items(EN_PJSIP_SYNC_AUTH);
+    sweep_items(EN_PJSIP_SYNC_CONTACT);
+  }
+  g_reload.endpoint_pending = false;
+}
+
+/**
+ * Event: EndpointDetail
+ * The EndpointDetailComplete does not have the endpoint name.
+ * Keeps the name to match the complete with the request.
+ * @param j_data
+ * @return
+ */
+bool pjsip_sync_endpoint_info(const json_t* j_data)
+{
+  const char* name;
+
+  name = json_string_value(json_object_get(j_data, "object_name"));
+  if(name != NULL) {
+    json_array_append_new(g_detail.j_details, json_string(name));
+  }
+
+  return sync_item(EN_PJSIP_SYNC_ENDPOINT, j_data);
+}
+
+bool pjsip_sync_aor_info(const json_t* j_data)
+{
+  return sync_item(EN_PJSIP_SYNC_AOR, j_data);
+}
+
+bool pjsip_sync_auth_info(const json_t* j_data)
+{
+  return sync_item(EN_PJSIP_SYNC_AUTH, j_data);
+}
+
+bool pjsip_sync_contact_info(const json_t* j_data)
+{
+  return sync_item(EN_PJSIP_SYNC_CONTACT, j_data);
+}
+
+bool pjsip_sync_registration_inbound_info(const json_t* j_data)
+{
+  return sync_item(EN_PJSIP_SYNC_REGISTRATION_INBOUND, j_data);
+}
+
+bool pjsip_sync_registration_outbound_info(const json_t* j_data)
+{
+  return sync_item(EN_PJSIP_SYNC_REGISTRATION_OUTBOUND, j_data);
+}
+
+/**
+ * Sync the endpoint info of the EndpointList.
+ * Requests the endpoint detail if the endpoint has been changed
+ * or has no detail info yet. Otherwise, the related objects are kept as seen.
+ * @param j_data
+ * @return
+ */
+bool pjsip_sync_endpoint_list_info(const json_t* j_data)
+{
+  const char* name;
+  json_t* j_old;
+  bool skip;
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  name = json_string_value(json_object_get(j_data, "object_name"));
+  if(name == NULL) {
+    slog(LOG_NOTICE, "Could not get endpoint name.");
+    return false;
+  }
+
+  if(g_detail.running == false) {
+    start_detail_sync();
+  }
+  g_detail.endpoints++;
+
+  // the context is filled by the endpoint detail
+  skip = false;
+  j_old = resource_get_mem_detail_item_key_string(DEF_DB_TABLE_PJSIP_ENDPOINT, "object_name", name);
+  if((g_detail.skip_unchanged == true)
+      && (j_old != NULL)
+      && (json_is_string(json_object_get(j_old, "context")) == true)
+      && (utils_is_item_changed(j_old, j_data) == false)) {
+    skip = true;
+  }
+
+  ret = sync_item(EN_PJSIP_SYNC_ENDPOINT, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not sync endpoint info. name[%s]", name);
+    skip = false;
+  }
+
+  if(skip == true) {
+    mark_endpoint_related_seen(j_old);
+    json_decref(j_old);
+    g_detail.skipped++;
+    check_detail_sync();
+    return true;
+  }
+  json_decref(j_old);
+
+  ret = enqueue_endpoint_detail(name);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not enqueue endpoint detail request. name[%s]", name);
+    return false;
+  }
+  dispatch_endpoint_details();
+
+  return true;
+}
+
+/**
+ * Event: EndpointListComplete
+ */
+void pjsip_complete_endpoint_list(void)
+{
+  g_reload.endpoint_listed = true;
+  g_detail.listed = true;
+  check_detail_sync();
+}
+
+/**
+ * Event: EndpointDetailComplete
+ */
+void pjsip_complete_endpoint_detail(void)
+{
+  char* name;
+  json_int_t count;
+
+  // the oldest received detail
+  name = NULL;
+  if(json_array_size(g_detail.j_details) > 0) {
+    name = strdup(json_string_value(json_array_get(g_detail.j_details, 0)));
+    json_array_remove(g_detail.j_details, 0);
+  }
+
+  // could be a late response of the released request
+  count = json_integer_value(json_object_get(g_detail.j_in_flight, name? : ""));
+  if(count <= 0) {
+    slog(LOG_NOTICE, "Could not find the in flight request of the endpoint detail. name[%s]", (name != NULL)? name : "");
+    sfree(name);
+    return;
+  }
+
+  if(count == 1) {
+    json_object_del(g_detail.j_in_flight, name);
+  }
+  else {
+    json_object_set_new(g_detail.j_in_flight, name, json_integer(count - 1));
+  }
+  sfree(name);
+
+  g_detail.in_flight--;
+  g_detail.completed++;
+  g_detail.tm_progress = get_monotonic_sec();
+
+  dispatch_endpoint_details();
+  check_detail_sync();
+}
+
+/**
+ * Returns endpoint detail sync status.
+ * @return
+ */
+json_t* pjsip_get_detail_sync_status(void)
+{
+  json_t* j_res;
+  struct timespec tm_end;
+  double elapsed;
+
+  elapsed = 0;
+  if((g_detail.tm_start.tv_sec != 0) || (g_detail.tm_start.tv_nsec != 0)) {
+    tm_end = g_detail.tm_end;
+    if(g_detail.running == true) {
+      clock_gettime(CLOCK_MONOTONIC, &tm_end);
+    }
+    elapsed = (tm_end.tv_sec - g_detail.tm_start.tv_sec) + (tm_end.tv_nsec - g_detail.tm_start.tv_nsec) / 1000000000.0;
+  }
+
+  j_res = json_pack("{"
+      "s:i, s:i, s:b, "
+      "s:b, s:i, s:i, s:f, s:I, "
+      "s:I, s:I, s:I, s:I, s:I, s:I"
+      "}",
+
+      "concurrency",      g_detail.concurrency,
+      "timeout",          g_detail.timeout,
+      "skip_unchanged",   g_detail.skip_unchanged,
+
+      "running",          g_detail.running,
+      "queued",           g_detail.queued,
+      "in_flight",        g_detail.in_flight,
+      "elapsed",          elapsed,
+      "rounds",           (json_int_t)g_detail.rounds,
+
+      "endpoints",        (json_int_t)g_detail.endpoints,
+      "skipped",          (json_int_t)g_detail.skipped,
+      "sent",             (json_int_t)g_detail.sent,
+      "completed",        (json_int_t)g_detail.completed,
+      "timeouts",         (json_int_t)g_detail.timeouts,
+      "failed",           (json_int_t)g_detail.failed
+      );
+
+  return j_res;
+}
+
+/**
+ * Initiate endpoint detail sync.
+ * Registers the in flight request check timer.
+ * @return
+ */
+static bool init_detail_sync(void)
+{
+  struct timeval tm_interval;
+  struct event* ev;
+
+  memset(&g_detail, 0x00, sizeof(g_detail));
+  TAILQ_INIT(&g_detail.queue);
+  g_detail.j_queued = json_object();
+  g_detail.j_in_flight = json_object();
+  g_detail.j_details = json_array();
+  load_detail_sync_config();
+
+  tm_interval.tv_sec = DEF_PJSIP_DETAIL_CHECK_INTERVAL;
+  tm_interval.tv_usec = 0;
+  ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_pjsip_detail_sync, NULL);
+  if(ev == NULL) {
+    slog(LOG_ERR, "Could not create event for the endpoint detail sync.");
+    return false;
+  }
+  event_add(ev, &tm_interval);
+  event_add_handler(ev);
+
+  return true;
+}
+
+static void term_detail_sync(void)
+{
+  struct pjsip_detail_entry* entry;
+
+  while((entry = TAILQ_FIRST(&g_detail.queue)) != NULL) {
+    TAILQ_REMOVE(&g_detail.queue, entry, entries);
+    sfree(entry->name);
+    sfree(entry);
+  }
+  json_decref(g_detail.j_queued);
+  json_decref(g_detail.j_in_flight);
+  json_decref(g_detail.j_details);
+
+  memset(&g_detail, 0x00, sizeof(g_detail));
+  TAILQ_INIT(&g_detail.queue);
+}
+
+static void load_detail_sync_config(void)
+{
+  g_detail.concurrency = config_get_value_number("pjsip", "detail_concurrency", 1);
+  g_detail.timeout = config_get_value_number("pjsip", "detail_timeout", 1);
+  g_detail.skip_unchanged = config_get_value_number("pjsip", "detail_skip_unchanged", 0)? true : false;
+  slog(LOG_NOTICE, "Endpoint detail sync info. concurrency[%d], timeout[%d], skip_unchanged[%d]",
+      g_detail.concurrency,
+      g_detail.timeout,
+      g_detail.skip_unchanged
+      );
+}
+
+/**
+ * Releases the in flight requests if there is no progress until the timeout.
+ * The Asterisk does not send the EndpointDetailComplete for the removed endpoint.
+ */
+static void cb_pjsip_detail_sync(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  if(g_detail.in_flight == 0) {
+    return;
+  }
+
+  if((get_monotonic_sec() - g_detail.tm_progress) < g_detail.timeout) {
+    return;
+  }
+
+  slog(LOG_WARNING, "Released the endpoint detail requests. in_flight[%d], queued[%d]", g_detail.in_flight, g_detail.queued);
+  g_detail.timeouts += g_detail.in_flight;
+  release_detail_in_flights();
+
+  dispatch_endpoint_details();
+  check_detail_sync();
+}
+
+/**
+ * Release all of the in flight requests.
+ * The late EndpointDetailComplete of them does not match any request.
+ */
+static void release_detail_in_flights(void)
+{
+  json_object_clear(g_detail.j_in_flight);
+  json_array_clear(g_detail.j_details);
+  g_detail.in_flight = 0;
+}
+
+/**
+ * Start the new sync round.
+ */
+static void start_detail_sync(void)
+{
+  g_detail.running = true;
+  g_detail.listed = false;
+  g_detail.endpoints = 0;
+  g_detail.skipped = 0;
+  g_detail.sent = 0;
+  g_detail.completed = 0;
+  g_detail.timeouts = 0;
+  g_detail.failed = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &g_detail.tm_start);
+  memset(&g_detail.tm_end, 0x00, sizeof(g_detail.tm_end));
+}
+
+/**
+ * Finish the sync round if the list and every requests are complete.
+ * Then sweeps the endpoints.
+ */
+static void check_detail_sync(void)
+{
+  double elapsed;
+
+  if((g_detail.running == true)
+      && (g_detail.listed == true)
+      && (g_detail.queued == 0)
+      && (g_detail.in_flight == 0)) {
+    g_detail.running = false;
+    g_detail.rounds++;
+    clock_gettime(CLOCK_MONOTONIC, &g_detail.tm_end);
+
+    elapsed = (g_detail.tm_end.tv_sec - g_detail.tm_start.tv_sec) + (g_detail.tm_end.tv_nsec - g_detail.tm_start.tv_nsec) / 1000000000.0;
+    slog(LOG_NOTICE, "Completed endpoint detail sync. endpoints[%llu], skipped[%llu], sent[%llu], completed[%llu], timeouts[%llu], failed[%llu], elapsed[%.3f]",
+        g_detail.endpoints,
+        g_detail.skipped,
+        g_detail.sent,
+        g_detail.completed,
+        g_detail.timeouts,
+        g_detail.failed,
+        elapsed
+        );
+  }
+
+  sweep_endpoints();
+}
+
+/**
+ * Add the endpoint detail request to the queue.
+ * The already queued endpoint is not added again.
+ * @param name
+ * @return
+ */
+static bool enqueue_endpoint_detail(const char* name)
+{
+  struct pjsip_detail_entry* entry;
+
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  if(json_object_get(g_detail.j_queued, name) != NULL) {
+    return true;
+  }
+
+  entry = calloc(1, sizeof(*entry));
+  entry->name = strdup(name);
+  TAILQ_INSERT_TAIL(&g_detail.queue, entry, entries);
+  json_object_set_new(g_detail.j_queued, name, json_true());
+  g_detail.queued++;
+
+  return true;
+}
+
+/**
+ * Send the queued requests until the in flight requests reach the concurrency.
+ */
+static void dispatch_endpoint_details(void)
+{
+  struct pjsip_detail_entry* entry;
+  json_int_t count;
+  int ret;
+
+  while((g_detail.in_flight < g_detail.concurrency) && ((entry = TAILQ_FIRST(&g_detail.queue)) != NULL)) {
+    TAILQ_REMOVE(&g_detail.queue, entry, entries);
+    json_object_del(g_detail.j_queued, entry->name);
+    g_detail.queued--;
+
+    ret = send_endpoint_detail(entry->name);
+    if(ret == false) {
+      g_detail.failed++;
+      sfree(entry->name);
+      sfree(entry);
+      continue;
+    }
+
+    count = json_integer_value(json_object_get(g_detail.j_in_flight, entry->name));
+    json_object_set_new(g_detail.j_in_flight, entry->name, json_integer(count + 1));
+    sfree(entry->name);
+    sfree(entry);
+
+    g_detail.in_flight++;
+    g_detail.sent++;
+    g_detail.tm_progress = get_monotonic_sec();
+  }
+}
+
+/**
+ * Send the PJSIPShowEndpoint for the given endpoint.
+ * @param name
+ * @return
+ */
+static bool send_endpoint_detail(const char* name)
+{
+  json_t* j_tmp;
+  int ret;
+
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  j_tmp = json_pack("{s:s, s:s}",
+      "Action", "PJSIPShowEndpoint",
+      "Endpoint", name
+      );
+  ret = ami_send_cmd(j_tmp);
+  json_decref(j_tmp);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowEndpoint");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Mark the aors, auths and contacts of the given endpoint as seen.
+ * The skipped endpoint does not receive the detail events of them.
+ * @param j_endpoint
+ */
+static void mark_endpoint_related_seen(const json_t* j_endpoint)
+{
+  if(j_endpoint == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+
+  mark_seen_names(EN_PJSIP_SYNC_AOR, json_string_value(json_object_get(j_endpoint, "aors")));
+  mark_seen_names(EN_PJSIP_SYNC_AUTH, json_string_value(json_object_get(j_endpoint, "auth")));
+  mark_seen_names(EN_PJSIP_SYNC_AUTH, json_string_value(json_object_get(j_endpoint, "outbound_auth")));
+}
+
+/**
+ * Mark the comma separated names as seen.
+ * The contacts of the aor are marked too.
+ * @param type
+ * @param names
+ */
+static void mark_seen_names(enum EN_PJSIP_SYNC_TYPES type, const char* names)
+{
+  char* org;
+  char* token;
+  char* save;
+  json_t* j_contacts;
+  json_t* j_contact;
+  const char* uri;
+  int idx;
+
+  if((names == NULL) || (g_reload.j_seens[type] == NULL)) {
+    return;
+  }
+
+  org = strdup(names);
+  for(token = strtok_r(org, ",", &save); token != NULL; token = strtok_r(NULL, ",", &save)) {
+    utils_trim(token);
+    if(strlen(token) == 0) {
+      continue;
+    }
+    json_object_set_new(g_reload.j_seens[type], token, json_true());
+
+    if((type != EN_PJSIP_SYNC_AOR) || (g_reload.j_seens[EN_PJSIP_SYNC_CONTACT] == NULL)) {
+      continue;
+    }
 
-  return true;
+    j_contacts = resource_get_mem_detail_items_key_string(DEF_DB_TABLE_PJSIP_CONTACT, "aor", token);
+    json_array_foreach(j_contacts, idx, j_contact) {
+      uri = json_string_value(json_object_get(j_contact, "uri"));
+      if(uri == NULL) {
+        continue;
+      }
+      json_object_set_new(g_reload.j_seens[EN_PJSIP_SYNC_CONTACT], uri, json_true());
+    }
+    json_decref(j_contacts);
+  }
+  sfree(org);
 }
 
-static bool init_resources(void)
+/**
+ * Expire the endpoint detail to be requested at the next sync.
+ * The endpoint list does not show the detail changes of the written config.
+ * @param name endpoint name. NULL expires every endpoint.
+ */
+static void expire_endpoint_detail(const char* name)
 {
   int ret;
   json_t* j_tmp;
 
-  // send PJSIPShowEndpoints
-  j_tmp = json_pack("{s:s}",
-      "Action", "PJSIPShowEndpoints"
-      );
-  ret = ami_send_cmd(j_tmp);
-  json_decref(j_tmp);
+  if(name == NULL) {
+    ret = resource_exec_mem_sql("update " DEF_DB_TABLE_PJSIP_ENDPOINT " set context = null;");
+  }
+  else {
+    j_tmp = json_pack("{s:s, s:n}",
+        "object_name",  name,
+        "context"
+        );
+    ret = resource_update_mem_item(DEF_DB_TABLE_PJSIP_ENDPOINT, "object_name", j_tmp);
+    json_decref(j_tmp);
+  }
   if(ret == false) {
-    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowEndpoints");
-    return false;
+    slog(LOG_NOTICE, "Could not expire the endpoint detail. name[%s]", (name != NULL)? name : "");
   }
+}
 
-  // send PJSIPShowRegistrationsOutbound
-  j_tmp = json_pack("{s:s}",
-      "Action", "PJSIPShowRegistrationsOutbound"
-      );
-  ret = ami_send_cmd(j_tmp);
-  json_decref(j_tmp);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowRegistrationsOutbound");
-    return false;
+static time_t get_monotonic_sec(void)
+{
+  struct timespec tm;
+
+  clock_gettime(CLOCK_MONOTONIC, &tm);
+
+  return tm.tv_sec;
+}
+
+/**
+ * Event: InboundRegistrationDetailComplete
+ */
+void pjsip_complete_registration_inbound_list(void)
+{
+  if(g_reload.registration_inbound_pending == false) {
+    return;
   }
 
-  // send PJSIPShowRegistrationsInbound
-  j_tmp = json_pack("{s:s}",
-      "Action", "PJSIPShowRegistrationsInbound"
-      );
-  ret = ami_send_cmd(j_tmp);
-  json_decref(j_tmp);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not send ami action. action[%s]", "PJSIPShowRegistrationsInbound");
-    return false;
+  sweep_items(EN_PJSIP_SYNC_REGISTRATION_INBOUND);
+  g_reload.registration_inbound_pending = false;
+}
+
+/**
+ * Event: OutboundRegistrationDetailComplete
+ */
+void pjsip_complete_registration_outbound_list(void)
+{
+  if(g_reload.registration_outbound_pending == false) {
+    return;
   }
 
-  return true;
+  sweep_items(EN_PJSIP_SYNC_REGISTRATION_OUTBOUND);
+  g_reload.registration_outbound_pending = false;
 }
 
 static bool init_callbacks(void)
@@ -1021,6 +1887,26 @@ json_t* pjsip_get_endpoint_info(const char* name)
   return j_res;
 }
 
+/**
+ * Get list of pjsip_endpoint info of given names.
+ * @param j_names json array of endpoint names.
+ * @return
+ */
+json_t* pjsip_get_endpoints_info_by_names(const json_t* j_names)
+{
+  json_t* j_res;
+
+  if(j_names == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired pjsip_get_endpoints_info_by_names.");
+
+  j_res = resource_get_mem_detail_items_key_strings(DEF_DB_TABLE_PJSIP_ENDPOINT, "object_name", j_names);
+
+  return j_res;
+}
+
 /**
  * Get all list of pjsip_endpoint info.
  * @param name
@@ -1037,6 +1923,23 @@ json_t* pjsip_get_endpoints_all(void)
   return j_res;
 }
 
+/**
+ * Get the page of pjsip_endpoint ordered by object_name.
+ * @param cursor: object_name of the last endpoint of the previous page.
+ * @param count
+ * @return
+ */
+json_t* pjsip_get_endpoints_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  slog(LOG_DEBUG, "Fired pjsip_get_endpoints_page.");
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PJSIP_ENDPOINT, "object_name", cursor, count);
+
+  return j_res;
+}
+
 /**
  * Get all list of pjsip_aor info.
  * @param name
@@ -1053,6 +1956,20 @@ json_t* pjsip_get_aors_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of aors ordered by object_name.
+ * @param cursor: object_name of the last aor of the previous page.
+ * @param count
+ * @return
+ */
+json_t* pjsip_get_aors_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PJSIP_AOR, "object_name", cursor, count);
+  return j_res;
+}
+
 /**
  * Get detail info of given pjsip_aor key.
  * @param name
@@ -1089,6 +2006,20 @@ json_t* pjsip_get_auths_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of auths ordered by object_name.
+ * @param cursor: object_name of the last auth of the previous page.
+ * @param count
+ * @return
+ */
+json_t* pjsip_get_auths_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PJSIP_AUTH, "object_name", cursor, count);
+  return j_res;
+}
+
 /**
  * Get detail info of given pjsip_auth key.
  * @param name
@@ -1109,6 +2040,26 @@ json_t* pjsip_get_auth_info(const char* key)
   return j_res;
 }
 
+/**
+ * Get list of pjsip_auth info of given names.
+ * @param j_names json array of auth names.
+ * @return
+ */
+json_t* pjsip_get_auths_info_by_names(const json_t* j_names)
+{
+  json_t* j_res;
+
+  if(j_names == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired pjsip_get_auths_info_by_names.");
+
+  j_res = resource_get_mem_detail_items_key_strings(DEF_DB_TABLE_PJSIP_AUTH, "object_name", j_names);
+
+  return j_res;
+}
+
 /**
  * Get all list of pjsip_contact info.
  * @param name
@@ -1125,6 +2076,20 @@ json_t* pjsip_get_contacts_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of contacts ordered by uri.
+ * @param cursor: uri of the last contact of the previous page.
+ * @param count
+ * @return
+ */
+json_t* pjsip_get_contacts_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PJSIP_CONTACT, "uri", cursor, count);
+  return j_res;
+}
+
 /**
  * Get detail info of given pjsip_contact key.
  * @param name
@@ -1967,6 +2932,20 @@ json_t* pjsip_get_registration_outbounds_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of registration outbounds ordered by object_name.
+ * @param cursor: object_name of the last registration outbound of the previous page.
+ * @param count
+ * @return
+ */
+json_t* pjsip_get_registration_outbounds_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_PJSIP_REGISTRATION_OUTBOUND, "object_name", cursor, count);
+  return j_res;
+}
+
 /**
  * Return the given registraion_outbound info.
  * @param key
@@ -2676,6 +3655,9 @@ static bool cfg_update_aor_info(const json_t* j_data)
     return false;
   }
 
+  // the endpoints refer the aor by the name
+  expire_endpoint_detail(NULL);
+
   return true;
 }
 
@@ -2743,6 +3725,9 @@ static bool cfg_update_auth_info(const json_t* j_data)
     return false;
   }
 
+  // the endpoints refer the auth by the name
+  expire_endpoint_detail(NULL);
+
   return true;
 }
 
@@ -2867,6 +3852,8 @@ static bool cfg_create_endpoint_info(const json_t* j_data)
     return false;
   }
 
+  expire_endpoint_detail(name);
+
   // execute
   execute_callbacks_cfg_endpoint(EN_RESOURCE_CREATE, j_tmp);
   json_decref(j_tmp);
@@ -2909,6 +3896,8 @@ static bool cfg_update_endpoint_info(const json_t* j_data)
     return false;
   }
 
+  expire_endpoint_detail(name);
+
   execute_callbacks_cfg_endpoint(EN_RESOURCE_UPDATE, j_tmp);
   json_decref(j_tmp);
 
@@ -3387,14 +4376,15 @@ bool pjsip_is_exist_endpoint(const char* target)
 }
 
 /**
- * Reload asterisk pjsip module
+ * Reload asterisk pjsip module.
+ * The reload is delayed to coalesce the following config changes.
  * @return
  */
 bool pjsip_reload_config(void)
 {
   int ret;
 
-  ret = ami_action_moduleload("res_pjsip", "reload");
+  ret = core_module_reload_delayed("res_pjsip");
   if(ret == false) {
     return false;
   }
@@ -3402,6 +4392,305 @@ bool pjsip_reload_config(void)
   return true;
 }
 
+/**
+ * Create the pjsip config objects in a batch.
+ * Validates every item first, writes each config file once
+ * and reloads the pjsip module once.
+ * Failed items are reported and skipped; the rest are created.
+ * @param j_data {"aors": [{"name": "...", "data": {...}}, ...], "auths": [...], "endpoints": [...], "identifies": [...]}
+ * @return per item results
+ */
+json_t* pjsip_cfg_create_batch_info(const json_t* j_data)
+{
+  const struct pjsip_batch_info* info;
+  conf_doc* docs[EN_PJSIP_BATCH_COUNT];
+  json_t* j_results[EN_PJSIP_BATCH_COUNT];
+  json_t* j_items;
+  json_t* j_item;
+  json_t* j_tmp;
+  json_t* j_res;
+  const char* name;
+  const char* msg;
+  int created;
+  int failed;
+  int reloaded;
+  int idx;
+  int ret;
+  int i;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired pjsip_cfg_create_batch_info.");
+
+  for(i = 0; i < EN_PJSIP_BATCH_COUNT; i++) {
+    j_items = json_object_get(j_data, g_batch_infos[i].key);
+    if((j_items != NULL) && (json_is_array(j_items) == false)) {
+      slog(LOG_NOTICE, "Wrong batch items. key[%s]", g_batch_infos[i].key);
+      return NULL;
+    }
+  }
+
+  // open configs
+  memset(docs, 0x00, sizeof(docs));
+  for(i = 0; i < EN_PJSIP_BATCH_COUNT; i++) {
+    docs[i] = conf_open_ast_current_config(g_batch_infos[i].filename);
+    if(docs[i] == NULL) {
+      slog(LOG_ERR, "Could not open config. filename[%s]", g_batch_infos[i].filename);
+      for(i = i - 1; i >= 0; i--) {
+        conf_doc_free(docs[i]);
+      }
+      return NULL;
+    }
+  }
+
+  // validate and set in the dependency order
+  created = 0;
+  failed = 0;
+  for(i = 0; i < EN_PJSIP_BATCH_COUNT; i++) {
+    info = &g_batch_infos[i];
+    j_results[i] = json_array();
+
+    j_items = json_object_get(j_data, info->key);
+    json_array_foreach(j_items, idx, j_item) {
+      name = json_string_value(json_object_get(j_item, "name"));
+
+      msg = validate_batch_item(i, j_item, docs);
+      if(msg != NULL) {
+        json_array_append_new(j_results[i], json_pack("{s:o, s:b, s:s}", "name", name? json_string(name) : json_null(), "result", false, "message", msg));
+        failed++;
+        continue;
+      }
+
+      j_tmp = json_deep_copy(json_object_get(j_item, "data"))? : json_object();
+      json_object_set_new(j_tmp, "type", json_string(info->type));
+      ret = conf_doc_add_section(docs[i], name);
+      if(ret == true) {
+        ret = conf_set_doc_section_data(docs[i], name, j_tmp);
+        if(ret == false) {
+          conf_doc_delete_section(docs[i], name);
+        }
+      }
+      json_decref(j_tmp);
+      if(ret == false) {
+        slog(LOG_ERR, "Could not set the batch item. key[%s], name[%s]", info->key, name);
+        json_array_append_new(j_results[i], json_pack("{s:s, s:b, s:s}", "name", name, "result", false, "message", "Could not set the config section."));
+        failed++;
+        continue;
+      }
+
+      json_array_append_new(j_results[i], json_pack("{s:s, s:b}", "name", name, "result", true));
+      created++;
+    }
+  }
+
+  // write configs
+  for(i = 0; i < EN_PJSIP_BATCH_COUNT; i++) {
+    ret = conf_commit_ast_current_config(g_batch_infos[i].filename, docs[i]);
+    conf_doc_free(docs[i]);
+    if(ret == true) {
+      continue;
+    }
+    slog(LOG_ERR, "Could not write config. filename[%s]", g_batch_infos[i].filename);
+
+    json_array_foreach(j_results[i], idx, j_item) {
+      if(json_is_true(json_object_get(j_item, "result")) == false) {
+        continue;
+      }
+      json_object_set_new(j_item, "result", json_false());
+      json_object_set_new(j_item, "message", json_string("Could not write the config file."));
+      created--;
+      failed++;
+    }
+  }
+
+  // execute endpoint callbacks
+  json_array_foreach(j_results[EN_PJSIP_BATCH_ENDPOINT], idx, j_item) {
+    if(json_is_true(json_object_get(j_item, "result")) == false) {
+      continue;
+    }
+
+    expire_endpoint_detail(json_string_value(json_object_get(j_item, "name")));
+
+    j_tmp = pjsip_cfg_get_endpoint_info(json_string_value(json_object_get(j_item, "name")));
+    if(j_tmp == NULL) {
+      continue;
+    }
+    execute_callbacks_cfg_endpoint(EN_RESOURCE_CREATE, j_tmp);
+    json_decref(j_tmp);
+  }
+
+  // reload once
+  reloaded = false;
+  if(created > 0) {
+    reloaded = pjsip_reload_config();
+    if(reloaded == false) {
+      slog(LOG_WARNING, "Could not reload pjsip config.");
+    }
+  }
+  slog(LOG_NOTICE, "Created pjsip config batch. created[%d], failed[%d]", created, failed);
+
+  j_res = json_pack("{s:o, s:o, s:o, s:o, s:i, s:i, s:b}",
+      g_batch_infos[EN_PJSIP_BATCH_AOR].key,        j_results[EN_PJSIP_BATCH_AOR],
+      g_batch_infos[EN_PJSIP_BATCH_AUTH].key,       j_results[EN_PJSIP_BATCH_AUTH],
+      g_batch_infos[EN_PJSIP_BATCH_ENDPOINT].key,   j_results[EN_PJSIP_BATCH_ENDPOINT],
+      g_batch_infos[EN_PJSIP_BATCH_IDENTIFY].key,   j_results[EN_PJSIP_BATCH_IDENTIFY],
+
+      "created",    created,
+      "failed",     failed,
+      "reloaded",   reloaded
+      );
+
+  return j_res;
+}
+
+/**
+ * Validate the batch item.
+ * The referred objects should exist in the config, the batch or the asterisk.
+ * @param type
+ * @param j_item
+ * @param docs
+ * @return error message. NULL if valid.
+ */
+static const char* validate_batch_item(enum EN_PJSIP_BATCH_TYPES type, const json_t* j_item, conf_doc** docs)
+{
+  const char* name;
+  const char* key;
+  json_t* j_data;
+  json_t* j_val;
+  json_t* j_tmp;
+  int idx;
+
+  if((j_item == NULL) || (docs == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return "Wrong input parameter.";
+  }
+
+  if(json_is_object(j_item) == false) {
+    return "The item is not an object.";
+  }
+
+  name = json_string_value(json_object_get(j_item, "name"));
+  if((is_batch_string_valid(name) == false) || (strpbrk(name, "[]") != NULL)) {
+    return "Wrong name.";
+  }
+
+  j_data = json_object_get(j_item, "data");
+  if((j_data != NULL) && (json_is_object(j_data) == false)) {
+    return "The data is not an object.";
+  }
+
+  json_object_foreach(j_data, key, j_val) {
+    if((is_batch_string_valid(key) == false) || (strchr(key, '=') != NULL)) {
+      return "Wrong data key.";
+    }
+
+    if(json_is_array(j_val) == false) {
+      if(json_is_string(j_val) == false) {
+        return "Wrong data value.";
+      }
+      continue;
+    }
+
+    json_array_foreach(j_val, idx, j_tmp) {
+      if(json_is_string(j_tmp) == false) {
+        return "Wrong data value.";
+      }
+    }
+  }
+
+  if(conf_doc_has_section(docs[type], name) == true) {
+    return "The name already exists.";
+  }
+
+  // references
+  if(type == EN_PJSIP_BATCH_ENDPOINT) {
+    if(is_batch_refers_exist(EN_PJSIP_BATCH_AOR, json_string_value(json_object_get(j_data, "aors")), docs) == false) {
+      return "Could not find the aor.";
+    }
+    if(is_batch_refers_exist(EN_PJSIP_BATCH_AUTH, json_string_value(json_object_get(j_data, "auth")), docs) == false) {
+      return "Could not find the auth.";
+    }
+    if(is_batch_refers_exist(EN_PJSIP_BATCH_AUTH, json_string_value(json_object_get(j_data, "outbound_auth")), docs) == false) {
+      return "Could not find the outbound_auth.";
+    }
+  }
+  else if(type == EN_PJSIP_BATCH_IDENTIFY) {
+    if(json_string_value(json_object_get(j_data, "endpoint")) == NULL) {
+      return "Could not get the endpoint.";
+    }
+    if(is_batch_refers_exist(EN_PJSIP_BATCH_ENDPOINT, json_string_value(json_object_get(j_data, "endpoint")), docs) == false) {
+      return "Could not find the endpoint.";
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Returns true if the given string is not empty and has no line break or comment.
+ */
+static bool is_batch_string_valid(const char* str)
+{
+  if((str == NULL) || (strlen(str) == 0)) {
+    return false;
+  }
+
+  if(strpbrk(str, "\r\n;") != NULL) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Returns true if every comma separated name exists.
+ * Returns true if the names is NULL.
+ * @param type
+ * @param names
+ * @param docs
+ * @return
+ */
+static bool is_batch_refers_exist(enum EN_PJSIP_BATCH_TYPES type, const char* names, conf_doc** docs)
+{
+  char* org;
+  char* token;
+  char* save;
+  json_t* j_tmp;
+  bool res;
+
+  if(names == NULL) {
+    return true;
+  }
+
+  res = true;
+  org = strdup(names);
+  for(token = strtok_r(org, ",", &save); token != NULL; token = strtok_r(NULL, ",", &save)) {
+    utils_trim(token);
+    if(strlen(token) == 0) {
+      continue;
+    }
+
+    if(conf_doc_has_section(docs[type], token) == true) {
+      continue;
+    }
+
+    // could be defined in the other config
+    j_tmp = resource_get_mem_detail_item_key_string(g_batch_infos[type].table, "object_name", token);
+    if(j_tmp != NULL) {
+      json_decref(j_tmp);
+      continue;
+    }
+
+    res = false;
+    break;
+  }
+  sfree(org);
+
+  return res;
+}
+
 json_t* pjsip_cfg_get_aor_info_data(const char* name)
 {
   json_t* j_res;
@@ -3968,6 +5257,21 @@ json_t* pjsip_get_configuration_info(const char* name)
   return j_res;
 }
 
+/**
+ * Returns the config filename of the given name for the raw text.
+ * @param name current or backup config name
+ * @return
+ */
+char* pjsip_get_configuration_filename(const char* name)
+{
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  return conf_get_ast_config_filename(name, DEF_PJSIP_CONFNAME);
+}
+
 bool pjsip_update_configuration_info(const json_t* j_data)
 {
   int ret;
@@ -3996,6 +5300,7 @@ bool pjsip_update_configuration_info(const json_t* j_data)
   if(ret == false) {
     return false;
   }
+  expire_endpoint_detail(NULL);
 
   return true;
 }
@@ -10,10 +10,12 @@
 #include "slog.h"
 #include "zmq_handler.h"
 #include "utils.h"
+#include "websocket_handler.h"
 
 #include <publication_handler.h>
 
 static bool publish_event(const char* topic, const char* event_name, const json_t* j_data);
+static char* create_event_name(const char* event_prefix, enum EN_PUBLISH_TYPES type);
 
 /**
  * Publish event
@@ -735,17 +737,8 @@ bool publication_publish_event(const char* topic, const char* event_prefix, enum
   }
 
   // create event name
-  if(type == EN_PUBLISH_CREATE) {
-    asprintf(&event, "%s.%s", event_prefix, DEF_PUB_TYPE_CREATE);
-  }
-  else if(type == EN_PUBLISH_UPDATE) {
-    asprintf(&event, "%s.%s", event_prefix, DEF_PUB_TYPE_UPDATE);
-  }
-  else if(type == EN_PUBLISH_DELETE) {
-    asprintf(&event, "%s.%s", event_prefix, DEF_PUB_TYPE_DELETE);
-  }
-  else {
-    slog(LOG_ERR, "Could not get correct publish type. type[%u]", type);
+  event = create_event_name(event_prefix, type);
+  if(event == NULL) {
     return false;
   }
 
@@ -759,3 +752,71 @@ bool publication_publish_event(const char* topic, const char* event_prefix, enum
 
   return true;
 }
+
+/**
+ * Publish event to the group.
+ * The event is published to the zmq topic of the group name for the
+ * external subscribers, and delivered to the member websocket sessions
+ * directly. The member session which subscribes the group topic gets
+ * the zmq published one only.
+ * @param group
+ * @param event_prefix
+ * @param type
+ * @param j_data
+ * @return
+ */
+bool publication_publish_group_event(const char* group, const char* event_prefix, enum EN_PUBLISH_TYPES type, const json_t* j_data)
+{
+  char* event;
+  int ret;
+
+  if((group == NULL) || (event_prefix == NULL) || (j_data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  // create event name
+  event = create_event_name(event_prefix, type);
+  if(event == NULL) {
+    return false;
+  }
+
+  // publish event to the zmq subscribers
+  ret = publish_event(group, event, j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not publish event.");
+    sfree(event);
+    return false;
+  }
+
+  // deliver event to the member sessions
+  ret = websocket_publish_group(group, event, j_data);
+  sfree(event);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not publish group event.");
+    return false;
+  }
+
+  return true;
+}
+
+static char* create_event_name(const char* event_prefix, enum EN_PUBLISH_TYPES type)
+{
+  char* res;
+
+  if(type == EN_PUBLISH_CREATE) {
+    asprintf(&res, "%s.%s", event_prefix, DEF_PUB_TYPE_CREATE);
+  }
+  else if(type == EN_PUBLISH_UPDATE) {
+    asprintf(&res, "%s.%s", event_prefix, DEF_PUB_TYPE_UPDATE);
+  }
+  else if(type == EN_PUBLISH_DELETE) {
+    asprintf(&res, "%s.%s", event_prefix, DEF_PUB_TYPE_DELETE);
+  }
+  else {
+    slog(LOG_ERR, "Could not get correct publish type. type[%u]", type);
+    return NULL;
+  }
+
+  return res;
+}
@@ -17,6 +17,7 @@
 #include "ami_action_handler.h"
 #include "publication_handler.h"
 #include "conf_handler.h"
+#include "ast_header.h"
 
 #include "queue_handler.h"
 #include "resource_handler.h"
@@ -34,6 +35,9 @@
 static struct st_callback* g_callback_db_entry;
 static struct st_callback* g_callback_db_member;
 
+static json_t* g_queue_stats = NULL;          ///< queue_name:queue stat counters
+static json_t* g_queue_member_stats = NULL;   ///< member id:member's counted state
+
 
 static bool init_databases(void);
 static bool init_database_param(void);
@@ -73,6 +77,14 @@ static bool send_request_member_penalty_update(const json_t* j_data);
 static bool send_request_member_paused_update(const json_t* j_data);
 static bool send_request_member_add_to_queue(const json_t* j_data);
 
+static json_t* get_queue_stat(const char* name);
+static void add_queue_stat_count(json_t* j_stat, const char* key, int delta);
+static void add_queue_stat_member(const json_t* j_member, int delta);
+static void update_queue_stat_member(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_member);
+static void update_queue_stat_param(const json_t* j_param);
+static void clear_queue_stats(void);
+static bool is_member_inuse(int status);
+
 
 bool queue_init_handler(void)
 {
@@ -144,6 +156,8 @@ bool queue_term_handler(void)
     return false;
   }
 
+  clear_queue_stats();
+
   return true;
 }
 
@@ -281,6 +295,13 @@ static bool init_database_member(void)
     return false;
   }
 
+  // index for the page lookup
+  ret = resource_exec_mem_sql("create index idx_queue_member_id on " DEF_DB_TABLE_QUEUE_MEMBER "(id);");
+  if(ret == false) {
+    slog(LOG_ERR, "Could not create index. database[%s]", DEF_DB_TABLE_QUEUE_MEMBER);
+    return false;
+  }
+
   return true;
 }
 
@@ -459,7 +480,8 @@ static bool db_create_member_info(const json_t* j_data)
     return false;
   }
 
-  // execute callback
+  // update stat and execute callback
+  update_queue_stat_member(EN_RESOURCE_CREATE, j_tmp);
   execute_callbacks_db_member(EN_RESOURCE_CREATE, j_tmp);
   json_decref(j_tmp);
 
@@ -498,7 +520,8 @@ static bool db_update_member_info(const json_t* j_data)
     return false;
   }
 
-  // execute callback
+  // update stat and execute callback
+  update_queue_stat_member(EN_RESOURCE_UPDATE, j_tmp);
   execute_callbacks_db_member(EN_RESOURCE_UPDATE, j_tmp);
   json_decref(j_tmp);
 
@@ -530,7 +553,8 @@ static bool db_delete_member_info(const char* key)
     return false;
   }
 
-  // execute callback
+  // update stat and execute callback
+  update_queue_stat_member(EN_RESOURCE_DELETE, j_tmp);
   execute_callbacks_db_member(EN_RESOURCE_DELETE, j_tmp);
   json_decref(j_tmp);
 
@@ -741,6 +765,20 @@ json_t* queue_get_queue_params_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of queues ordered by name.
+ * @param cursor: name of the last queue of the previous page.
+ * @param count
+ * @return
+ */
+json_t* queue_get_queue_params_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_QUEUE_PARAM, "name", cursor, count);
+  return j_res;
+}
+
 /**
  * Get corresponding queue param info.
  * @return
@@ -783,12 +821,14 @@ static bool db_create_param_info(const json_t* j_data)
   }
 
   // insert queue info
-  ret = resource_insert_mem_item(DEF_DB_TABLE_QUEUE_PARAM, j_data);
+  ret = resource_insrep_mem_item(DEF_DB_TABLE_QUEUE_PARAM, j_data);
   if(ret == false) {
     slog(LOG_ERR, "Could not insert queue_param.");
     return false;
   }
 
+  update_queue_stat_param(j_data);
+
   return true;
 }
 
@@ -891,6 +931,20 @@ json_t* queue_get_members_all(void)
   return j_res;
 }
 
+/**
+ * Get the page of queue_member ordered by id.
+ * @param cursor: id of the last member of the previous page.
+ * @param count
+ * @return
+ */
+json_t* queue_get_members_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_QUEUE_MEMBER, "id", cursor, count);
+  return j_res;
+}
+
 /**
  * Get queue_member array of given queue name
  * @return
@@ -1178,6 +1232,20 @@ json_t* queue_get_entries_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of entries ordered by unique_id.
+ * @param cursor: unique_id of the last entry of the previous page.
+ * @param count
+ * @return
+ */
+json_t* queue_get_entries_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_QUEUE_ENTRY, "unique_id", cursor, count);
+  return j_res;
+}
+
 static bool clear_queue_member(void)
 {
   int ret;
@@ -1409,6 +1477,21 @@ json_t* queue_get_configuration_info(const char* name)
   return j_res;
 }
 
+/**
+ * Returns the config filename of the given name for the raw text.
+ * @param name current or backup config name
+ * @return
+ */
+char* queue_get_configuration_filename(const char* name)
+{
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  return conf_get_ast_config_filename(name, DEF_QUEUE_CONFNAME);
+}
+
 bool queue_update_configuration_info(const json_t* j_data)
 {
   int ret;
@@ -1464,3 +1547,240 @@ bool queue_delete_configuration_info(const char* name)
 
   return true;
 }
+
+/**
+ * Get queue stat counters of given queue.
+ * The counters are maintained by the queue member/param events,
+ * so doesn't need to query the database.
+ * @param name
+ * @param stat
+ * @return false if there's no given queue.
+ */
+bool queue_get_stat(const char* name, queue_stat* stat)
+{
+  json_t* j_stat;
+
+  if((name == NULL) || (stat == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  memset(stat, 0x00, sizeof(queue_stat));
+
+  j_stat = json_object_get(g_queue_stats, name);
+  if(j_stat == NULL) {
+    return false;
+  }
+
+  stat->ready = json_integer_value(json_object_get(j_stat, "ready"));
+  stat->paused = json_integer_value(json_object_get(j_stat, "paused"));
+  stat->in_use = json_integer_value(json_object_get(j_stat, "in_use"));
+  stat->total = json_integer_value(json_object_get(j_stat, "total"));
+  stat->service_level_perf = json_real_value(json_object_get(j_stat, "service_level_perf"));
+
+  return true;
+}
+
+/**
+ * Get queue stat info of given queue.
+ * @param name
+ * @return
+ */
+json_t* queue_get_stat_info(const char* name)
+{
+  json_t* j_stat;
+
+  if(name == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_stat = json_object_get(g_queue_stats, name);
+  if(j_stat == NULL) {
+    return NULL;
+  }
+
+  return json_deep_copy(j_stat);
+}
+
+/**
+ * Get all queue stat info.
+ * @return
+ */
+json_t* queue_get_stats_all(void)
+{
+  json_t* j_res;
+  json_t* j_stat;
+  const char* key;
+
+  j_res = json_array();
+  json_object_foreach(g_queue_stats, key, j_stat) {
+    json_array_append_new(j_res, json_deep_copy(j_stat));
+  }
+
+  return j_res;
+}
+
+/**
+ * Returns queue stat of given queue name.
+ * Creates new one if not exist.
+ * @param name
+ * @return borrowed reference
+ */
+static json_t* get_queue_stat(const char* name)
+{
+  json_t* j_stat;
+
+  if(g_queue_stats == NULL) {
+    g_queue_stats = json_object();
+  }
+
+  j_stat = json_object_get(g_queue_stats, name);
+  if(j_stat != NULL) {
+    return j_stat;
+  }
+
+  j_stat = json_pack("{s:s, s:i, s:i, s:i, s:i, s:f}",
+      "name",     name,
+      "ready",    0,
+      "paused",   0,
+      "in_use",   0,
+      "total",    0,
+      "service_level_perf", 0.0
+      );
+  json_object_set_new(g_queue_stats, name, j_stat);
+
+  return j_stat;
+}
+
+static void add_queue_stat_count(json_t* j_stat, const char* key, int delta)
+{
+  json_t* j_tmp;
+
+  j_tmp = json_object_get(j_stat, key);
+  json_integer_set(j_tmp, json_integer_value(j_tmp) + delta);
+}
+
+/**
+ * Add(or subtract) the member's state to the queue counters.
+ * @param j_member
+ * @param delta 1:add, -1:subtract
+ */
+static void add_queue_stat_member(const json_t* j_member, int delta)
+{
+  json_t* j_stat;
+  int status;
+  int paused;
+
+  j_stat = get_queue_stat(json_string_value(json_object_get(j_member, "queue_name"))? : "");
+  status = json_integer_value(json_object_get(j_member, "status"));
+  paused = json_integer_value(json_object_get(j_member, "paused"));
+
+  add_queue_stat_count(j_stat, "total", delta);
+  if(paused != 0) {
+    add_queue_stat_count(j_stat, "paused", delta);
+  }
+  if((status == AST_DEVICE_NOT_INUSE) && (paused == 0)) {
+    add_queue_stat_count(j_stat, "ready", delta);
+  }
+  if(is_member_inuse(status) == true) {
+    add_queue_stat_count(j_stat, "in_use", delta);
+  }
+}
+
+/**
+ * Update queue counters with the changed member info.
+ * @param type
+ * @param j_member member info of the queue_member table.
+ */
+static void update_queue_stat_member(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_member)
+{
+  json_t* j_old;
+  json_t* j_state;
+  const char* id;
+
+  id = json_string_value(json_object_get(j_member, "id"));
+  if(id == NULL) {
+    return;
+  }
+
+  if(g_queue_member_stats == NULL) {
+    g_queue_member_stats = json_object();
+  }
+
+  // subtract previously counted state
+  j_old = json_object_get(g_queue_member_stats, id);
+  if(j_old != NULL) {
+    add_queue_stat_member(j_old, -1);
+    json_object_del(g_queue_member_stats, id);
+  }
+
+  if(type == EN_RESOURCE_DELETE) {
+    return;
+  }
+
+  j_state = json_pack("{s:s, s:I, s:I}",
+      "queue_name", json_string_value(json_object_get(j_member, "queue_name"))? : "",
+      "status",     json_integer_value(json_object_get(j_member, "status")),
+      "paused",     json_integer_value(json_object_get(j_member, "paused"))
+      );
+  add_queue_stat_member(j_state, 1);
+  json_object_set_new(g_queue_member_stats, id, j_state);
+
+  return;
+}
+
+/**
+ * Update queue counters with the queue param info.
+ * @param j_param
+ */
+static void update_queue_stat_param(const json_t* j_param)
+{
+  json_t* j_stat;
+  const char* name;
+
+  name = json_string_value(json_object_get(j_param, "name"));
+  if(name == NULL) {
+    return;
+  }
+
+  j_stat = get_queue_stat(name);
+  json_object_set_new(j_stat, "service_level_perf", json_real(json_number_value(json_object_get(j_param, "service_level_perf"))));
+
+  return;
+}
+
+static void clear_queue_stats(void)
+{
+  json_decref(g_queue_stats);
+  g_queue_stats = NULL;
+
+  json_decref(g_queue_member_stats);
+  g_queue_member_stats = NULL;
+}
+
+/**
+ * Returns true if the given member device status is in use.
+ * @param status
+ * @return
+ */
+static bool is_member_inuse(int status)
+{
+  switch(status) {
+    case AST_DEVICE_INUSE:
+    case AST_DEVICE_BUSY:
+    case AST_DEVICE_RINGING:
+    case AST_DEVICE_RINGINUSE:
+    case AST_DEVICE_ONHOLD: {
+      return true;
+    }
+    break;
+
+    default: {
+      return false;
+    }
+    break;
+  }
+
+  return false;
+}
@@ -38,6 +38,10 @@ static json_t* get_detail_item_by_obj(db_ctx_t* ctx, const char* table, json_t*
 static json_t* get_detail_items_by_obj(db_ctx_t* ctx, const char* table, json_t* j_obj);
 static json_t* get_detail_items_by_obj_order(db_ctx_t* ctx, const char* table, json_t* j_obj, const char* order);
 static json_t* get_detail_items_by_condition(db_ctx_t* ctx, const char* table, const char* condition);
+static json_t* get_items_by_sql(db_ctx_t* ctx, const char* sql);
+static json_t* get_detail_items_key_strings(db_ctx_t* ctx, const char* table, const char* key, const json_t* j_vals);
+static json_t* get_items_page(db_ctx_t* ctx, const char* table, const char* where, const char* key, const char* cursor, int count);
+static bool add_column(db_ctx_t* ctx, const char* table, const char* column, const char* type);
 
 static bool init_db(void);
 static bool init_ast_database(void);
@@ -104,6 +108,10 @@ static bool init_db(void)
     return false;
   }
 
+  // allow the incremental vacuum.
+  // takes effect only for a new database or after the full vacuum.
+  db_ctx_exec(g_db_file, "pragma auto_vacuum = incremental;");
+
   slog(LOG_NOTICE, "Finished db_init.");
 
   return true;
@@ -671,6 +679,221 @@ static json_t* get_detail_items_by_condition(db_ctx_t* ctx, const char* table, c
   return j_res;
 }
 
+/**
+ * Return the records of given select sql.
+ * For the query which can not be expressed with table and condition. ex) join.
+ * @param ctx
+ * @param sql
+ * @return
+ */
+static json_t* get_items_by_sql(db_ctx_t* ctx, const char* sql)
+{
+  int ret;
+  json_t* j_res;
+  json_t* j_tmp;
+
+  if((ctx == NULL) || (sql == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired get_items_by_sql. sql[%s]", sql);
+
+  ret = db_ctx_query(ctx, sql);
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not get items info.");
+    return NULL;
+  }
+
+  j_res = json_array();
+  while(true) {
+    j_tmp = db_ctx_get_record(ctx);
+    if(j_tmp == NULL) {
+      break;
+    }
+    json_array_append_new(j_res, j_tmp);
+  }
+  db_ctx_free(ctx);
+
+  return j_res;
+}
+
+/**
+ * Return the records which has one of the given values.
+ * Gets all of the records in one query.
+ * @param ctx
+ * @param table
+ * @param key
+ * @param j_vals json array of strings.
+ * @return
+ */
+static json_t* get_detail_items_key_strings(db_ctx_t* ctx, const char* table, const char* key, const json_t* j_vals)
+{
+  json_t* j_res;
+  json_t* j_val;
+  char* condition;
+  char* tmp;
+  char* tmp_sqlite_buf;
+  int idx;
+
+  if((ctx == NULL) || (table == NULL) || (key == NULL) || (j_vals == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired get_detail_items_key_strings. table[%s], key[%s], count[%zu]", table, key, json_array_size(j_vals));
+
+  // nothing to find
+  if(json_array_size(j_vals) == 0) {
+    return json_array();
+  }
+
+  // create condition. where key in ('val1', 'val2', ...)
+  condition = NULL;
+  json_array_foreach(j_vals, idx, j_val) {
+    if(json_is_string(j_val) == false) {
+      continue;
+    }
+
+    tmp_sqlite_buf = sqlite3_mprintf("%Q", json_string_value(j_val));
+    if(condition == NULL) {
+      asprintf(&tmp, "where %s in (%s", key, tmp_sqlite_buf);
+    }
+    else {
+      asprintf(&tmp, "%s, %s", condition, tmp_sqlite_buf);
+    }
+    sqlite3_free(tmp_sqlite_buf);
+    sfree(condition);
+    condition = tmp;
+  }
+
+  if(condition == NULL) {
+    return json_array();
+  }
+
+  asprintf(&tmp, "%s)", condition);
+  sfree(condition);
+
+  j_res = get_detail_items_by_condition(ctx, table, tmp);
+  sfree(tmp);
+
+  return j_res;
+}
+
+/**
+ * Add the column to the existing table if it doesn't exist.
+ * For the database created by the old version.
+ * @param ctx
+ * @param table
+ * @param column
+ * @param type
+ * @return
+ */
+static bool add_column(db_ctx_t* ctx, const char* table, const char* column, const char* type)
+{
+  int ret;
+  int exist;
+  char* sql;
+  json_t* j_tmp;
+
+  if((ctx == NULL) || (table == NULL) || (column == NULL) || (type == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  ret = asprintf(&sql, "pragma table_info(%s);", table);
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not create sql. table[%s]", table);
+    return false;
+  }
+
+  ret = db_ctx_query(ctx, sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not get table info. table[%s]", table);
+    return false;
+  }
+
+  exist = false;
+  while(1) {
+    j_tmp = db_ctx_get_record(ctx);
+    if(j_tmp == NULL) {
+      break;
+    }
+
+    if(strcmp(json_string_value(json_object_get(j_tmp, "name"))? : "", column) == 0) {
+      exist = true;
+    }
+    json_decref(j_tmp);
+  }
+  db_ctx_free(ctx);
+
+  if(exist == true) {
+    return true;
+  }
+
+  slog(LOG_NOTICE, "Add column to the table. table[%s], column[%s], type[%s]", table, column, type);
+  ret = asprintf(&sql, "alter table %s add column %s %s;", table, column, type);
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not create sql. table[%s]", table);
+    return false;
+  }
+
+  ret = db_ctx_exec(ctx, sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not add the column. table[%s], column[%s]", table, column);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Return the records of the page. Keyset pagination.
+ * "select * from <table> where (<where>) and <key> > <cursor> order by <key> limit <count>;"
+ * @param ctx
+ * @param table
+ * @param where: additional condition of the items. NULL for all items.
+ * @param key: unique key column.
+ * @param cursor: key of the last item of the previous page. NULL for the first page.
+ * @param count
+ * @return
+ */
+static json_t* get_items_page(db_ctx_t* ctx, const char* table, const char* where, const char* key, const char* cursor, int count)
+{
+  json_t* j_res;
+  char* tmp_sqlite_buf;
+  char* condition;
+
+  if((ctx == NULL) || (table == NULL) || (key == NULL) || (count <= 0)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired get_items_page. table[%s], key[%s], count[%d]", table, key, count);
+
+  if((cursor == NULL) && (where == NULL)) {
+    asprintf(&condition, "order by %s limit %d", key, count);
+  }
+  else if(cursor == NULL) {
+    asprintf(&condition, "where (%s) order by %s limit %d", where, key, count);
+  }
+  else if(where == NULL) {
+    tmp_sqlite_buf = sqlite3_mprintf("%Q", cursor);
+    asprintf(&condition, "where %s > %s order by %s limit %d", key, tmp_sqlite_buf, key, count);
+    sqlite3_free(tmp_sqlite_buf);
+  }
+  else {
+    // the where is wrapped not to be combined with the keyset condition.
+    tmp_sqlite_buf = sqlite3_mprintf("%Q", cursor);
+    asprintf(&condition, "where (%s) and %s > %s order by %s limit %d", where, key, tmp_sqlite_buf, key, count);
+    sqlite3_free(tmp_sqlite_buf);
+  }
+
+  j_res = get_detail_items_by_condition(ctx, table, condition);
+  sfree(condition);
+
+  return j_res;
+}
+
 bool resource_exec_mem_sql(const char* sql)
 {
   int ret;
@@ -802,6 +1025,28 @@ json_t* resource_get_mem_items(const char* table, const char* item)
   return j_res;
 }
 
+/**
+ * Get the page of the items ordered by the key.
+ * @param table
+ * @param key: unique key column.
+ * @param cursor: key of the last item of the previous page. NULL for the first page.
+ * @param count
+ * @return
+ */
+json_t* resource_get_mem_items_page(const char* table, const char* key, const char* cursor, int count)
+{
+  json_t* j_res;
+
+  if((table == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_items_page(g_db_memory, table, NULL, key, cursor, count);
+
+  return j_res;
+}
+
 json_t* resource_get_mem_detail_items_by_condtion(const char* table, const char* condition)
 {
   json_t* j_res;
@@ -892,6 +1137,30 @@ json_t* resource_get_mem_detail_items_key_string(const char* table, const char*
   return j_res;
 }
 
+/**
+ * Return the records of memory database which has one of the given values.
+ * @param table
+ * @param key
+ * @param j_vals
+ * @return
+ */
+json_t* resource_get_mem_detail_items_key_strings(const char* table, const char* key, const json_t* j_vals)
+{
+  json_t* j_res;
+
+  if((table == NULL) || (key == NULL) || (j_vals == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_detail_items_key_strings(g_db_memory, table, key, j_vals);
+  if(j_res == NULL) {
+    return NULL;
+  }
+
+  return j_res;
+}
+
 bool resource_exec_file_sql(const char* sql)
 {
   int ret;
@@ -910,6 +1179,30 @@ bool resource_exec_file_sql(const char* sql)
   return true;
 }
 
+/**
+ * Execute the given sql to the file database
+ * and returns the count of changed rows.
+ * @param sql
+ * @return -1 if failed.
+ */
+int resource_exec_file_sql_changes(const char* sql)
+{
+  int ret;
+
+  if(sql == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return -1;
+  }
+
+  ret = db_ctx_exec(g_db_file, sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not execute sql for jade database.");
+    return -1;
+  }
+
+  return db_ctx_get_changes(g_db_file);
+}
+
 /**
  *
  * @param table
@@ -1049,6 +1342,28 @@ json_t* resource_get_file_items(const char* table, const char* item)
   return j_res;
 }
 
+/**
+ * Get the page of the file database's items ordered by the key.
+ * @param table
+ * @param key: unique key column.
+ * @param cursor: key of the last item of the previous page. NULL for the first page.
+ * @param count
+ * @return
+ */
+json_t* resource_get_file_items_page(const char* table, const char* key, const char* cursor, int count)
+{
+  json_t* j_res;
+
+  if((table == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_items_page(g_db_file, table, NULL, key, cursor, count);
+
+  return j_res;
+}
+
 /**
  * Get detail info of key="val" from table. get only 1 item.
  * "select * from <table> where <key>=<val>;"
@@ -1168,6 +1483,118 @@ json_t* resource_get_file_detail_items_by_condtion(const char* table, const char
   return j_res;
 }
 
+/**
+ * Return the records of file database which has one of the given values.
+ * @param table
+ * @param key
+ * @param j_vals
+ * @return
+ */
+json_t* resource_get_file_detail_items_key_strings(const char* table, const char* key, const json_t* j_vals)
+{
+  json_t* j_res;
+
+  if((table == NULL) || (key == NULL) || (j_vals == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_detail_items_key_strings(g_db_file, table, key, j_vals);
+  if(j_res == NULL) {
+    return NULL;
+  }
+
+  return j_res;
+}
+
+/**
+ * Return the records of given select sql.
+ * @param sql
+ * @return
+ */
+json_t* resource_get_file_items_by_sql(const char* sql)
+{
+  json_t* j_res;
+
+  if(sql == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_items_by_sql(g_db_file, sql);
+  if(j_res == NULL) {
+    return NULL;
+  }
+
+  return j_res;
+}
+
+/**
+ * Add the column to the given database's table if it doesn't exist.
+ * @param ctx
+ * @param table
+ * @param column
+ * @param type
+ * @return
+ */
+bool resource_add_db_column(db_ctx_t* ctx, const char* table, const char* column, const char* type)
+{
+  return add_column(ctx, table, column, type);
+}
+
+/**
+ * Get the page of the given database's items ordered by the key.
+ * @param ctx
+ * @param table
+ * @param where: additional condition of the items. NULL for all items.
+ * @param key: unique key column.
+ * @param cursor: key of the last item of the previous page. NULL for the first page.
+ * @param count
+ * @return
+ */
+json_t* resource_get_db_items_page(db_ctx_t* ctx, const char* table, const char* where, const char* key, const char* cursor, int count)
+{
+  json_t* j_res;
+
+  if((ctx == NULL) || (table == NULL) || (key == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = get_items_page(ctx, table, where, key, cursor, count);
+
+  return j_res;
+}
+
+/**
+ * Add the column to the file database's table if it doesn't exist.
+ * @param table
+ * @param column
+ * @param type
+ * @return
+ */
+bool resource_add_file_column(const char* table, const char* column, const char* type)
+{
+  return add_column(g_db_file, table, column, type);
+}
+
+/**
+ * Return the resource statistics.
+ * The query counts are accumulated from the start.
+ * @return
+ */
+json_t* resource_get_stats(void)
+{
+  json_t* j_res;
+
+  j_res = json_pack("{s:I, s:I}",
+      "memory_query_count",   (json_int_t)g_db_memory->query_count,
+      "file_query_count",     (json_int_t)g_db_file->query_count
+      );
+
+  return j_res;
+}
+
 /**
  * Return the sorted json array of given data.
  * @param j_data
@@ -1714,6 +2141,20 @@ json_t* get_agent_agents_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of agents ordered by id.
+ * @param cursor: id of the last agent of the previous page.
+ * @param count
+ * @return
+ */
+json_t* get_agent_agents_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page("agent", "id", cursor, count);
+  return j_res;
+}
+
 
 /**
  * Get corresponding agent detail info.
@@ -1852,6 +2293,20 @@ json_t* get_voicemail_users_all()
   return j_res;
 }
 
+/**
+ * Returns the page of voicemail users ordered by id.
+ * @param cursor: id of the last voicemail user of the previous page.
+ * @param count
+ * @return
+ */
+json_t* get_voicemail_users_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page("voicemail_user", "id", cursor, count);
+  return j_res;
+}
+
 /**
  * Create agent agent info.
  * @param j_data
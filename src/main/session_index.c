@@ -0,0 +1,551 @@
+/*
+ * session_index.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bsd_queue.h"
+#include "bsd_tree.h"
+
+#include "session_index.h"
+
+struct idx_member;
+
+/**
+ * Indexed session.
+ */
+struct idx_session {
+  RB_ENTRY(idx_session) linkage;
+  LIST_ENTRY(idx_session) user_link;    ///< link of idx_user
+
+  void* session;              ///< caller's session
+  struct idx_user* user;      ///< owner user. NULL if not set.
+  LIST_HEAD(idx_session_member_head, idx_member) members;   ///< joined groups
+};
+
+/**
+ * Connected sessions of the user.
+ */
+struct idx_user {
+  RB_ENTRY(idx_user) linkage;
+
+  char* uuid;   ///< user uuid
+  LIST_HEAD(idx_user_session_head, idx_session) sessions;
+};
+
+/**
+ * Member sessions of the group.
+ */
+struct idx_group {
+  RB_ENTRY(idx_group) linkage;
+
+  char* name;   ///< group name
+  LIST_HEAD(idx_group_member_head, idx_member) members;
+};
+
+/**
+ * Membership of the session and the group.
+ */
+struct idx_member {
+  LIST_ENTRY(idx_member) group_link;    ///< link of idx_group
+  LIST_ENTRY(idx_member) session_link;  ///< link of idx_session
+
+  struct idx_session* session;
+  struct idx_group* group;
+};
+
+static int compare_idx_session(struct idx_session* e1, struct idx_session* e2);
+static int compare_idx_user(struct idx_user* e1, struct idx_user* e2);
+static int compare_idx_group(struct idx_group* e1, struct idx_group* e2);
+static void remove_empty_group(session_index* idx, struct idx_group* group);
+
+RB_HEAD(idx_session_entries, idx_session);
+RB_PROTOTYPE(idx_session_entries, idx_session, linkage, compare_idx_session);
+RB_GENERATE(idx_session_entries, idx_session, linkage, compare_idx_session);
+
+RB_HEAD(idx_user_entries, idx_user);
+RB_PROTOTYPE(idx_user_entries, idx_user, linkage, compare_idx_user);
+RB_GENERATE(idx_user_entries, idx_user, linkage, compare_idx_user);
+
+RB_HEAD(idx_group_entries, idx_group);
+RB_PROTOTYPE(idx_group_entries, idx_group, linkage, compare_idx_group);
+RB_GENERATE(idx_group_entries, idx_group, linkage, compare_idx_group);
+
+struct _session_index {
+  struct idx_session_entries sessions;
+  struct idx_user_entries users;
+  struct idx_group_entries groups;
+
+  int user_count;
+  int group_count;
+};
+
+static int compare_idx_session(struct idx_session* e1, struct idx_session* e2)
+{
+  if((uintptr_t)e1->session < (uintptr_t)e2->session) {
+    return -1;
+  }
+  if((uintptr_t)e1->session > (uintptr_t)e2->session) {
+    return 1;
+  }
+  return 0;
+}
+
+static int compare_idx_user(struct idx_user* e1, struct idx_user* e2)
+{
+  return strcmp(e1->uuid, e2->uuid);
+}
+
+static int compare_idx_group(struct idx_group* e1, struct idx_group* e2)
+{
+  return strcmp(e1->name, e2->name);
+}
+
+static struct idx_session* find_session(const session_index* idx, const void* session)
+{
+  struct idx_session find;
+
+  find.session = (void*)session;
+  return RB_FIND(idx_session_entries, (struct idx_session_entries*)&idx->sessions, &find);
+}
+
+static struct idx_user* find_user(const session_index* idx, const char* uuid_user)
+{
+  struct idx_user find;
+
+  find.uuid = (char*)uuid_user;
+  return RB_FIND(idx_user_entries, (struct idx_user_entries*)&idx->users, &find);
+}
+
+static struct idx_group* find_group(const session_index* idx, const char* name)
+{
+  struct idx_group find;
+
+  find.name = (char*)name;
+  return RB_FIND(idx_group_entries, (struct idx_group_entries*)&idx->groups, &find);
+}
+
+/**
+ * Returns the indexed session. Creates it if not exist.
+ */
+static struct idx_session* get_session(session_index* idx, void* session)
+{
+  struct idx_session* entry;
+
+  entry = find_session(idx, session);
+  if(entry != NULL) {
+    return entry;
+  }
+
+  entry = calloc(1, sizeof(struct idx_session));
+  if(entry == NULL) {
+    return NULL;
+  }
+  entry->session = session;
+  entry->user = NULL;
+  LIST_INIT(&entry->members);
+  RB_INSERT(idx_session_entries, &idx->sessions, entry);
+
+  return entry;
+}
+
+static void unset_user(session_index* idx, struct idx_session* entry)
+{
+  struct idx_user* user;
+
+  user = entry->user;
+  if(user == NULL) {
+    return;
+  }
+
+  LIST_REMOVE(entry, user_link);
+  entry->user = NULL;
+
+  if(LIST_EMPTY(&user->sessions)) {
+    RB_REMOVE(idx_user_entries, &idx->users, user);
+    idx->user_count--;
+    free(user->uuid);
+    free(user);
+  }
+}
+
+static bool join_group(session_index* idx, struct idx_session* entry, const char* name)
+{
+  struct idx_group* group;
+  struct idx_member* member;
+
+  LIST_FOREACH(member, &entry->members, session_link) {
+    if(strcmp(member->group->name, name) == 0) {
+      return true;
+    }
+  }
+
+  group = find_group(idx, name);
+  if(group == NULL) {
+    group = calloc(1, sizeof(struct idx_group));
+    if(group == NULL) {
+      return false;
+    }
+    group->name = strdup(name);
+    if(group->name == NULL) {
+      free(group);
+      return false;
+    }
+    LIST_INIT(&group->members);
+    RB_INSERT(idx_group_entries, &idx->groups, group);
+    idx->group_count++;
+  }
+
+  member = calloc(1, sizeof(struct idx_member));
+  if(member == NULL) {
+    remove_empty_group(idx, group);
+    return false;
+  }
+  member->session = entry;
+  member->group = group;
+  LIST_INSERT_HEAD(&group->members, member, group_link);
+  LIST_INSERT_HEAD(&entry->members, member, session_link);
+
+  return true;
+}
+
+/**
+ * Remove the membership.
+ * The group is removed together if it has no more member.
+ */
+static void remove_member(session_index* idx, struct idx_member* member)
+{
+  struct idx_group* group;
+
+  group = member->group;
+  LIST_REMOVE(member, group_link);
+  LIST_REMOVE(member, session_link);
+  free(member);
+
+  remove_empty_group(idx, group);
+}
+
+/**
+ * Remove the group if it has no member.
+ */
+static void remove_empty_group(session_index* idx, struct idx_group* group)
+{
+  if(!LIST_EMPTY(&group->members)) {
+    return;
+  }
+
+  RB_REMOVE(idx_group_entries, &idx->groups, group);
+  idx->group_count--;
+  free(group->name);
+  free(group);
+}
+
+static void leave_group(session_index* idx, struct idx_session* entry, const char* name)
+{
+  struct idx_member* member;
+
+  LIST_FOREACH(member, &entry->members, session_link) {
+    if(strcmp(member->group->name, name) == 0) {
+      remove_member(idx, member);
+      return;
+    }
+  }
+}
+
+static void remove_session(session_index* idx, struct idx_session* entry)
+{
+  while(LIST_FIRST(&entry->members) != NULL) {
+    remove_member(idx, LIST_FIRST(&entry->members));
+  }
+  unset_user(idx, entry);
+
+  RB_REMOVE(idx_session_entries, &idx->sessions, entry);
+  free(entry);
+}
+
+session_index* session_index_create(void)
+{
+  session_index* idx;
+
+  idx = calloc(1, sizeof(session_index));
+  if(idx == NULL) {
+    return NULL;
+  }
+  RB_INIT(&idx->sessions);
+  RB_INIT(&idx->users);
+  RB_INIT(&idx->groups);
+
+  return idx;
+}
+
+void session_index_destroy(session_index* idx)
+{
+  if(idx == NULL) {
+    return;
+  }
+
+  while(RB_ROOT(&idx->sessions) != NULL) {
+    remove_session(idx, RB_ROOT(&idx->sessions));
+  }
+  free(idx);
+}
+
+/**
+ * Set the owner user of the session.
+ * The session is moved if it has the other user already.
+ * @param idx
+ * @param session
+ * @param uuid_user
+ * @return
+ */
+bool session_index_set_user(session_index* idx, void* session, const char* uuid_user)
+{
+  struct idx_session* entry;
+  struct idx_user* user;
+
+  if((idx == NULL) || (session == NULL) || (uuid_user == NULL)) {
+    return false;
+  }
+
+  entry = get_session(idx, session);
+  if(entry == NULL) {
+    return false;
+  }
+
+  if((entry->user != NULL) && (strcmp(entry->user->uuid, uuid_user) == 0)) {
+    return true;
+  }
+  unset_user(idx, entry);
+
+  user = find_user(idx, uuid_user);
+  if(user == NULL) {
+    user = calloc(1, sizeof(struct idx_user));
+    if(user == NULL) {
+      return false;
+    }
+    user->uuid = strdup(uuid_user);
+    if(user->uuid == NULL) {
+      free(user);
+      return false;
+    }
+    LIST_INIT(&user->sessions);
+    RB_INSERT(idx_user_entries, &idx->users, user);
+    idx->user_count++;
+  }
+
+  LIST_INSERT_HEAD(&user->sessions, entry, user_link);
+  entry->user = user;
+
+  return true;
+}
+
+/**
+ * Remove the session from its user and all of its groups.
+ * @param idx
+ * @param session
+ */
+void session_index_remove_session(session_index* idx, void* session)
+{
+  struct idx_session* entry;
+
+  if((idx == NULL) || (session == NULL)) {
+    return;
+  }
+
+  entry = find_session(idx, session);
+  if(entry == NULL) {
+    return;
+  }
+
+  remove_session(idx, entry);
+}
+
+/**
+ * Join the session to the group.
+ * Does nothing if the session is already a member.
+ * @param idx
+ * @param session
+ * @param group
+ * @return
+ */
+bool session_index_join_group(session_index* idx, void* session, const char* group)
+{
+  struct idx_session* entry;
+
+  if((idx == NULL) || (session == NULL) || (group == NULL)) {
+    return false;
+  }
+
+  entry = get_session(idx, session);
+  if(entry == NULL) {
+    return false;
+  }
+
+  return join_group(idx, entry, group);
+}
+
+/**
+ * Leave the session from the group.
+ * @param idx
+ * @param session
+ * @param group
+ */
+void session_index_leave_group(session_index* idx, void* session, const char* group)
+{
+  struct idx_session* entry;
+
+  if((idx == NULL) || (session == NULL) || (group == NULL)) {
+    return;
+  }
+
+  entry = find_session(idx, session);
+  if(entry == NULL) {
+    return;
+  }
+
+  leave_group(idx, entry, group);
+}
+
+/**
+ * Join all the sessions of the user to the group.
+ * @param idx
+ * @param uuid_user
+ * @param group
+ * @return count of the joined sessions. -1 if failed.
+ */
+int session_index_join_group_user(session_index* idx, const char* uuid_user, const char* group)
+{
+  struct idx_user* user;
+  struct idx_session* entry;
+  int count;
+
+  if((idx == NULL) || (uuid_user == NULL) || (group == NULL)) {
+    return -1;
+  }
+
+  user = find_user(idx, uuid_user);
+  if(user == NULL) {
+    return 0;
+  }
+
+  count = 0;
+  LIST_FOREACH(entry, &user->sessions, user_link) {
+    if(join_group(idx, entry, group) == false) {
+      return -1;
+    }
+    count++;
+  }
+
+  return count;
+}
+
+/**
+ * Leave all the sessions of the user from the group.
+ * @param idx
+ * @param uuid_user
+ * @param group
+ * @return count of the user's sessions. -1 if failed.
+ */
+int session_index_leave_group_user(session_index* idx, const char* uuid_user, const char* group)
+{
+  struct idx_user* user;
+  struct idx_session* entry;
+  int count;
+
+  if((idx == NULL) || (uuid_user == NULL) || (group == NULL)) {
+    return -1;
+  }
+
+  user = find_user(idx, uuid_user);
+  if(user == NULL) {
+    return 0;
+  }
+
+  count = 0;
+  LIST_FOREACH(entry, &user->sessions, user_link) {
+    leave_group(idx, entry, group);
+    count++;
+  }
+
+  return count;
+}
+
+/**
+ * Call the given callback for each member session of the group.
+ * The callback should not change the index.
+ * @param idx
+ * @param group
+ * @param cb
+ * @param data
+ * @return count of the member sessions. -1 if failed.
+ */
+int session_index_foreach_group(const session_index* idx, const char* group, session_index_cb cb, void* data)
+{
+  struct idx_group* entry;
+  struct idx_member* member;
+  int count;
+
+  if((idx == NULL) || (group == NULL) || (cb == NULL)) {
+    return -1;
+  }
+
+  entry = find_group(idx, group);
+  if(entry == NULL) {
+    return 0;
+  }
+
+  count = 0;
+  LIST_FOREACH(member, &entry->members, group_link) {
+    cb(member->session->session, data);
+    count++;
+  }
+
+  return count;
+}
+
+bool session_index_is_member(const session_index* idx, const void* session, const char* group)
+{
+  struct idx_session* entry;
+  struct idx_member* member;
+
+  if((idx == NULL) || (session == NULL) || (group == NULL)) {
+    return false;
+  }
+
+  entry = find_session(idx, session);
+  if(entry == NULL) {
+    return false;
+  }
+
+  LIST_FOREACH(member, &entry->members, session_link) {
+    if(strcmp(member->group->name, group) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int session_index_get_user_count(const session_index* idx)
+{
+  if(idx == NULL) {
+    return 0;
+  }
+  return idx->user_count;
+}
+
+int session_index_get_group_count(const session_index* idx)
+{
+  if(idx == NULL) {
+    return 0;
+  }
+  return idx->group_count;
+}
@@ -21,6 +21,7 @@
 
 static bool subscribe_topic(void* zmq_sock, const char* topic);
 static bool unsubscribe_topic(void* zmq_sock, const char* topic);
+static bool join_groups_client(const char* authtoken, const json_t* j_user);
 
 
 bool subscription_init_handler(void)
@@ -123,12 +124,72 @@ bool subscription_subscribe_topics_client(const char* authtoken, void* zmq_sock)
     }
   }
   json_decref(j_topics);
+
+  // join groups
+  if(strcmp(type, "me") == 0) {
+    ret = join_groups_client(authtoken, j_user);
+    if(ret == false) {
+      slog(LOG_NOTICE, "Could not join the client groups.");
+    }
+  }
   json_decref(j_user);
   json_decref(j_authtoken);
 
   return true;
 }
 
+/**
+ * Set the session user and join all the groups of the given user.
+ * @param authtoken
+ * @param j_user
+ * @return
+ */
+static bool join_groups_client(const char* authtoken, const json_t* j_user)
+{
+  json_t* j_groups;
+  json_t* j_group;
+  const char* uuid_user;
+  const char* group;
+  int idx;
+  int ret;
+
+  if((authtoken == NULL) || (j_user == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  uuid_user = json_string_value(json_object_get(j_user, "uuid"));
+  if(uuid_user == NULL) {
+    slog(LOG_NOTICE, "Could not get user uuid info.");
+    return false;
+  }
+
+  ret = websocket_set_session_user(authtoken, uuid_user);
+  if(ret == false) {
+    slog(LOG_NOTICE, "Could not set the session user.");
+    return false;
+  }
+
+  j_groups = me_get_joinable_groups_all(j_user);
+  if(j_groups == NULL) {
+    slog(LOG_NOTICE, "Could not get joinable groups.");
+    return false;
+  }
+
+  json_array_foreach(j_groups, idx, j_group) {
+    group = json_string_value(j_group);
+
+    ret = websocket_join_group(authtoken, group);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not join the group. group[%s]", group);
+      continue;
+    }
+  }
+  json_decref(j_groups);
+
+  return true;
+}
+
 static bool subscribe_topic(void* zmq_sock, const char* topic)
 {
   int ret;
@@ -219,3 +280,34 @@ bool subscription_unsubscribe_topic(const char* authtoken, const char* topic)
   return true;
 }
 
+/**
+ * Join all the connected sessions of the given user to the group.
+ * @param uuid_user
+ * @param group
+ * @return
+ */
+bool subscription_join_group_user(const char* uuid_user, const char* group)
+{
+  if((uuid_user == NULL) || (group == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  return websocket_join_group_user(uuid_user, group);
+}
+
+/**
+ * Leave all the connected sessions of the given user from the group.
+ * @param uuid_user
+ * @param group
+ * @return
+ */
+bool subscription_leave_group_user(const char* uuid_user, const char* group)
+{
+  if((uuid_user == NULL) || (group == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  return websocket_leave_group_user(uuid_user, group);
+}
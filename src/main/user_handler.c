@@ -37,6 +37,7 @@ static struct event* g_ev_validate_authtoken = NULL;
 static struct st_callback* g_callback_db_userinfo;
 static struct st_callback* g_callback_db_permission;
 static struct st_callback* g_callback_db_buddy;
+static struct st_callback* g_callback_db_contact;
 
 static bool init_databases(void);
 static bool init_database_contact(void);
@@ -51,6 +52,7 @@ static bool term_callback(void);
 static void execute_callbacks_db_userinfo(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static void execute_callbacks_db_permission(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static void execute_callbacks_db_buddy(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
+static void execute_callbacks_db_contact(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 
 static bool db_create_buddy_info(const json_t* j_data);
 static json_t* db_get_buddies_info_by_owneruuid(const char* uuid_user);
@@ -897,6 +899,27 @@ json_t* user_get_userinfo_info(const char* key)
   return j_res;
 }
 
+/**
+ * Get list of user_userinfo detail info of given uuids.
+ * Gets all of the given users in one query.
+ * @param j_uuids json array of user uuids.
+ * @return
+ */
+json_t* user_get_userinfos_info_by_uuids(const json_t* j_uuids)
+{
+  json_t* j_res;
+
+  if(j_uuids == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired user_get_userinfos_info_by_uuids.");
+
+  j_res = resource_get_file_detail_items_key_strings(DEF_DB_TABLE_USER_USERINFO, "uuid", j_uuids);
+
+  return j_res;
+}
+
 /**
  * Get all user_userinfo detail info.
  * @return
@@ -912,6 +935,20 @@ json_t* user_get_userinfos_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of userinfos ordered by uuid.
+ * @param cursor: uuid of the last userinfo of the previous page.
+ * @param count
+ * @return
+ */
+json_t* user_get_userinfos_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_file_items_page(DEF_DB_TABLE_USER_USERINFO, "uuid", cursor, count);
+  return j_res;
+}
+
 
 /**
  * Get corresponding user_userinfo detail info.
@@ -1430,6 +1467,8 @@ static bool db_delete_permission_info(const char* key)
 static bool db_create_contact_info(const json_t* j_data)
 {
   int ret;
+  const char* uuid;
+  json_t* j_tmp;
 
   if(j_data == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1444,6 +1483,18 @@ static bool db_create_contact_info(const json_t* j_data)
     return false;
   }
 
+  // get created info
+  uuid = json_string_value(json_object_get(j_data, "uuid"));
+  j_tmp = user_get_contact_info(uuid);
+  if(j_tmp == NULL) {
+    slog(LOG_ERR, "Could not get created contact info.");
+    return false;
+  }
+
+  // execute registered callbacks
+  execute_callbacks_db_contact(EN_RESOURCE_CREATE, j_tmp);
+  json_decref(j_tmp);
+
   return true;
 }
 
@@ -1656,6 +1707,20 @@ json_t* user_get_permissions_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of permissions ordered by uuid.
+ * @param cursor: uuid of the last permission of the previous page.
+ * @param count
+ * @return
+ */
+json_t* user_get_permissions_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_file_items_page(DEF_DB_TABLE_USER_PERMISSION, "uuid", cursor, count);
+  return j_res;
+}
+
 json_t* user_get_permission_info(const char* key)
 {
   json_t* j_res;
@@ -1815,6 +1880,20 @@ json_t* user_get_contacts_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of contacts ordered by uuid.
+ * @param cursor: uuid of the last contact of the previous page.
+ * @param count
+ * @return
+ */
+json_t* user_get_contacts_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_file_items_page(DEF_DB_TABLE_USER_CONTACT, "uuid", cursor, count);
+  return j_res;
+}
+
 /**
  * Returns conntact info array of given user_uuid.
  * @param user_uuid
@@ -1909,6 +1988,8 @@ bool user_delete_contact_info(const char* key)
 static bool db_update_contact_info(const json_t* j_data)
 {
   int ret;
+  const char* uuid;
+  json_t* j_tmp;
 
   if(j_data == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1923,6 +2004,18 @@ static bool db_update_contact_info(const json_t* j_data)
     return false;
   }
 
+  // get updated info
+  uuid = json_string_value(json_object_get(j_data, "uuid"));
+  j_tmp = user_get_contact_info(uuid);
+  if(j_tmp == NULL) {
+    slog(LOG_ERR, "Could not get updated contact info.");
+    return false;
+  }
+
+  // execute registered callbacks
+  execute_callbacks_db_contact(EN_RESOURCE_UPDATE, j_tmp);
+  json_decref(j_tmp);
+
   return true;
 }
 
@@ -1956,6 +2049,7 @@ static bool delete_contact(const char* uuid)
 static bool db_delete_contact_info(const char* key)
 {
   int ret;
+  json_t* j_tmp;
 
   if(key == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1963,12 +2057,24 @@ static bool db_delete_contact_info(const char* key)
   }
   slog(LOG_DEBUG, "Fired delete_user_contact_info. key[%s]", key);
 
+  // get delete info
+  j_tmp = user_get_contact_info(key);
+  if(j_tmp == NULL) {
+    slog(LOG_NOTICE, "Could not get delete contact info. key[%s]", key);
+    return false;
+  }
+
   ret = resource_delete_file_items_string(DEF_DB_TABLE_USER_CONTACT, "uuid", key);
   if(ret == false) {
     slog(LOG_WARNING, "Could not delete user_contact info. key[%s]", key);
+    json_decref(j_tmp);
     return false;
   }
 
+  // execute registered callbacks
+  execute_callbacks_db_contact(EN_RESOURCE_DELETE, j_tmp);
+  json_decref(j_tmp);
+
   return true;
 }
 
@@ -2261,6 +2367,9 @@ static bool init_callback(void)
   // buddy
   g_callback_db_buddy = utils_create_callback();
 
+  // contact
+  g_callback_db_contact = utils_create_callback();
+
   return true;
 }
 
@@ -2269,6 +2378,7 @@ static bool term_callback(void)
   utils_terminate_callback(g_callback_db_userinfo);
   utils_terminate_callback(g_callback_db_buddy);
   utils_terminate_callback(g_callback_db_permission);
+  utils_terminate_callback(g_callback_db_contact);
 
   return true;
 }
@@ -2339,6 +2449,28 @@ bool user_reigster_callback_db_buddy(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES,
   return true;
 }
 
+/**
+ * Register the callback for contact
+ */
+bool user_register_callback_db_contact(bool (*func)(enum EN_RESOURCE_UPDATE_TYPES, const json_t*))
+{
+  int ret;
+
+  if(func == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired user_register_callback_db_contact.");
+
+  ret = utils_register_callback(g_callback_db_contact, func);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not register callback for contact.");
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * Execute the registered callbacks for userinfo
  * @param j_data
@@ -2390,3 +2522,19 @@ static void execute_callbacks_db_buddy(enum EN_RESOURCE_UPDATE_TYPES type, const
   return;
 }
 
+/**
+ * Execute the registered callbacks for contact
+ * @param j_data
+ */
+static void execute_callbacks_db_contact(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data)
+{
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired execute_callbacks_contact.");
+
+  utils_execute_callbacks(g_callback_db_contact, type, j_data);
+
+  return;
+}
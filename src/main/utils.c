@@ -15,6 +15,11 @@
 #include <ctype.h>
 #include <jansson.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
 
 #include "utils.h"
 #include "slog.h"
@@ -517,6 +522,200 @@ bool utils_create_empty_file(const char* filename)
   return true;
 }
 
+/**
+ * Copy the given file to the target in the process.
+ * Uses the reflink or the copy_file_range() if the filesystem supports it.
+ * Fails if the target is already exist.
+ * @param src
+ * @param dst
+ * @return
+ */
+bool utils_copy_file(const char* src, const char* dst)
+{
+  struct stat sb;
+  char buf[65536];
+  ssize_t ret;
+  ssize_t len;
+  ssize_t pos;
+  int fd_src;
+  int fd_dst;
+
+  if((src == NULL) || (dst == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  fd_src = open(src, O_RDONLY | O_CLOEXEC);
+  if(fd_src < 0) {
+    slog(LOG_ERR, "Could not open file. filename[%s], err[%d:%s]", src, errno, strerror(errno));
+    return false;
+  }
+
+  ret = fstat(fd_src, &sb);
+  if(ret != 0) {
+    slog(LOG_ERR, "Could not get file info. filename[%s], err[%d:%s]", src, errno, strerror(errno));
+    close(fd_src);
+    return false;
+  }
+
+  fd_dst = open(dst, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, sb.st_mode & 0777);
+  if(fd_dst < 0) {
+    slog(LOG_ERR, "Could not create file. filename[%s], err[%d:%s]", dst, errno, strerror(errno));
+    close(fd_src);
+    return false;
+  }
+
+#ifdef FICLONE
+  // shares the blocks. btrfs, xfs.
+  ret = ioctl(fd_dst, FICLONE, fd_src);
+  if(ret == 0) {
+    close(fd_src);
+    close(fd_dst);
+    return true;
+  }
+#endif
+
+  // copies in the kernel. continues from the file offsets if it's not supported.
+  while(1) {
+    ret = copy_file_range(fd_src, NULL, fd_dst, NULL, 1 << 30, 0);
+    if(ret <= 0) {
+      break;
+    }
+  }
+
+  while(ret != 0) {
+    ret = read(fd_src, buf, sizeof(buf));
+    if((ret < 0) && (errno == EINTR)) {
+      continue;
+    }
+    if(ret <= 0) {
+      break;
+    }
+
+    len = ret;
+    for(pos = 0; pos < len; pos += ret) {
+      ret = write(fd_dst, buf + pos, len - pos);
+      if(ret < 0) {
+        break;
+      }
+    }
+    if(ret < 0) {
+      break;
+    }
+  }
+  close(fd_src);
+  close(fd_dst);
+
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not copy file. src[%s], dst[%s], err[%d:%s]", src, dst, errno, strerror(errno));
+    unlink(dst);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Return true if the given files have the same content.
+ * @param filename1
+ * @param filename2
+ * @return
+ */
+bool utils_is_file_same(const char* filename1, const char* filename2)
+{
+  struct stat sb1;
+  struct stat sb2;
+  char buf1[65536];
+  char buf2[65536];
+  FILE* fp1;
+  FILE* fp2;
+  size_t len1;
+  size_t len2;
+  bool res;
+
+  if((filename1 == NULL) || (filename2 == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  if((stat(filename1, &sb1) != 0) || (stat(filename2, &sb2) != 0) || (sb1.st_size != sb2.st_size)) {
+    return false;
+  }
+
+  fp1 = fopen(filename1, "r");
+  fp2 = fopen(filename2, "r");
+  if((fp1 == NULL) || (fp2 == NULL)) {
+    if(fp1 != NULL) {
+      fclose(fp1);
+    }
+    if(fp2 != NULL) {
+      fclose(fp2);
+    }
+    return false;
+  }
+
+  res = true;
+  while(1) {
+    len1 = fread(buf1, 1, sizeof(buf1), fp1);
+    len2 = fread(buf2, 1, sizeof(buf2), fp2);
+    if((len1 != len2) || (memcmp(buf1, buf2, len1) != 0)) {
+      res = false;
+      break;
+    }
+
+    if(len1 == 0) {
+      break;
+    }
+  }
+  fclose(fp1);
+  fclose(fp2);
+
+  return res;
+}
+
+/**
+ * Returns true if any of the given data is different with the old one.
+ * The tm_update is not compared.
+ * @param j_old
+ * @param j_data
+ * @return
+ */
+bool utils_is_item_changed(const json_t* j_old, const json_t* j_data)
+{
+  const char* key;
+  json_t* j_val;
+  json_t* j_tmp;
+  char* tmp1;
+  char* tmp2;
+  int ret;
+
+  json_object_foreach((json_t*)j_data, key, j_val) {
+    if(strcmp(key, "tm_update") == 0) {
+      continue;
+    }
+
+    j_tmp = json_object_get(j_old, key);
+    if(json_equal(j_tmp, j_val) == 1) {
+      continue;
+    }
+
+    // the column affinity could change the type. "10" and 10.
+    if((j_tmp == NULL) || (json_is_array(j_tmp) == true) || (json_is_object(j_tmp) == true)) {
+      return true;
+    }
+    tmp1 = json_is_string(j_tmp)? strdup(json_string_value(j_tmp)) : json_dumps(j_tmp, JSON_ENCODE_ANY);
+    tmp2 = json_is_string(j_val)? strdup(json_string_value(j_val)) : json_dumps(j_val, JSON_ENCODE_ANY);
+    ret = ((tmp1 != NULL) && (tmp2 != NULL) && (strcmp(tmp1, tmp2) == 0))? false : true;
+    sfree(tmp1);
+    sfree(tmp2);
+    if(ret == true) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * Copy the given str and replace given org character to target character from str.
  * Return string should be freed after use it.
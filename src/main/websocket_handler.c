@@ -19,6 +19,7 @@
 #include "utils.h"
 #include "zmq_handler.h"
 #include "subscription_handler.h"
+#include "session_index.h"
 
 
 #define MAX_MSG_COUNT 1000
@@ -45,11 +46,21 @@ struct client_session {
   TAILQ_HEAD(msg_head, msg_entry) msg_queue;
 };
 
+/**
+ * Queue message.
+ * Shared by all the sessions which have the same message.
+ */
+struct msg_data {
+  int ref;      ///< reference count
+  size_t len;   ///< message length. without LWS_PRE.
+  char* msg;    ///< LWS_PRE padding + message
+};
+
 /**
  * Queue entry
  */
 struct msg_entry {
-  char* msg;
+  struct msg_data* data;
   TAILQ_ENTRY(msg_entry) entries;
 };
 
@@ -66,6 +77,8 @@ static struct lws_protocols* g_protocols;
 struct lws_context* g_websocket_context;
 extern app* g_app;
 
+static session_index* g_session_index = NULL;   ///< user and group index of the sessions
+
 static int callback_http(struct lws *wsi, enum lws_callback_reasons reason, void *user, void *in, size_t len);
 
 static bool init_client_session(struct lws* wsi, struct client_session* session);
@@ -73,6 +86,9 @@ static void destroy_client_session(struct client_session* session);
 
 static struct msg_entry* create_msg_entry(void);
 static void destroy_msg_entry(struct msg_entry* entry);
+static struct msg_data* create_msg_data(const json_t* j_msg);
+static void release_msg_data(struct msg_data* data);
+static bool enqueue_session_message(struct client_session* session, struct msg_data* data);
 
 static bool websocket_handler_established(struct lws *wsi, struct client_session* session, char* data, size_t len);
 static bool websocket_handler_receive(struct client_session* session, char* data, size_t len);
@@ -85,6 +101,7 @@ static bool recv_session_message_handler(struct client_session* session, json_t*
 static void zmq_sub_message_recv(int fd, short ev, void* arg);
 static void add_subscription(struct client_session* session, const char* topic);
 static void remove_subscription(struct client_session* session, const char* topic);
+static bool is_subscribed_topic(const struct client_session* session, const char* topic);
 
 static json_t* parse_uri_parameter(struct lws *wsi);
 static json_t* parse_uri_parameter_string(const char* param);
@@ -93,6 +110,9 @@ static bool set_zmq_sock(struct client_session* session);
 static bool set_event_handler(struct client_session* session);
 static bool set_authtoken(struct client_session* session);
 
+static struct client_session* find_client_session(const char* authtoken);
+static void cb_publish_group_session(void* session, void* data);
+
 static int compare_client_session(struct client_session *e1, struct client_session *e2);
 
 RB_HEAD(client_session_entries, client_session) client_session_head = RB_INITIALIZER(&head);
@@ -113,6 +133,12 @@ bool websocket_init_handler(void)
 
   memset(&info, 0, sizeof(info));
 
+  g_session_index = session_index_create();
+  if(g_session_index == NULL) {
+    slog(LOG_ERR, "Could not create session index.");
+    return false;
+  }
+
   // get init info
   addr = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "websock_addr"));
   port = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "websock_port"));
@@ -166,6 +192,9 @@ bool websocket_init_handler(void)
 void websocket_term_handler(void)
 {
   lws_context_destroy(g_websocket_context);
+
+  session_index_destroy(g_session_index);
+  g_session_index = NULL;
 }
 
 /**
@@ -321,6 +350,9 @@ static void destroy_client_session(struct client_session* session)
   // delete from RBTREE
   RB_REMOVE(client_session_entries, &client_session_head, session);
 
+  // leave the user and all groups
+  session_index_remove_session(g_session_index, session);
+
   // delete all msg
   TAILQ_FOREACH_SAFE(entry, &(session->msg_queue), entries, entry_tmp) {
     TAILQ_REMOVE(&(session->msg_queue), session->msg_queue.tqh_first, entries);
@@ -348,7 +380,7 @@ static struct msg_entry* create_msg_entry(void)
   struct msg_entry* entry;
 
   entry = calloc(1, sizeof(struct msg_entry));
-  entry->msg = NULL;
+  entry->data = NULL;
 
   return entry;
 }
@@ -363,49 +395,81 @@ static void destroy_msg_entry(struct msg_entry* entry)
     return;
   }
 
-  sfree(entry->msg);
+  release_msg_data(entry->data);
   sfree(entry);
 }
 
 /**
- * Add the message to the given session.
- * It will be sent when the session is receivable.
+ * Create msg_data of the given message.
+ * The returned data has a reference. Release it after use.
  */
-bool add_session_message(struct client_session* session, json_t* j_msg)
+static struct msg_data* create_msg_data(const json_t* j_msg)
 {
-  struct msg_entry* entry;
+  struct msg_data* data;
   char* tmp;
-  char* message;
 
-  if((session == NULL) || (j_msg == NULL)) {
+  if(j_msg == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
-    return false;
-  }
-
-  if(session->msg_count >= MAX_MSG_COUNT) {
-    slog(LOG_WARNING, "The queue message size exceed maximum message count. msg_count[%d]", session->msg_count);
-    return false;
+    return NULL;
   }
 
   // dump message
   tmp = json_dumps(j_msg, JSON_ENCODE_ANY);
   if(tmp == NULL) {
     slog(LOG_ERR, "Could not dump the message.");
-    return false;
+    return NULL;
   }
 
-  // create entry
-  entry = create_msg_entry();
+  data = calloc(1, sizeof(struct msg_data));
+  data->ref = 1;
+  data->len = strlen(tmp);
 
   // create message
   // Add the padding data(LWS_PRE) is important.
   // See detail (https://libwebsockets.org/lws-api-doc-master/html/group__sending-data.html)
-  message = calloc(1, LWS_PRE + strlen(tmp) + 1);
-  strcpy(message + LWS_PRE, tmp);
+  data->msg = calloc(1, LWS_PRE + data->len + 1);
+  memcpy(data->msg + LWS_PRE, tmp, data->len);
   sfree(tmp);
-//  slog(LOG_DEBUG, "Copied message. msg[%s]", message + LWS_PRE);
 
-  entry->msg = message;
+  return data;
+}
+
+static void release_msg_data(struct msg_data* data)
+{
+  if(data == NULL) {
+    return;
+  }
+
+  data->ref--;
+  if(data->ref > 0) {
+    return;
+  }
+
+  sfree(data->msg);
+  sfree(data);
+}
+
+/**
+ * Add the shared message to the given session's queue.
+ */
+static bool enqueue_session_message(struct client_session* session, struct msg_data* data)
+{
+  struct msg_entry* entry;
+
+  if((session == NULL) || (data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  if(session->msg_count >= MAX_MSG_COUNT) {
+    slog(LOG_WARNING, "The queue message size exceed maximum message count. msg_count[%d]", session->msg_count);
+    return false;
+  }
+
+  // create entry
+  entry = create_msg_entry();
+  entry->data = data;
+  data->ref++;
 
   // insert entry
   TAILQ_INSERT_TAIL(&(session->msg_queue), entry, entries);
@@ -414,6 +478,36 @@ bool add_session_message(struct client_session* session, json_t* j_msg)
   return true;
 }
 
+/**
+ * Add the message to the given session.
+ * It will be sent when the session is receivable.
+ */
+bool add_session_message(struct client_session* session, json_t* j_msg)
+{
+  struct msg_data* data;
+  int ret;
+
+  if((session == NULL) || (j_msg == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  if(session->msg_count >= MAX_MSG_COUNT) {
+    slog(LOG_WARNING, "The queue message size exceed maximum message count. msg_count[%d]", session->msg_count);
+    return false;
+  }
+
+  data = create_msg_data(j_msg);
+  if(data == NULL) {
+    return false;
+  }
+
+  ret = enqueue_session_message(session, data);
+  release_msg_data(data);
+
+  return ret;
+}
+
 /**
  * @brief Send queued message to the session.
  * This should be called when the session is ready to receive the message.
@@ -437,7 +531,7 @@ static bool send_session_message(struct client_session* session)
     return true;
   }
 
-  message = entry->msg;
+  message = (entry->data != NULL)? entry->data->msg : NULL;
   if(message == NULL) {
     slog(LOG_ERR, "Could not get correct message info.");
 
@@ -450,7 +544,9 @@ static bool send_session_message(struct client_session* session)
 
   // send message
   // we send text message only.
-  ret = lws_write(session->wsi, (unsigned char*)message + LWS_PRE, strlen(message + LWS_PRE), LWS_WRITE_TEXT);
+  // the message could be shared with other sessions.
+  // lws_write() touches only the LWS_PRE padding area.
+  ret = lws_write(session->wsi, (unsigned char*)message + LWS_PRE, entry->data->len, LWS_WRITE_TEXT);
   slog(LOG_DEBUG, "Sent message result. ret[%d]", ret);
 
   // remove entry from the queue
@@ -618,6 +714,38 @@ static void remove_subscription(struct client_session* session, const char* topi
   return;
 }
 
+/**
+ * Returns true if the topic is received by the session's zmq subscription.
+ * The zmq subscription matches the topic by the prefix.
+ * @param session
+ * @param topic
+ * @return
+ */
+static bool is_subscribed_topic(const struct client_session* session, const char* topic)
+{
+  int idx;
+  json_t* j_tmp;
+  const char* tmp_const;
+
+  if((session == NULL) || (topic == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  json_array_foreach(session->j_subs, idx, j_tmp) {
+    tmp_const = json_string_value(j_tmp);
+    if(tmp_const == NULL) {
+      continue;
+    }
+
+    if(strncmp(topic, tmp_const, strlen(tmp_const)) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * Websocket received message handler
  * @param state
@@ -1035,23 +1163,216 @@ static bool set_authtoken(struct client_session* session)
   return true;
 }
 
+static struct client_session* find_client_session(const char* authtoken)
+{
+  struct client_session find;
+
+  if(authtoken == NULL) {
+    return NULL;
+  }
+
+  find.authtoken = (char*)authtoken;
+
+  return RB_FIND(client_session_entries, &client_session_head, &find);
+}
+
 void* websocket_get_subscription_socket(const char* authtoken)
 {
   struct client_session* session;
-  struct client_session find;
 
   if(authtoken == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
 
-  find.authtoken = strdup(authtoken);
-
-  session = RB_FIND(client_session_entries, &client_session_head, &find);
-  sfree(find.authtoken);
+  session = find_client_session(authtoken);
   if(session == NULL) {
     return NULL;
   }
 
   return session->zmq_sock;
 }
+
+/**
+ * Set the owner user of the given authtoken's session.
+ * @param authtoken
+ * @param uuid_user
+ * @return
+ */
+bool websocket_set_session_user(const char* authtoken, const char* uuid_user)
+{
+  struct client_session* session;
+
+  if((authtoken == NULL) || (uuid_user == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  session = find_client_session(authtoken);
+  if(session == NULL) {
+    slog(LOG_NOTICE, "Could not find session. authtoken[%s]", authtoken);
+    return false;
+  }
+
+  return session_index_set_user(g_session_index, session, uuid_user);
+}
+
+/**
+ * Join the given authtoken's session to the group.
+ * @param authtoken
+ * @param group
+ * @return
+ */
+bool websocket_join_group(const char* authtoken, const char* group)
+{
+  struct client_session* session;
+
+  if((authtoken == NULL) || (group == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  session = find_client_session(authtoken);
+  if(session == NULL) {
+    slog(LOG_NOTICE, "Could not find session. authtoken[%s]", authtoken);
+    return false;
+  }
+
+  return session_index_join_group(g_session_index, session, group);
+}
+
+/**
+ * Join all the connected sessions of the given user to the group.
+ * Does nothing if the user has no connected session.
+ * @param uuid_user
+ * @param group
+ * @return
+ */
+bool websocket_join_group_user(const char* uuid_user, const char* group)
+{
+  int ret;
+
+  if((uuid_user == NULL) || (group == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired websocket_join_group_user. uuid_user[%s], group[%s]", uuid_user, group);
+
+  ret = session_index_join_group_user(g_session_index, uuid_user, group);
+  if(ret < 0) {
+    slog(LOG_NOTICE, "Could not join the group. uuid_user[%s], group[%s]", uuid_user, group);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Leave all the connected sessions of the given user from the group.
+ * @param uuid_user
+ * @param group
+ * @return
+ */
+bool websocket_leave_group_user(const char* uuid_user, const char* group)
+{
+  int ret;
+
+  if((uuid_user == NULL) || (group == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired websocket_leave_group_user. uuid_user[%s], group[%s]", uuid_user, group);
+
+  ret = session_index_leave_group_user(g_session_index, uuid_user, group);
+  if(ret < 0) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Group message of the websocket_publish_group().
+ */
+struct publish_group_data {
+  const char* group;
+  const char* event_name;
+  const json_t* j_data;
+  struct msg_data* data;    ///< created at the first member session.
+};
+
+/**
+ * session_index_foreach_group() callback of the websocket_publish_group().
+ */
+static void cb_publish_group_session(void* session, void* data)
+{
+  struct client_session* client;
+  struct publish_group_data* publish;
+  json_t* j_msg;
+  int ret;
+
+  client = session;
+  publish = data;
+  if((client == NULL) || (publish == NULL)) {
+    return;
+  }
+
+  // the session gets the zmq published one already
+  ret = is_subscribed_topic(client, publish->group);
+  if(ret == true) {
+    return;
+  }
+
+  // create message once
+  if(publish->data == NULL) {
+    j_msg = json_pack("{s:{s:O}}", publish->group, publish->event_name, publish->j_data);
+    publish->data = create_msg_data(j_msg);
+    json_decref(j_msg);
+    if(publish->data == NULL) {
+      slog(LOG_ERR, "Could not create message data.");
+      return;
+    }
+  }
+
+  ret = enqueue_session_message(client, publish->data);
+  if(ret == false) {
+    slog(LOG_NOTICE, "Could not add the message. addr[%s], group[%s]", client->addr, publish->group);
+    return;
+  }
+
+  // request writable callback
+  lws_callback_on_writable(client->wsi);
+}
+
+/**
+ * Deliver the event to the member sessions of the group.
+ * The message has the same format with the subscribed topic's message.
+ * The message is dumped once and shared by all member sessions.
+ * @param group
+ * @param event_name
+ * @param j_data
+ * @return
+ */
+bool websocket_publish_group(const char* group, const char* event_name, const json_t* j_data)
+{
+  struct publish_group_data publish;
+  int ret;
+
+  if((group == NULL) || (event_name == NULL) || (j_data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  publish.group = group;
+  publish.event_name = event_name;
+  publish.j_data = j_data;
+  publish.data = NULL;
+
+  ret = session_index_foreach_group(g_session_index, group, cb_publish_group_session, &publish);
+  release_msg_data(publish.data);
+  if(ret < 0) {
+    return false;
+  }
+
+  return true;
+}
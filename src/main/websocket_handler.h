@@ -9,6 +9,7 @@
 #define SRC_WEBSOCKET_HANDLER_H_
 
 #include <stdbool.h>
+#include <jansson.h>
 
 bool websocket_init_handler(void);
 void websocket_term_handler(void);
@@ -16,4 +17,10 @@ void websocket_term_handler(void);
 
 void* websocket_get_subscription_socket(const char* authtoken);
 
+bool websocket_set_session_user(const char* authtoken, const char* uuid_user);
+bool websocket_join_group(const char* authtoken, const char* group);
+bool websocket_join_group_user(const char* uuid_user, const char* group);
+bool websocket_leave_group_user(const char* uuid_user, const char* group);
+bool websocket_publish_group(const char* group, const char* event_name, const json_t* j_data);
+
 #endif /* SRC_WEBSOCKET_HANDLER_H_ */
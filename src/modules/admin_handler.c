@@ -8,6 +8,7 @@
 #define _GNU_SOURCE
 
 #include <stdio.h>
+#include <string.h>
 #include <evhtp.h>
 #include <jansson.h>
 
@@ -23,6 +24,9 @@
 #include "publication_handler.h"
 #include "pjsip_handler.h"
 #include "dialplan_handler.h"
+#include "resource_handler.h"
+#include "chat_handler.h"
+#include "conf_handler.h"
 
 #include "admin_handler.h"
 
@@ -41,47 +45,42 @@
 
 static bool init_callbacks(void);
 
+static bool is_raw_format_request(evhtp_request_t* req);
+static void response_configuration_raw(evhtp_request_t* req, const char* filename);
+
 
 ////// core module
 // channels
-static json_t* get_core_channels_all(void);
 static json_t* get_core_channel_info(const char* key);
 static bool delete_core_channel_info(const char* key);
 
 // modules
-static json_t* get_core_modules_all(void);
 static json_t* get_core_module_info(const char* key);
 
 // systems
-static json_t* get_core_systems_all(void);
 static json_t* get_core_system_info(const char* key);
 
 
 
 ////// queue module
 // queues
-static json_t* get_queue_queues_all(void);
 static json_t* get_queue_queue_info(const char* key);
 
 // members
-static json_t* get_queue_members_all(void);
 static json_t* get_queue_member_info(const char* key);
 static bool create_queue_member_info(const json_t* j_data);
 static bool update_queue_member_info(const char* key, const json_t* j_data);
 static bool delete_queue_member_info(const char* key);
 
 // entries
-static json_t* get_queue_entries_all(void);
 static json_t* get_queue_entry_info(const char* key);
 static bool delete_queue_entry_info(const char* key);
 
 
 ////// park module
-static json_t* get_park_parkedcalls_all(void);
 static json_t* get_park_parkedcall_info(const char* key);
 static bool delete_park_parkedcall_info(const char* key);
 
-static json_t* get_park_parkinglots_all(void);
 static json_t* get_park_parkinglot_info(const char* key);
 
 static json_t* get_park_cfg_parkinglots_all(void);
@@ -109,21 +108,18 @@ static bool update_dialplan_configuration_info(const char* key, const json_t* j_
 
 ////// user module
 // user
-static json_t* get_user_users_all(void);
 static json_t* get_user_userinfo(const char* uuid);
 static bool create_user_userinfo(const json_t* j_data);
 static bool update_user_userinfo(const char* uuid, const json_t* j_data);
 static bool delete_user_userinfo(const char* uuid);
 
 // contact
-static json_t* get_user_contacts_all(void);
 static json_t* get_user_contact_info(const char* uuid);
 static bool create_user_contact_info(const json_t* j_data);
 static bool update_user_contact_info(const char* uuid, const json_t* j_data);
 static bool delete_user_contact_info(const char* uuid);
 
 // permission
-static json_t* get_user_permissions_all(void);
 static json_t* get_user_permission_info(const char* uuid);
 static bool create_user_permission_info(const json_t* j_data);
 static bool delete_user_permission_info(const char* uuid);
@@ -202,6 +198,40 @@ static bool init_callbacks(void)
   return true;
 }
 
+/**
+ * Returns true if the request wants the raw format.
+ * ?format=raw
+ * @param req
+ * @return
+ */
+static bool is_raw_format_request(evhtp_request_t* req)
+{
+  const char* tmp_const;
+
+  tmp_const = evhtp_kv_find(req->uri->query, "format");
+  if((tmp_const == NULL) || (strcmp(tmp_const, "raw") != 0)) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Send the config file as a plain text.
+ * @param req
+ * @param filename full path of the config file. NULL sends the not found.
+ */
+static void response_configuration_raw(evhtp_request_t* req, const char* filename)
+{
+  if(filename == NULL) {
+    slog(LOG_NOTICE, "Could not find the config file.");
+    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
+    return;
+  }
+
+  http_simple_response_file(req, filename, "text/plain; charset=utf-8");
+}
+
 /**
  * Returns all subscribable topics of admin module.
  * @param j_user
@@ -424,31 +454,14 @@ void admin_htp_delete_admin_login(evhtp_request_t *req, void *data)
  */
 void admin_htp_get_admin_user_users(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_user_users.");
 
-  // get info
-  j_tmp = get_user_users_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get users info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, user_get_userinfos_page, "uuid");
 
   return;
 }
@@ -644,31 +657,14 @@ void admin_htp_delete_admin_user_users_detail(evhtp_request_t *req, void *data)
  */
 void admin_htp_get_admin_user_contacts(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_user_contacts.");
 
-  // get info
-  j_tmp = get_user_contacts_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get contacts info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, user_get_contacts_page, "uuid");
 
   return;
 }
@@ -864,31 +860,14 @@ void admin_htp_delete_admin_user_contacts_detail(evhtp_request_t *req, void *dat
  */
 void admin_htp_get_admin_user_permissions(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_user_permissions.");
 
-  // get info
-  j_tmp = get_user_permissions_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, user_get_permissions_page, "uuid");
 
   return;
 }
@@ -1030,18 +1009,82 @@ void admin_htp_delete_admin_user_permissions_detail(evhtp_request_t *req, void *
  * @param data
  */
 void admin_htp_get_admin_queue_queues(evhtp_request_t *req, void *data)
+{
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_queues.");
+
+  // response
+  http_simple_response_page(req, queue_get_queue_params_page, "name");
+
+  return;
+}
+
+/**
+ * GET ^/admin/queue/queues/(.*) request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
+  char* detail;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_queues.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_queues_detail.");
+
+  // detail parse
+  detail = http_get_parsed_detail(req);
+  if(detail == NULL) {
+    slog(LOG_ERR, "Could not get detail info.");
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    return;
+  }
+
+  // get detail info
+  j_tmp = get_queue_queue_info(detail);
+  sfree(detail);
+  if(j_tmp == NULL) {
+    slog(LOG_NOTICE, "Could not find info.");
+    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
+    return;
+  }
+
+  // create result
+  j_res = http_create_default_result(EVHTP_RES_OK);
+  json_object_set_new(j_res, "result", j_tmp);
+
+  // response
+  http_simple_response_normal(req, j_res);
+  json_decref(j_res);
+
+  return;
+}
+
+/**
+ * GET ^/admin/queue/stats request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_queue_stats(evhtp_request_t *req, void *data)
+{
+  json_t* j_res;
+  json_t* j_tmp;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_stats.");
 
   // get info
-  j_tmp = get_queue_queues_all();
+  j_tmp = queue_get_stats_all();
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
@@ -1061,11 +1104,11 @@ void admin_htp_get_admin_queue_queues(evhtp_request_t *req, void *data)
 }
 
 /**
- * GET ^/admin/queue/queues/(.*) request handler.
+ * GET ^/admin/queue/stats/(.*) request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data)
+void admin_htp_get_admin_queue_stats_detail(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
@@ -1075,7 +1118,7 @@ void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_queues_detail.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_stats_detail.");
 
   // detail parse
   detail = http_get_parsed_detail(req);
@@ -1086,7 +1129,7 @@ void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data)
   }
 
   // get detail info
-  j_tmp = get_queue_queue_info(detail);
+  j_tmp = queue_get_stat_info(detail);
   sfree(detail);
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not find info.");
@@ -1106,33 +1149,73 @@ void admin_htp_get_admin_queue_queues_detail(evhtp_request_t *req, void *data)
 }
 
 /**
- * GET ^/admin/queue/members request handler.
+ * GET ^/admin/resource/stats request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_queue_members(evhtp_request_t *req, void *data)
+void admin_htp_get_admin_resource_stats(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
+  json_t* j_stats;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_members.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_resource_stats.");
 
   // get info
-  j_tmp = get_queue_members_all();
+  j_tmp = resource_get_stats();
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
     return;
   }
 
+  // add config cache info
+  j_stats = conf_get_cache_stats();
+  json_object_update(j_tmp, j_stats);
+  json_decref(j_stats);
+
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
+  json_object_set_new(j_res, "result", j_tmp);
+
+  // response
+  http_simple_response_normal(req, j_res);
+  json_decref(j_res);
+
+  return;
+}
+
+/**
+ * GET ^/admin/chat/retention request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_chat_retention(evhtp_request_t *req, void *data)
+{
+  json_t* j_res;
+  json_t* j_tmp;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_chat_retention.");
+
+  // get info
+  j_tmp = chat_get_retention_status();
+  if(j_tmp == NULL) {
+    slog(LOG_NOTICE, "Could not get info.");
+    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
+    return;
+  }
+
+  // create result
+  j_res = http_create_default_result(EVHTP_RES_OK);
+  json_object_set_new(j_res, "result", j_tmp);
 
   // response
   http_simple_response_normal(req, j_res);
@@ -1141,6 +1224,25 @@ void admin_htp_get_admin_queue_members(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * GET ^/admin/queue/members request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_queue_members(evhtp_request_t *req, void *data)
+{
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_members.");
+
+  // response
+  http_simple_response_page(req, queue_get_members_page, "id");
+
+  return;
+}
+
 /**
  * htp request handler.
  * request: POST ^/admin/queue/members$
@@ -1332,31 +1434,14 @@ void admin_htp_delete_admin_queue_member_detail(evhtp_request_t *req, void *data
  */
 void admin_htp_get_admin_queue_entries(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_queue_entries.");
 
-  // get info
-  j_tmp = get_queue_entries_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, queue_get_entries_page, "unique_id");
 
   return;
 }
@@ -1716,6 +1801,7 @@ void admin_htp_get_admin_queue_configurations_detail(evhtp_request_t *req, void
   json_t* j_res;
   json_t* j_tmp;
   char* detail;
+  char* filename;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1731,6 +1817,15 @@ void admin_htp_get_admin_queue_configurations_detail(evhtp_request_t *req, void
     return;
   }
 
+  // raw text
+  if(is_raw_format_request(req) == true) {
+    filename = queue_get_configuration_filename(detail);
+    sfree(detail);
+    response_configuration_raw(req, filename);
+    sfree(filename);
+    return;
+  }
+
   // get detail info
   j_tmp = queue_get_configuration_info(detail);
   sfree(detail);
@@ -1854,31 +1949,14 @@ void admin_htp_delete_admin_queue_configurations_detail(evhtp_request_t *req, vo
  */
 void admin_htp_get_admin_park_parkinglots(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_park_parkinglots.");
 
-  // get info
-  j_tmp = get_park_parkinglots_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, park_get_parkinglots_page, "name");
 
   return;
 }
@@ -2156,31 +2234,14 @@ void admin_htp_delete_admin_park_cfg_parkinglots_detail(evhtp_request_t *req, vo
  */
 void admin_htp_get_admin_park_parkedcalls(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_park_parkedcalls.");
 
-  // get info
-  j_tmp = get_park_parkedcalls_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, park_get_parkedcalls_page, "parkee_unique_id");
 
   return;
 }
@@ -2319,6 +2380,7 @@ void admin_htp_get_admin_park_configurations_detail(evhtp_request_t *req, void *
   json_t* j_res;
   json_t* j_tmp;
   char* detail;
+  char* filename;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -2334,6 +2396,15 @@ void admin_htp_get_admin_park_configurations_detail(evhtp_request_t *req, void *
     return;
   }
 
+  // raw text
+  if(is_raw_format_request(req) == true) {
+    filename = park_get_configuration_filename(detail);
+    sfree(detail);
+    response_configuration_raw(req, filename);
+    sfree(filename);
+    return;
+  }
+
   // get detail info
   j_tmp = get_park_configuration_info(detail);
   sfree(detail);
@@ -2457,31 +2528,14 @@ void admin_htp_delete_admin_park_configurations_detail(evhtp_request_t *req, voi
  */
 void admin_htp_get_admin_core_channels(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_core_channels.");
 
-  // get info
-  j_tmp = get_core_channels_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, core_get_channels_page, "unique_id");
 
   return;
 }
@@ -2581,31 +2635,14 @@ void admin_htp_delete_admin_core_channels_detail(evhtp_request_t *req, void *dat
  */
 void admin_htp_get_admin_core_modules(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_core_modules.");
 
-  // get info
-  j_tmp = get_core_modules_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, core_get_modules_page, "name");
 
   return;
 }
@@ -2785,11 +2822,11 @@ void admin_htp_delete_admin_core_modules_detail(evhtp_request_t *req, void *data
 }
 
 /**
- * GET ^/admin/core/systems$ request handler.
+ * GET ^/admin/core/reloads request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data)
+void admin_htp_get_admin_core_reloads(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
@@ -2798,10 +2835,10 @@ void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data)
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_core_systems.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_core_reloads.");
 
   // get info
-  j_tmp = get_core_systems_all();
+  j_tmp = core_get_module_reload_status();
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
@@ -2810,8 +2847,7 @@ void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data)
 
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
+  json_object_set_new(j_res, "result", j_tmp);
 
   // response
   http_simple_response_normal(req, j_res);
@@ -2820,6 +2856,25 @@ void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * GET ^/admin/core/systems$ request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_core_systems(evhtp_request_t *req, void *data)
+{
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_core_systems.");
+
+  // response
+  http_simple_response_page(req, core_get_systems_page, "id");
+
+  return;
+}
+
 /**
  * GET ^/admin/core/systems/(.*) request handler.
  * @param req
@@ -2874,6 +2929,7 @@ void admin_htp_get_admin_dialplan_adps(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
+  char* dpma_uuid;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -2881,8 +2937,16 @@ void admin_htp_get_admin_dialplan_adps(evhtp_request_t *req, void *data)
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_dialplan_adps.");
 
-  // get info
-  j_tmp = dialplan_get_dialplans_all();
+  // the dialplans of all dpmas are paged.
+  dpma_uuid = http_get_parameter(req, "dpma_uuid");
+  if(dpma_uuid == NULL) {
+    http_simple_response_page(req, dialplan_get_dialplans_page, "uuid");
+    return;
+  }
+
+  // get info. the dpma_uuid gives the dialplans of the dpma in the sequence order.
+  j_tmp = dialplan_get_dialplans_by_dpma_uuid_order_sequence(dpma_uuid);
+  sfree(dpma_uuid);
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get users info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
@@ -3092,31 +3156,14 @@ void admin_htp_delete_admin_dialplan_adps_detail(evhtp_request_t *req, void *dat
  */
 void admin_htp_get_admin_dialplan_adpmas(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_dialplan_adpmas.");
 
-  // get info
-  j_tmp = dialplan_get_dpmas_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get users info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, dialplan_get_dpmas_page, "uuid");
 
   return;
 }
@@ -3571,6 +3618,7 @@ void admin_htp_get_admin_dialplan_configurations_detail(evhtp_request_t *req, vo
   json_t* j_res;
   json_t* j_tmp;
   char* detail;
+  char* filename;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -3586,6 +3634,15 @@ void admin_htp_get_admin_dialplan_configurations_detail(evhtp_request_t *req, vo
     return;
   }
 
+  // raw text
+  if(is_raw_format_request(req) == true) {
+    filename = dialplan_get_configuration_filename(detail);
+    sfree(detail);
+    response_configuration_raw(req, filename);
+    sfree(filename);
+    return;
+  }
+
   // get detail info
   j_tmp = dialplan_get_configuration_info(detail);
   sfree(detail);
@@ -3711,31 +3768,14 @@ void admin_htp_delete_admin_dialplan_configurations_detail(evhtp_request_t *req,
  */
 void admin_htp_get_admin_pjsip_aors(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_aors.");
 
-  // get info
-  j_tmp = pjsip_get_aors_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, pjsip_get_aors_page, "object_name");
 
   return;
 }
@@ -3792,31 +3832,14 @@ void admin_htp_get_admin_pjsip_aors_detail(evhtp_request_t *req, void *data)
  */
 void admin_htp_get_admin_pjsip_auths(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_auths.");
 
-  // get info
-  j_tmp = pjsip_get_auths_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, pjsip_get_auths_page, "object_name");
 
   return;
 }
@@ -3873,31 +3896,14 @@ void admin_htp_get_admin_pjsip_auths_detail(evhtp_request_t *req, void *data)
  */
 void admin_htp_get_admin_pjsip_contacts(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_contacts.");
 
-  // get info
-  j_tmp = pjsip_get_contacts_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, pjsip_get_contacts_page, "uri");
 
   return;
 }
@@ -3953,28 +3959,56 @@ void admin_htp_get_admin_pjsip_contacts_detail(evhtp_request_t *req, void *data)
  * @param data
  */
 void admin_htp_get_admin_pjsip_endpoints(evhtp_request_t *req, void *data)
+{
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_endpoints.");
+
+  // response
+  http_simple_response_page(req, pjsip_get_endpoints_page, "object_name");
+
+  return;
+}
+
+/**
+ * GET ^/admin/pjsip/endpoints/(.*) request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
+  char* detail;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_endpoints.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_endpoints_detail.");
 
-  // get info
-  j_tmp = pjsip_get_endpoints_all();
+  // detail parse
+  detail = http_get_parsed_detail(req);
+  if(detail == NULL) {
+    slog(LOG_ERR, "Could not get detail info.");
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    return;
+  }
+
+  // get detail info
+  j_tmp = pjsip_get_endpoint_info(detail);
+  sfree(detail);
   if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get info.");
+    slog(LOG_NOTICE, "Could not find info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
     return;
   }
 
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
+  json_object_set_new(j_res, "result", j_tmp);
 
   // response
   http_simple_response_normal(req, j_res);
@@ -3984,11 +4018,30 @@ void admin_htp_get_admin_pjsip_endpoints(evhtp_request_t *req, void *data)
 }
 
 /**
- * GET ^/admin/pjsip/endpoints/(.*) request handler.
+ * GET ^/admin/pjsip/registration_outbounds$ request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data)
+void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void *data)
+{
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_registration_outbounds.");
+
+  // response
+  http_simple_response_page(req, pjsip_get_registration_outbounds_page, "object_name");
+
+  return;
+}
+
+/**
+ * GET ^/admin/pjsip/registration_outbounds/(.*) request handler.
+ * @param req
+ * @param data
+ */
+void admin_htp_get_admin_pjsip_registration_outbounds_detail(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
@@ -3998,7 +4051,7 @@ void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_endpoints_detail.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_registration_outbounds_detail.");
 
   // detail parse
   detail = http_get_parsed_detail(req);
@@ -4009,7 +4062,7 @@ void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data
   }
 
   // get detail info
-  j_tmp = pjsip_get_endpoint_info(detail);
+  j_tmp = pjsip_get_registration_outbound_info(detail);
   sfree(detail);
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not find info.");
@@ -4029,11 +4082,11 @@ void admin_htp_get_admin_pjsip_endpoints_detail(evhtp_request_t *req, void *data
 }
 
 /**
- * GET ^/admin/pjsip/registration_outbounds$ request handler.
+ * GET ^/admin/pjsip/sync request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void *data)
+void admin_htp_get_admin_pjsip_sync(evhtp_request_t *req, void *data)
 {
   json_t* j_res;
   json_t* j_tmp;
@@ -4042,10 +4095,10 @@ void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_registration_outbounds.");
+  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_sync.");
 
   // get info
-  j_tmp = pjsip_get_registration_outbounds_all();
+  j_tmp = pjsip_get_detail_sync_status();
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get info.");
     http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
@@ -4054,8 +4107,7 @@ void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void
 
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
+  json_object_set_new(j_res, "result", j_tmp);
 
   // response
   http_simple_response_normal(req, j_res);
@@ -4065,36 +4117,34 @@ void admin_htp_get_admin_pjsip_registration_outbounds(evhtp_request_t *req, void
 }
 
 /**
- * GET ^/admin/pjsip/registration_outbounds/(.*) request handler.
+ * POST ^/admin/pjsip/batch request handler.
  * @param req
  * @param data
  */
-void admin_htp_get_admin_pjsip_registration_outbounds_detail(evhtp_request_t *req, void *data)
+void admin_htp_post_admin_pjsip_batch(evhtp_request_t *req, void *data)
 {
+  json_t* j_data;
   json_t* j_res;
   json_t* j_tmp;
-  char* detail;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
-  slog(LOG_DEBUG, "Fired admin_htp_get_admin_pjsip_registration_outbounds_detail.");
+  slog(LOG_DEBUG, "Fired admin_htp_post_admin_pjsip_batch.");
 
-  // detail parse
-  detail = http_get_parsed_detail(req);
-  if(detail == NULL) {
-    slog(LOG_ERR, "Could not get detail info.");
+  // get data
+  j_data = http_get_json_from_request_data(req);
+  if(j_data == NULL) {
     http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
     return;
   }
 
-  // get detail info
-  j_tmp = pjsip_get_registration_outbound_info(detail);
-  sfree(detail);
+  // create info
+  j_tmp = pjsip_cfg_create_batch_info(j_data);
+  json_decref(j_data);
   if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not find info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
     return;
   }
 
@@ -4155,6 +4205,7 @@ void admin_htp_get_admin_pjsip_configurations_detail(evhtp_request_t *req, void
   json_t* j_res;
   json_t* j_tmp;
   char* detail;
+  char* filename;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -4170,6 +4221,15 @@ void admin_htp_get_admin_pjsip_configurations_detail(evhtp_request_t *req, void
     return;
   }
 
+  // raw text
+  if(is_raw_format_request(req) == true) {
+    filename = pjsip_get_configuration_filename(detail);
+    sfree(detail);
+    response_configuration_raw(req, filename);
+    sfree(filename);
+    return;
+  }
+
   // get detail info
   j_tmp = pjsip_get_configuration_info(detail);
   sfree(detail);
@@ -4293,18 +4353,6 @@ void admin_htp_delete_admin_pjsip_configurations_detail(evhtp_request_t *req, vo
 
 
 
-static json_t* get_user_users_all(void)
-{
-  json_t* j_res;
-
-  j_res = user_get_userinfos_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static bool create_user_userinfo(const json_t* j_data)
 {
   int ret;
@@ -4378,18 +4426,6 @@ static bool delete_user_userinfo(const char* uuid)
   return true;
 }
 
-static json_t* get_user_contacts_all(void)
-{
-  json_t* j_res;
-
-  j_res = user_get_contacts_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_user_contact_info(const char* uuid)
 {
   json_t* j_res;
@@ -4459,18 +4495,6 @@ static bool delete_user_contact_info(const char* uuid)
   return true;
 }
 
-static json_t* get_user_permissions_all(void)
-{
-  json_t* j_res;
-
-  j_res = user_get_permissions_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_user_permission_info(const char* uuid)
 {
   json_t* j_res;
@@ -4523,18 +4547,6 @@ static bool delete_user_permission_info(const char* uuid)
   return true;
 }
 
-static json_t* get_queue_queues_all(void)
-{
-  json_t* j_res;
-
-  j_res = queue_get_queue_params_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_queue_queue_info(const char* key)
 {
   json_t* j_res;
@@ -4552,18 +4564,6 @@ static json_t* get_queue_queue_info(const char* key)
   return j_res;
 }
 
-static json_t* get_queue_members_all(void)
-{
-  json_t* j_res;
-
-  j_res = queue_get_members_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_queue_member_info(const char* key)
 {
   json_t* j_res;
@@ -4632,18 +4632,6 @@ static bool delete_queue_member_info(const char* key)
   return true;
 }
 
-static json_t* get_queue_entries_all(void)
-{
-  json_t* j_res;
-
-  j_res = queue_get_entries_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_queue_entry_info(const char* key)
 {
   json_t* j_res;
@@ -4673,18 +4661,6 @@ static bool delete_queue_entry_info(const char* key)
   return true;
 }
 
-static json_t* get_park_parkedcalls_all(void)
-{
-  json_t* j_res;
-
-  j_res = park_get_parkedcalls_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_park_parkedcall_info(const char* key)
 {
   json_t* j_res;
@@ -4719,18 +4695,6 @@ static bool delete_park_parkedcall_info(const char* key)
   return true;
 }
 
-static json_t* get_park_parkinglots_all(void)
-{
-  json_t* j_res;
-
-  j_res = park_get_parkinglots_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_park_parkinglot_info(const char* key)
 {
   json_t* j_res;
@@ -4878,18 +4842,6 @@ static bool update_queue_configuration_info(const char* key, const json_t* j_dat
   return true;
 }
 
-static json_t* get_core_channels_all(void)
-{
-  json_t* j_res;
-
-  j_res = core_get_channels_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_core_channel_info(const char* key)
 {
   json_t* j_res;
@@ -4924,18 +4876,6 @@ static bool delete_core_channel_info(const char* key)
   return true;
 }
 
-static json_t* get_core_modules_all(void)
-{
-  json_t* j_res;
-
-  j_res = core_get_modules_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_core_module_info(const char* key)
 {
   json_t* j_res;
@@ -5004,18 +4944,6 @@ static bool unload_module(const char* name)
   return true;
 }
 
-static json_t* get_core_systems_all(void)
-{
-  json_t* j_res;
-
-  j_res = core_get_systems_all();
-  if(j_res == NULL) {
-    return NULL;
-  }
-
-  return j_res;
-}
-
 static json_t* get_core_system_info(const char* key)
 {
   json_t* j_res;
@@ -22,28 +22,14 @@
  */
 void agent_htp_get_agent_agents(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_INFO, "Fired htp_get_agent_agents.");
 
-  j_tmp = get_agent_agents_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  // response
+  http_simple_response_page(req, get_agent_agents_page, "id");
 
   return;
 }
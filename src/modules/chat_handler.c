@@ -8,12 +8,18 @@
 #define _GNU_SOURCE
 
 #include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <event2/event.h>
 
 #include "common.h"
 #include "slog.h"
 #include "utils.h"
 #include "resource_handler.h"
+#include "db_ctx_handler.h"
 #include "user_handler.h"
+#include "event_handler.h"
+#include "config.h"
 #include <publication_handler.h>
 
 #include "chat_handler.h"
@@ -21,20 +27,61 @@
 
 #define DEF_DB_TABLE_CHAT_ROOM  "chat_room"
 #define DEF_DB_TABLE_CHAT_USERROOM  "chat_userroom"
+#define DEF_DB_TABLE_CHAT_MESSAGE   "chat_message"
+#define DEF_DB_TABLE_CHAT_ROOM_PURGE  "chat_room_purge"   // deleted rooms which have messages to be deleted
+
+#define DEF_DB_CHAT_MESSAGE_TABLE_PATTERN "chat\\_%\\_message"  // old per-room message tables. chat_<uuid>_message
+
+#define DEF_ONE_SEC_IN_MICRO_SEC  1000000
+
+/**
+ * Chat message retention.
+ * Each step deletes at most batch_size messages,
+ * so the event loop is never blocked by a big deletion.
+ */
+typedef struct _chat_retention {
+  int days;
+  int count;
+  int batch_size;
+  int room_count;
+  int vacuum_pages;
+
+  char* cursor_room;    ///< last checked room of the count policy
+
+  unsigned long long steps;
+  unsigned long long deleted_room;    ///< deleted messages of deleted rooms
+  unsigned long long deleted_days;    ///< deleted messages by the days policy
+  unsigned long long deleted_count;   ///< deleted messages by the count policy
+  unsigned long long vacuumed_pages;  ///< released pages by the incremental vacuum
+} chat_retention;
 
 static struct st_callback* g_callback_room;
 static struct st_callback* g_callback_userroom;
 static struct st_callback* g_callback_message;
 
+static chat_retention g_chat_retention = {0};
+
+extern app* g_app;
+
 static bool init_chat_databases(void);
 static bool init_chat_database_room(void);
 static bool init_chat_database_userroom(void);
+static bool init_chat_database_message(void);
+static bool init_chat_database_room_purge(void);
+static bool migrate_chat_message_tables(void);
 
 static bool init_callbacks(void);
 static bool term_callbacks(void);
 
-static bool db_create_table_chat_message(const char* table_name);
-static bool db_delete_table_chat_message(const char* table_name);
+static bool init_retention(void);
+static void term_retention(void);
+static void cb_chat_retention(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static int retention_purge_rooms(int limit);
+static int retention_delete_by_days(int limit);
+static int retention_delete_by_count(int limit);
+static bool retention_refresh_userrooms(const char* uuid_room);
+static int retention_vacuum(void);
+static int get_file_pragma_value(const char* name);
 
 static json_t* db_get_chat_rooms_info_by_useruuid(const char* user_uuid);
 static json_t* db_get_chat_room_info(const char* uuid);
@@ -42,18 +89,21 @@ static json_t* db_get_chat_room_info_by_type_members(const enum EN_CHAT_ROOM_TYP
 static bool db_create_chat_room_info(const json_t* j_data);
 static bool db_update_chat_room_info(json_t* j_data);
 static bool db_delete_chat_room_info(const char* uuid);
-static char* db_create_tablename_chat_message(const char* uuid);
 
 static json_t* db_get_chat_userroom_info(const char* uuid);
 static json_t* db_get_chat_userroom_info_by_user_room(const char* uuid_user, const char* uuid_room);
 static json_t* db_get_chat_userrooms_info_by_useruuid(const char* user_uuid);
 static json_t* db_get_chat_userrooms_info_by_roomuuid(const char* uuid_room);
+static json_t* db_get_chat_userrooms_summary_by_useruuid(const char* uuid_user);
 static bool db_create_chat_userroom_info(const json_t* j_data);
 static bool db_update_chat_userroom_info(const json_t* j_data);
 static bool db_delete_chat_userroom_info(const char* uuid);
+static bool db_update_chat_userrooms_last_message(const json_t* j_message);
+static bool db_update_chat_userroom_read(const char* uuid);
 
-static bool db_create_chat_message_info(const char* table_name, const json_t* j_data);
-static json_t* db_get_chat_messages_info_newest(const char* table_name, const char* timestamp, const unsigned int count);
+static bool db_create_chat_message_info(const json_t* j_data);
+static json_t* db_get_chat_messages_info_newest(const char* uuid_room, const char* timestamp, const unsigned int count);
+static bool db_create_chat_room_purge_info(const char* uuid_room);
 
 static void execute_callbacks_room(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static void execute_callbacks_userroom(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
@@ -73,7 +123,6 @@ static bool delete_room_member(const char* uuid_room, const char* uuid_user);
 static char* create_default_chatroom_name(const json_t* j_data);
 
 static char* get_room_uuid_by_type_members(enum EN_CHAT_ROOM_TYPE type, json_t* j_members);
-static char* get_message_table_by_userroom(const char* uuid_userroom);
 
 static bool is_room_exist(const char* uuid);
 static bool is_userroom_exist(const char* uuid);
@@ -102,6 +151,13 @@ bool chat_init_handler(void)
     return false;
   }
 
+  // init retention
+  ret = init_retention();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate retention.");
+    return false;
+  }
+
   return true;
 }
 
@@ -109,6 +165,8 @@ bool chat_term_handler(void)
 {
   int ret;
 
+  term_retention();
+
   ret = term_callbacks();
   if(ret == false) {
     slog(LOG_NOTICE, "Could not terminate callbacks.");
@@ -150,6 +208,496 @@ static bool term_callbacks(void)
   return true;
 }
 
+/**
+ * Initiate chat message retention.
+ * Registers the retention step timer.
+ * @return
+ */
+static bool init_retention(void)
+{
+  long long interval;
+  struct timeval tm_interval;
+  struct event* ev;
+
+  term_retention();
+
+  g_chat_retention.days = config_get_value_number("chat", "retention_days", 0);
+  g_chat_retention.count = config_get_value_number("chat", "retention_count", 0);
+  g_chat_retention.batch_size = config_get_value_number("chat", "retention_batch_size", 1);
+  g_chat_retention.room_count = config_get_value_number("chat", "retention_room_count", 1);
+  g_chat_retention.vacuum_pages = config_get_value_number("chat", "vacuum_pages", 0);
+  interval = config_get_value_number("chat", "retention_interval", 1);
+
+  slog(LOG_NOTICE, "Chat retention info. days[%d], count[%d], interval[%lld], batch_size[%d], room_count[%d], vacuum_pages[%d]",
+      g_chat_retention.days,
+      g_chat_retention.count,
+      interval,
+      g_chat_retention.batch_size,
+      g_chat_retention.room_count,
+      g_chat_retention.vacuum_pages
+      );
+
+  // the room purge runs regardless of the policy.
+  tm_interval.tv_sec = interval / DEF_ONE_SEC_IN_MICRO_SEC;
+  tm_interval.tv_usec = interval % DEF_ONE_SEC_IN_MICRO_SEC;
+  ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_chat_retention, NULL);
+  if(ev == NULL) {
+    slog(LOG_ERR, "Could not create event for the chat retention.");
+    return false;
+  }
+  event_add(ev, &tm_interval);
+  event_add_handler(ev);
+
+  return true;
+}
+
+static void term_retention(void)
+{
+  sfree(g_chat_retention.cursor_room);
+  memset(&g_chat_retention, 0x00, sizeof(g_chat_retention));
+}
+
+/**
+ * Retention step.
+ * Deletes at most batch_size messages in the order of
+ * the deleted rooms, the days policy and the count policy.
+ * Then releases the free pages by the incremental vacuum.
+ */
+static void cb_chat_retention(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  int limit;
+  int ret;
+
+  g_chat_retention.steps++;
+  limit = g_chat_retention.batch_size;
+
+  ret = retention_purge_rooms(limit);
+  if(ret > 0) {
+    g_chat_retention.deleted_room += ret;
+    limit -= ret;
+  }
+
+  if((limit > 0) && (g_chat_retention.days > 0)) {
+    ret = retention_delete_by_days(limit);
+    if(ret > 0) {
+      g_chat_retention.deleted_days += ret;
+      limit -= ret;
+    }
+  }
+
+  if((limit > 0) && (g_chat_retention.count > 0)) {
+    ret = retention_delete_by_count(limit);
+    if(ret > 0) {
+      g_chat_retention.deleted_count += ret;
+      limit -= ret;
+    }
+  }
+
+  if(g_chat_retention.vacuum_pages > 0) {
+    ret = retention_vacuum();
+    if(ret > 0) {
+      g_chat_retention.vacuumed_pages += ret;
+    }
+  }
+
+  if(limit < g_chat_retention.batch_size) {
+    slog(LOG_DEBUG, "Deleted chat messages. count[%d]", g_chat_retention.batch_size - limit);
+  }
+}
+
+/**
+ * Delete the messages of the deleted rooms.
+ * @param limit
+ * @return count of deleted messages. -1 if failed.
+ */
+static int retention_purge_rooms(int limit)
+{
+  int deleted;
+  int ret;
+  char* sql;
+  char* uuid_room;
+  json_t* j_tmp;
+
+  deleted = 0;
+  while(deleted < limit) {
+    j_tmp = resource_get_file_items_by_sql("select uuid_room from " DEF_DB_TABLE_CHAT_ROOM_PURGE " limit 1;");
+    if(j_tmp == NULL) {
+      slog(LOG_ERR, "Could not get chat_room_purge info.");
+      return -1;
+    }
+
+    if(json_array_size(j_tmp) == 0) {
+      json_decref(j_tmp);
+      break;
+    }
+    uuid_room = strdup(json_string_value(json_object_get(json_array_get(j_tmp, 0), "uuid_room")));
+    json_decref(j_tmp);
+
+    asprintf(&sql, "delete from " DEF_DB_TABLE_CHAT_MESSAGE " where rowid in ("
+        "select rowid from " DEF_DB_TABLE_CHAT_MESSAGE " where uuid_room = '%s' limit %d);",
+        uuid_room,
+        limit - deleted
+        );
+    ret = resource_exec_file_sql_changes(sql);
+    sfree(sql);
+    if(ret < 0) {
+      slog(LOG_ERR, "Could not delete messages of deleted room. uuid_room[%s]", uuid_room);
+      sfree(uuid_room);
+      return -1;
+    }
+    deleted += ret;
+
+    // more messages left
+    if(deleted >= limit) {
+      sfree(uuid_room);
+      break;
+    }
+
+    // no more messages
+    resource_delete_file_items_string(DEF_DB_TABLE_CHAT_ROOM_PURGE, "uuid_room", uuid_room);
+    slog(LOG_INFO, "Purged all messages of deleted room. uuid_room[%s]", uuid_room);
+    sfree(uuid_room);
+  }
+
+  return deleted;
+}
+
+/**
+ * Delete the messages which are older than the retention days.
+ * @param limit
+ * @return count of deleted messages. -1 if failed.
+ */
+static int retention_delete_by_days(int limit)
+{
+  char timestr[128];
+  char* sql;
+  time_t tt;
+  struct tm tm;
+  int ret;
+  int idx;
+  json_t* j_rooms;
+  json_t* j_room;
+
+  tt = time(NULL) - ((time_t)g_chat_retention.days * 86400);
+  gmtime_r(&tt, &tm);
+  strftime(timestr, sizeof(timestr), "%Y-%m-%dT%H:%M:%S", &tm);
+
+  // get the rooms of the messages to be deleted
+  ret = asprintf(&sql, "select distinct uuid_room from ("
+      "select uuid_room from " DEF_DB_TABLE_CHAT_MESSAGE " where tm_create < '%s' limit %d);",
+      timestr,
+      limit
+      );
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not create sql.");
+    return -1;
+  }
+  j_rooms = resource_get_file_items_by_sql(sql);
+  sfree(sql);
+  if(j_rooms == NULL) {
+    slog(LOG_ERR, "Could not get rooms of old chat messages.");
+    return -1;
+  }
+
+  if(json_array_size(j_rooms) == 0) {
+    json_decref(j_rooms);
+    return 0;
+  }
+
+  asprintf(&sql, "delete from " DEF_DB_TABLE_CHAT_MESSAGE " where rowid in ("
+      "select rowid from " DEF_DB_TABLE_CHAT_MESSAGE " where tm_create < '%s' limit %d);",
+      timestr,
+      limit
+      );
+  ret = resource_exec_file_sql_changes(sql);
+  sfree(sql);
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not delete old chat messages.");
+    json_decref(j_rooms);
+    return -1;
+  }
+
+  // refresh the message summary of the rooms
+  json_array_foreach(j_rooms, idx, j_room) {
+    retention_refresh_userrooms(json_string_value(json_object_get(j_room, "uuid_room")));
+  }
+  json_decref(j_rooms);
+
+  return ret;
+}
+
+/**
+ * Delete the messages which exceed the retention count of the room.
+ * Checks at most room_count rooms from the last checked room.
+ * @param limit
+ * @return count of deleted messages. -1 if failed.
+ */
+static int retention_delete_by_count(int limit)
+{
+  int deleted;
+  int ret;
+  int idx;
+  char* sql;
+  const char* uuid_room;
+  json_t* j_rooms;
+  json_t* j_room;
+
+  asprintf(&sql, "select uuid from " DEF_DB_TABLE_CHAT_ROOM " where uuid > '%s' order by uuid limit %d;",
+      g_chat_retention.cursor_room? : "",
+      g_chat_retention.room_count
+      );
+  j_rooms = resource_get_file_items_by_sql(sql);
+  sfree(sql);
+  if(j_rooms == NULL) {
+    slog(LOG_ERR, "Could not get chat rooms info.");
+    return -1;
+  }
+
+  // checked all rooms. start over from the next step.
+  if(json_array_size(j_rooms) < (size_t)g_chat_retention.room_count) {
+    sfree(g_chat_retention.cursor_room);
+  }
+
+  deleted = 0;
+  json_array_foreach(j_rooms, idx, j_room) {
+    uuid_room = json_string_value(json_object_get(j_room, "uuid"));
+    if(uuid_room == NULL) {
+      continue;
+    }
+
+    asprintf(&sql, "delete from " DEF_DB_TABLE_CHAT_MESSAGE " where rowid in ("
+        "select rowid from " DEF_DB_TABLE_CHAT_MESSAGE " where uuid_room = '%s'"
+        " order by tm_create desc limit %d offset %d);",
+        uuid_room,
+        limit - deleted,
+        g_chat_retention.count
+        );
+    ret = resource_exec_file_sql_changes(sql);
+    sfree(sql);
+    if(ret < 0) {
+      slog(LOG_ERR, "Could not delete exceeded chat messages. uuid_room[%s]", uuid_room);
+      break;
+    }
+    deleted += ret;
+
+    // refresh the message summary of the room
+    if(ret > 0) {
+      retention_refresh_userrooms(uuid_room);
+    }
+
+    // more messages left. continue from this room at the next step.
+    if(deleted >= limit) {
+      break;
+    }
+
+    if(json_array_size(j_rooms) == (size_t)g_chat_retention.room_count) {
+      sfree(g_chat_retention.cursor_room);
+      g_chat_retention.cursor_room = strdup(uuid_room);
+    }
+  }
+  json_decref(j_rooms);
+
+  return deleted;
+}
+
+/**
+ * Refresh the message summary of all userrooms of the given room
+ * after the room's messages were deleted.
+ * last_message is the newest remaining message.
+ * unread_count does not count the deleted messages.
+ * @param uuid_room
+ * @return
+ */
+static bool retention_refresh_userrooms(const char* uuid_room)
+{
+  int ret;
+  char* sql;
+  char* tmp;
+  const char* uuid_message;
+  json_t* j_tmp;
+  json_t* j_message;
+
+  if(uuid_room == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  // get the newest remaining message
+  ret = asprintf(&sql, "select uuid from " DEF_DB_TABLE_CHAT_MESSAGE " where uuid_room = '%s'"
+      " order by tm_create desc limit 1;",
+      uuid_room
+      );
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not create sql.");
+    return false;
+  }
+  j_tmp = resource_get_file_items_by_sql(sql);
+  sfree(sql);
+  if(j_tmp == NULL) {
+    slog(LOG_ERR, "Could not get the newest chat message. uuid_room[%s]", uuid_room);
+    return false;
+  }
+
+  j_message = NULL;
+  uuid_message = json_string_value(json_object_get(json_array_get(j_tmp, 0), "uuid"));
+  if(uuid_message != NULL) {
+    j_message = chat_get_message_info(uuid_message);
+  }
+  json_decref(j_tmp);
+
+  if(j_message != NULL) {
+    j_tmp = json_pack("{s:O, s:O}",
+        "last_message",     j_message,
+        "last_message_tm",  json_object_get(j_message, "tm_create")
+        );
+    json_decref(j_message);
+  }
+  else {
+    // no more messages
+    j_tmp = json_pack("{s:n, s:n}",
+        "last_message",
+        "last_message_tm"
+        );
+  }
+  tmp = db_ctx_get_update_str(j_tmp);
+  json_decref(j_tmp);
+  if(tmp == NULL) {
+    slog(LOG_ERR, "Could not create update string.");
+    return false;
+  }
+
+  // the unread messages are the other's messages after the last read.
+  ret = asprintf(&sql, "update " DEF_DB_TABLE_CHAT_USERROOM " set %s, "
+      "unread_count = min(unread_count, ("
+      "select count(*) from " DEF_DB_TABLE_CHAT_MESSAGE " as m"
+      " where m.uuid_room = " DEF_DB_TABLE_CHAT_USERROOM ".uuid_room"
+      " and m.uuid_owner != " DEF_DB_TABLE_CHAT_USERROOM ".uuid_user"
+      " and (" DEF_DB_TABLE_CHAT_USERROOM ".last_read_tm is null or m.tm_create > " DEF_DB_TABLE_CHAT_USERROOM ".last_read_tm))) "
+      "where uuid_room = '%s';",
+      tmp,
+      uuid_room
+      );
+  sfree(tmp);
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not create sql.");
+    return false;
+  }
+
+  ret = resource_exec_file_sql(sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not refresh chat_userroom message summary. uuid_room[%s]", uuid_room);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Release the free pages of the file database.
+ * Works only when the database's auto_vacuum is incremental.
+ * @return count of released pages. -1 if failed.
+ */
+static int retention_vacuum(void)
+{
+  int before;
+  int after;
+  int ret;
+  char* sql;
+
+  // 2: incremental
+  if(get_file_pragma_value("auto_vacuum") != 2) {
+    return 0;
+  }
+
+  before = get_file_pragma_value("freelist_count");
+  if(before <= 0) {
+    return before;
+  }
+
+  asprintf(&sql, "pragma incremental_vacuum(%d);", g_chat_retention.vacuum_pages);
+  ret = resource_exec_file_sql(sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not execute incremental vacuum.");
+    return -1;
+  }
+
+  after = get_file_pragma_value("freelist_count");
+  if(after < 0) {
+    return -1;
+  }
+
+  return before - after;
+}
+
+/**
+ * Returns the integer pragma value of the file database.
+ * @param name
+ * @return -1 if failed.
+ */
+static int get_file_pragma_value(const char* name)
+{
+  char* sql;
+  json_t* j_tmp;
+  int ret;
+
+  asprintf(&sql, "pragma %s;", name);
+  j_tmp = resource_get_file_items_by_sql(sql);
+  sfree(sql);
+  if(j_tmp == NULL) {
+    return -1;
+  }
+
+  ret = json_integer_value(json_object_get(json_array_get(j_tmp, 0), name));
+  json_decref(j_tmp);
+
+  return ret;
+}
+
+/**
+ * Returns the chat message retention status.
+ * @return
+ */
+json_t* chat_get_retention_status(void)
+{
+  json_t* j_res;
+  json_t* j_tmp;
+  int pending;
+
+  j_tmp = resource_get_file_items_by_sql("select count(*) as count from " DEF_DB_TABLE_CHAT_ROOM_PURGE ";");
+  pending = json_integer_value(json_object_get(json_array_get(j_tmp, 0), "count"));
+  json_decref(j_tmp);
+
+  j_res = json_pack("{"
+      "s:i, s:i, s:i, s:i, s:i, "
+      "s:I, s:I, s:I, s:I, s:I, "
+      "s:i, "
+      "s:i, s:i, s:i"
+      "}",
+
+      "retention_days",         g_chat_retention.days,
+      "retention_count",        g_chat_retention.count,
+      "retention_batch_size",   g_chat_retention.batch_size,
+      "retention_room_count",   g_chat_retention.room_count,
+      "vacuum_pages",           g_chat_retention.vacuum_pages,
+
+      "steps",                  (json_int_t)g_chat_retention.steps,
+      "deleted_room",           (json_int_t)g_chat_retention.deleted_room,
+      "deleted_days",           (json_int_t)g_chat_retention.deleted_days,
+      "deleted_count",          (json_int_t)g_chat_retention.deleted_count,
+      "vacuumed_pages",         (json_int_t)g_chat_retention.vacuumed_pages,
+
+      "pending_rooms",          pending,
+
+      "auto_vacuum",            get_file_pragma_value("auto_vacuum"),
+      "page_count",             get_file_pragma_value("page_count"),
+      "freelist_count",         get_file_pragma_value("freelist_count")
+      );
+
+  return j_res;
+}
+
 /**
  * Initiate chat databases
  * @return
@@ -174,6 +722,27 @@ static bool init_chat_databases(void)
     return false;
   }
 
+  // init message
+  ret = init_chat_database_message();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate database message.");
+    return false;
+  }
+
+  // init room purge
+  ret = init_chat_database_room_purge();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate database room purge.");
+    return false;
+  }
+
+  // migrate old per-room message tables
+  ret = migrate_chat_message_tables();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not migrate chat message tables.");
+    return false;
+  }
+
   return true;
 }
 
@@ -191,7 +760,6 @@ static bool init_chat_database_room(void)
 
     // basic info
     "   uuid              varchar(255),"    // uuid(chat_room)
-    "   message_table     varchar(255),"    // chat message table name
     "   type              int,"             // chat room type. see EN_CHAT_ROOM_TYPE
 
     // owner, creator
@@ -238,6 +806,12 @@ static bool init_chat_database_userroom(void)
     "   name      varchar(255),"    // room name
     "   detail    varchar(1023),"   // room detail
 
+    // message summary
+    "   unread_count      int default 0,"   // count of messages after the last read
+    "   last_read_tm      datetime(6),"     // tm_create of the last read message
+    "   last_message      text,"            // last message info. json
+    "   last_message_tm   datetime(6),"     // tm_create of the last message
+
     // timestamp. UTC."
     "   tm_create     datetime(6),"  // create time
     "   tm_update     datetime(6),"  // latest updated time
@@ -252,46 +826,79 @@ static bool init_chat_database_userroom(void)
     return false;
   }
 
+  // message summary columns for the database created by the old version
+  ret = resource_add_file_column(DEF_DB_TABLE_CHAT_USERROOM, "unread_count", "int default 0");
+  ret = ret && resource_add_file_column(DEF_DB_TABLE_CHAT_USERROOM, "last_read_tm", "datetime(6)");
+  ret = ret && resource_add_file_column(DEF_DB_TABLE_CHAT_USERROOM, "last_message", "text");
+  ret = ret && resource_add_file_column(DEF_DB_TABLE_CHAT_USERROOM, "last_message_tm", "datetime(6)");
+  if(ret == false) {
+    slog(LOG_ERR, "Could not upgrade database. database[%s]", DEF_DB_TABLE_CHAT_USERROOM);
+    return false;
+  }
+
+  // message summary is updated by room
+  ret = resource_exec_file_sql(
+      "create index if not exists idx_" DEF_DB_TABLE_CHAT_USERROOM "_room"
+      " on " DEF_DB_TABLE_CHAT_USERROOM "(uuid_room);"
+      );
+  if(ret == false) {
+    slog(LOG_ERR, "Could not create index. database[%s]", DEF_DB_TABLE_CHAT_USERROOM);
+    return false;
+  }
+
   return true;
 }
 
-static bool db_create_table_chat_message(const char* table_name)
+/**
+ * Initiate chat database. message.
+ * All of the chat room's messages are stored in the one table.
+ * The (uuid_room, tm_create) index makes the room history paging
+ * independent from the history length.
+ * @return
+ */
+static bool init_chat_database_message(void)
 {
   int ret;
-  char* create_table;
+  const char* create_table;
+  const char* create_index;
 
-  if(table_name == NULL) {
-    slog(LOG_WARNING, "Wrong input parameter.");
-    return false;
-  }
-  slog(LOG_DEBUG, "Fired create_table_chat_message. table_name[%s]", table_name);
+  create_table =
+    "create table if not exists " DEF_DB_TABLE_CHAT_MESSAGE " ("
 
-  asprintf(&create_table,
-      "create table %s ("
+    // basic info
+    "   uuid              varchar(255),"    // uuid
+    "   uuid_room         varchar(255),"    // uuid of room
+    "   uuid_owner        varchar(255),"    // message owner's uuid
 
-      // basic info
-      "   uuid              varchar(255),"    // uuid
-      "   uuid_room         varchar(255),"    // uuid of room
-      "   uuid_owner        varchar(255),"    // message owner's uuid
+    "   username          varchar(255),"
+    "   name              varchar(255),"
 
-      "   username          varchar(255),"
-      "   name              varchar(255),"
+    "   message           text,"            // message
 
-      "   message           text,"            // message
+    // timestamp. UTC."
+    "   tm_create     datetime(6),"   // create time
 
-      // timestamp. UTC."
-      "   tm_create     datetime(6),"   // create time
+    "   primary key(uuid)"
+    ");";
 
-      "   primary key(uuid)"
-      ");",
-      table_name
-      );
+  create_index =
+    "create index if not exists idx_" DEF_DB_TABLE_CHAT_MESSAGE "_room_tm_create"
+    " on " DEF_DB_TABLE_CHAT_MESSAGE "(uuid_room, tm_create);"
+
+    // for the retention by days
+    "create index if not exists idx_" DEF_DB_TABLE_CHAT_MESSAGE "_tm_create"
+    " on " DEF_DB_TABLE_CHAT_MESSAGE "(tm_create);";
 
   // execute
   ret = resource_exec_file_sql(create_table);
-  sfree(create_table);
   if(ret == false) {
-    slog(LOG_ERR, "Could not initiate database. database[%s]", table_name);
+    slog(LOG_ERR, "Could not initiate database. database[%s]", DEF_DB_TABLE_CHAT_MESSAGE);
+    return false;
+  }
+
+  ret = resource_exec_file_sql(create_index);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not create index. database[%s]", DEF_DB_TABLE_CHAT_MESSAGE);
     return false;
   }
 
@@ -299,33 +906,85 @@ static bool db_create_table_chat_message(const char* table_name)
 }
 
 /**
- * Delete chat message table of given table name.
- * @param table_name
+ * Initiate chat database. room purge.
+ * The messages of the deleted rooms are deleted by the retention step.
  * @return
  */
-static bool db_delete_table_chat_message(const char* table_name)
+static bool init_chat_database_room_purge(void)
 {
   int ret;
-  char* drop_table;
+  const char* create_table;
 
-  if(table_name == NULL) {
-    slog(LOG_WARNING, "Wrong input parameter.");
+  create_table =
+    "create table if not exists " DEF_DB_TABLE_CHAT_ROOM_PURGE " ("
+    "   uuid_room     varchar(255),"    // uuid of deleted room
+    "   tm_create     datetime(6),"     // room delete time
+
+    "   primary key(uuid_room)"
+    ");";
+
+  ret = resource_exec_file_sql(create_table);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate database. database[%s]", DEF_DB_TABLE_CHAT_ROOM_PURGE);
     return false;
   }
-  slog(LOG_DEBUG, "Fired delete_table_chat_message. table_name[%s]", table_name);
 
-  // todo: validate table_name
+  return true;
+}
 
-  asprintf(&drop_table, "drop table %s", table_name);
+/**
+ * Move the messages of old per-room message tables(chat_<uuid>_message)
+ * into the chat_message table and drop the old tables.
+ * Each table is moved in a transaction, so it's safe to be interrupted.
+ * Does nothing if there's no old table.
+ * @return
+ */
+static bool migrate_chat_message_tables(void)
+{
+  int ret;
+  int idx;
+  json_t* j_tables;
+  json_t* j_table;
+  const char* table_name;
+  char* sql;
 
-  // execute
-  ret = resource_exec_file_sql(drop_table);
-  sfree(drop_table);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not delete chat_message table. table_name[%s]", table_name);
+  j_tables = resource_get_file_detail_items_by_condtion("sqlite_master",
+      "where type = 'table' and name like '" DEF_DB_CHAT_MESSAGE_TABLE_PATTERN "' escape '\\'"
+      );
+  if(j_tables == NULL) {
+    slog(LOG_ERR, "Could not get old chat message tables info.");
     return false;
   }
 
+  json_array_foreach(j_tables, idx, j_table) {
+    table_name = json_string_value(json_object_get(j_table, "name"));
+    if((table_name == NULL) || (strcmp(table_name, DEF_DB_TABLE_CHAT_MESSAGE) == 0)) {
+      continue;
+    }
+    slog(LOG_NOTICE, "Migrating chat message table. table_name[%s]", table_name);
+
+    asprintf(&sql,
+        "begin transaction;"
+        "insert or ignore into " DEF_DB_TABLE_CHAT_MESSAGE
+        " (uuid, uuid_room, uuid_owner, username, name, message, tm_create)"
+        " select uuid, uuid_room, uuid_owner, username, name, message, tm_create from %s;"
+        "drop table %s;"
+        "commit;",
+        table_name,
+        table_name
+        );
+
+    ret = resource_exec_file_sql(sql);
+    sfree(sql);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not migrate chat message table. table_name[%s]", table_name);
+      resource_exec_file_sql("rollback;");
+      json_decref(j_tables);
+      return false;
+    }
+  }
+  json_decref(j_tables);
+
   return true;
 }
 
@@ -417,12 +1076,96 @@ static json_t* db_get_chat_userrooms_info_by_roomuuid(const char* uuid_room)
     return NULL;
   }
 
-  j_res = resource_get_file_detail_items_key_string(DEF_DB_TABLE_CHAT_USERROOM, "uuid_room", uuid_room);
-  if(j_res == NULL) {
-    slog(LOG_ERR, "Could not get list of chat_userrooms info. uuid_room[%s]", uuid_room);
+  j_res = resource_get_file_detail_items_key_string(DEF_DB_TABLE_CHAT_USERROOM, "uuid_room", uuid_room);
+  if(j_res == NULL) {
+    slog(LOG_ERR, "Could not get list of chat_userrooms info. uuid_room[%s]", uuid_room);
+    return NULL;
+  }
+
+  return j_res;
+}
+
+/**
+ * Get list of chat_userrooms info with the room info of given user_uuid.
+ * Gets all of the user's userrooms and rooms in one query.
+ * @param uuid_user
+ * @return
+ */
+static json_t* db_get_chat_userrooms_summary_by_useruuid(const char* uuid_user)
+{
+  json_t* j_res;
+  json_t* j_records;
+  json_t* j_record;
+  json_t* j_tmp;
+  char* sql;
+  int idx;
+
+  if(uuid_user == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  asprintf(&sql, "select"
+      " u.uuid, u.name, u.detail,"
+      " u.unread_count, u.last_read_tm, u.last_message, u.last_message_tm,"
+      " u.tm_create, u.tm_update,"
+      " r.uuid as room_uuid, r.type as room_type,"
+      " r.uuid_creator as room_uuid_creator, r.uuid_owner as room_uuid_owner,"
+      " r.members as room_members,"
+      " r.tm_create as room_tm_create, r.tm_update as room_tm_update"
+      " from %s as u inner join %s as r on u.uuid_room = r.uuid"
+      " where u.uuid_user = '%s';",
+      DEF_DB_TABLE_CHAT_USERROOM,
+      DEF_DB_TABLE_CHAT_ROOM,
+      uuid_user
+      );
+
+  j_records = resource_get_file_items_by_sql(sql);
+  sfree(sql);
+  if(j_records == NULL) {
+    slog(LOG_ERR, "Could not get list of chat_userrooms summary. uuid_user[%s]", uuid_user);
     return NULL;
   }
 
+  j_res = json_array();
+  json_array_foreach(j_records, idx, j_record) {
+    j_tmp = json_pack("{"
+        "s:O, s:O, s:O, "
+        "s:O, s:O, s:O, s:O, "
+        "s:O, s:O, "
+        "s:{s:O, s:O, s:O, s:O, s:O, s:O, s:O}"
+        "}",
+
+        "uuid",             json_object_get(j_record, "uuid"),
+        "name",             json_object_get(j_record, "name"),
+        "detail",           json_object_get(j_record, "detail"),
+
+        "unread_count",     json_object_get(j_record, "unread_count"),
+        "last_read_tm",     json_object_get(j_record, "last_read_tm"),
+        "last_message",     json_object_get(j_record, "last_message"),
+        "last_message_tm",  json_object_get(j_record, "last_message_tm"),
+
+        "tm_create",        json_object_get(j_record, "tm_create"),
+        "tm_update",        json_object_get(j_record, "tm_update"),
+
+        "room",
+          "uuid",           json_object_get(j_record, "room_uuid"),
+          "type",           json_object_get(j_record, "room_type"),
+          "uuid_creator",   json_object_get(j_record, "room_uuid_creator"),
+          "uuid_owner",     json_object_get(j_record, "room_uuid_owner"),
+          "members",        json_object_get(j_record, "room_members"),
+          "tm_create",      json_object_get(j_record, "room_tm_create"),
+          "tm_update",      json_object_get(j_record, "room_tm_update")
+        );
+    if(j_tmp == NULL) {
+      slog(LOG_NOTICE, "Could not create userroom summary info.");
+      continue;
+    }
+
+    json_array_append_new(j_res, j_tmp);
+  }
+  json_decref(j_records);
+
   return j_res;
 }
 
@@ -536,6 +1279,111 @@ static bool db_delete_chat_userroom_info(const char* uuid)
   return true;
 }
 
+/**
+ * Update the message summary of all userrooms of the given message's room.
+ * The message owner's userroom becomes read, others' unread count increase.
+ * @param j_message
+ * @return
+ */
+static bool db_update_chat_userrooms_last_message(const json_t* j_message)
+{
+  int ret;
+  char* sql;
+  char* tmp;
+  const char* uuid_room;
+  const char* uuid_owner;
+  const char* tm_create;
+  json_t* j_tmp;
+
+  if(j_message == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  uuid_room = json_string_value(json_object_get(j_message, "uuid_room"));
+  uuid_owner = json_string_value(json_object_get(j_message, "uuid_owner"));
+  tm_create = json_string_value(json_object_get(j_message, "tm_create"));
+  if((uuid_room == NULL) || (uuid_owner == NULL) || (tm_create == NULL)) {
+    slog(LOG_ERR, "Could not get message info.");
+    return false;
+  }
+
+  j_tmp = json_pack("{s:O, s:s}",
+      "last_message",     j_message,
+      "last_message_tm",  tm_create
+      );
+  tmp = db_ctx_get_update_str(j_tmp);
+  json_decref(j_tmp);
+  if(tmp == NULL) {
+    slog(LOG_ERR, "Could not create update string.");
+    return false;
+  }
+
+  asprintf(&sql, "update %s set %s, "
+      "unread_count = case when uuid_user = '%s' then 0 else unread_count + 1 end, "
+      "last_read_tm = case when uuid_user = '%s' then '%s' else last_read_tm end "
+      "where uuid_room = '%s';",
+      DEF_DB_TABLE_CHAT_USERROOM,
+      tmp,
+      uuid_owner,
+      uuid_owner,
+      tm_create,
+      uuid_room
+      );
+  sfree(tmp);
+
+  ret = resource_exec_file_sql(sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not update chat_userroom message summary. uuid_room[%s]", uuid_room);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Reset the unread count of the given userroom.
+ * @param uuid
+ * @return
+ */
+static bool db_update_chat_userroom_read(const char* uuid)
+{
+  int ret;
+  char* sql;
+  json_t* j_tmp;
+
+  if(uuid == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  asprintf(&sql, "update %s set unread_count = 0, last_read_tm = last_message_tm where uuid = '%s';",
+      DEF_DB_TABLE_CHAT_USERROOM,
+      uuid
+      );
+
+  ret = resource_exec_file_sql(sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not update chat_userroom read info. uuid[%s]", uuid);
+    return false;
+  }
+
+  // get updated info
+  j_tmp = chat_get_userroom(uuid);
+  if(j_tmp == NULL) {
+    slog(LOG_ERR, "Could not get updated userroom info. uuid[%s]", uuid);
+    return false;
+  }
+
+  // execute callbacks
+  execute_callbacks_userroom(EN_RESOURCE_UPDATE, j_tmp);
+  json_decref(j_tmp);
+
+  return true;
+}
+
 static bool db_create_chat_room_info(const json_t* j_data)
 {
   int ret;
@@ -944,6 +1792,29 @@ json_t* chat_get_userrooms_by_useruuid(const char* user_uuid)
   return j_res;
 }
 
+/**
+ * Get list of given user's userrooms with the room info and message summary.
+ * Each item has the room info in the "room".
+ * @param uuid_user
+ * @return
+ */
+json_t* chat_get_userrooms_summary_by_useruuid(const char* uuid_user)
+{
+  json_t* j_res;
+
+  if(uuid_user == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = db_get_chat_userrooms_summary_by_useruuid(uuid_user);
+  if(j_res == NULL) {
+    return NULL;
+  }
+
+  return j_res;
+}
+
 /**
  * Interface for get userroom info.
  * @param uuid
@@ -1287,7 +2158,6 @@ static bool create_room(
     const json_t* j_members
     )
 {
-  char* table_name;
   int ret;
   json_t* j_tmp;
   json_t* j_tmp_members;
@@ -1321,28 +2191,11 @@ static bool create_room(
     return false;
   }
 
-  // create table name for chat_message
-  table_name = db_create_tablename_chat_message(uuid);
-  if(table_name == NULL) {
-    slog(LOG_ERR, "Could not create table name.");
-    json_decref(j_tmp_members);
-    return false;
-  }
-
-  // create table for chat_message
-  ret = db_create_table_chat_message(table_name);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not create table for chat message. table_name[%s]", table_name);
-    json_decref(j_tmp_members);
-    sfree(table_name);
-    return false;
-  }
-
   // create request data
   timestamp = utils_get_utc_timestamp();
   j_tmp = json_pack("{"
       "s:s, s:s, s:s, "
-      "s:s, s:i, s:o, "
+      "s:i, s:o, "
 
       "s:s "
       "}",
@@ -1351,7 +2204,6 @@ static bool create_room(
       "uuid_creator",   uuid_user,
       "uuid_owner",     uuid_user,
 
-      "message_table",  table_name,
       "type",           type,
       "members",        j_tmp_members,
 
@@ -1364,11 +2216,8 @@ static bool create_room(
   json_decref(j_tmp);
   if(ret == false) {
     slog(LOG_ERR, "Could not create chat_room.");
-    db_delete_table_chat_message(table_name);
-    sfree(table_name);
     return false;
   }
-  sfree(table_name);
 
   return true;
 }
@@ -1399,8 +2248,6 @@ static json_t* get_room_by_type_members(enum EN_CHAT_ROOM_TYPE type, json_t* j_m
 bool chat_delete_room(const char* uuid)
 {
   int ret;
-  json_t* j_tmp;
-  const char* message_table;
 
   if(uuid == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1408,19 +2255,18 @@ bool chat_delete_room(const char* uuid)
   }
   slog(LOG_DEBUG, "Fired delete_chat_room. uuid[%s]", uuid);
 
-  j_tmp = db_get_chat_room_info(uuid);
-  if(j_tmp == NULL) {
+  ret = is_room_exist(uuid);
+  if(ret == false) {
     slog(LOG_ERR, "Could not get chat_room info. uuid[%s]", uuid);
     return false;
   }
 
-  // get message table name
-  message_table = json_string_value(json_object_get(j_tmp, "message_table"));
-  if(message_table != NULL) {
-    // delete
-    db_delete_table_chat_message(message_table);
+  // the messages are deleted by the retention step
+  ret = db_create_chat_room_purge_info(uuid);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not add the chat messages purge info. uuid[%s]", uuid);
+    return false;
   }
-  json_decref(j_tmp);
 
   // delete chat room
   ret = db_delete_chat_room_info(uuid);
@@ -1447,7 +2293,6 @@ static bool create_message(const char* uuid_message, const char* uuid_room, cons
   json_t* j_user;
   json_t* j_room;
   json_t* j_data;
-  const char* message_table;
 
   if((uuid_message == NULL) || (uuid_room == NULL) || (uuid_user == NULL) || (j_message == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1488,14 +2333,6 @@ static bool create_message(const char* uuid_message, const char* uuid_room, cons
     return false;
   }
 
-  // get message table
-  message_table = json_string_value(json_object_get(j_room, "message_table"));
-  if(message_table == NULL) {
-    slog(LOG_ERR, "Could not get message_table info.");
-    json_decref(j_room);
-    return false;
-  }
-
   // get user info
   j_user = user_get_userinfo_info(uuid_user);
   if(j_user == NULL) {
@@ -1527,7 +2364,7 @@ static bool create_message(const char* uuid_message, const char* uuid_room, cons
   sfree(timestamp);
 
   // create message
-  ret = db_create_chat_message_info(message_table, j_data);
+  ret = db_create_chat_message_info(j_data);
   json_decref(j_room);
   json_decref(j_user);
   json_decref(j_data);
@@ -1551,6 +2388,7 @@ bool chat_create_message_to_userroom(const char* uuid_message, const char* uuid_
   int ret;
   const char* uuid_room;
   json_t* j_userroom;
+  json_t* j_tmp;
 
   if((uuid_message == NULL) || (uuid_userroom == NULL) || (uuid_user == NULL) || (j_message == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1580,9 +2418,55 @@ bool chat_create_message_to_userroom(const char* uuid_message, const char* uuid_
 
   // create message
   ret = create_message(uuid_message, uuid_room, uuid_user, j_message);
-  json_decref(j_userroom);
   if(ret == false) {
     slog(LOG_ERR, "Could not create chat message. uuid_room[%s], uuid_user[%s]", uuid_room, uuid_user);
+    json_decref(j_userroom);
+    return false;
+  }
+  json_decref(j_userroom);
+
+  // get created message
+  j_tmp = chat_get_message_info(uuid_message);
+  if(j_tmp == NULL) {
+    slog(LOG_ERR, "Could not get created message info. uuid[%s]", uuid_message);
+    return false;
+  }
+
+  // update message summary of the room's userrooms
+  ret = db_update_chat_userrooms_last_message(j_tmp);
+  json_decref(j_tmp);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not update userrooms message summary. uuid_message[%s]", uuid_message);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Mark all messages of the given userroom as read.
+ * @param uuid_userroom
+ * @return
+ */
+bool chat_mark_read_userroom(const char* uuid_userroom)
+{
+  int ret;
+
+  if(uuid_userroom == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired chat_mark_read_userroom. uuid_userroom[%s]", uuid_userroom);
+
+  ret = is_userroom_exist(uuid_userroom);
+  if(ret == false) {
+    slog(LOG_NOTICE, "The given userroom info is not exist. uuid[%s]", uuid_userroom);
+    return false;
+  }
+
+  ret = db_update_chat_userroom_read(uuid_userroom);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not mark read the userroom. uuid[%s]", uuid_userroom);
     return false;
   }
 
@@ -1695,23 +2579,30 @@ char* chat_get_uuidroom_by_uuiduserroom(const char* uuid_userroom)
 json_t* chat_get_message_info_by_userroom(const char* uuid_message, const char* uuid_userroom)
 {
   json_t* j_res;
-  char* table_name;
+  json_t* j_data;
+  char* uuid_room;
 
   if((uuid_message == NULL) || (uuid_userroom == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
 
-  // get table_name
-  table_name = get_message_table_by_userroom(uuid_userroom);
-  if(table_name == NULL) {
-    slog(LOG_WARNING, "Could not get table name.");
+  // get room uuid
+  uuid_room = chat_get_uuidroom_by_uuiduserroom(uuid_userroom);
+  if(uuid_room == NULL) {
+    slog(LOG_WARNING, "Could not get room uuid info.");
     return NULL;
   }
 
   // get message
-  j_res = chat_get_message_info(table_name, uuid_message);
-  sfree(table_name);
+  j_data = json_pack("{s:s, s:s}",
+      "uuid",       uuid_message,
+      "uuid_room",  uuid_room
+      );
+  sfree(uuid_room);
+
+  j_res = resource_get_file_detail_item_by_obj(DEF_DB_TABLE_CHAT_MESSAGE, j_data);
+  json_decref(j_data);
   if(j_res == NULL) {
     return NULL;
   }
@@ -1729,9 +2620,7 @@ json_t* chat_get_message_info_by_userroom(const char* uuid_message, const char*
 json_t* chat_get_messages_newest_of_room(const char* uuid_room, const char* timestamp, const unsigned int count)
 {
   int ret;
-  json_t* j_room;
   json_t* j_res;
-  const char* table_name;
 
   if((uuid_room == NULL) || (timestamp == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1745,18 +2634,8 @@ json_t* chat_get_messages_newest_of_room(const char* uuid_room, const char* time
     return NULL;
   }
 
-  // get chat_room
-  j_room = db_get_chat_room_info(uuid_room);
-  if(j_room == NULL) {
-    slog(LOG_ERR, "Could not get chat room info.");
-    return NULL;
-  }
-
-  table_name = json_string_value(json_object_get(j_room, "message_table"));
-
   // get messages
-  j_res = db_get_chat_messages_info_newest(table_name, timestamp, count);
-  json_decref(j_room);
+  j_res = db_get_chat_messages_info_newest(uuid_room, timestamp, count);
   if(j_res == NULL) {
     slog(LOG_ERR, "Could not get chat messages. uuid[%s]", uuid_room);
     return NULL;
@@ -1766,23 +2645,21 @@ json_t* chat_get_messages_newest_of_room(const char* uuid_room, const char* time
 }
 
 /**
- * Get chat messages.
- * Order by newest first of given timestamp.
+ * Get chat message of given uuid.
  * @param uuid
- * @param count
  * @return
  */
-json_t* chat_get_message_info(const char* table_name, const char* uuid)
+json_t* chat_get_message_info(const char* uuid)
 {
   json_t* j_res;
 
-  if((table_name == NULL) || (uuid == NULL)) {
+  if(uuid == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
 
   // get info
-  j_res = resource_get_file_detail_item_key_string(table_name, "uuid", uuid);
+  j_res = resource_get_file_detail_item_key_string(DEF_DB_TABLE_CHAT_MESSAGE, "uuid", uuid);
   if(j_res == NULL) {
     slog(LOG_NOTICE, "Could not get message info.");
     return NULL;
@@ -1834,23 +2711,21 @@ json_t* chat_get_userroom_messages_newest(const char* uuid_userroom, const char*
   return j_res;
 }
 
-static bool db_create_chat_message_info(const char* table_name, const json_t* j_data)
+static bool db_create_chat_message_info(const json_t* j_data)
 {
   int ret;
   const char* uuid;
   json_t* j_tmp;
 
-  if((table_name == NULL) || (j_data == NULL)) {
+  if(j_data == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return false;
   }
 
-  // todo: need to validate table_name
-
   // insert info
-  ret = resource_insert_file_item(table_name, j_data);
+  ret = resource_insert_file_item(DEF_DB_TABLE_CHAT_MESSAGE, j_data);
   if(ret == false) {
-    slog(LOG_ERR, "Could not insert chat_room.");
+    slog(LOG_ERR, "Could not insert chat_message.");
     return false;
   }
 
@@ -1862,7 +2737,7 @@ static bool db_create_chat_message_info(const char* table_name, const json_t* j_
   }
 
   // get created info
-  j_tmp = chat_get_message_info(table_name, uuid);
+  j_tmp = chat_get_message_info(uuid);
   if(j_tmp == NULL) {
     slog(LOG_NOTICE, "Could not get created message info.");
     return false;
@@ -1877,55 +2752,67 @@ static bool db_create_chat_message_info(const char* table_name, const json_t* j_
 
 /**
  * Return the array of chat messages of given info.
- * @param table_name
+ * Keyset pagination on (uuid_room, tm_create) index.
+ * Reads only the given count of records regardless of the room's history length.
+ * @param uuid_room
  * @param timestamp
  * @param count
  * @return
  */
-static json_t* db_get_chat_messages_info_newest(const char* table_name, const char* timestamp, const unsigned int count)
+static json_t* db_get_chat_messages_info_newest(const char* uuid_room, const char* timestamp, const unsigned int count)
 {
   json_t* j_res;
   char* condition;
 
-  if((table_name == NULL) || (timestamp == NULL)) {
+  if((uuid_room == NULL) || (timestamp == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
 
   // create condition
-  asprintf(&condition, "where tm_create < '%s' order by tm_create desc limit %u", timestamp, count);
+  asprintf(&condition, "where uuid_room = '%s' and tm_create < '%s' order by tm_create desc limit %u",
+      uuid_room,
+      timestamp,
+      count
+      );
 
-  j_res = resource_get_file_detail_items_by_condtion(table_name, condition);
+  j_res = resource_get_file_detail_items_by_condtion(DEF_DB_TABLE_CHAT_MESSAGE, condition);
   sfree(condition);
 
   return j_res;
 }
 
 /**
- * Create string for chat_message table name.
- * @param uuid
+ * Delete all chat messages of given room.
+ * @param uuid_room
  * @return
  */
-static char* db_create_tablename_chat_message(const char* uuid)
+static bool db_create_chat_room_purge_info(const char* uuid_room)
 {
-  char* res;
-  char* tmp;
+  int ret;
+  char* timestamp;
+  json_t* j_data;
 
-  if(uuid == NULL) {
+  if(uuid_room == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
-    return NULL;
+    return false;
   }
 
-  tmp = utils_string_replace_char(uuid, '-', '_');
-  if(tmp == NULL) {
-    slog(LOG_ERR, "Could not create table name.");
-    return NULL;
-  }
+  timestamp = utils_get_utc_timestamp();
+  j_data = json_pack("{s:s, s:s}",
+      "uuid_room",  uuid_room,
+      "tm_create",  timestamp
+      );
+  sfree(timestamp);
 
-  asprintf(&res, "chat_%s_message", tmp);
-  sfree(tmp);
+  ret = resource_insrep_file_item(DEF_DB_TABLE_CHAT_ROOM_PURGE, j_data);
+  json_decref(j_data);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not create chat_room_purge info. uuid_room[%s]", uuid_room);
+    return false;
+  }
 
-  return res;
+  return true;
 }
 
 static bool is_room_exist(const char* uuid)
@@ -2181,61 +3068,6 @@ bool chat_is_user_userroom_owned(const char* uuid_user, const char* uuid_userroo
   return true;
 }
 
-/**
- * Return the table name string of given userroom
- * @param uuid_userroom
- * @return
- */
-static char* get_message_table_by_userroom(const char* uuid_userroom)
-{
-  char* res;
-  json_t* j_userroom;
-  json_t* j_room;
-  const char* uuid_room;
-  const char* table_name;
-
-  if(uuid_userroom == NULL) {
-    slog(LOG_WARNING, "Wrong input parameter.");
-    return NULL;
-  }
-
-  // get userroom
-  j_userroom = chat_get_userroom(uuid_userroom);
-  if(j_userroom == NULL) {
-    slog(LOG_NOTICE, "Could not get userroom info.");
-    return NULL;
-  }
-
-  // get uuid_room
-  uuid_room = json_string_value(json_object_get(j_userroom, "uuid_room"));
-  if(uuid_room == NULL) {
-    slog(LOG_ERR, "Could not get room uuid info.");
-    json_decref(j_userroom);
-    return NULL;
-  }
-
-  // get room
-  j_room = chat_get_room(uuid_room);
-  json_decref(j_userroom);
-  if(j_room == NULL) {
-    slog(LOG_ERR, "Could not get room info.");
-    return NULL;
-  }
-
-  // get table_name
-  table_name = json_string_value(json_object_get(j_room, "message_table"));
-  if(table_name == NULL) {
-    slog(LOG_ERR, "Could not get table name.");
-    json_decref(j_room);
-    return NULL;
-  }
-
-  res = strdup(table_name);
-  json_decref(j_room);
-
-  return res;
-}
-
 /**
  * Execute the registered callbacks for room
  * @param j_data
@@ -36,7 +36,7 @@ static json_t* get_manager_info(const json_t* j_user);
 static bool update_manager_info(const json_t* j_user, const json_t* j_data);
 
 // user
-static json_t* get_users_all(void);
+static json_t* get_users_page(const char* cursor, int count);
 static json_t* get_user_info(const char* uuid_user);
 static bool create_user_info(const json_t* j_data);
 static bool update_user_info(const char* uuid_user, const json_t* j_data);
@@ -312,31 +312,14 @@ void manager_htp_put_manager_info(evhtp_request_t *req, void *data)
  */
 void manager_htp_get_manager_users(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired manager_htp_get_manager_users.");
 
-  // get info
-  j_tmp = get_users_all();
-  if(j_tmp == NULL) {
-    slog(LOG_NOTICE, "Could not get users info.");
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, get_users_page, "uuid");
 
   return;
 }
@@ -1073,7 +1056,13 @@ static bool update_manager_info(const json_t* j_user, const json_t* j_data)
   return true;
 }
 
-static json_t* get_users_all(void)
+/**
+ * Returns the page of users ordered by uuid.
+ * @param cursor: uuid of the last user of the previous page.
+ * @param count
+ * @return
+ */
+static json_t* get_users_page(const char* cursor, int count)
 {
   json_t* j_res;
   json_t* j_tmp;
@@ -1082,7 +1071,7 @@ static json_t* get_users_all(void)
   int idx;
   const char* uuid;
 
-  j_users = user_get_userinfos_all();
+  j_users = user_get_userinfos_page(cursor, count);
   if(j_users == NULL) {
     return NULL;
   }
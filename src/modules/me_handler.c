@@ -26,11 +26,14 @@
 #include "subscription_handler.h"
 #include "core_handler.h"
 #include "call_handler.h"
+#include "user_search.h"
 
 #include "me_handler.h"
 
 #define DEF_ME_CHAT_MESSAGE_COUNT   30
 #define DEF_ME_AUTHTOKEN_TYPE       "me"
+#define DEF_ME_SEARCH_LIMIT         20
+#define DEF_ME_SEARCH_LIMIT_MAX     100
 
 #define DEF_PUBLISH_TOPIC_PREFIX_ME_INFO        "/me/info"
 #define DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE    "/me/chats"
@@ -40,12 +43,14 @@
 #define DEF_PUB_EVENT_PREFIX_ME_CHATROOM_MESSAGE    "me.chats.message"    // topic: DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM
 #define DEF_PUB_EVENT_PREFIX_ME_BUDDY               "me.buddies"          // topic: DEF_PUBLISH_TOPIC_PREFIX_ME_INFO
 
+static user_search* g_user_search = NULL;   ///< user directory search index. username, name and contact targets.
+
 static char* create_public_url(const char* target);
 
 static json_t* get_contacts_info(const json_t* j_user);
 
-static json_t* get_contact_info(const json_t* j_user_contact);
-static json_t* get_contact_info_pjsip(const char* target);
+static json_t* get_contact_info(const json_t* j_user_contact, const json_t* j_endpoints, const json_t* j_auths);
+static json_t* get_contact_info_pjsip(const char* target, const json_t* j_endpoints, const json_t* j_auths);
 
 static json_t* get_me_info_by_user(const json_t* j_user);
 static json_t* get_me_info(const char* uuid);
@@ -54,11 +59,15 @@ static bool update_me_info(const json_t* j_user, const json_t* j_data);
 static json_t* get_room_info(const char* uuid_room);
 
 static json_t* get_chats_info(const json_t* j_user);
+static json_t* get_room_members_info(const json_t* j_members_org, const json_t* j_users);
+static json_t* get_users_info_by_uuids(const json_t* j_uuids);
+static json_t* create_items_map(const json_t* j_items, const char* key);
 static json_t* get_chatroom_info(const json_t* j_user, const char* uuid_userroom);
 static json_t* get_chatroom_info_by_useruuid(const char* uuid_user, const char* uuid_userroom);
 static bool create_chatroom_info(json_t* j_user, json_t* j_data);
 static bool update_chatroom_info(json_t* j_user, const char* uuid_userroom, json_t* j_data);
 static bool delete_chatroom_info(json_t* j_user, const char* uuid_userroom);
+static bool update_chatroom_read_info(json_t* j_user, const char* uuid_userroom);
 
 static json_t* get_chatmessages_info(json_t* j_user, const char* uuid_userroom, const char* timestamp, int count);
 static bool create_chatmessage_info(json_t* j_user, const char* uuid_userroom, json_t* j_data);
@@ -74,28 +83,42 @@ static bool create_call_info(const json_t* j_user, const json_t* j_data);
 static bool create_call_to_user(const json_t* j_user, const json_t* j_data);
 static char* get_callable_contact_from_useruuid(const char* uuid_user);
 
-static json_t* get_search_info(json_t* j_user, const char* filter, const char* type);
+static json_t* get_search_info(json_t* j_user, const char* filter, const char* type, int limit);
 static json_t* get_users_info_by_username(const char* username);
+static json_t* get_users_info_by_search(const char* filter, int limit);
+
+static bool init_user_search(void);
+static bool set_user_search(const json_t* j_user, const json_t* j_contacts);
+static bool update_user_search(const char* uuid_user);
 
-static bool add_subscription_to_useruuid(const char* uuid_user, const char* topic);
-static bool add_subscription_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room);
+static bool join_group_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room);
 
-static bool remove_subscription_to_useruuid(const char* uuid_user, const char* topic);
-static bool remove_subscription_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room);
+static bool leave_group_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room);
 
 static bool cb_resource_handler_user_buddy(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static bool cb_resource_handler_user_userinfo(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
+static bool cb_resource_handler_user_contact(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static bool cb_resource_handler_chat_userroom(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 static bool cb_resource_handler_chat_message(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data);
 
 
 bool me_init_handler(void)
 {
+  int ret;
+
   slog(LOG_DEBUG, "Fired init_me_handler.");
 
+  // user search index
+  ret = init_user_search();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate user search index.");
+    return false;
+  }
+
   // register callback
   user_reigster_callback_db_buddy(&cb_resource_handler_user_buddy);
   user_register_callback_db_userinfo(&cb_resource_handler_user_userinfo);
+  user_register_callback_db_contact(&cb_resource_handler_user_contact);
 
   chat_register_callback_userroom(&cb_resource_handler_chat_userroom);
   chat_register_callback_message(cb_resource_handler_chat_message);
@@ -116,6 +139,10 @@ bool me_reload_handler(void)
 void me_term_handler(void)
 {
   slog(LOG_DEBUG, "Fired term_handler.");
+
+  user_search_destroy(g_user_search);
+  g_user_search = NULL;
+
   return;
 }
 
@@ -630,6 +657,58 @@ void me_htp_post_me_chats_detail_messages(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * POST ^/me/chats/<detail>/read request handler.
+ * @param req
+ * @param data
+ */
+void me_htp_post_me_chats_detail_read(evhtp_request_t *req, void *data)
+{
+  int ret;
+  json_t* j_res;
+  json_t* j_user;
+  char* detail;
+
+  if(req == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return;
+  }
+  slog(LOG_DEBUG, "Fired htp_post_me_chats_detail_read.");
+
+  // get user info
+  j_user = http_get_userinfo(req);
+  if(j_user == NULL) {
+    http_simple_response_error(req, EVHTP_RES_FORBIDDEN, 0, NULL);
+    return;
+  }
+
+  // get detail
+  detail = http_get_parsed_detail_start(req);
+  if(detail == NULL) {
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    json_decref(j_user);
+    return;
+  }
+
+  // mark read
+  ret = update_chatroom_read_info(j_user, detail);
+  json_decref(j_user);
+  sfree(detail);
+  if(ret == false) {
+    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
+    return;
+  }
+
+  // create result
+  j_res = http_create_default_result(EVHTP_RES_OK);
+
+  // response
+  http_simple_response_normal(req, j_res);
+  json_decref(j_res);
+
+  return;
+}
+
 /**
  * GET ^/me/buddies request handler.
  * @param req
@@ -1103,6 +1182,8 @@ void me_htp_get_me_search(evhtp_request_t *req, void *data)
   json_t* j_user;
   char* filter;
   char* type;
+  char* tmp;
+  int limit;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1132,7 +1213,21 @@ void me_htp_get_me_search(evhtp_request_t *req, void *data)
     return;
   }
 
-  j_tmp = get_search_info(j_user, filter, type);
+  // get limit
+  limit = DEF_ME_SEARCH_LIMIT;
+  tmp = http_get_parameter(req, "limit");
+  if(tmp != NULL) {
+    limit = atoi(tmp);
+    sfree(tmp);
+  }
+  if(limit <= 0) {
+    limit = DEF_ME_SEARCH_LIMIT;
+  }
+  if(limit > DEF_ME_SEARCH_LIMIT_MAX) {
+    limit = DEF_ME_SEARCH_LIMIT_MAX;
+  }
+
+  j_tmp = get_search_info(j_user, filter, type, limit);
   json_decref(j_user);
   sfree(filter);
   sfree(type);
@@ -1287,18 +1382,19 @@ static bool update_me_info(const json_t* j_user, const json_t* j_data)
 }
 
 /**
- * Get contact info of given data.
- * @param type
- * @param target
+ * Get contact info.
+ * @param j_user_contact
+ * @param j_endpoints pjsip endpoints. key:object_name
+ * @param j_auths pjsip auths. key:object_name
  * @return
  */
-static json_t* get_contact_info(const json_t* j_user_contact)
+static json_t* get_contact_info(const json_t* j_user_contact, const json_t* j_endpoints, const json_t* j_auths)
 {
   json_t* j_tmp;
   json_t* j_res;
   const char* target;
 
-  if(j_user_contact == NULL) {
+  if((j_user_contact == NULL) || (j_endpoints == NULL) || (j_auths == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
@@ -1310,7 +1406,7 @@ static json_t* get_contact_info(const json_t* j_user_contact)
   }
 
   // we support only pjsip
-  j_tmp = get_contact_info_pjsip(target);
+  j_tmp = get_contact_info_pjsip(target, j_endpoints, j_auths);
   if(j_tmp == NULL) {
     slog(LOG_WARNING, "Could not get contact info from pjsip.");
     return NULL;
@@ -1325,33 +1421,36 @@ static json_t* get_contact_info(const json_t* j_user_contact)
 /**
  * Get contact info for pjsip type.
  * @param target
+ * @param j_endpoints pjsip endpoints. key:object_name
+ * @param j_auths pjsip auths. key:object_name
  * @return
  */
-static json_t* get_contact_info_pjsip(const char* target)
+static json_t* get_contact_info_pjsip(const char* target, const json_t* j_endpoints, const json_t* j_auths)
 {
   json_t* j_res;
   json_t* j_endpoint;
   json_t* j_auth;
   const char* id;
   const char* password;
+  const char* auth;
   char* pub_url;
 
-  if(target == NULL) {
+  if((target == NULL) || (j_endpoints == NULL) || (j_auths == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
   slog(LOG_DEBUG, "Fired get_contact_info_pjsip. target[%s]", target);
 
-  j_endpoint = pjsip_get_endpoint_info(target);
+  j_endpoint = json_object_get(j_endpoints, target);
   if(j_endpoint == NULL) {
     slog(LOG_NOTICE, "Could not get pjsip endpoint info.");
     return NULL;
   }
 
-  j_auth = pjsip_get_auth_info(json_string_value(json_object_get(j_endpoint, "auth")));
+  auth = json_string_value(json_object_get(j_endpoint, "auth"));
+  j_auth = (auth != NULL)? json_object_get(j_auths, auth) : NULL;
   if(j_auth == NULL) {
     slog(LOG_NOTICE, "Could not get pjsip auth info.");
-    json_decref(j_endpoint);
     return NULL;
   }
 
@@ -1375,8 +1474,6 @@ static json_t* get_contact_info_pjsip(const char* target)
       "public_url",   pub_url
       );
   sfree(pub_url);
-  json_decref(j_endpoint);
-  json_decref(j_auth);
 
   return j_res;
 }
@@ -1404,6 +1501,12 @@ static json_t* get_contacts_info(const json_t* j_user)
   json_t* j_tmp;
   json_t* j_user_contacts;
   json_t* j_user_contact;
+  json_t* j_names;
+  json_t* j_endpoints;
+  json_t* j_auths;
+  json_t* j_endpoint;
+  const char* key;
+  const char* tmp_const;
   int idx;
   const char* uuid_user;
 
@@ -1426,10 +1529,38 @@ static json_t* get_contacts_info(const json_t* j_user)
     return NULL;
   }
 
+  // get all of the endpoints
+  j_names = json_array();
+  json_array_foreach(j_user_contacts, idx, j_user_contact) {
+    tmp_const = json_string_value(json_object_get(j_user_contact, "target"));
+    if(tmp_const == NULL) {
+      continue;
+    }
+    json_array_append_new(j_names, json_string(tmp_const));
+  }
+  j_tmp = pjsip_get_endpoints_info_by_names(j_names);
+  json_decref(j_names);
+  j_endpoints = create_items_map(j_tmp, "object_name");
+  json_decref(j_tmp);
+
+  // get all of the auths
+  j_names = json_array();
+  json_object_foreach(j_endpoints, key, j_endpoint) {
+    tmp_const = json_string_value(json_object_get(j_endpoint, "auth"));
+    if(tmp_const == NULL) {
+      continue;
+    }
+    json_array_append_new(j_names, json_string(tmp_const));
+  }
+  j_tmp = pjsip_get_auths_info_by_names(j_names);
+  json_decref(j_names);
+  j_auths = create_items_map(j_tmp, "object_name");
+  json_decref(j_tmp);
+
   j_res = json_array();
   json_array_foreach(j_user_contacts, idx, j_user_contact) {
 
-    j_tmp = get_contact_info(j_user_contact);
+    j_tmp = get_contact_info(j_user_contact, j_endpoints, j_auths);
     if(j_tmp == NULL) {
       continue;
     }
@@ -1437,6 +1568,8 @@ static json_t* get_contacts_info(const json_t* j_user)
     json_array_append_new(j_res, j_tmp);
   }
   json_decref(j_user_contacts);
+  json_decref(j_endpoints);
+  json_decref(j_auths);
 
   return j_res;
 }
@@ -1449,11 +1582,14 @@ static json_t* get_contacts_info(const json_t* j_user)
 static json_t* get_chats_info(const json_t* j_user)
 {
   json_t* j_res;
-  json_t* j_userrooms;
-  json_t* j_userroom;
+  json_t* j_room;
   json_t* j_tmp;
+  json_t* j_uuids;
+  json_t* j_users;
+  json_t* j_member;
   const char* tmp_const;
-  int idx;
+  size_t idx;
+  size_t idx_member;
 
   if(j_user == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -1466,64 +1602,57 @@ static json_t* get_chats_info(const json_t* j_user)
     return NULL;
   }
 
-  // get all userrooms of user.
-  j_userrooms = chat_get_userrooms_by_useruuid(tmp_const);
-  if(j_userrooms == NULL) {
+  // get all userrooms of user with room info and message summary.
+  j_res = chat_get_userrooms_summary_by_useruuid(tmp_const);
+  if(j_res == NULL) {
     slog(LOG_ERR, "Could not get chat userrooms info.");
     return NULL;
   }
 
-  // create result
-  j_res = json_array();
-  json_array_foreach(j_userrooms, idx, j_userroom) {
-    tmp_const = json_string_value(json_object_get(j_userroom, "uuid"));
-    if(tmp_const == NULL) {
-      continue;
-    }
-
-    j_tmp = get_chatroom_info(j_user, tmp_const);
-    if(j_tmp == NULL) {
-      continue;
+  // get all of the members info
+  j_uuids = json_array();
+  json_array_foreach(j_res, idx, j_tmp) {
+    j_room = json_object_get(j_tmp, "room");
+    json_array_foreach(json_object_get(j_room, "members"), idx_member, j_member) {
+      json_array_append(j_uuids, j_member);
     }
+  }
+  j_users = get_users_info_by_uuids(j_uuids);
+  json_decref(j_uuids);
 
-    json_array_append_new(j_res, j_tmp);
+  // set members info
+  json_array_foreach(j_res, idx, j_tmp) {
+    j_room = json_object_get(j_tmp, "room");
+    json_object_set_new(j_room, "members", get_room_members_info(json_object_get(j_room, "members"), j_users));
   }
-  json_decref(j_userrooms);
+  json_decref(j_users);
 
   return j_res;
 }
 
-static json_t* get_room_info(const char* uuid_room)
+/**
+ * Return the array of members info of given member uuids.
+ * @param j_members_org
+ * @param j_users users info. key:uuid
+ * @return
+ */
+static json_t* get_room_members_info(const json_t* j_members_org, const json_t* j_users)
 {
-  json_t* j_res;
   json_t* j_members;
   json_t* j_member;
-  json_t* j_members_org;
   json_t* j_member_org;
   int idx;
   const char* uuid;
   json_t* j_user;
 
-  if(uuid_room == NULL) {
-    slog(LOG_WARNING, "Wrong input parameter.");
-    return NULL;
-  }
-
-  j_res = chat_get_room(uuid_room);
-  if(j_res == NULL) {
-    slog(LOG_NOTICE, "Could not get chat room info.");
-    return NULL;
-  }
-
   j_members = json_array();
-  j_members_org = json_object_get(j_res, "members");
   json_array_foreach(j_members_org, idx, j_member_org) {
     uuid = json_string_value(j_member_org);
     if(uuid == NULL) {
       continue;
     }
 
-    j_user = user_get_userinfo_info(uuid);
+    j_user = json_object_get(j_users, uuid);
     if(j_user == NULL) {
       continue;
     }
@@ -1533,12 +1662,79 @@ static json_t* get_room_info(const char* uuid_room)
         "username",   json_string_value(json_object_get(j_user, "username"))? : "",
         "name",       json_string_value(json_object_get(j_user, "name"))? : ""
         );
-    json_decref(j_user);
 
     json_array_append_new(j_members, j_member);
   }
 
-  json_object_set_new(j_res, "members", j_members);
+  return j_members;
+}
+
+/**
+ * Return the users info of given uuids.
+ * Gets all of the users in one query.
+ * @param j_uuids
+ * @return json object. key:uuid
+ */
+static json_t* get_users_info_by_uuids(const json_t* j_uuids)
+{
+  json_t* j_res;
+  json_t* j_tmp;
+
+  j_tmp = user_get_userinfos_info_by_uuids(j_uuids);
+  j_res = create_items_map(j_tmp, "uuid");
+  json_decref(j_tmp);
+
+  return j_res;
+}
+
+/**
+ * Create json object of given items with given key.
+ * @param j_items json array of items.
+ * @param key
+ * @return json object. key:item's key value
+ */
+static json_t* create_items_map(const json_t* j_items, const char* key)
+{
+  json_t* j_res;
+  json_t* j_item;
+  const char* tmp_const;
+  int idx;
+
+  j_res = json_object();
+  if((j_items == NULL) || (key == NULL)) {
+    return j_res;
+  }
+
+  json_array_foreach(j_items, idx, j_item) {
+    tmp_const = json_string_value(json_object_get(j_item, key));
+    if(tmp_const == NULL) {
+      continue;
+    }
+    json_object_set(j_res, tmp_const, j_item);
+  }
+
+  return j_res;
+}
+
+static json_t* get_room_info(const char* uuid_room)
+{
+  json_t* j_res;
+  json_t* j_users;
+
+  if(uuid_room == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  j_res = chat_get_room(uuid_room);
+  if(j_res == NULL) {
+    slog(LOG_NOTICE, "Could not get chat room info.");
+    return NULL;
+  }
+
+  j_users = get_users_info_by_uuids(json_object_get(j_res, "members"));
+  json_object_set_new(j_res, "members", get_room_members_info(json_object_get(j_res, "members"), j_users));
+  json_decref(j_users);
 
   return j_res;
 }
@@ -1734,6 +1930,44 @@ static bool delete_chatroom_info(json_t* j_user, const char* uuid_userroom)
   return true;
 }
 
+/**
+ * Mark the given user's chatroom(userroom) as read.
+ * @param j_user
+ * @param uuid_userroom
+ * @return
+ */
+static bool update_chatroom_read_info(json_t* j_user, const char* uuid_userroom)
+{
+  int ret;
+  const char* uuid_user;
+
+  if((j_user == NULL) || (uuid_userroom == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  uuid_user = json_string_value(json_object_get(j_user, "uuid"));
+  if(uuid_user == NULL) {
+    slog(LOG_ERR, "Could not get user uuid.");
+    return false;
+  }
+
+  // check permission
+  ret = chat_is_user_userroom_owned(uuid_user, uuid_userroom);
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not pass the permission check. uuid_user[%s], uuid_userroom[%s]", uuid_user, uuid_userroom);
+    return false;
+  }
+
+  ret = chat_mark_read_userroom(uuid_userroom);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not mark read chatroom.");
+    return false;
+  }
+
+  return true;
+}
+
 static json_t* get_chatmessages_info(json_t* j_user, const char* uuid_userroom, const char* timestamp, int count)
 {
   int ret;
@@ -1885,6 +2119,7 @@ static json_t* get_buddies_info(const json_t* j_user)
     return NULL;
   }
 
+  // the buddies are already owned by the user.
   j_res = json_array();
   json_array_foreach(j_buddies, idx, j_buddy) {
     uuid = json_string_value(json_object_get(j_buddy, "uuid"));
@@ -1892,10 +2127,8 @@ static json_t* get_buddies_info(const json_t* j_user)
       continue;
     }
 
-    j_tmp = get_buddy_info(j_user, uuid);
-    if(j_tmp == NULL) {
-      continue;
-    }
+    j_tmp = json_deep_copy(j_buddy);
+    json_object_del(j_tmp, "uuid_owner");
 
     json_array_append_new(j_res, j_tmp);
   }
@@ -2021,11 +2254,9 @@ static json_t* get_calls_info(const json_t* j_user)
   json_t* j_res;
   json_t* j_contacts;
   json_t* j_contact;
-  json_t* j_calls;
-  json_t* j_call;
+  json_t* j_targets;
   const char* target;
   int idx;
-  int idx_2;
 
   if(j_user == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -2045,32 +2276,26 @@ static json_t* get_calls_info(const json_t* j_user)
     return NULL;
   }
 
-  // get all calls info of given user's all contacts.
-  j_res = json_array();
+  // get targets
+  j_targets = json_array();
   json_array_foreach(j_contacts, idx, j_contact) {
-    // get target
     target = json_string_value(json_object_get(j_contact, "target"));
     if(target == NULL) {
       slog(LOG_WARNING, "Could not get target info.");
       continue;
     }
-
-    // get call info
-    j_calls = core_get_channels_by_devicename(target);
-    if(j_calls == NULL) {
-      slog(LOG_NOTICE, "Could not get channels info. target[%s]", target);
-      continue;
-    }
-
-    // add to result array
-    json_array_foreach(j_calls, idx_2, j_call) {
-      json_array_append(j_res, j_call);
-    }
-    json_decref(j_calls);
-
+    json_array_append_new(j_targets, json_string(target));
   }
   json_decref(j_contacts);
 
+  // get all calls info of given user's all contacts.
+  j_res = core_get_channels_by_devicenames(j_targets);
+  json_decref(j_targets);
+  if(j_res == NULL) {
+    slog(LOG_NOTICE, "Could not get channels info. uuid_user[%s]", uuid_user);
+    return NULL;
+  }
+
   return j_res;
 }
 
@@ -2186,7 +2411,7 @@ static bool create_call_to_user(const json_t* j_user, const json_t* j_data)
   return true;
 }
 
-static json_t* get_search_info(json_t* j_user, const char* filter, const char* type)
+static json_t* get_search_info(json_t* j_user, const char* filter, const char* type, int limit)
 {
   json_t* j_res;
 
@@ -2198,6 +2423,9 @@ static json_t* get_search_info(json_t* j_user, const char* filter, const char* t
   if(strcmp(type, "username") == 0) {
     j_res = get_users_info_by_username(filter);
   }
+  else if(strcmp(type, "user") == 0) {
+    j_res = get_users_info_by_search(filter, limit);
+  }
   else {
     slog(LOG_NOTICE, "Not support search type. type[%s]", type);
     return NULL;
@@ -2238,92 +2466,168 @@ static json_t* get_users_info_by_username(const char* username)
 }
 
 /**
- * Returns all subscribable topics of me module
- * @param j_user
+ * Returns the users which have the given filter in the username, name or contact target.
+ * @param filter
+ * @param limit
  * @return
  */
-json_t* me_get_subscribable_topics_all(const json_t* j_user)
+static json_t* get_users_info_by_search(const char* filter, int limit)
 {
-  char* topic;
-  const char* tmp_const;
   json_t* j_res;
-  json_t* j_chats;
-  json_t* j_chat;
-  int idx;
+  json_t* j_uuids;
+  json_t* j_users;
+  json_t* j_tmp;
+  const char** uuids;
+  int cnt;
+  int i;
 
-  if(j_user == NULL) {
+  if((filter == NULL) || (limit <= 0)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return NULL;
   }
+  slog(LOG_DEBUG, "Fired get_users_info_by_search. filter[%s], limit[%d]", filter, limit);
 
-  j_res = json_array();
+  uuids = calloc(limit, sizeof(char*));
+  cnt = user_search_find(g_user_search, filter, uuids, limit);
 
-  // set topics for me info
-  tmp_const = json_string_value(json_object_get(j_user, "uuid"));
-  asprintf(&topic, "/me/info/%s", tmp_const);
-  json_array_append_new(j_res, json_string(topic));
-  sfree(topic);
+  j_uuids = json_array();
+  for(i = 0; i < cnt; i++) {
+    json_array_append_new(j_uuids, json_string(uuids[i]));
+  }
+  sfree(uuids);
 
-  // get all involved chat rooms
-  j_chats = chat_get_rooms_by_useruuid(tmp_const);
-  if(j_chats == NULL) {
-    slog(LOG_ERR, "Could not get chats info.");
-    json_decref(j_res);
+  // get users info at once
+  j_users = get_users_info_by_uuids(j_uuids);
+  if(j_users == NULL) {
+    slog(LOG_ERR, "Could not get users info.");
+    json_decref(j_uuids);
     return NULL;
   }
 
-  // set topics for chat rooms
-  json_array_foreach(j_chats, idx, j_chat) {
-    tmp_const = json_string_value(json_object_get(j_chat, "uuid"));
-    asprintf(&topic, "/me/chats/%s", tmp_const);
-    json_array_append_new(j_res, json_string(topic));
-    sfree(topic);
+  // keep the order of the search result
+  j_res = json_array();
+  for(i = 0; i < cnt; i++) {
+    j_tmp = json_object_get(j_users, json_string_value(json_array_get(j_uuids, i)));
+    if(j_tmp == NULL) {
+      continue;
+    }
+
+    j_tmp = json_deep_copy(j_tmp);
+    json_object_del(j_tmp, "password");
+    json_object_del(j_tmp, "tm_create");
+    json_object_del(j_tmp, "tm_update");
+    json_array_append_new(j_res, j_tmp);
   }
-  json_decref(j_chats);
+  json_decref(j_users);
+  json_decref(j_uuids);
 
   return j_res;
 }
 
-static bool add_subscription_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room)
+/**
+ * Build the user search index with all of the users.
+ * @return
+ */
+static bool init_user_search(void)
 {
-  int ret;
-  char* topic;
+  json_t* j_users;
+  json_t* j_user;
+  json_t* j_contacts;
+  json_t* j_contact;
+  json_t* j_targets;
+  json_t* j_tmp;
+  const char* tmp_const;
+  int idx;
 
-  if((uuid_user == NULL) || (uuid_room == NULL)) {
-    slog(LOG_WARNING, "Wrong input parameter.");
+  if(g_user_search == NULL) {
+    g_user_search = user_search_create();
+    if(g_user_search == NULL) {
+      slog(LOG_ERR, "Could not create user search index.");
+      return false;
+    }
+  }
+  user_search_clear(g_user_search);
+
+  j_users = user_get_userinfos_all();
+  j_contacts = user_get_contacts_all();
+  if((j_users == NULL) || (j_contacts == NULL)) {
+    slog(LOG_ERR, "Could not get users info.");
+    json_decref(j_users);
+    json_decref(j_contacts);
     return false;
   }
 
-  // create topic
-  asprintf(&topic, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, uuid_room);
+  // group contacts by the user
+  j_targets = json_object();
+  json_array_foreach(j_contacts, idx, j_contact) {
+    tmp_const = json_string_value(json_object_get(j_contact, "user_uuid"));
+    if(tmp_const == NULL) {
+      continue;
+    }
 
-  ret = add_subscription_to_useruuid(uuid_user, topic);
-  sfree(topic);
-  if(ret == false) {
-    slog(LOG_NOTICE, "Could not subscribe the topic.");
-    return false;
+    j_tmp = json_object_get(j_targets, tmp_const);
+    if(j_tmp == NULL) {
+      j_tmp = json_array();
+      json_object_set_new(j_targets, tmp_const, j_tmp);
+    }
+    json_array_append(j_tmp, j_contact);
   }
+  json_decref(j_contacts);
+
+  json_array_foreach(j_users, idx, j_user) {
+    tmp_const = json_string_value(json_object_get(j_user, "uuid"));
+    if(tmp_const == NULL) {
+      continue;
+    }
+    set_user_search(j_user, json_object_get(j_targets, tmp_const));
+  }
+  json_decref(j_targets);
+  json_decref(j_users);
+
+  slog(LOG_INFO, "Initiated user search index. count[%d]", user_search_get_count(g_user_search));
 
   return true;
 }
 
-static bool remove_subscription_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room)
+/**
+ * Set the user search index of the given user.
+ * Indexes username, name and contact targets.
+ * @param j_user
+ * @param j_contacts: user's contacts. Could be NULL.
+ * @return
+ */
+static bool set_user_search(const json_t* j_user, const json_t* j_contacts)
 {
+  const char** fields;
+  const char* uuid;
+  json_t* j_contact;
+  int count;
+  int idx;
   int ret;
-  char* topic;
 
-  if((uuid_user == NULL) || (uuid_room == NULL)) {
+  if(j_user == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return false;
   }
 
-  // create topic
-  asprintf(&topic, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, uuid_room);
+  uuid = json_string_value(json_object_get(j_user, "uuid"));
+  if(uuid == NULL) {
+    slog(LOG_NOTICE, "Could not get user uuid info.");
+    return false;
+  }
 
-  ret = remove_subscription_to_useruuid(uuid_user, topic);
-  sfree(topic);
+  fields = calloc(json_array_size(j_contacts) + 2, sizeof(char*));
+  count = 0;
+  fields[count++] = json_string_value(json_object_get(j_user, "username"));
+  fields[count++] = json_string_value(json_object_get(j_user, "name"));
+  json_array_foreach(j_contacts, idx, j_contact) {
+    fields[count++] = json_string_value(json_object_get(j_contact, "target"));
+  }
+
+  ret = user_search_set(g_user_search, uuid, fields, count);
+  sfree(fields);
   if(ret == false) {
-    slog(LOG_NOTICE, "Could not unsubscribe the topic.");
+    slog(LOG_ERR, "Could not set user search index. uuid[%s]", uuid);
     return false;
   }
 
@@ -2331,91 +2635,159 @@ static bool remove_subscription_to_useruuid_chatroom(const char* uuid_user, cons
 }
 
 /**
- * Add the subscription to given topic of all given user's authtoken
+ * Update the user search index of the given user.
+ * Removes the user from the index if the user is not exist.
  * @param uuid_user
- * @param topic
  * @return
  */
-static bool add_subscription_to_useruuid(const char* uuid_user, const char* topic)
+static bool update_user_search(const char* uuid_user)
 {
+  json_t* j_user;
+  json_t* j_contacts;
   int ret;
-  int idx;
-  json_t* j_tokens;
-  json_t* j_token;
-  const char* authtoken;
 
-  if((uuid_user == NULL) || (topic == NULL)) {
+  if(uuid_user == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return false;
   }
-  slog(LOG_DEBUG, "Fired subscribe_created_chatroom. uuid_user[%s], topic[%s]", uuid_user, topic);
+  slog(LOG_DEBUG, "Fired update_user_search. uuid_user[%s]", uuid_user);
 
-  // get all authtokens
-  j_tokens = user_get_authtokens_user_type(uuid_user, DEF_ME_AUTHTOKEN_TYPE);
-  if(j_tokens == NULL) {
-    slog(LOG_ERR, "Could not get authtoken info.");
-    return false;
+  j_user = user_get_userinfo_info(uuid_user);
+  if(j_user == NULL) {
+    user_search_remove(g_user_search, uuid_user);
+    return true;
   }
 
-  json_array_foreach(j_tokens, idx, j_token) {
-    authtoken = json_string_value(json_object_get(j_token, "uuid"));
-    if(authtoken == NULL) {
-      continue;
-    }
+  j_contacts = user_get_contacts_by_user_uuid(uuid_user);
+  ret = set_user_search(j_user, j_contacts);
+  json_decref(j_contacts);
+  json_decref(j_user);
 
-    // add subscription
-    ret = subscription_subscribe_topic(authtoken, topic);
-    if(ret == false) {
-      slog(LOG_NOTICE, "Could not add subscribe topic.");
-      continue;
-    }
+  return ret;
+}
+
+/**
+ * Returns all subscribable topics of me module
+ * @param j_user
+ * @return
+ */
+json_t* me_get_subscribable_topics_all(const json_t* j_user)
+{
+  char* topic;
+  const char* tmp_const;
+  json_t* j_res;
+
+  if(j_user == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
   }
-  json_decref(j_tokens);
 
-  return true;
+  j_res = json_array();
+
+  // set topics for me info
+  tmp_const = json_string_value(json_object_get(j_user, "uuid"));
+  asprintf(&topic, "/me/info/%s", tmp_const);
+  json_array_append_new(j_res, json_string(topic));
+  sfree(topic);
+
+  return j_res;
+}
+
+/**
+ * Returns all joinable groups of me module.
+ * The chat room messages are delivered to the group members directly.
+ * @param j_user
+ * @return
+ */
+json_t* me_get_joinable_groups_all(const json_t* j_user)
+{
+  char* group;
+  const char* tmp_const;
+  json_t* j_res;
+  json_t* j_chats;
+  json_t* j_chat;
+  int idx;
+
+  if(j_user == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  // get all involved chat rooms
+  tmp_const = json_string_value(json_object_get(j_user, "uuid"));
+  j_chats = chat_get_rooms_by_useruuid(tmp_const);
+  if(j_chats == NULL) {
+    slog(LOG_ERR, "Could not get chats info.");
+    return NULL;
+  }
+
+  // set groups for chat rooms
+  j_res = json_array();
+  json_array_foreach(j_chats, idx, j_chat) {
+    tmp_const = json_string_value(json_object_get(j_chat, "uuid"));
+    asprintf(&group, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, tmp_const);
+    json_array_append_new(j_res, json_string(group));
+    sfree(group);
+  }
+  json_decref(j_chats);
+
+  return j_res;
 }
 
 /**
- * Remove the subscription to given topic of all given user's authtoken
+ * Join the connected sessions of the given user to the chat room group.
  * @param uuid_user
- * @param topic
+ * @param uuid_room
  * @return
  */
-static bool remove_subscription_to_useruuid(const char* uuid_user, const char* topic)
+static bool join_group_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room)
 {
   int ret;
-  int idx;
-  json_t* j_tokens;
-  json_t* j_token;
-  const char* authtoken;
+  char* group;
 
-  if((uuid_user == NULL) || (topic == NULL)) {
+  if((uuid_user == NULL) || (uuid_room == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return false;
   }
-  slog(LOG_DEBUG, "Fired remove_subscription_to_useruuid. uuid_user[%s], topic[%s]", uuid_user, topic);
 
-  // get all authtokens
-  j_tokens = user_get_authtokens_user_type(uuid_user, DEF_ME_AUTHTOKEN_TYPE);
-  if(j_tokens == NULL) {
-    slog(LOG_ERR, "Could not get authtoken info.");
+  // create group
+  asprintf(&group, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, uuid_room);
+
+  ret = subscription_join_group_user(uuid_user, group);
+  sfree(group);
+  if(ret == false) {
+    slog(LOG_NOTICE, "Could not join the group.");
     return false;
   }
 
-  json_array_foreach(j_tokens, idx, j_token) {
-    authtoken = json_string_value(json_object_get(j_token, "uuid"));
-    if(authtoken == NULL) {
-      continue;
-    }
+  return true;
+}
 
-    // remove subscription
-    ret = subscription_unsubscribe_topic(authtoken, topic);
-    if(ret == false) {
-      slog(LOG_NOTICE, "Could not remove subscribe topic.");
-      continue;
-    }
+/**
+ * Leave the connected sessions of the given user from the chat room group.
+ * @param uuid_user
+ * @param uuid_room
+ * @return
+ */
+static bool leave_group_to_useruuid_chatroom(const char* uuid_user, const char* uuid_room)
+{
+  int ret;
+  char* group;
+
+  if((uuid_user == NULL) || (uuid_room == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  // create group
+  asprintf(&group, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, uuid_room);
+
+  ret = subscription_leave_group_user(uuid_user, group);
+  sfree(group);
+  if(ret == false) {
+    slog(LOG_NOTICE, "Could not leave the group.");
+    return false;
   }
-  json_decref(j_tokens);
 
   return true;
 }
@@ -2513,6 +2885,14 @@ static bool cb_resource_handler_user_userinfo(enum EN_RESOURCE_UPDATE_TYPES type
     return false;
   }
 
+  // update search index
+  if(type == EN_RESOURCE_DELETE) {
+    user_search_remove(g_user_search, uuid);
+  }
+  else {
+    update_user_search(uuid);
+  }
+
   if(type == EN_RESOURCE_UPDATE) {
     event_type = EN_PUBLISH_UPDATE;
 
@@ -2543,6 +2923,40 @@ static bool cb_resource_handler_user_userinfo(enum EN_RESOURCE_UPDATE_TYPES type
   return true;
 }
 
+/**
+ * Callback handler.
+ * user_contact.
+ * @param type
+ * @param j_data
+ * @return
+ */
+static bool cb_resource_handler_user_contact(enum EN_RESOURCE_UPDATE_TYPES type, const json_t* j_data)
+{
+  const char* uuid_user;
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired cb_resource_handler_user_contact.");
+
+  uuid_user = json_string_value(json_object_get(j_data, "user_uuid"));
+  if(uuid_user == NULL) {
+    slog(LOG_NOTICE, "Could not get user uuid info.");
+    return false;
+  }
+
+  // update search index
+  ret = update_user_search(uuid_user);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not update user search index. uuid_user[%s]", uuid_user);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * Callback handler.
  * publish event.
@@ -2574,10 +2988,10 @@ static bool cb_resource_handler_chat_userroom(enum EN_RESOURCE_UPDATE_TYPES type
   if(type == EN_RESOURCE_CREATE) {
     event_type = EN_RESOURCE_CREATE;
 
-    // add subscribe
-    ret = add_subscription_to_useruuid_chatroom(uuid_user, uuid_room);
+    // join group
+    ret = join_group_to_useruuid_chatroom(uuid_user, uuid_room);
     if(ret == false) {
-      slog(LOG_ERR, "Could not add subscription for created chatroom.");
+      slog(LOG_ERR, "Could not join the group for created chatroom.");
       return false;
     }
 
@@ -2601,10 +3015,10 @@ static bool cb_resource_handler_chat_userroom(enum EN_RESOURCE_UPDATE_TYPES type
   else if(type == EN_RESOURCE_DELETE) {
     event_type = EN_PUBLISH_DELETE;
 
-    // delete subscribe
-    ret = remove_subscription_to_useruuid_chatroom(uuid_user, uuid_room);
+    // leave group
+    ret = leave_group_to_useruuid_chatroom(uuid_user, uuid_room);
     if(ret == false) {
-      slog(LOG_ERR, "Could not unsubscribe for deleted chatroom.");
+      slog(LOG_ERR, "Could not leave the group for deleted chatroom.");
       return false;
     }
 
@@ -2674,8 +3088,8 @@ static bool cb_resource_handler_chat_message(enum EN_RESOURCE_UPDATE_TYPES type,
   // create topic
   asprintf(&topic, "%s/%s", DEF_PUBLISH_TOPIC_PREFIX_ME_CHATROOM_MESSAGE, uuid_room);
 
-  // publish event
-  ret = publication_publish_event(topic, DEF_PUB_EVENT_PREFIX_ME_CHATROOM_MESSAGE, event_type, j_event);
+  // publish event to the topic subscribers and the room members
+  ret = publication_publish_group_event(topic, DEF_PUB_EVENT_PREFIX_ME_CHATROOM_MESSAGE, event_type, j_event);
   sfree(topic);
   json_decref(j_event);
   if(ret == false) {
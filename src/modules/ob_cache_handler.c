@@ -0,0 +1,243 @@
+/*
+ * ob_cache_handler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  In-memory cache of the outbound objects(campaign, plan, destination, dlma).
+ *  The objects are changed only by the create/update/delete paths of each handler,
+ *  and those paths invalidate the cache. So the dialing loop doesn't need to
+ *  query the database for every dialing.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <jansson.h>
+
+#include "slog.h"
+#include "ob_cache_handler.h"
+#include "ob_campaign_handler.h"
+#include "ob_plan_handler.h"
+#include "ob_destination_handler.h"
+#include "ob_dlma_handler.h"
+
+#define DEF_OB_CACHE_TYPE_COUNT 4
+
+struct ob_cache {
+  const char* name;       ///< type name. for the log.
+  json_t* j_items;        ///< uuid:object
+  unsigned long version;  ///< increased on every change
+  unsigned long hit;
+  unsigned long miss;
+};
+
+static struct ob_cache g_ob_cache[DEF_OB_CACHE_TYPE_COUNT] = {
+    { "campaign",     NULL, 0, 0, 0 },
+    { "plan",         NULL, 0, 0, 0 },
+    { "destination",  NULL, 0, 0, 0 },
+    { "dlma",         NULL, 0, 0, 0 },
+};
+
+static struct ob_cache* get_ob_cache(E_OB_CACHE_TYPE type);
+static bool load_ob_cache(E_OB_CACHE_TYPE type, json_t* j_items);
+
+
+/**
+ * Initiate cache and load all of the objects.
+ * Should be called after the outbound database initiated.
+ * @return
+ */
+bool ob_cache_init_handler(void)
+{
+  int ret;
+
+  slog(LOG_DEBUG, "Fired ob_cache_init_handler.");
+
+  ob_cache_term_handler();
+
+  ret = load_ob_cache(E_OB_CACHE_CAMPAIGN, ob_get_campaigns_all());
+  ret = ret && load_ob_cache(E_OB_CACHE_PLAN, ob_get_plans_all());
+  ret = ret && load_ob_cache(E_OB_CACHE_DESTINATION, ob_get_destinations_all());
+  ret = ret && load_ob_cache(E_OB_CACHE_DLMA, ob_get_dlmas_all());
+  if(ret == false) {
+    slog(LOG_ERR, "Could not load outbound cache.");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Release all cached objects.
+ */
+void ob_cache_term_handler(void)
+{
+  int i;
+
+  for(i = 0; i < DEF_OB_CACHE_TYPE_COUNT; i++) {
+    if(g_ob_cache[i].j_items != NULL) {
+      slog(LOG_DEBUG, "Release ob cache. type[%s], hit[%lu], miss[%lu]",
+          g_ob_cache[i].name, g_ob_cache[i].hit, g_ob_cache[i].miss
+          );
+      json_decref(g_ob_cache[i].j_items);
+      g_ob_cache[i].j_items = NULL;
+    }
+    g_ob_cache[i].version++;
+    g_ob_cache[i].hit = 0;
+    g_ob_cache[i].miss = 0;
+  }
+
+  return;
+}
+
+/**
+ * Returns copy of the cached object.
+ * @param type
+ * @param uuid
+ * @return NULL if not cached.
+ */
+json_t* ob_cache_get(E_OB_CACHE_TYPE type, const char* uuid)
+{
+  struct ob_cache* cache;
+  json_t* j_tmp;
+
+  cache = get_ob_cache(type);
+  if((cache == NULL) || (uuid == NULL)) {
+    return NULL;
+  }
+
+  j_tmp = json_object_get(cache->j_items, uuid);
+  if(j_tmp == NULL) {
+    cache->miss++;
+    return NULL;
+  }
+  cache->hit++;
+
+  // the callers modify the result.
+  return json_deep_copy(j_tmp);
+}
+
+/**
+ * Add the object to the cache.
+ * @param type
+ * @param j_data
+ * @return
+ */
+bool ob_cache_set(E_OB_CACHE_TYPE type, const json_t* j_data)
+{
+  struct ob_cache* cache;
+  const char* uuid;
+
+  cache = get_ob_cache(type);
+  if((cache == NULL) || (j_data == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  uuid = json_string_value(json_object_get(j_data, "uuid"));
+  if(uuid == NULL) {
+    slog(LOG_WARNING, "Could not get uuid info. type[%s]", cache->name);
+    return false;
+  }
+
+  if(cache->j_items == NULL) {
+    cache->j_items = json_object();
+  }
+  json_object_set_new(cache->j_items, uuid, json_deep_copy(j_data));
+  cache->version++;
+
+  return true;
+}
+
+/**
+ * Remove the object from the cache.
+ * Should be called after every change of the object in the database.
+ * @param type
+ * @param uuid
+ */
+void ob_cache_invalidate(E_OB_CACHE_TYPE type, const char* uuid)
+{
+  struct ob_cache* cache;
+
+  cache = get_ob_cache(type);
+  if((cache == NULL) || (uuid == NULL)) {
+    return;
+  }
+
+  json_object_del(cache->j_items, uuid);
+  cache->version++;
+
+  return;
+}
+
+/**
+ * Remove all objects of the given type from the cache.
+ * For the changes of the multiple objects.
+ * @param type
+ */
+void ob_cache_invalidate_all(E_OB_CACHE_TYPE type)
+{
+  struct ob_cache* cache;
+
+  cache = get_ob_cache(type);
+  if(cache == NULL) {
+    return;
+  }
+
+  json_object_clear(cache->j_items);
+  cache->version++;
+
+  return;
+}
+
+/**
+ * Returns version of the given type cache.
+ * The version increases on every change of the cache.
+ * @param type
+ * @return
+ */
+unsigned long ob_cache_get_version(E_OB_CACHE_TYPE type)
+{
+  struct ob_cache* cache;
+
+  cache = get_ob_cache(type);
+  if(cache == NULL) {
+    return 0;
+  }
+
+  return cache->version;
+}
+
+static struct ob_cache* get_ob_cache(E_OB_CACHE_TYPE type)
+{
+  if((type < 0) || (type >= DEF_OB_CACHE_TYPE_COUNT)) {
+    return NULL;
+  }
+
+  return &g_ob_cache[type];
+}
+
+/**
+ * Load given objects to the cache.
+ * Steals the reference of the j_items.
+ */
+static bool load_ob_cache(E_OB_CACHE_TYPE type, json_t* j_items)
+{
+  json_t* j_item;
+  unsigned int idx;
+
+  if(j_items == NULL) {
+    return false;
+  }
+
+  json_array_foreach(j_items, idx, j_item) {
+    ob_cache_set(type, j_item);
+  }
+  slog(LOG_INFO, "Loaded ob cache. type[%s], count[%zu]", g_ob_cache[type].name, json_array_size(j_items));
+  json_decref(j_items);
+
+  return true;
+}
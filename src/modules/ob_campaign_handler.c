@@ -11,8 +11,11 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
+#include <event2/event.h>
 #include <jansson.h>
 
+#include "bsd_tree.h"
 #include "common.h"
 #include "slog.h"
 #include "utils.h"
@@ -20,21 +23,54 @@
 #include "ob_dl_handler.h"
 #include "ob_plan_handler.h"
 #include "ob_dlma_handler.h"
+#include "ob_schedule.h"
+#include "ob_cache_handler.h"
+#include "resource_handler.h"
 
 #define DEF_CAMPAIGN_SCHEDULE_MODE  E_CAMP_SCHEDULE_OFF
 #define DEF_CAMPAIGN_STATUS E_CAMP_STOP
 
+#define DEF_CAMPAIGN_SCHEDULE_MAX_WAIT  3600    // max wait(sec) of the schedule event. guards the wall clock changes.
+#define DEF_CAMPAIGN_SCHEDULE_RECHECK   86400   // recheck interval(sec) of the schedule which has no transition
+
+
+/**
+ * Campaign schedule timer.
+ * Each scheduled campaign is kept in the fire time ordered tree
+ * with its next open/close transition time,
+ * and only one event is armed for the earliest one.
+ */
+struct campaign_schedule {
+  RB_ENTRY(campaign_schedule) link_uuid;
+  RB_ENTRY(campaign_schedule) link_fire;
+
+  char* uuid;   ///< campaign uuid
+  time_t fire;  ///< next transition time. utc
+};
+
+static struct event* g_ev_campaign_schedule = NULL;   ///< campaign schedule event
+
 static json_t* get_deleted_ob_campaign(const char* uuid);
 static json_t* create_ob_campaign_default(void);
-static json_t* get_campaigns_uuid_by_status_schedule(E_CAMP_STATUS_T status, E_CAMP_SCHEDULE_MODE mode);
 static json_t* get_ob_campaigns_uuid_by_status(E_CAMP_STATUS_T status);
 
-static bool is_startable_campaign_schedule(json_t* j_camp);
-static bool is_startable_campaign_schedule_day(json_t* j_camp, int day);
-static bool is_startable_campaign_schedule_check(json_t* j_camp, const char* cur_date, const char* cur_time, int cur_day);
-static bool is_stopable_campaign_schedule_day_date_list(json_t* j_camp);
-static bool is_stoppable_campaign_schedule_check(json_t* j_camp, const char* cur_date, const char* cur_time, int cur_day);
-
+static void cb_campaign_schedule(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static int compare_campaign_schedule_uuid(struct campaign_schedule* e1, struct campaign_schedule* e2);
+static int compare_campaign_schedule_fire(struct campaign_schedule* e1, struct campaign_schedule* e2);
+static struct campaign_schedule* find_campaign_schedule(const char* uuid);
+static void set_campaign_schedule(const char* uuid, time_t fire);
+static void remove_campaign_schedule(const char* uuid);
+static void arm_campaign_schedule(void);
+static void apply_campaign_schedule(const char* uuid, time_t now);
+
+RB_HEAD(campaign_schedule_uuids, campaign_schedule) g_campaign_schedule_uuids = RB_INITIALIZER(&g_campaign_schedule_uuids);
+RB_HEAD(campaign_schedule_fires, campaign_schedule) g_campaign_schedule_fires = RB_INITIALIZER(&g_campaign_schedule_fires);
+RB_PROTOTYPE(campaign_schedule_uuids, campaign_schedule, link_uuid, compare_campaign_schedule_uuid);
+RB_PROTOTYPE(campaign_schedule_fires, campaign_schedule, link_fire, compare_campaign_schedule_fire);
+RB_GENERATE(campaign_schedule_uuids, campaign_schedule, link_uuid, compare_campaign_schedule_uuid);
+RB_GENERATE(campaign_schedule_fires, campaign_schedule, link_fire, compare_campaign_schedule_fire);
+
+extern app* g_app;
 extern db_ctx_t* g_db_ob;
 
 static json_t* create_ob_campaign_default(void)
@@ -45,7 +81,7 @@ static json_t* create_ob_campaign_default(void)
       "s:o, s:o, s:i, "
       "s:o, s:o, s:o, "
       "s:o, "
-      "s:i, s:o, s:o, s:o, s:o, s:o, s:o, s:o, "
+      "s:i, s:o, s:o, s:o, s:o, s:o, s:o, s:o, s:o, "
       "s:o"
       "}",
 
@@ -68,6 +104,7 @@ static json_t* create_ob_campaign_default(void)
       "sc_time_start",        json_null(),
       "sc_time_end",          json_null(),
       "sc_day_list",          json_null(),
+      "sc_timezone",          json_null(),
 
       "variables",  json_object()
       );
@@ -159,6 +196,7 @@ json_t* ob_delete_campaign(const char* uuid)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_CAMPAIGN, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not delete campaign. uuid[%s]", uuid);
     return NULL;
@@ -214,11 +252,17 @@ json_t* ob_get_campaign(const char* uuid)
   }
   slog(LOG_DEBUG, "Fired get_ob_campaign. uuid[%s]", uuid);
 
+  j_res = ob_cache_get(E_OB_CACHE_CAMPAIGN, uuid);
+  if(j_res != NULL) {
+    return j_res;
+  }
+
   j_res = get_ob_campaign_use(uuid, E_USE_OK);
   if(j_res == NULL) {
     slog(LOG_WARNING, "Could not get ob_campaign info.");
     return NULL;
   }
+  ob_cache_set(E_OB_CACHE_CAMPAIGN, j_res);
 
   return j_res;
 }
@@ -278,6 +322,24 @@ json_t* ob_get_campaigns_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of campaigns ordered by uuid.
+ * @param cursor: uuid of the last campaign of the previous page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_campaigns_page(const char* cursor, int count)
+{
+  json_t* j_res;
+  char* where;
+
+  asprintf(&where, "in_use=%d", E_USE_OK);
+  j_res = resource_get_db_items_page(g_db_ob, "ob_campaign", where, "uuid", cursor, count);
+  sfree(where);
+
+  return j_res;
+}
+
 
 /**
  * Return the json array of all campaign uuid.
@@ -321,133 +383,6 @@ json_t* ob_get_campaigns_all_uuid(void)
   return j_res;
 }
 
-static json_t* get_campaigns_uuid_by_status_schedule(E_CAMP_STATUS_T status, E_CAMP_SCHEDULE_MODE mode)
-{
-  int ret;
-  json_t* j_res;
-  json_t* j_tmp;
-  char* sql;
-  const char* uuid;
-
-  asprintf(&sql, "select uuid from ob_campaign where status == %d and sc_mode == %d;",
-      status,
-      mode
-      );
-
-  ret = db_ctx_query(g_db_ob, sql);
-  sfree(sql);
-  if(ret == false) {
-    return NULL;
-  }
-
-  j_res = json_array();
-  while(1) {
-
-    j_tmp = db_ctx_get_record(g_db_ob);
-    if(j_tmp == NULL) {
-      break;
-    }
-
-    uuid = json_string_value(json_object_get(j_tmp, "uuid"));
-    if(uuid == NULL) {
-      json_decref(j_tmp);
-      continue;
-    }
-
-    json_array_append_new(j_res, json_string(uuid));
-    json_decref(j_tmp);
-  }
-  db_ctx_free(g_db_ob);
-
-  return j_res;
-}
-
-/**
- * Get all start-able campaigns by schedule.
- * \return
- */
-json_t* ob_get_campaigns_schedule_start(void)
-{
-  json_t* j_res;
-  json_t* j_tmp;
-  json_t* j_uuids;
-  int ret;
-  unsigned int idx;
-  json_t* j_val;
-  const char* uuid;
-
-  // get scheduled campaigns uuid
-  j_uuids = get_campaigns_uuid_by_status_schedule(E_CAMP_STOP, E_CAMP_SCHEDULE_ON);
-
-  j_res = json_array();
-  json_array_foreach(j_uuids, idx, j_val) {
-
-    uuid = json_string_value(j_val);
-    if(uuid == NULL) {
-      continue;
-    }
-
-    j_tmp = ob_get_campaign(uuid);
-    if(j_tmp == NULL) {
-      continue;
-    }
-
-    ret = is_startable_campaign_schedule(j_tmp);
-    if(ret == false) {
-      json_decref(j_tmp);
-      continue;
-    }
-
-    json_array_append_new(j_res, j_tmp);
-  }
-  json_decref(j_uuids);
-
-  return j_res;
-}
-
-/**
- * Get all stop-able campaigns by schedule.
- * \return
- */
-json_t* ob_get_campaigns_schedule_end(void)
-{
-  json_t* j_res;
-  json_t* j_tmp;
-  json_t* j_uuids;
-  int ret;
-  unsigned int idx;
-  json_t* j_val;
-  const char* uuid;
-
-  // get scheduled campaigns uuid
-  j_uuids = get_campaigns_uuid_by_status_schedule(E_CAMP_START, E_CAMP_SCHEDULE_ON);
-
-  j_res = json_array();
-  json_array_foreach(j_uuids, idx, j_val) {
-
-    uuid = json_string_value(j_val);
-    if(uuid == NULL) {
-      continue;
-    }
-
-    j_tmp = ob_get_campaign(uuid);
-    if(j_tmp == NULL) {
-      continue;
-    }
-
-    ret = is_stopable_campaign_schedule_day_date_list(j_tmp);
-    if(ret == false) {
-      json_decref(j_tmp);
-      continue;
-    }
-
-    json_array_append_new(j_res, j_tmp);
-  }
-  json_decref(j_uuids);
-
-  return j_res;
-}
-
 /**
  * Update ob_campaign
  * @param j_camp
@@ -496,6 +431,7 @@ json_t* ob_update_campaign(const json_t* j_camp)
   // update
   db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_CAMPAIGN, uuid);
 
   slog(LOG_DEBUG, "Getting updated campaign info. uuid[%s]", uuid);
   j_tmp = ob_get_campaign(uuid);
@@ -819,181 +755,6 @@ bool ob_is_stoppable_campgain(json_t* j_camp)
   return true;
 }
 
-static bool is_startable_campaign_schedule(json_t* j_camp)
-{
-  char* cur_date;
-  char* cur_time;
-  int cur_day;
-  int ret;
-
-  if(j_camp == NULL) {
-    return false;
-  }
-
-  cur_date = utils_get_utc_timestamp_date();
-  cur_time = utils_get_utc_timestamp_time();
-  cur_day = utils_get_utc_timestamp_day();
-
-  // check startable date
-  ret = is_startable_campaign_schedule_check(j_camp, cur_date, cur_time, cur_day);
-  sfree(cur_date);
-  sfree(cur_time);
-  if(ret == true) {
-    return true;
-  }
-
-  return false;
-}
-
-static bool is_startable_campaign_schedule_check(
-    json_t* j_camp,
-    const char* cur_date,
-    const char* cur_time,
-    int cur_day
-    )
-{
-  const char* date_list;
-  const char* date_except;
-  char* tmp;
-  const char* tmp_const;
-  int ret;
-
-  if((j_camp == NULL) || (cur_date == NULL) || (cur_time == NULL)) {
-    return false;
-  }
-
-  // check except date. If there's except date, return false
-  date_except = json_string_value(json_object_get(j_camp, "sc_date_list_except"));
-  if(date_except != NULL) {
-    tmp = strstr(date_except, cur_date);
-    if(tmp != NULL) {
-      return false;
-    }
-  }
-
-  // check date_list. If there's current date, return true
-  date_list = json_string_value(json_object_get(j_camp, "sc_date_list"));
-  if(date_list != NULL) {
-    tmp = strstr(date_list, cur_date);
-    if(tmp != NULL) {
-      return true;
-    }
-  }
-
-  // check start date.
-  // if start date is in the future, return false
-  tmp_const = json_string_value(json_object_get(j_camp, "sc_date_start"));
-  if(tmp_const != NULL) {
-    ret = strcmp(tmp_const, cur_date);
-    if(ret > 0) {
-      return false;
-    }
-  }
-
-  // check end date.
-  // if end date is in the fast, return false
-  tmp_const = json_string_value(json_object_get(j_camp, "sc_date_end"));
-  if(tmp_const != NULL) {
-    ret = strcmp(tmp_const, cur_date);
-    if(ret < 0) {
-      return false;
-    }
-  }
-
-  // check startable day
-  ret = is_startable_campaign_schedule_day(j_camp, cur_day);
-  if(ret == false) {
-    return false;
-  }
-
-  // check end time
-  // if end time is in the fast, return false
-  tmp_const = json_string_value(json_object_get(j_camp, "sc_time_end"));
-  if(tmp_const != NULL) {
-    ret = strcmp(tmp_const, cur_time);
-    if(ret < 0) {
-      return false;
-    }
-  }
-
-  // check start time
-  // if start time is in the future, return false
-  tmp_const = json_string_value(json_object_get(j_camp, "sc_time_start"));
-  if(tmp_const != NULL) {
-    ret = strcmp(tmp_const, cur_time);
-    if(ret > 0) {
-      return false;
-    }
-  }
-
-  return true;
-}
-
-static bool is_startable_campaign_schedule_day(json_t* j_camp, int day)
-{
-  const char* day_list;
-  char* tmp;
-  char   day_str[2];
-
-  // 0=Sunday, 1=Monday, ..., 6=Saturday
-  if((j_camp == NULL) || (day < 0) || (day > 6)) {
-    return false;
-  }
-
-  // if it doesn't set, just return true.
-  day_list = json_string_value(json_object_get(j_camp, "sc_day_list"));
-  if((day_list == NULL) || (strlen(day_list) == 0)) {
-    return true;
-  }
-
-  // check date_list. If there's no current date, return false
-  snprintf(day_str, sizeof(day_str), "%d", day);
-  tmp = strstr(day_list, day_str);
-  if(tmp == NULL) {
-    return false;
-  }
-
-  return true;
-}
-
-static bool is_stopable_campaign_schedule_day_date_list(json_t* j_camp)
-{
-  char* cur_date;
-  char* cur_time;
-  int cur_day;
-  int ret;
-
-  if(j_camp == NULL) {
-    return false;
-  }
-
-  cur_date = utils_get_utc_timestamp_date();
-  cur_time = utils_get_utc_timestamp_time();
-  cur_day = utils_get_utc_timestamp_day();
-
-  // check startable date
-  ret = is_stoppable_campaign_schedule_check(j_camp, cur_date, cur_time, cur_day);
-  sfree(cur_date);
-  sfree(cur_time);
-  if(ret == true) {
-    return true;
-  }
-
-  return false;
-}
-
-static bool is_stoppable_campaign_schedule_check(json_t* j_camp, const char* cur_date, const char* cur_time, int cur_day)
-{
-  int ret;
-
-  ret = is_startable_campaign_schedule_check(j_camp, cur_date, cur_time, cur_day);
-  if(ret == true) {
-    return false;
-  }
-
-  return true;
-}
-
 /**
  * Return existence of given ob_campaign uuid.
  * @param uuid
@@ -1207,6 +968,7 @@ bool ob_clear_campaign_destination(const char* uuid_dest)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate_all(E_OB_CACHE_CAMPAIGN);
   if(ret == false) {
     return false;
   }
@@ -1234,6 +996,7 @@ bool ob_clear_campaign_dlma(const char* uuid_dlma)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate_all(E_OB_CACHE_CAMPAIGN);
   if(ret == false) {
     return false;
   }
@@ -1261,6 +1024,7 @@ bool ob_clear_campaign_plan(const char* uuid_plan)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate_all(E_OB_CACHE_CAMPAIGN);
   if(ret == false) {
     return false;
   }
@@ -1271,3 +1035,294 @@ bool ob_clear_campaign_plan(const char* uuid_plan)
 
 
 
+
+/**
+ * Initiate campaign schedule.
+ * Evaluates all of the campaigns and arms the event for the earliest schedule transition.
+ * @return
+ */
+bool ob_init_campaign_schedule(void)
+{
+  json_t* j_uuids;
+  json_t* j_val;
+  unsigned int idx;
+
+  if(g_app->evt_base == NULL) {
+    slog(LOG_ERR, "Could not initiate campaign schedule. No event base.");
+    return false;
+  }
+
+  if(g_ev_campaign_schedule != NULL) {
+    event_free(g_ev_campaign_schedule);
+  }
+
+  g_ev_campaign_schedule = evtimer_new(g_app->evt_base, cb_campaign_schedule, NULL);
+  if(g_ev_campaign_schedule == NULL) {
+    slog(LOG_ERR, "Could not create campaign schedule event.");
+    return false;
+  }
+
+  j_uuids = ob_get_campaigns_all_uuid();
+  json_array_foreach(j_uuids, idx, j_val) {
+    ob_reschedule_campaign(json_string_value(json_object_get(j_val, "uuid")));
+  }
+  json_decref(j_uuids);
+
+  return true;
+}
+
+/**
+ * Terminate campaign schedule.
+ */
+void ob_term_campaign_schedule(void)
+{
+  struct campaign_schedule* sc;
+
+  if(g_ev_campaign_schedule != NULL) {
+    event_free(g_ev_campaign_schedule);
+    g_ev_campaign_schedule = NULL;
+  }
+
+  while(1) {
+    sc = RB_MIN(campaign_schedule_uuids, &g_campaign_schedule_uuids);
+    if(sc == NULL) {
+      break;
+    }
+
+    RB_REMOVE(campaign_schedule_uuids, &g_campaign_schedule_uuids, sc);
+    RB_REMOVE(campaign_schedule_fires, &g_campaign_schedule_fires, sc);
+    sfree(sc->uuid);
+    sfree(sc);
+  }
+
+  return;
+}
+
+/**
+ * Evaluate the campaign's schedule now and compute the next transition.
+ * Should be called whenever the campaign's schedule is changed.
+ * @param uuid
+ * @return
+ */
+bool ob_reschedule_campaign(const char* uuid)
+{
+  if(uuid == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired ob_reschedule_campaign. uuid[%s]", uuid);
+
+  apply_campaign_schedule(uuid, time(NULL));
+
+  return true;
+}
+
+/**
+ * Fired at the earliest campaign schedule transition.
+ */
+static void cb_campaign_schedule(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  struct campaign_schedule* sc;
+  time_t now;
+  char* uuid;
+
+  now = time(NULL);
+  while(1) {
+    sc = RB_MIN(campaign_schedule_fires, &g_campaign_schedule_fires);
+    if((sc == NULL) || (sc->fire > now)) {
+      break;
+    }
+
+    // the entry could be released in the apply.
+    uuid = strdup(sc->uuid);
+    apply_campaign_schedule(uuid, now);
+    sfree(uuid);
+  }
+
+  arm_campaign_schedule();
+
+  return;
+}
+
+/**
+ * Update the campaign status by its schedule,
+ * and set the next transition time.
+ * @param uuid
+ * @param now
+ */
+static void apply_campaign_schedule(const char* uuid, time_t now)
+{
+  json_t* j_camp;
+  ob_schedule sc;
+  time_t fire;
+  int status;
+  int ret;
+
+  j_camp = ob_get_campaign(uuid);
+  if(j_camp == NULL) {
+    remove_campaign_schedule(uuid);
+    return;
+  }
+
+  if(json_integer_value(json_object_get(j_camp, "sc_mode")) != E_CAMP_SCHEDULE_ON) {
+    remove_campaign_schedule(uuid);
+    json_decref(j_camp);
+    return;
+  }
+
+  sc.date_start = json_string_value(json_object_get(j_camp, "sc_date_start"));
+  sc.date_end = json_string_value(json_object_get(j_camp, "sc_date_end"));
+  sc.date_list = json_string_value(json_object_get(j_camp, "sc_date_list"));
+  sc.date_list_except = json_string_value(json_object_get(j_camp, "sc_date_list_except"));
+  sc.time_start = json_string_value(json_object_get(j_camp, "sc_time_start"));
+  sc.time_end = json_string_value(json_object_get(j_camp, "sc_time_end"));
+  sc.day_list = json_string_value(json_object_get(j_camp, "sc_day_list"));
+  sc.timezone = json_string_value(json_object_get(j_camp, "sc_timezone"));
+
+  status = json_integer_value(json_object_get(j_camp, "status"));
+  ret = ob_schedule_is_open(&sc, now);
+  if((ret == true) && (status == E_CAMP_STOP)) {
+    slog(LOG_NOTICE, "Update ob_campaign status to starting by scheduling. camp_uuid[%s], camp_name[%s]",
+        uuid,
+        json_string_value(json_object_get(j_camp, "name"))? : ""
+        );
+    ret = ob_update_campaign_status(uuid, E_CAMP_STARTING);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not update ob_campaign status to starting. camp_uuid[%s]", uuid);
+    }
+  }
+  else if((ret == false) && (status == E_CAMP_START)) {
+    slog(LOG_NOTICE, "Update ob_campaign status to stopping by scheduling. camp_uuid[%s], camp_name[%s]",
+        uuid,
+        json_string_value(json_object_get(j_camp, "name"))? : ""
+        );
+    ret = ob_update_campaign_status(uuid, E_CAMP_STOPPING);
+    if(ret == false) {
+      slog(LOG_ERR, "Could not update ob_campaign status to stopping. camp_uuid[%s]", uuid);
+    }
+  }
+
+  fire = ob_schedule_get_next_transition(&sc, now);
+  json_decref(j_camp);
+  if(fire == -1) {
+    fire = now + DEF_CAMPAIGN_SCHEDULE_RECHECK;
+  }
+  slog(LOG_DEBUG, "Set next campaign schedule. uuid[%s], fire[%lld]", uuid, (long long)fire);
+
+  set_campaign_schedule(uuid, fire);
+
+  return;
+}
+
+static int compare_campaign_schedule_uuid(struct campaign_schedule* e1, struct campaign_schedule* e2)
+{
+  return strcmp(e1->uuid, e2->uuid);
+}
+
+static int compare_campaign_schedule_fire(struct campaign_schedule* e1, struct campaign_schedule* e2)
+{
+  if(e1->fire < e2->fire) {
+    return -1;
+  }
+  if(e1->fire > e2->fire) {
+    return 1;
+  }
+  return strcmp(e1->uuid, e2->uuid);
+}
+
+static struct campaign_schedule* find_campaign_schedule(const char* uuid)
+{
+  struct campaign_schedule find;
+
+  if(uuid == NULL) {
+    return NULL;
+  }
+
+  find.uuid = (char*)uuid;
+
+  return RB_FIND(campaign_schedule_uuids, &g_campaign_schedule_uuids, &find);
+}
+
+/**
+ * Add or update the campaign's next transition time.
+ * @param uuid
+ * @param fire
+ */
+static void set_campaign_schedule(const char* uuid, time_t fire)
+{
+  struct campaign_schedule* sc;
+
+  sc = find_campaign_schedule(uuid);
+  if(sc != NULL) {
+    RB_REMOVE(campaign_schedule_fires, &g_campaign_schedule_fires, sc);
+    sc->fire = fire;
+    RB_INSERT(campaign_schedule_fires, &g_campaign_schedule_fires, sc);
+  }
+  else {
+    sc = calloc(1, sizeof(struct campaign_schedule));
+    sc->uuid = strdup(uuid);
+    sc->fire = fire;
+
+    RB_INSERT(campaign_schedule_uuids, &g_campaign_schedule_uuids, sc);
+    RB_INSERT(campaign_schedule_fires, &g_campaign_schedule_fires, sc);
+  }
+
+  arm_campaign_schedule();
+
+  return;
+}
+
+static void remove_campaign_schedule(const char* uuid)
+{
+  struct campaign_schedule* sc;
+
+  sc = find_campaign_schedule(uuid);
+  if(sc == NULL) {
+    return;
+  }
+
+  RB_REMOVE(campaign_schedule_uuids, &g_campaign_schedule_uuids, sc);
+  RB_REMOVE(campaign_schedule_fires, &g_campaign_schedule_fires, sc);
+  sfree(sc->uuid);
+  sfree(sc);
+
+  arm_campaign_schedule();
+
+  return;
+}
+
+/**
+ * Arm the schedule event for the earliest transition.
+ * The transition time is wall clock based,
+ * so the wait is limited to DEF_CAMPAIGN_SCHEDULE_MAX_WAIT.
+ */
+static void arm_campaign_schedule(void)
+{
+  struct campaign_schedule* sc;
+  struct timeval tv;
+  time_t remain;
+
+  if(g_ev_campaign_schedule == NULL) {
+    return;
+  }
+
+  sc = RB_MIN(campaign_schedule_fires, &g_campaign_schedule_fires);
+  if(sc == NULL) {
+    evtimer_del(g_ev_campaign_schedule);
+    return;
+  }
+
+  remain = sc->fire - time(NULL);
+  if(remain < 0) {
+    remain = 0;
+  }
+  if(remain > DEF_CAMPAIGN_SCHEDULE_MAX_WAIT) {
+    remain = DEF_CAMPAIGN_SCHEDULE_MAX_WAIT;
+  }
+  tv.tv_sec = remain;
+  tv.tv_usec = 0;
+
+  evtimer_add(g_ev_campaign_schedule, &tv);
+
+  return;
+}
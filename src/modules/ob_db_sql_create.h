@@ -205,6 +205,7 @@ static const char* g_sql_ob_campaign =
 "    sc_time_start        time,"    // "HH:MM:SS"
 "    sc_time_end          time,"    // "HH:MM:SS"
 "    sc_day_list          text,"    // "0, 1, ..., 6" 0=Sunday, 1=Monday, ... 6=Saturday
+"    sc_timezone          varchar(255),"  // tz database name. "America/New_York". UTC if not set.
 
 // timestamp. UTC."
 "    tm_create           datetime(6),"   // create time."
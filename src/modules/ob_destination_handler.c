@@ -23,6 +23,9 @@
 #include "db_ctx_handler.h"
 #include "ob_dl_handler.h"
 #include "ob_campaign_handler.h"
+#include "ob_cache_handler.h"
+#include "queue_handler.h"
+#include "resource_handler.h"
 
 static json_t* get_deleted_ob_destination(const char* uuid);
 static json_t* create_ob_destination_default(void);
@@ -140,6 +143,7 @@ json_t* ob_delete_destination(const char* uuid)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_DESTINATION, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not delete ob_destination. uuid[%s]", uuid);
     return NULL;
@@ -194,11 +198,17 @@ json_t* ob_get_destination(const char* uuid)
     return NULL;
   }
 
+  j_res = ob_cache_get(E_OB_CACHE_DESTINATION, uuid);
+  if(j_res != NULL) {
+    return j_res;
+  }
+
   j_res = get_ob_destination_use(uuid, E_USE_OK);
   if(j_res == NULL) {
     slog(LOG_WARNING, "Could not get ob_destination info.");
     return NULL;
   }
+  ob_cache_set(E_OB_CACHE_DESTINATION, j_res);
 
   return j_res;
 }
@@ -297,6 +307,24 @@ json_t* ob_get_destinations_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of destinations ordered by uuid.
+ * @param cursor: uuid of the last destination of the previous page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_destinations_page(const char* cursor, int count)
+{
+  json_t* j_res;
+  char* where;
+
+  asprintf(&where, "in_use=%d", E_USE_OK);
+  j_res = resource_get_db_items_page(g_db_ob, "ob_destination", where, "uuid", cursor, count);
+  sfree(where);
+
+  return j_res;
+}
+
 /**
  * Update ob_destination
  * @param j_dest
@@ -348,6 +376,7 @@ json_t* ob_update_destination(const json_t* j_dest)
   // update
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_DESTINATION, uuid);
   if(ret == false) {
     slog(LOG_ERR, "Could not update ob_destination info. uuid[%s]", uuid);
     sfree(uuid);
@@ -452,9 +481,7 @@ static int get_avail_cnt_app(json_t* j_dest)
 
 static int get_avail_cnt_app_queue_available_member(const char* name)
 {
-  int ret;
-  char* sql;
-  json_t* j_res;
+  queue_stat stat;
 
   if(name == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -462,40 +489,16 @@ static int get_avail_cnt_app_queue_available_member(const char* name)
   }
   slog(LOG_DEBUG, "Fired get_avail_cnt_app_queue.");
 
-  asprintf(&sql, "select count(*) from queue_member where queue_name=\"%s\""
-      " and status = %d"
-      " and paused = %d"
-      ";",
-      name,
-      AST_DEVICE_NOT_INUSE,
-      0
-      );
-
-  ret = db_ctx_query(g_db_memory, sql);
-  sfree(sql);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not get correct available queue member info. queue_name[%s]", name);
-    return 0;
-  }
-
-  j_res = db_ctx_get_record(g_db_memory);
-  db_ctx_free(g_db_memory);
-  if(j_res == NULL) {
-    slog(LOG_ERR, "Could not get correct available queue member count. queue_name[%s]", name);
-    return 0;
-  }
+  // not in use and not paused member count
+  queue_get_stat(name, &stat);
 
-  ret = json_integer_value(json_object_get(j_res, "count(*)"));
-  json_decref(j_res);
-  return ret;
+  return stat.ready;
 }
 
 static int get_avail_cnt_app_queue_service_perf(const char* name)
 {
+  queue_stat stat;
   int ret;
-  char* sql;
-  json_t* j_res;
-  double service_perf;
 
   if(name == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -503,33 +506,19 @@ static int get_avail_cnt_app_queue_service_perf(const char* name)
   }
   slog(LOG_DEBUG, "fired get_avail_cnt_app_queue_service_perf.");
 
-  asprintf(&sql, "select service_level_perf from queue_param where name=\"%s\";",
-      name
-      );
-
-  ret = db_ctx_query(g_db_memory, sql);
-  sfree(sql);
+  ret = queue_get_stat(name, &stat);
   if(ret == false) {
     slog(LOG_ERR, "Could not get correct queue performance info. queue_name[%s]", name);
     return 0;
   }
 
-  j_res = db_ctx_get_record(g_db_memory);
-  db_ctx_free(g_db_memory);
-  if(j_res == NULL) {
-    slog(LOG_ERR, "Could not get correct queue performance info. queue_name[%s]", name);
-    return 0;
-  }
-
   // get service level performance
-  service_perf = json_real_value(json_object_get(j_res, "service_level_perf"));
-  json_decref(j_res);
-  if(service_perf == 0) {
-    service_perf = 1;
+  if(stat.service_level_perf == 0) {
+    stat.service_level_perf = 1;
   }
 
   // convert type. we need only the integer here.
-  ret = (int)service_perf;
+  ret = (int)stat.service_level_perf;
 
   return ret;
 }
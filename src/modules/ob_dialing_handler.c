@@ -10,8 +10,11 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
+#include <event2/event.h>
 #include <jansson.h>
 
+#include "bsd_tree.h"
 #include "common.h"
 #include "slog.h"
 #include "utils.h"
@@ -23,6 +26,7 @@
 #include "ob_dialing_handler.h"
 #include "ob_event_handler.h"
 #include "ob_dl_handler.h"
+#include "resource_handler.h"
 
 extern app* g_app;
 extern db_ctx_t* g_db_ob;
@@ -102,8 +106,42 @@ map_res_dial g_map_res_dial[] =
 };
 
 
+/**
+ * Dialing timeout timer.
+ * Each live dialing is kept in the deadline ordered tree,
+ * and only one event is armed for the earliest deadline.
+ */
+struct dialing_timer {
+  RB_ENTRY(dialing_timer) link_uuid;
+  RB_ENTRY(dialing_timer) link_deadline;
+
+  char* uuid;           ///< dialing uuid
+  long long deadline;   ///< timeout deadline. monotonic milli seconds
+};
+
+static struct event* g_ev_dialing_timeout = NULL;   ///< dialing timeout event
+static long long g_dialing_timeout_armed = -1;      ///< armed deadline of the dialing timeout event
+
 static const char* get_res_dial_detail_string(int res_dial);
 
+static void cb_dialing_timeout(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static int compare_dialing_timer_uuid(struct dialing_timer* e1, struct dialing_timer* e2);
+static int compare_dialing_timer_deadline(struct dialing_timer* e1, struct dialing_timer* e2);
+static long long get_monotonic_msec(void);
+static int get_dialing_timeout(void);
+static struct dialing_timer* find_dialing_timer(const char* uuid);
+static bool add_dialing_timer(const char* uuid);
+static void touch_dialing_timer(const char* uuid);
+static void remove_dialing_timer(const char* uuid);
+static void arm_dialing_timer(void);
+
+RB_HEAD(dialing_timer_uuids, dialing_timer) g_dialing_timer_uuids = RB_INITIALIZER(&g_dialing_timer_uuids);
+RB_HEAD(dialing_timer_deadlines, dialing_timer) g_dialing_timer_deadlines = RB_INITIALIZER(&g_dialing_timer_deadlines);
+RB_PROTOTYPE(dialing_timer_uuids, dialing_timer, link_uuid, compare_dialing_timer_uuid);
+RB_PROTOTYPE(dialing_timer_deadlines, dialing_timer, link_deadline, compare_dialing_timer_deadline);
+RB_GENERATE(dialing_timer_uuids, dialing_timer, link_uuid, compare_dialing_timer_uuid);
+RB_GENERATE(dialing_timer_deadlines, dialing_timer, link_deadline, compare_dialing_timer_deadline);
+
 /**
  * Create dialing obj.
  * @param j_camp
@@ -293,8 +331,7 @@ bool ob_update_dialing_timestamp(const char* uuid)
     return false;
   }
 
-  ret = ob_is_exist_dialing(uuid);
-  if(ret == false) {
+  if(find_dialing_timer(uuid) == NULL) {
     // non exist
     // already deleted dialing or wrong dialing uuid
     return false;
@@ -322,6 +359,8 @@ bool ob_update_dialing_timestamp(const char* uuid)
     return false;
   }
 
+  touch_dialing_timer(uuid);
+
   return true;
 }
 
@@ -348,6 +387,8 @@ bool ob_delete_dialing(const char* uuid)
     return false;
   }
 
+  remove_dialing_timer(uuid);
+
   return true;
 }
 
@@ -367,6 +408,14 @@ bool ob_insert_dialing(json_t* j_dialing)
     return false;
   }
 
+  // register timeout
+  ret = add_dialing_timer(json_string_value(json_object_get(j_dialing, "uuid")));
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not register dialing timeout. uuid[%s]",
+        json_string_value(json_object_get(j_dialing, "uuid"))
+        );
+  }
+
   return true;
 }
 
@@ -612,6 +661,8 @@ bool ob_update_dialing_status(const char* uuid, E_DIALING_STATUS_T status)
     return false;
   }
 
+  touch_dialing_timer(uuid);
+
   return true;
 }
 
@@ -720,6 +771,8 @@ bool ob_update_dialing_hangup(const char* uuid, int hangup, const char* hangup_d
     return false;
   }
 
+  touch_dialing_timer(uuid);
+
   return true;
 }
 
@@ -779,6 +832,8 @@ bool ob_update_dialing_res_dial(const char* uuid, bool success, int res_dial, co
     return false;
   }
 
+  touch_dialing_timer(uuid);
+
   // update status
   if(success == true) {
     ret = ob_update_dialing_status(uuid, E_DIALING_ORIGINATE_RESPONSED);
@@ -1021,89 +1076,6 @@ json_t* ob_get_dialing(const char* uuid)
   return j_res;
 }
 
-json_t* get_ob_dialings_uuid_timeout(void)
-{
-  char* sql;
-  int ret;
-  json_t* j_res;
-  json_t* j_tmp;
-  int timeout;
-  const char* uuid;
-
-  timeout = json_integer_value(json_object_get(json_object_get(g_app->j_conf, "ob"), "dialing_timeout"));
-  if(timeout < DEF_MIN_DIALING_UPDATE_TIMEOUT) {
-    timeout = DEF_MIN_DIALING_UPDATE_TIMEOUT;
-  }
-
-  asprintf(&sql, "select uuid from ob_dialing where"
-      " (strftime('%%s', tm_update) + 0) < (strftime('%%s', 'now') - %d);",
-      timeout
-      );
-
-  ret = db_ctx_query(g_db_ob, sql);
-  sfree(sql);
-  if(ret == false) {
-    slog(LOG_ERR, "Could not get correct ob_dialing record info.");
-    return NULL;
-  }
-
-  j_res = json_array();
-  while(1) {
-    j_tmp = db_ctx_get_record(g_db_ob);
-    if(j_tmp == NULL) {
-      break;
-    }
-
-    uuid = json_string_value(json_object_get(j_tmp, "uuid"));
-    if(uuid == NULL) {
-      json_decref(j_tmp);
-      continue;
-    }
-
-    json_array_append_new(j_res, json_string(uuid));
-    json_decref(j_tmp);
-  }
-  db_ctx_free(g_db_ob);
-
-  return j_res;
-}
-
-/**
- * Get timeout dialings info.
- * @param action_id
- * @return
- */
-json_t* ob_get_dialings_timeout(void)
-{
-  json_t* j_uuids;
-  unsigned int idx;
-  json_t* j_val;
-  json_t* j_res;
-  json_t* j_tmp;
-  const char* uuid;
-
-  j_uuids = get_ob_dialings_uuid_timeout();
-
-  j_res = json_array();
-  json_array_foreach(j_uuids, idx, j_val) {
-
-    uuid = json_string_value(j_val);
-    if(uuid == NULL) {
-      continue;
-    }
-
-    j_tmp = ob_get_dialing(uuid);
-    if(j_tmp == NULL) {
-      continue;
-    }
-
-    json_array_append_new(j_res, j_tmp);
-  }
-  json_decref(j_uuids);
-
-  return j_res;
-}
-
 static json_t* get_ob_dalings_uuid_error(void)
 {
   char* sql;
@@ -1292,6 +1264,20 @@ json_t* ob_get_dialings_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of dialings ordered by uuid.
+ * @param cursor: uuid of the last dialing of the previous page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_dialings_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_db_items_page(g_db_ob, "ob_dialing", NULL, "uuid", cursor, count);
+  return j_res;
+}
+
 
 /**
  * Return existence of given ob_dialing uuid.
@@ -1434,3 +1420,269 @@ bool ob_send_dialing_hangup_request(const char* uuid)
 
   return true;
 }
+
+/**
+ * Initiate dialing timeout timer.
+ * @return
+ */
+bool ob_init_dialing_timeout(void)
+{
+  if(g_app->evt_base == NULL) {
+    slog(LOG_ERR, "Could not initiate dialing timeout. No event base.");
+    return false;
+  }
+
+  if(g_ev_dialing_timeout != NULL) {
+    event_free(g_ev_dialing_timeout);
+  }
+
+  g_ev_dialing_timeout = evtimer_new(g_app->evt_base, cb_dialing_timeout, NULL);
+  if(g_ev_dialing_timeout == NULL) {
+    slog(LOG_ERR, "Could not create dialing timeout event.");
+    return false;
+  }
+  g_dialing_timeout_armed = -1;
+  arm_dialing_timer();
+
+  return true;
+}
+
+/**
+ * Terminate dialing timeout timer.
+ */
+void ob_term_dialing_timeout(void)
+{
+  struct dialing_timer* timer;
+
+  if(g_ev_dialing_timeout != NULL) {
+    event_free(g_ev_dialing_timeout);
+    g_ev_dialing_timeout = NULL;
+  }
+  g_dialing_timeout_armed = -1;
+
+  while(1) {
+    timer = RB_MIN(dialing_timer_uuids, &g_dialing_timer_uuids);
+    if(timer == NULL) {
+      break;
+    }
+
+    RB_REMOVE(dialing_timer_uuids, &g_dialing_timer_uuids, timer);
+    RB_REMOVE(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+    sfree(timer->uuid);
+    sfree(timer);
+  }
+
+  return;
+}
+
+/**
+ * Fired at the earliest dialing deadline.
+ * Updates the expired dialings status to timeout.
+ */
+static void cb_dialing_timeout(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  struct dialing_timer* timer;
+  long long now;
+  char* uuid;
+  int ret;
+
+  g_dialing_timeout_armed = -1;
+  now = get_monotonic_msec();
+
+  while(1) {
+    timer = RB_MIN(dialing_timer_deadlines, &g_dialing_timer_deadlines);
+    if((timer == NULL) || (timer->deadline > now)) {
+      break;
+    }
+
+    // reschedule first. the dialing stays until the error handler deletes it.
+    uuid = strdup(timer->uuid);
+    RB_REMOVE(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+    timer->deadline = now + ((long long)get_dialing_timeout() * 1000);
+    RB_INSERT(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+
+    slog(LOG_NOTICE, "Dialing timed out. uuid[%s]", uuid);
+    ret = ob_update_dialing_status(uuid, E_DIALING_ERROR_UPDATE_TIMEOUT);
+    if(ret == false) {
+      // the dialing is not exist anymore.
+      remove_dialing_timer(uuid);
+    }
+    sfree(uuid);
+  }
+
+  arm_dialing_timer();
+
+  return;
+}
+
+static int compare_dialing_timer_uuid(struct dialing_timer* e1, struct dialing_timer* e2)
+{
+  return strcmp(e1->uuid, e2->uuid);
+}
+
+static int compare_dialing_timer_deadline(struct dialing_timer* e1, struct dialing_timer* e2)
+{
+  if(e1->deadline < e2->deadline) {
+    return -1;
+  }
+  if(e1->deadline > e2->deadline) {
+    return 1;
+  }
+  return strcmp(e1->uuid, e2->uuid);
+}
+
+static long long get_monotonic_msec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((long long)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+}
+
+/**
+ * Returns dialing update timeout(sec).
+ * @return
+ */
+static int get_dialing_timeout(void)
+{
+  json_t* j_tmp;
+  int timeout;
+
+  j_tmp = json_object_get(json_object_get(g_app->j_conf, "ob"), "dialing_timeout");
+  if(json_is_string(j_tmp)) {
+    timeout = atoi(json_string_value(j_tmp));
+  }
+  else {
+    timeout = json_integer_value(j_tmp);
+  }
+
+  if(timeout < DEF_MIN_DIALING_UPDATE_TIMEOUT) {
+    timeout = DEF_MIN_DIALING_UPDATE_TIMEOUT;
+  }
+
+  return timeout;
+}
+
+static struct dialing_timer* find_dialing_timer(const char* uuid)
+{
+  struct dialing_timer find;
+
+  if(uuid == NULL) {
+    return NULL;
+  }
+
+  find.uuid = (char*)uuid;
+
+  return RB_FIND(dialing_timer_uuids, &g_dialing_timer_uuids, &find);
+}
+
+/**
+ * Register the dialing to the timeout timer.
+ * @param uuid
+ * @return
+ */
+static bool add_dialing_timer(const char* uuid)
+{
+  struct dialing_timer* timer;
+
+  if(uuid == NULL) {
+    return false;
+  }
+
+  timer = find_dialing_timer(uuid);
+  if(timer != NULL) {
+    touch_dialing_timer(uuid);
+    return true;
+  }
+
+  timer = calloc(1, sizeof(struct dialing_timer));
+  timer->uuid = strdup(uuid);
+  timer->deadline = get_monotonic_msec() + ((long long)get_dialing_timeout() * 1000);
+
+  RB_INSERT(dialing_timer_uuids, &g_dialing_timer_uuids, timer);
+  RB_INSERT(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+
+  arm_dialing_timer();
+
+  return true;
+}
+
+/**
+ * Reschedule the dialing's timeout deadline.
+ * @param uuid
+ */
+static void touch_dialing_timer(const char* uuid)
+{
+  struct dialing_timer* timer;
+
+  timer = find_dialing_timer(uuid);
+  if(timer == NULL) {
+    return;
+  }
+
+  RB_REMOVE(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+  timer->deadline = get_monotonic_msec() + ((long long)get_dialing_timeout() * 1000);
+  RB_INSERT(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+
+  arm_dialing_timer();
+
+  return;
+}
+
+static void remove_dialing_timer(const char* uuid)
+{
+  struct dialing_timer* timer;
+
+  timer = find_dialing_timer(uuid);
+  if(timer == NULL) {
+    return;
+  }
+
+  RB_REMOVE(dialing_timer_uuids, &g_dialing_timer_uuids, timer);
+  RB_REMOVE(dialing_timer_deadlines, &g_dialing_timer_deadlines, timer);
+  sfree(timer->uuid);
+  sfree(timer);
+
+  arm_dialing_timer();
+
+  return;
+}
+
+/**
+ * Arm the timeout event for the earliest deadline.
+ * Does nothing if the event is already armed for it.
+ */
+static void arm_dialing_timer(void)
+{
+  struct dialing_timer* timer;
+  struct timeval tv;
+  long long remain;
+
+  if(g_ev_dialing_timeout == NULL) {
+    return;
+  }
+
+  timer = RB_MIN(dialing_timer_deadlines, &g_dialing_timer_deadlines);
+  if(timer == NULL) {
+    evtimer_del(g_ev_dialing_timeout);
+    g_dialing_timeout_armed = -1;
+    return;
+  }
+
+  if(timer->deadline == g_dialing_timeout_armed) {
+    return;
+  }
+
+  remain = timer->deadline - get_monotonic_msec();
+  if(remain < 0) {
+    remain = 0;
+  }
+  tv.tv_sec = remain / 1000;
+  tv.tv_usec = (remain % 1000) * 1000;
+
+  evtimer_add(g_ev_dialing_timeout, &tv);
+  g_dialing_timeout_armed = timer->deadline;
+
+  return;
+}
@@ -496,6 +496,75 @@ json_t* ob_get_dls_by_dlma_count(const char* dlma_uuid, int count)
   return j_res;
 }
 
+/**
+ * Get the page of dl_list ordered by uuid.
+ * Gets all of the records in one query.
+ * @param dlma_uuid
+ * @param cursor: uuid of the last dl of the previous page. NULL for the first page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_dls_by_dlma_page(const char* dlma_uuid, const char* cursor, int count)
+{
+  char* sql;
+  char* condition;
+  char* tmp_sqlite_buf;
+  char* dl_table;
+  json_t* j_res;
+  json_t* j_tmp;
+  int ret;
+
+  if((dlma_uuid == NULL) || (count <= 0)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+  slog(LOG_DEBUG, "Fired ob_get_dls_by_dlma_page. dlma_uuid[%s], count[%d]", dlma_uuid, count);
+
+  // get dl_table
+  dl_table = ob_get_dlma_table_name(dlma_uuid);
+  if(dl_table == NULL) {
+    slog(LOG_NOTICE, "Could not get correct dl_table name. dlma_uuid[%s]", dlma_uuid);
+    return NULL;
+  }
+
+  if(cursor == NULL) {
+    condition = strdup("");
+  }
+  else {
+    tmp_sqlite_buf = sqlite3_mprintf("%Q", cursor);
+    asprintf(&condition, " and uuid > %s", tmp_sqlite_buf);
+    sqlite3_free(tmp_sqlite_buf);
+  }
+
+  asprintf(&sql, "select * from `%s` where in_use=%d%s order by uuid limit %d;",
+      dl_table,
+      E_USE_OK,
+      condition,
+      count
+      );
+  sfree(dl_table);
+  sfree(condition);
+
+  ret = db_ctx_query(g_db_ob, sql);
+  sfree(sql);
+  if(ret == false) {
+    slog(LOG_ERR, "Could not get dial list info.");
+    return NULL;
+  }
+
+  j_res = json_array();
+  while(1) {
+    j_tmp = db_ctx_get_record(g_db_ob);
+    if(j_tmp == NULL) {
+      break;
+    }
+    json_array_append_new(j_res, j_tmp);
+  }
+  db_ctx_free(g_db_ob);
+
+  return j_res;
+}
+
 static json_t* get_ob_dls_uuid_count(int count)
 {
   char* sql;
@@ -21,6 +21,8 @@
 #include "ob_dlma_handler.h"
 #include "ob_dl_handler.h"
 #include "ob_campaign_handler.h"
+#include "ob_cache_handler.h"
+#include "resource_handler.h"
 
 static bool create_dlma_view(const char* uuid, const char* view_name);
 static json_t* create_ob_dlma_default(void);
@@ -160,6 +162,7 @@ json_t* ob_delete_dlma(const char* uuid)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_DLMA, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not delete ob_dlma. uuid[%s]", uuid);
     return NULL;
@@ -216,11 +219,17 @@ json_t* ob_get_dlma(const char* uuid)
     return NULL;
   }
 
+  j_res = ob_cache_get(E_OB_CACHE_DLMA, uuid);
+  if(j_res != NULL) {
+    return j_res;
+  }
+
   j_res = get_ob_dlma_use(uuid, E_USE_OK);
   if(j_res == NULL) {
     slog(LOG_ERR, "Could not get ob_dl_list_ma info. uuid[%s]", uuid);
     return NULL;
   }
+  ob_cache_set(E_OB_CACHE_DLMA, j_res);
   return j_res;
 }
 
@@ -324,6 +333,7 @@ json_t* ob_update_dlma(const json_t* j_dlma)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_DLMA, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not get updated ob_dlma. uuid[%s]", uuid);
     sfree(uuid);
@@ -375,6 +385,24 @@ json_t* ob_get_dlmas_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of dlmas ordered by uuid.
+ * @param cursor: uuid of the last dlma of the previous page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_dlmas_page(const char* cursor, int count)
+{
+  json_t* j_res;
+  char* where;
+
+  asprintf(&where, "in_use=%d", E_USE_OK);
+  j_res = resource_get_db_items_page(g_db_ob, "ob_dl_list_ma", where, "uuid", cursor, count);
+  sfree(where);
+
+  return j_res;
+}
+
 /**
  * Get all dlma's uuid array
  * @return
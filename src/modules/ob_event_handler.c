@@ -18,6 +18,7 @@
 #include "slog.h"
 #include "utils.h"
 #include "db_ctx_handler.h"
+#include "resource_handler.h"
 #include "ami_handler.h"
 #include "ast_header.h"
 #include "ob_db_sql_create.h"
@@ -30,6 +31,8 @@
 #include "ob_destination_handler.h"
 #include "ob_http_handler.h"
 #include "ob_dlma_handler.h"
+#include "ob_result_handler.h"
+#include "ob_cache_handler.h"
 
 
 #define TEMP_FILENAME "/tmp/asterisk_outbound_tmp.txt"
@@ -52,12 +55,9 @@ static void cb_campaign_stopping(__attribute__((unused)) int fd, __attribute__((
 static void cb_campaign_stopping_force(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
 
 static void cb_check_campaign_end(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
-static void cb_check_campaign_schedule_start(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
-static void cb_check_campaign_schedule_end(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
 
 static void cb_check_dialing_end(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
 static void cb_check_dialing_refresh(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
-static void cb_check_dialing_timeout(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
 static void cb_check_dialing_error(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
 
 static void cb_check_dl_error(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
@@ -68,8 +68,6 @@ static void dial_predictive(json_t* j_camp, json_t* j_plan, json_t* j_dlma, json
 static void dial_robo(const json_t* j_camp, const json_t* j_plan, const json_t* j_dlma);
 static void dial_redirect(const json_t* j_camp, const json_t* j_plan, const json_t* j_dlma);
 
-static bool write_result_json(json_t* j_res);
-
 // todo
 static int check_dial_avaiable_predictive(json_t* j_camp, json_t* j_plan, json_t* j_dlma, json_t* j_dest);
 
@@ -80,7 +78,7 @@ static bool init_ob_event_handler(void)
   struct event* ev;
   struct timeval tm_fast;
   struct timeval tm_slow;
-  int cnt = -1;
+  int cnt = 0;
 
   // event delay fast.
   tmp_const = json_string_value(json_object_get(json_object_get(g_app->j_conf, "general"), "event_time_fast"));
@@ -136,26 +134,11 @@ static bool init_ob_event_handler(void)
   event_add(ev, &tm_slow);
   g_ev_ob[cnt++] = ev;
 
-  // check campaign scheduling start
-  ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_check_campaign_schedule_start, NULL);
-  event_add(ev, &tm_slow);
-  g_ev_ob[cnt++] = ev;
-
-  // check campaign scheduling end
-  ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_check_campaign_schedule_end, NULL);
-  event_add(ev, &tm_slow);
-  g_ev_ob[cnt++] = ev;
-
   // refresh dialing
   ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_check_dialing_refresh, NULL);
   event_add(ev, &tm_slow);
   g_ev_ob[cnt++] = ev;
 
-  // check timeout dialing
-  ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_check_dialing_timeout, NULL);
-  event_add(ev, &tm_slow);
-  g_ev_ob[cnt++] = ev;
-
   // check error dialing
   ev = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_check_dialing_error, NULL);
   event_add(ev, &tm_slow);
@@ -245,6 +228,13 @@ static bool init_ob_database_handler(void)
     return false;
   }
 
+  // ob_campaign. added columns.
+  ret = resource_add_db_column(g_db_ob, "ob_campaign", "sc_timezone", "varchar(255)");
+  if(ret == false) {
+    slog(LOG_ERR, "Could not upgrade outbound database. table[campaign], column[sc_timezone]");
+    return false;
+  }
+
   return true;
 }
 
@@ -266,6 +256,34 @@ bool ob_init_handler(void)
     return false;
   }
 
+  // init cache
+  ret = ob_cache_init_handler();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate outbound cache.");
+    return false;
+  }
+
+  // init result sink
+  ret = ob_result_init_handler();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate outbound result handler.");
+    return false;
+  }
+
+  // init dialing timeout
+  ret = ob_init_dialing_timeout();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate outbound dialing timeout.");
+    return false;
+  }
+
+  // init campaign schedule
+  ret = ob_init_campaign_schedule();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not initiate outbound campaign schedule.");
+    return false;
+  }
+
   // init event
   ret = init_ob_event_handler();
   if(ret == false) {
@@ -296,6 +314,13 @@ void ob_term_handler(void)
     g_ev_ob[idx] = NULL;
   }
 
+  ob_term_dialing_timeout();
+  ob_term_campaign_schedule();
+  ob_cache_term_handler();
+
+  // flush and close the result file
+  ob_result_term_handler();
+
   return;
 }
 
@@ -661,7 +686,7 @@ static void cb_check_dialing_end(__attribute__((unused)) int fd, __attribute__((
     }
 
     // write result
-    ret = write_result_json(j_res);
+    ret = ob_result_write(j_res);
     json_decref(j_res);
     if(ret == false) {
       slog(LOG_ERR, "Could not write result correctly.");
@@ -734,82 +759,6 @@ static void cb_check_campaign_end(__attribute__((unused)) int fd, __attribute__(
   return;
 }
 
-/**
- * Check campaign schedule. If the campaign is start-able, set the status to STARTING.
- * \param fd
- * \param event
- * \param arg
- */
-static void cb_check_campaign_schedule_start(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
-{
-  json_t* j_camps;
-  json_t* j_camp;
-  int size;
-  int i;
-  int ret;
-
-  j_camps = ob_get_campaigns_schedule_start();
-  size = json_array_size(j_camps);
-  for(i = 0; i < size; i++) {
-    j_camp = json_array_get(j_camps, i);
-    if(j_camp == NULL) {
-      continue;
-    }
-
-    slog(LOG_NOTICE, "update ob_campaign status to starting by scheduling. camp_uuid[%s], camp_name[%s]",
-        json_string_value(json_object_get(j_camp, "uuid"))? : "",
-        json_string_value(json_object_get(j_camp, "name"))? : ""
-        );
-    ret = ob_update_campaign_status(json_string_value(json_object_get(j_camp, "uuid")), E_CAMP_STARTING);
-    if(ret == false) {
-      slog(LOG_ERR, "Could not update ob_campaign status to starting. camp_uuid[%s], camp_name[%s]",
-          json_string_value(json_object_get(j_camp, "uuid"))? : "",
-          json_string_value(json_object_get(j_camp, "name"))? : ""
-          );
-    }
-  }
-
-  json_decref(j_camps);
-}
-
-/**
- * Check campaign schedule. If the campaign is end-able, set the status to STOPPING.
- * \param fd
- * \param event
- * \param arg
- */
-static void cb_check_campaign_schedule_end(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
-{
-  json_t* j_camps;
-  json_t* j_camp;
-  int size;
-  int i;
-  int ret;
-
-  j_camps = ob_get_campaigns_schedule_end();
-  size = json_array_size(j_camps);
-  for(i = 0; i < size; i++) {
-    j_camp = json_array_get(j_camps, i);
-    if(j_camp == NULL) {
-      continue;
-    }
-
-    slog(LOG_NOTICE, "Update ob_campaign status to stopping by scheduling. camp_uuid[%s], camp_name[%s]",
-        json_string_value(json_object_get(j_camp, "uuid")),
-        json_string_value(json_object_get(j_camp, "name"))
-        );
-    ret = ob_update_campaign_status(json_string_value(json_object_get(j_camp, "uuid")), E_CAMP_STOPPING);
-    if(ret == false) {
-      slog(LOG_ERR, "Could not update ob_campaign status to schedule_stopping. camp_uuid[%s], camp_name[%s]",
-          json_string_value(json_object_get(j_camp, "uuid")),
-          json_string_value(json_object_get(j_camp, "name"))
-          );
-    }
-  }
-
-  json_decref(j_camps);
-}
-
 /**
  * Check refresh dialing.
  * \param fd
@@ -866,36 +815,6 @@ static void cb_check_dialing_refresh(__attribute__((unused)) int fd, __attribute
   return;
 }
 
-/**
- * Check timed out dialing.
- * \param fd
- * \param event
- * \param arg
- */
-static void cb_check_dialing_timeout(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
-{
-  unsigned int idx;
-  json_t* j_dialings;
-  json_t* j_dialing;
-  const char* uuid;
-
-  // get all timeout dialings
-  j_dialings = ob_get_dialings_timeout();
-  if(j_dialings == NULL) {
-    return;
-  }
-  slog(LOG_DEBUG, "Fired cb_check_dialing_timeout.");
-
-  json_array_foreach(j_dialings, idx, j_dialing) {
-    // update dialing status
-    uuid = json_string_value(json_object_get(j_dialing, "uuid"));
-    ob_update_dialing_status(uuid, E_DIALING_ERROR_UPDATE_TIMEOUT);
-  }
-  json_decref(j_dialings);
-
-  return;
-}
-
 /**
  * Check error dialing.
  * \param fd
@@ -940,7 +859,7 @@ static void cb_check_dialing_error(__attribute__((unused)) int fd, __attribute__
     }
 
     // write result
-    ret = write_result_json(j_res);
+    ret = ob_result_write(j_res);
     json_decref(j_res);
     if(ret == false) {
       slog(LOG_ERR, "Could not write result correctly.");
@@ -1330,51 +1249,3 @@ static int check_dial_avaiable_predictive(
 
   return 1;
 }
-
-static bool write_result_json(json_t* j_res)
-{
-  FILE* fp;
-  const char* filename;
-  char* tmp;
-
-  if(j_res == NULL) {
-    slog(LOG_ERR, "Wrong input parameter.");
-    return false;
-  }
-
-  // open json file
-  filename = json_string_value(json_object_get(json_object_get(g_app->j_conf, "ob"), "dialing_result_filename"));
-  if(filename == NULL) {
-    slog(LOG_ERR, "Could not get option value. option[%s]", "result_filename");
-    return false;
-  }
-
-  // open file
-  fp = fopen(filename, "a");
-  if(fp == NULL) {
-    slog(LOG_ERR, "Could not open result file. filename[%s], err[%s]",
-        filename, strerror(errno)
-        );
-    return false;
-  }
-
-  tmp = json_dumps(j_res, JSON_ENCODE_ANY);
-  if(tmp == NULL) {
-    slog(LOG_ERR, "Could not get result string to the file. filename[%s], err[%s]",
-        filename, strerror(errno)
-        );
-    fclose(fp);
-    return false;
-  }
-
-  fprintf(fp, "%s\n", tmp);
-  sfree(tmp);
-  fclose(fp);
-
-  slog(LOG_DEBUG, "Result write succeed.");
-
-  return true;
-}
-
-
-
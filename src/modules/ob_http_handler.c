@@ -56,6 +56,7 @@ static void htp_get_ob_campaigns_all(evhtp_request_t *req, void *data);
 static void htp_get_ob_campaigns_uuid(evhtp_request_t *req, void *data);
 static void htp_put_ob_campaigns_uuid(evhtp_request_t *req, void *data);
 static void htp_delete_ob_campaigns_uuid(evhtp_request_t *req, void *data);
+static bool is_updated_campaign_schedule(json_t* j_data);
 
 // ob/dlmas
 static void htp_get_ob_dlmas(evhtp_request_t *req, void *data);
@@ -831,30 +832,14 @@ void ob_cb_htp_ob_dls_detail(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_destinations(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_destinations.");
 
-  // get info
-  j_tmp = ob_get_destinations_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_destinations_page, "uuid");
 
   return;
 }
@@ -933,30 +918,14 @@ static void htp_post_ob_destinations(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_destinations_all(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_destinations_all.");
 
-  // get info
-  j_tmp = ob_get_destinations_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_destinations_page, "uuid");
 
   return;
 }
@@ -1170,30 +1139,14 @@ static void htp_delete_ob_destinations_uuid(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_plans(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_plans.");
 
-  // get info
-  j_tmp = ob_get_plans_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_plans_page, "uuid");
 
   return;
 }
@@ -1332,30 +1285,14 @@ static void htp_get_ob_plans_uuid(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_plans_all(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_plans_all.");
 
-  // get plan info
-  j_tmp = ob_get_plans_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_plans_page, "uuid");
 
   return;
 }
@@ -1530,30 +1467,14 @@ static void htp_delete_ob_plans_uuid(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_campaigns(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_campaigns.");
 
-  // get info
-  j_tmp = ob_get_campaigns_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_campaigns_page, "uuid");
 
   return;
 }
@@ -1620,6 +1541,9 @@ static void htp_post_ob_campaigns(evhtp_request_t *req, void *data)
     return;
   }
 
+  // schedule
+  ob_reschedule_campaign(json_string_value(json_object_get(j_tmp, "uuid")));
+
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
   json_object_set_new(j_res, "result", j_tmp);
@@ -1639,30 +1563,14 @@ static void htp_post_ob_campaigns(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_campaigns_all(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_campaigns_all.");
 
-  // get all campaigns info
-  j_tmp = ob_get_campaigns_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_NOTFOUND, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_campaigns_page, "uuid");
 
   return;
 }
@@ -1775,12 +1683,19 @@ static void htp_put_ob_campaigns_uuid(evhtp_request_t *req, void *data)
   // update info
   json_object_set_new(j_data, "uuid", json_string(uuid));
   j_tmp = ob_update_campaign(j_data);
-  json_decref(j_data);
   if(j_tmp == NULL) {
+    json_decref(j_data);
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
 
+  // reschedule if the schedule or status has changed
+  ret = is_updated_campaign_schedule(j_data);
+  json_decref(j_data);
+  if(ret == true) {
+    ob_reschedule_campaign(uuid);
+  }
+
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
   json_object_set_new(j_res, "result", j_tmp);
@@ -1833,6 +1748,9 @@ static void htp_delete_ob_campaigns_uuid(evhtp_request_t *req, void *data)
     return;
   }
 
+  // unschedule
+  ob_reschedule_campaign(uuid);
+
   // create result
   j_res = http_create_default_result(EVHTP_RES_OK);
   json_object_set_new(j_res, "result", j_tmp);
@@ -1844,6 +1762,25 @@ static void htp_delete_ob_campaigns_uuid(evhtp_request_t *req, void *data)
   return;
 }
 
+/**
+ * Returns true if the given campaign update data has schedule or status.
+ * @param j_data
+ * @return
+ */
+static bool is_updated_campaign_schedule(json_t* j_data)
+{
+  const char* key;
+  json_t* j_val;
+
+  json_object_foreach(j_data, key, j_val) {
+    if((strncmp(key, "sc_", 3) == 0) || (strcmp(key, "status") == 0)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 
 /**
  * htp request handler.
@@ -1853,30 +1790,14 @@ static void htp_delete_ob_campaigns_uuid(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_dlmas(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_dlmas.");
 
-  // get info
-  j_tmp = ob_get_dlmas_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_dlmas_page, "uuid");
 
   return;
 }
@@ -1962,30 +1883,14 @@ static void htp_post_ob_dlmas(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_dlmas_all(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_dlmas_all.");
 
-  // get info
-  j_tmp = ob_get_dlmas_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_dlmas_page, "uuid");
 
   return;
 }
@@ -2220,10 +2125,11 @@ static void htp_delete_ob_dlmas_uuid(evhtp_request_t *req, void *data)
 static void htp_get_ob_dls(evhtp_request_t *req, void *data)
 {
   json_t* j_tmp;
-  json_t* j_res;
   const char* dlma_uuid;
   const char* tmp_const;
+  http_page page;
   int count;
+  int ret;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -2245,21 +2151,31 @@ static void htp_get_ob_dls(evhtp_request_t *req, void *data)
     count = atoi(tmp_const);
   }
 
-  // get info
-  j_tmp = ob_get_dls_by_dlma_count(dlma_uuid, count);
+  // get page
+  ret = http_get_page(req, &page);
+  if(ret == false) {
+    http_page_clear(&page);
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    return;
+  }
+
+  // get info. gets one more item to see the next page.
+  if(page.enable == true) {
+    j_tmp = ob_get_dls_by_dlma_page(dlma_uuid, page.cursor, page.limit + 1);
+  }
+  else {
+    j_tmp = ob_get_dls_by_dlma_count(dlma_uuid, count);
+  }
   if(j_tmp == NULL) {
+    http_page_clear(&page);
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
 
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_list(req, j_tmp, &page, "uuid");
+  json_decref(j_tmp);
+  http_page_clear(&page);
 
   return;
 }
@@ -2348,10 +2264,11 @@ static void htp_post_ob_dls(evhtp_request_t *req, void *data)
 static void htp_get_ob_dls_all(evhtp_request_t *req, void *data)
 {
   json_t* j_tmp;
-  json_t* j_res;
   const char* dlma_uuid;
   const char* tmp_const;
+  http_page page;
   int count;
+  int ret;
 
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -2373,21 +2290,31 @@ static void htp_get_ob_dls_all(evhtp_request_t *req, void *data)
     count = atoi(tmp_const);
   }
 
-  // get info
-  j_tmp = ob_get_dls_by_dlma_count(dlma_uuid, count);
+  // get page
+  ret = http_get_page(req, &page);
+  if(ret == false) {
+    http_page_clear(&page);
+    http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
+    return;
+  }
+
+  // get info. gets one more item to see the next page.
+  if(page.enable == true) {
+    j_tmp = ob_get_dls_by_dlma_page(dlma_uuid, page.cursor, page.limit + 1);
+  }
+  else {
+    j_tmp = ob_get_dls_by_dlma_count(dlma_uuid, count);
+  }
   if(j_tmp == NULL) {
+    http_page_clear(&page);
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
 
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_list(req, j_tmp, &page, "uuid");
+  json_decref(j_tmp);
+  http_page_clear(&page);
 
   return;
 }
@@ -2671,34 +2598,14 @@ void ob_cb_htp_ob_dialings_all(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_dialings(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_dialings.");
 
-  // get info
-  j_tmp = ob_get_dialings_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  if(j_res == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_dialings_page, "uuid");
 
   return;
 }
@@ -2711,34 +2618,14 @@ static void htp_get_ob_dialings(evhtp_request_t *req, void *data)
  */
 static void htp_get_ob_dialings_all(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_ob_dialings_all.");
 
-  // get info
-  j_tmp = ob_get_dialings_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  if(j_res == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, ob_get_dialings_page, "uuid");
 
   return;
 }
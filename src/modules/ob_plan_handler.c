@@ -23,6 +23,8 @@
 #include "db_ctx_handler.h"
 #include "ob_campaign_handler.h"
 #include "ob_dl_handler.h"
+#include "ob_cache_handler.h"
+#include "resource_handler.h"
 
 static json_t* get_deleted_ob_plan(const char* uuid);
 static json_t* create_ob_plan_default(void);
@@ -168,6 +170,7 @@ json_t* ob_delete_plan(const char* uuid)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_PLAN, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not delete ob_plan. uuid[%s]", uuid);
     return NULL;
@@ -224,7 +227,15 @@ json_t* ob_get_plan(const char* uuid)
   }
   slog(LOG_DEBUG, "Fired get_ob_plan. uuid[%s]", uuid);
 
+  j_res = ob_cache_get(E_OB_CACHE_PLAN, uuid);
+  if(j_res != NULL) {
+    return j_res;
+  }
+
   j_res = get_ob_plan_use(uuid, E_USE_OK);
+  if(j_res != NULL) {
+    ob_cache_set(E_OB_CACHE_PLAN, j_res);
+  }
 
   return j_res;
 }
@@ -284,6 +295,24 @@ json_t* ob_get_plans_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of plans ordered by uuid.
+ * @param cursor: uuid of the last plan of the previous page.
+ * @param count
+ * @return
+ */
+json_t* ob_get_plans_page(const char* cursor, int count)
+{
+  json_t* j_res;
+  char* where;
+
+  asprintf(&where, "in_use=%d", E_USE_OK);
+  j_res = resource_get_db_items_page(g_db_ob, "ob_plan", where, "uuid", cursor, count);
+  sfree(where);
+
+  return j_res;
+}
+
 /**
  * Get all plan's uuid array
  * @return
@@ -378,6 +407,7 @@ json_t* ob_update_plan(const json_t* j_plan)
 
   ret = db_ctx_exec(g_db_ob, sql);
   sfree(sql);
+  ob_cache_invalidate(E_OB_CACHE_PLAN, uuid);
   if(ret == false) {
     slog(LOG_WARNING, "Could not update ob_plan info. uuid[%s]", uuid);
     sfree(uuid);
@@ -0,0 +1,454 @@
+/*
+ * ob_result_handler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <event2/event.h>
+#include <event2/buffer.h>
+#include <jansson.h>
+
+#include "common.h"
+#include "slog.h"
+#include "utils.h"
+#include "config.h"
+
+#include "ob_result_handler.h"
+
+#define DEF_OB_RESULT_MAX_PENDING_MULTIPLIER  16
+#define DEF_ONE_SEC_IN_MICRO_SEC  1000000
+
+extern app* g_app;
+
+typedef struct _ob_result_sink {
+  int fd;               ///< opened result file descriptor
+  char* filename;       ///< opened result file name
+  off_t size;           ///< current result file size
+  int date;             ///< local date(year * 1000 + yday) the file was opened
+
+  struct evbuffer* buf; ///< pending results
+
+  size_t flush_size;
+  size_t rotate_size;
+  bool rotate_daily;
+  int retention;
+
+  struct event* ev_flush;
+  struct event* ev_hup;
+} ob_result_sink;
+
+static ob_result_sink g_ob_result = {
+    .fd = -1,
+};
+
+static void cb_result_flush(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg);
+static void cb_result_signal_hup(__attribute__((unused)) evutil_socket_t sig, __attribute__((unused)) short events, __attribute__((unused)) void *arg);
+
+static int get_current_date(void);
+
+static bool open_result_file(void);
+static void close_result_file(void);
+static bool rotate_result_file(void);
+static bool check_rotate_result_file(size_t len);
+static bool write_pending_results(void);
+static void drop_pending_results(void);
+
+
+/**
+ * Initiate outbound result sink.
+ * @return
+ */
+bool ob_result_init_handler(void)
+{
+  int ret;
+  long long flush_interval;
+  struct timeval tm_flush;
+
+  if(g_app->evt_base == NULL) {
+    slog(LOG_ERR, "Could not initiate result handler. No event base.");
+    return false;
+  }
+
+  // release old one
+  ob_result_term_handler();
+
+  g_ob_result.flush_size = config_get_value_number("ob", "dialing_result_flush_size", 0);
+  g_ob_result.rotate_size = config_get_value_number("ob", "dialing_result_rotate_size", 0);
+  g_ob_result.rotate_daily = config_get_value_number("ob", "dialing_result_rotate_daily", 0) == 1? true : false;
+  g_ob_result.retention = config_get_value_number("ob", "dialing_result_retention", 0);
+  flush_interval = config_get_value_number("ob", "dialing_result_flush_interval", 1);
+  slog(LOG_NOTICE, "Outbound result sink info. flush_size[%zu], flush_interval[%lld], rotate_size[%zu], rotate_daily[%d], retention[%d]",
+      g_ob_result.flush_size,
+      flush_interval,
+      g_ob_result.rotate_size,
+      g_ob_result.rotate_daily,
+      g_ob_result.retention
+      );
+
+  g_ob_result.buf = evbuffer_new();
+  if(g_ob_result.buf == NULL) {
+    slog(LOG_ERR, "Could not create result buffer.");
+    return false;
+  }
+
+  ret = open_result_file();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not open result file.");
+    return false;
+  }
+
+  // flush timer
+  tm_flush.tv_sec = flush_interval / DEF_ONE_SEC_IN_MICRO_SEC;
+  tm_flush.tv_usec = flush_interval % DEF_ONE_SEC_IN_MICRO_SEC;
+  g_ob_result.ev_flush = event_new(g_app->evt_base, -1, EV_TIMEOUT | EV_PERSIST, cb_result_flush, NULL);
+  event_add(g_ob_result.ev_flush, &tm_flush);
+
+  // reopen the file for external log rotation
+  g_ob_result.ev_hup = evsignal_new(g_app->evt_base, SIGHUP, cb_result_signal_hup, NULL);
+  event_add(g_ob_result.ev_hup, NULL);
+
+  return true;
+}
+
+/**
+ * Terminate outbound result sink.
+ * Flushes all of pending results before closing.
+ */
+void ob_result_term_handler(void)
+{
+  if(g_ob_result.ev_flush != NULL) {
+    event_free(g_ob_result.ev_flush);
+    g_ob_result.ev_flush = NULL;
+  }
+
+  if(g_ob_result.ev_hup != NULL) {
+    event_free(g_ob_result.ev_hup);
+    g_ob_result.ev_hup = NULL;
+  }
+
+  ob_result_flush();
+  close_result_file();
+
+  if(g_ob_result.buf != NULL) {
+    evbuffer_free(g_ob_result.buf);
+    g_ob_result.buf = NULL;
+  }
+
+  return;
+}
+
+/**
+ * Add the result to the pending buffer.
+ * The buffer will be written when it reaches flush_size or flush timer fired.
+ * @param j_res
+ * @return
+ */
+bool ob_result_write(const json_t* j_res)
+{
+  char* tmp;
+  int ret;
+
+  if(j_res == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  if(g_ob_result.buf == NULL) {
+    slog(LOG_ERR, "Result sink is not initiated.");
+    return false;
+  }
+
+  tmp = json_dumps(j_res, JSON_ENCODE_ANY);
+  if(tmp == NULL) {
+    slog(LOG_ERR, "Could not get result string.");
+    return false;
+  }
+
+  ret = evbuffer_add_printf(g_ob_result.buf, "%s\n", tmp);
+  sfree(tmp);
+  if(ret < 0) {
+    slog(LOG_ERR, "Could not add result to the buffer.");
+    return false;
+  }
+
+  if(evbuffer_get_length(g_ob_result.buf) < g_ob_result.flush_size) {
+    return true;
+  }
+
+  ret = ob_result_flush();
+  if(ret == false) {
+    // the result is kept in the buffer. will try again later.
+    slog(LOG_WARNING, "Could not flush results. Retry later.");
+  }
+
+  return true;
+}
+
+/**
+ * Write all pending results to the file.
+ * @return
+ */
+bool ob_result_flush(void)
+{
+  size_t len;
+  int ret;
+
+  if(g_ob_result.buf == NULL) {
+    return true;
+  }
+
+  len = evbuffer_get_length(g_ob_result.buf);
+  if(len == 0) {
+    return true;
+  }
+
+  ret = check_rotate_result_file(len);
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not rotate result file.");
+  }
+
+  ret = write_pending_results();
+  if(ret == false) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Flush pending results and reopen the result file.
+ * Used after the file was moved by external log rotation.
+ * @return
+ */
+bool ob_result_reopen(void)
+{
+  int ret;
+
+  slog(LOG_NOTICE, "Reopen result file. filename[%s]", g_ob_result.filename? : "");
+
+  // write pending results to the old file.
+  write_pending_results();
+  close_result_file();
+
+  ret = open_result_file();
+  if(ret == false) {
+    slog(LOG_ERR, "Could not reopen result file.");
+    return false;
+  }
+
+  return true;
+}
+
+static void cb_result_flush(__attribute__((unused)) int fd, __attribute__((unused)) short event, __attribute__((unused)) void *arg)
+{
+  ob_result_flush();
+}
+
+static void cb_result_signal_hup(__attribute__((unused)) evutil_socket_t sig, __attribute__((unused)) short events, __attribute__((unused)) void *arg)
+{
+  slog(LOG_INFO, "Fired cb_result_signal_hup.");
+  ob_result_reopen();
+}
+
+static int get_current_date(void)
+{
+  time_t now;
+  struct tm tm;
+
+  now = time(NULL);
+  localtime_r(&now, &tm);
+
+  return (tm.tm_year * 1000) + tm.tm_yday;
+}
+
+static bool open_result_file(void)
+{
+  const char* filename;
+  struct stat st;
+  int ret;
+
+  if(g_ob_result.fd >= 0) {
+    return true;
+  }
+
+  filename = config_get_value("ob", "dialing_result_filename");
+  if(filename == NULL) {
+    slog(LOG_ERR, "Could not get option value. option[%s]", "dialing_result_filename");
+    return false;
+  }
+
+  g_ob_result.fd = open(filename, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if(g_ob_result.fd < 0) {
+    slog(LOG_ERR, "Could not open result file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+    return false;
+  }
+
+  sfree(g_ob_result.filename);
+  g_ob_result.filename = strdup(filename);
+
+  g_ob_result.size = 0;
+  ret = fstat(g_ob_result.fd, &st);
+  if(ret == 0) {
+    g_ob_result.size = st.st_size;
+  }
+  g_ob_result.date = get_current_date();
+
+  slog(LOG_DEBUG, "Opened result file. filename[%s], size[%lld]", g_ob_result.filename, (long long)g_ob_result.size);
+
+  return true;
+}
+
+static void close_result_file(void)
+{
+  if(g_ob_result.fd >= 0) {
+    close(g_ob_result.fd);
+    g_ob_result.fd = -1;
+  }
+  sfree(g_ob_result.filename);
+
+  return;
+}
+
+/**
+ * Rotate result file.
+ * filename -> filename.1 -> filename.2 ... -> filename.<retention>
+ * @return
+ */
+static bool rotate_result_file(void)
+{
+  char* filename;
+  char* old_name;
+  char* new_name;
+  int idx;
+  int ret;
+
+  if(g_ob_result.filename == NULL) {
+    return false;
+  }
+  filename = strdup(g_ob_result.filename);
+  slog(LOG_NOTICE, "Rotate result file. filename[%s], size[%lld], retention[%d]",
+      filename, (long long)g_ob_result.size, g_ob_result.retention
+      );
+
+  close_result_file();
+
+  if(g_ob_result.retention == 0) {
+    unlink(filename);
+  }
+  else {
+    for(idx = g_ob_result.retention - 1; idx > 0; idx--) {
+      asprintf(&old_name, "%s.%d", filename, idx);
+      asprintf(&new_name, "%s.%d", filename, idx + 1);
+      rename(old_name, new_name);
+      sfree(old_name);
+      sfree(new_name);
+    }
+
+    asprintf(&new_name, "%s.1", filename);
+    ret = rename(filename, new_name);
+    if(ret != 0) {
+      slog(LOG_ERR, "Could not rotate result file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+    }
+    sfree(new_name);
+  }
+  sfree(filename);
+
+  return open_result_file();
+}
+
+/**
+ * Rotate the result file if the size or date condition has been met.
+ * @param len   pending write size
+ * @return
+ */
+static bool check_rotate_result_file(size_t len)
+{
+  if(g_ob_result.fd < 0) {
+    return open_result_file();
+  }
+
+  if(g_ob_result.size == 0) {
+    // nothing to rotate.
+    g_ob_result.date = get_current_date();
+    return true;
+  }
+
+  if((g_ob_result.rotate_daily == true) && (g_ob_result.date != get_current_date())) {
+    return rotate_result_file();
+  }
+
+  if((g_ob_result.rotate_size > 0) && ((size_t)g_ob_result.size + len > g_ob_result.rotate_size)) {
+    return rotate_result_file();
+  }
+
+  return true;
+}
+
+static bool write_pending_results(void)
+{
+  int ret;
+
+  if(g_ob_result.buf == NULL) {
+    return true;
+  }
+
+  if(g_ob_result.fd < 0) {
+    ret = open_result_file();
+    if(ret == false) {
+      drop_pending_results();
+      return false;
+    }
+  }
+
+  while(evbuffer_get_length(g_ob_result.buf) > 0) {
+    ret = evbuffer_write(g_ob_result.buf, g_ob_result.fd);
+    if(ret < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      slog(LOG_ERR, "Could not write results. filename[%s], err[%d:%s]",
+          g_ob_result.filename, errno, strerror(errno)
+          );
+      drop_pending_results();
+      return false;
+    }
+    g_ob_result.size += ret;
+  }
+
+  return true;
+}
+
+/**
+ * Drop the pending results if the file is not writable for too long.
+ * Keeps the pending buffer from growing forever.
+ */
+static void drop_pending_results(void)
+{
+  size_t len;
+  size_t max_pending;
+
+  len = evbuffer_get_length(g_ob_result.buf);
+  max_pending = g_ob_result.flush_size * DEF_OB_RESULT_MAX_PENDING_MULTIPLIER;
+  if(len <= max_pending) {
+    return;
+  }
+
+  slog(LOG_ERR, "Drop pending results. size[%zu]", len);
+  evbuffer_drain(g_ob_result.buf, len);
+
+  return;
+}
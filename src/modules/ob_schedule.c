@@ -0,0 +1,524 @@
+/*
+ * ob_schedule.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "ob_schedule.h"
+
+#define DEF_SCHEDULE_TIMEZONE       "UTC0"
+#define DEF_SCHEDULE_SEARCH_DAYS    400   // max search range for the next transition
+#define DEF_SCHEDULE_MAX_CANDIDATES 16    // max transition candidates in a day
+#define DEF_SCHEDULE_MAX_ZONES      16    // max cached time zone offset periods
+#define DEF_SCHEDULE_ONE_DAY        86400
+#define DEF_SCHEDULE_MAX_OFFSET     (14 * 3600)   // max distance of the local time from UTC
+
+/**
+ * Cached offset period of the time zone.
+ * The offset is valid in [from, until).
+ */
+struct schedule_zone {
+  char* name;
+  time_t from;
+  time_t until;
+  long offset;    ///< seconds east of UTC
+};
+
+static struct schedule_zone g_zones[DEF_SCHEDULE_MAX_ZONES];
+static int g_zone_next = 0;   ///< next replacing cache slot
+
+static char* push_timezone(const char* timezone);
+static void pop_timezone(char* old);
+
+static const struct schedule_zone* get_zone(const char* timezone, time_t t);
+static const struct schedule_zone* load_zone(const char* timezone, time_t t);
+static time_t find_offset_change(time_t lo, time_t hi, long offset);
+static void get_local_tm(const char* timezone, time_t t, struct tm* tm);
+
+static bool is_open_local(const ob_schedule* sc, time_t t);
+static bool is_open_check(const ob_schedule* sc, const char* cur_date, const char* cur_time, int cur_day);
+static bool is_open_day(const ob_schedule* sc, int day);
+
+static int get_day_candidates(const ob_schedule* sc, int year, int mon, int mday, time_t* candidates, int max);
+static int add_wall_candidates(const char* timezone, int year, int mon, int mday, int hour, int min, int sec, time_t* candidates, int cnt, int max);
+static int add_offset_candidate(const char* timezone, int year, int mon, int mday, time_t* candidates, int cnt, int max);
+static bool parse_time(const char* str, int* hour, int* min, int* sec);
+static int compare_time(const void* a, const void* b);
+
+
+/**
+ * Returns true if the schedule is open at the given time.
+ * @param sc
+ * @param t
+ * @return
+ */
+bool ob_schedule_is_open(const ob_schedule* sc, time_t t)
+{
+  if(sc == NULL) {
+    return false;
+  }
+
+  return is_open_local(sc, t);
+}
+
+/**
+ * Returns the next instant after t when the schedule opens or closes.
+ * The schedule can change only at the local midnight, start time,
+ * the second after end time and the time zone offset changes(DST),
+ * so only those instants are evaluated.
+ * @param sc
+ * @param t
+ * @return Transition time. -1 if there's no transition in the search range.
+ */
+time_t ob_schedule_get_next_transition(const ob_schedule* sc, time_t t)
+{
+  time_t candidates[DEF_SCHEDULE_MAX_CANDIDATES];
+  struct tm tm_now;
+  bool state;
+  time_t res;
+  int cnt;
+  int day;
+  int i;
+
+  if(sc == NULL) {
+    return -1;
+  }
+
+  state = is_open_local(sc, t);
+  get_local_tm(sc->timezone, t, &tm_now);
+
+  res = -1;
+  for(day = 0; (day < DEF_SCHEDULE_SEARCH_DAYS) && (res == -1); day++) {
+    cnt = get_day_candidates(sc, tm_now.tm_year, tm_now.tm_mon, tm_now.tm_mday + day, candidates, DEF_SCHEDULE_MAX_CANDIDATES);
+    qsort(candidates, cnt, sizeof(time_t), compare_time);
+
+    for(i = 0; i < cnt; i++) {
+      if(candidates[i] <= t) {
+        continue;
+      }
+
+      if(is_open_local(sc, candidates[i]) != state) {
+        res = candidates[i];
+        break;
+      }
+    }
+  }
+
+  return res;
+}
+
+/**
+ * Set process time zone to the given one.
+ * Returns the previous TZ value. Should be restored by pop_timezone().
+ * Used only for loading the offset period of the time zone.
+ */
+static char* push_timezone(const char* timezone)
+{
+  const char* tmp_const;
+  char* old;
+
+  tmp_const = getenv("TZ");
+  old = (tmp_const != NULL)? strdup(tmp_const) : NULL;
+
+  if((timezone == NULL) || (strlen(timezone) == 0)) {
+    timezone = DEF_SCHEDULE_TIMEZONE;
+  }
+  setenv("TZ", timezone, 1);
+  tzset();
+
+  return old;
+}
+
+static void pop_timezone(char* old)
+{
+  if(old == NULL) {
+    unsetenv("TZ");
+  }
+  else {
+    setenv("TZ", old, 1);
+    free(old);
+  }
+  tzset();
+}
+
+/**
+ * Returns the cached offset period of the time zone at the given time.
+ * Loads the period if it's not cached.
+ */
+static const struct schedule_zone* get_zone(const char* timezone, time_t t)
+{
+  int i;
+
+  if((timezone == NULL) || (strlen(timezone) == 0)) {
+    timezone = DEF_SCHEDULE_TIMEZONE;
+  }
+
+  for(i = 0; i < DEF_SCHEDULE_MAX_ZONES; i++) {
+    if((g_zones[i].name == NULL) || (t < g_zones[i].from) || (t >= g_zones[i].until)) {
+      continue;
+    }
+
+    if(strcmp(g_zones[i].name, timezone) == 0) {
+      return &g_zones[i];
+    }
+  }
+
+  return load_zone(timezone, t);
+}
+
+/**
+ * Load the offset period of the time zone around the given time.
+ * The period is searched day by day in the search range, so the process
+ * time zone is changed only once for each period.
+ */
+static const struct schedule_zone* load_zone(const char* timezone, time_t t)
+{
+  struct schedule_zone* zone;
+  struct tm tm;
+  char* old;
+  time_t from;
+  time_t until;
+  time_t probe;
+  long offset;
+  int day;
+
+  old = push_timezone(timezone);
+
+  localtime_r(&t, &tm);
+  offset = tm.tm_gmtoff;
+
+  // search the previous offset change
+  from = t - ((time_t)DEF_SCHEDULE_SEARCH_DAYS * DEF_SCHEDULE_ONE_DAY);
+  for(day = 1; day <= DEF_SCHEDULE_SEARCH_DAYS; day++) {
+    probe = t - ((time_t)day * DEF_SCHEDULE_ONE_DAY);
+    localtime_r(&probe, &tm);
+    if(tm.tm_gmtoff != offset) {
+      from = find_offset_change(probe, probe + DEF_SCHEDULE_ONE_DAY, tm.tm_gmtoff);
+      break;
+    }
+  }
+
+  // search the next offset change
+  until = t + ((time_t)DEF_SCHEDULE_SEARCH_DAYS * DEF_SCHEDULE_ONE_DAY);
+  for(day = 1; day <= DEF_SCHEDULE_SEARCH_DAYS; day++) {
+    probe = t + ((time_t)day * DEF_SCHEDULE_ONE_DAY);
+    localtime_r(&probe, &tm);
+    if(tm.tm_gmtoff != offset) {
+      until = find_offset_change(probe - DEF_SCHEDULE_ONE_DAY, probe, offset);
+      break;
+    }
+  }
+
+  pop_timezone(old);
+
+  zone = &g_zones[g_zone_next];
+  g_zone_next = (g_zone_next + 1) % DEF_SCHEDULE_MAX_ZONES;
+
+  free(zone->name);
+  zone->name = strdup(timezone);
+  zone->from = from;
+  zone->until = until;
+  zone->offset = offset;
+
+  return zone;
+}
+
+/**
+ * Returns the first instant in (lo, hi] which doesn't have the given offset.
+ * The lo should have the given offset and the hi should not.
+ * Should be called in the pushed time zone.
+ */
+static time_t find_offset_change(time_t lo, time_t hi, long offset)
+{
+  struct tm tm;
+  time_t mid;
+
+  while(hi - lo > 1) {
+    mid = lo + ((hi - lo) / 2);
+    localtime_r(&mid, &tm);
+    if(tm.tm_gmtoff == offset) {
+      lo = mid;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return hi;
+}
+
+/**
+ * Get the local time of the time zone.
+ * Same as localtime_r() in the time zone, without changing the process time zone.
+ */
+static void get_local_tm(const char* timezone, time_t t, struct tm* tm)
+{
+  const struct schedule_zone* zone;
+  time_t local;
+
+  zone = get_zone(timezone, t);
+  local = t + zone->offset;
+  gmtime_r(&local, tm);
+  tm->tm_gmtoff = zone->offset;
+}
+
+static bool is_open_local(const ob_schedule* sc, time_t t)
+{
+  struct tm tm;
+  char cur_date[16];
+  char cur_time[16];
+
+  get_local_tm(sc->timezone, t, &tm);
+  strftime(cur_date, sizeof(cur_date), "%Y-%m-%d", &tm);
+  strftime(cur_time, sizeof(cur_time), "%H:%M:%S", &tm);
+
+  return is_open_check(sc, cur_date, cur_time, tm.tm_wday);
+}
+
+static bool is_open_check(const ob_schedule* sc, const char* cur_date, const char* cur_time, int cur_day)
+{
+  int ret;
+
+  // check except date. If there's except date, return false
+  if((sc->date_list_except != NULL) && (strstr(sc->date_list_except, cur_date) != NULL)) {
+    return false;
+  }
+
+  // check date_list. If there's current date, return true
+  if((sc->date_list != NULL) && (strstr(sc->date_list, cur_date) != NULL)) {
+    return true;
+  }
+
+  // check start date.
+  // if start date is in the future, return false
+  if(sc->date_start != NULL) {
+    ret = strcmp(sc->date_start, cur_date);
+    if(ret > 0) {
+      return false;
+    }
+  }
+
+  // check end date.
+  // if end date is in the past, return false
+  if(sc->date_end != NULL) {
+    ret = strcmp(sc->date_end, cur_date);
+    if(ret < 0) {
+      return false;
+    }
+  }
+
+  // check day
+  ret = is_open_day(sc, cur_day);
+  if(ret == false) {
+    return false;
+  }
+
+  // check end time
+  // if end time is in the past, return false
+  if(sc->time_end != NULL) {
+    ret = strcmp(sc->time_end, cur_time);
+    if(ret < 0) {
+      return false;
+    }
+  }
+
+  // check start time
+  // if start time is in the future, return false
+  if(sc->time_start != NULL) {
+    ret = strcmp(sc->time_start, cur_time);
+    if(ret > 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool is_open_day(const ob_schedule* sc, int day)
+{
+  char day_str[2];
+
+  // 0=Sunday, 1=Monday, ..., 6=Saturday
+  if((day < 0) || (day > 6)) {
+    return false;
+  }
+
+  // if it doesn't set, just return true.
+  if((sc->day_list == NULL) || (strlen(sc->day_list) == 0)) {
+    return true;
+  }
+
+  snprintf(day_str, sizeof(day_str), "%d", day);
+  if(strstr(sc->day_list, day_str) == NULL) {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Get transition candidates of the given local day.
+ */
+static int get_day_candidates(const ob_schedule* sc, int year, int mon, int mday, time_t* candidates, int max)
+{
+  int cnt;
+  int hour;
+  int min;
+  int sec;
+
+  cnt = 0;
+
+  // midnight
+  cnt = add_wall_candidates(sc->timezone, year, mon, mday, 0, 0, 0, candidates, cnt, max);
+
+  // start time
+  if(parse_time(sc->time_start, &hour, &min, &sec) == true) {
+    cnt = add_wall_candidates(sc->timezone, year, mon, mday, hour, min, sec, candidates, cnt, max);
+  }
+
+  // the second after end time
+  if(parse_time(sc->time_end, &hour, &min, &sec) == true) {
+    cnt = add_wall_candidates(sc->timezone, year, mon, mday, hour, min, sec + 1, candidates, cnt, max);
+  }
+
+  // time zone offset change
+  cnt = add_offset_candidate(sc->timezone, year, mon, mday, candidates, cnt, max);
+
+  return cnt;
+}
+
+/**
+ * Add the instants of the given local wall time.
+ * The wall time could be repeated(or skipped) on DST change,
+ * so adds all of the instants which have the wall time.
+ * The skipped wall time is covered by the offset change candidate.
+ */
+static int add_wall_candidates(const char* timezone, int year, int mon, int mday, int hour, int min, int sec, time_t* candidates, int cnt, int max)
+{
+  struct tm tm;
+  time_t wall;
+  time_t t;
+  long offsets[2];
+  int i;
+
+  memset(&tm, 0x00, sizeof(tm));
+  tm.tm_year = year;
+  tm.tm_mon = mon;
+  tm.tm_mday = mday;
+  tm.tm_hour = hour;
+  tm.tm_min = min;
+  tm.tm_sec = sec;
+
+  // the wall time as if it's UTC
+  wall = timegm(&tm);
+  if(wall == -1) {
+    return cnt;
+  }
+
+  // the offsets which could be used at the wall time
+  offsets[0] = get_zone(timezone, wall - DEF_SCHEDULE_MAX_OFFSET)->offset;
+  offsets[1] = get_zone(timezone, wall + DEF_SCHEDULE_MAX_OFFSET)->offset;
+
+  for(i = 0; i < 2; i++) {
+    if(cnt >= max) {
+      break;
+    }
+
+    if((i == 1) && (offsets[1] == offsets[0])) {
+      break;
+    }
+
+    t = wall - offsets[i];
+    if(get_zone(timezone, t)->offset != offsets[i]) {
+      continue;
+    }
+    candidates[cnt] = t;
+    cnt++;
+  }
+
+  return cnt;
+}
+
+/**
+ * Add the instant of time zone offset change in the given local day.
+ */
+static int add_offset_candidate(const char* timezone, int year, int mon, int mday, time_t* candidates, int cnt, int max)
+{
+  const struct schedule_zone* zone;
+  struct tm tm;
+  time_t lo;
+  time_t hi;
+
+  if(cnt >= max) {
+    return cnt;
+  }
+
+  memset(&tm, 0x00, sizeof(tm));
+  tm.tm_year = year;
+  tm.tm_mon = mon;
+  tm.tm_mday = mday;
+  lo = timegm(&tm);
+  if(lo == -1) {
+    return cnt;
+  }
+
+  // the local day is in [lo - offset, hi - offset) roughly.
+  lo = lo - DEF_SCHEDULE_MAX_OFFSET;
+  hi = lo + DEF_SCHEDULE_ONE_DAY + (2 * DEF_SCHEDULE_MAX_OFFSET);
+
+  zone = get_zone(timezone, lo);
+  if(zone->until >= hi) {
+    return cnt;
+  }
+
+  candidates[cnt] = zone->until;
+  cnt++;
+
+  return cnt;
+}
+
+/**
+ * Parse "HH:MM:SS" or "HH:MM".
+ */
+static bool parse_time(const char* str, int* hour, int* min, int* sec)
+{
+  int ret;
+
+  if(str == NULL) {
+    return false;
+  }
+
+  *sec = 0;
+  ret = sscanf(str, "%d:%d:%d", hour, min, sec);
+  if(ret < 2) {
+    return false;
+  }
+
+  return true;
+}
+
+static int compare_time(const void* a, const void* b)
+{
+  time_t t1;
+  time_t t2;
+
+  t1 = *(const time_t*)a;
+  t2 = *(const time_t*)b;
+
+  if(t1 < t2) {
+    return -1;
+  }
+  if(t1 > t2) {
+    return 1;
+  }
+  return 0;
+}
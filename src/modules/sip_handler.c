@@ -26,6 +26,18 @@
 #define DEF_DB_TABLE_SIP_PEERACCOUNT    "sip_peeraccount"
 #define DEF_DB_TABLE_SIP_REGISTRY       "sip_registry"
 
+/**
+ * Reload snapshot.
+ * The reload keeps the current data, and deletes the objects
+ * which are not received until the list is complete.
+ */
+struct sip_reload {
+  json_t* j_peers;        ///< received peers. {"<peer>": true}. NULL if not in the reload.
+  json_t* j_registries;   ///< received registry accounts. {"<account>": true}. NULL if not in the reload.
+};
+
+static struct sip_reload g_reload = {0};
+
 
 static bool init_sip_database(void);
 static bool init_sip_database_peer(void);
@@ -39,6 +51,13 @@ static bool init_sip_info_peeraccount(void);
 
 static bool term_sip_database(void);
 
+static void begin_reload(void);
+static void clear_reload(void);
+static int sweep_items(json_t* j_seens, json_t* j_items, const char* key, bool (*func_delete)(const char* key));
+
+static bool update_peeraccount_info(const json_t* j_data);
+static bool delete_peeraccount_info(const char* key);
+
 
 bool sip_init_handler(void)
 {
@@ -67,6 +86,8 @@ bool sip_term_handler(void)
 {
   int ret;
 
+  clear_reload();
+
   ret = term_sip_database();
   if(ret == false) {
     slog(LOG_ERR, "Could not clear sip.");
@@ -80,13 +101,12 @@ bool sip_reload_handler(void)
 {
   int ret;
 
-  ret = sip_term_handler();
-  if(ret == false) {
-    return false;
-  }
+  // keeps the current data until the new snapshot is complete
+  begin_reload();
 
-  ret = sip_init_handler();
+  ret = init_sip_info();
   if(ret == false) {
+    slog(LOG_ERR, "Could not initiate sip info.");
     return false;
   }
 
@@ -310,28 +330,14 @@ void sip_htp_get_sip_peers_detail(evhtp_request_t *req, void *data)
  */
 void sip_htp_get_sip_peers(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_INFO, "Fired htp_get_sip_peers.");
 
-  j_tmp = sip_get_peers_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  // response
+  http_simple_response_page(req, sip_get_peers_page, "peer");
 
   return;
 }
@@ -387,28 +393,14 @@ void sip_htp_get_sip_registries_detail(evhtp_request_t *req, void *data)
  */
 void sip_htp_get_sip_registries(evhtp_request_t *req, void *data)
 {
-  json_t* j_res;
-  json_t* j_tmp;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_INFO, "Fired htp_get_sip_registries.");
 
-  j_tmp = sip_get_registries_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  // response
+  http_simple_response_page(req, sip_get_registries_page, "account");
 
   return;
 }
@@ -933,6 +925,7 @@ static bool init_sip_info_peer(void)
 
 /**
  * Init sip peeraccount info.
+ * Syncs the peeraccount info with the sip config.
  * @return
  */
 static bool init_sip_info_peeraccount(void)
@@ -941,6 +934,9 @@ static bool init_sip_info_peeraccount(void)
   json_t* j_conf;
   json_t* j_tmp;
   json_t* j_info;
+  json_t* j_old;
+  json_t* j_seens;
+  json_t* j_items;
   char* timestamp;
   const char* key;
 
@@ -950,6 +946,7 @@ static bool init_sip_info_peeraccount(void)
     return false;
   }
 
+  j_seens = json_object();
   timestamp = utils_get_utc_timestamp();
   json_object_foreach(j_conf, key, j_tmp) {
     if(key == NULL) {
@@ -977,19 +974,35 @@ static bool init_sip_info_peeraccount(void)
 
         "tm_update", timestamp
         );
+    json_object_set_new(j_seens, key, json_true());
 
-    ret = sip_create_peeraccount_info(j_info);
+    // create or update
+    j_old = sip_get_peeraccount_info(key);
+    if(j_old == NULL) {
+      ret = sip_create_peeraccount_info(j_info);
+    }
+    else {
+      ret = utils_is_item_changed(j_old, j_info)? update_peeraccount_info(j_info) : true;
+      json_decref(j_old);
+    }
     json_decref(j_info);
     if(ret == false) {
       slog(LOG_ERR, "Could not create peeraccount info. peer[%s]", key);
       json_decref(j_conf);
+      json_decref(j_seens);
       sfree(timestamp);
       return false;
     }
   }
-
   json_decref(j_conf);
   sfree(timestamp);
+
+  // delete the peeraccounts not in the config
+  j_items = resource_get_mem_items(DEF_DB_TABLE_SIP_PEERACCOUNT, "peer");
+  sweep_items(j_seens, j_items, "peer", delete_peeraccount_info);
+  json_decref(j_items);
+  json_decref(j_seens);
+
   return true;
 }
 
@@ -1018,6 +1031,44 @@ bool sip_create_peeraccount_info(const json_t* j_data)
   return true;
 }
 
+static bool update_peeraccount_info(const json_t* j_data)
+{
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired update_peeraccount_info.");
+
+  ret = resource_update_mem_item(DEF_DB_TABLE_SIP_PEERACCOUNT, "peer", j_data);
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not update sip peeraccount info.");
+    return false;
+  }
+
+  return true;
+}
+
+static bool delete_peeraccount_info(const char* key)
+{
+  int ret;
+
+  if(key == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+  slog(LOG_DEBUG, "Fired delete_peeraccount_info. peer[%s]", key);
+
+  ret = resource_delete_mem_items_string(DEF_DB_TABLE_SIP_PEERACCOUNT, "peer", key);
+  if(ret == false) {
+    slog(LOG_WARNING, "Could not delete sip peeraccount info. peer[%s]", key);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * Get given peeraccount's detail info.
  * @param peer
@@ -1087,6 +1138,20 @@ json_t* sip_get_peers_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of peers ordered by peer.
+ * @param cursor: peer of the last peer of the previous page.
+ * @param count
+ * @return
+ */
+json_t* sip_get_peers_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_SIP_PEER, "peer", cursor, count);
+  return j_res;
+}
+
 /**
  * Get all registry account array
  * @return
@@ -1133,6 +1198,20 @@ json_t* sip_get_registries_all(void)
   return j_res;
 }
 
+/**
+ * Returns the page of registries ordered by account.
+ * @param cursor: account of the last registry of the previous page.
+ * @param count
+ * @return
+ */
+json_t* sip_get_registries_page(const char* cursor, int count)
+{
+  json_t* j_res;
+
+  j_res = resource_get_mem_items_page(DEF_DB_TABLE_SIP_REGISTRY, "account", cursor, count);
+  return j_res;
+}
+
 /**
  * Create sip peer info.
  * @param j_data
@@ -1388,6 +1467,188 @@ bool sip_delete_registry_info(const char* key)
   return true;
 }
 
+/**
+ * Create or update the sip peer info with the given data.
+ * Updates and publishes only if the data has been changed.
+ * The peer is marked as seen if the reload is in progress.
+ * @param j_data
+ * @return
+ */
+bool sip_sync_peer_info(const json_t* j_data)
+{
+  const char* peer;
+  json_t* j_tmp;
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  peer = json_string_value(json_object_get(j_data, "peer"));
+  if(peer == NULL) {
+    slog(LOG_NOTICE, "Could not get peer info.");
+    return false;
+  }
+
+  if(g_reload.j_peers != NULL) {
+    json_object_set_new(g_reload.j_peers, peer, json_true());
+  }
+
+  j_tmp = sip_get_peer_info(peer);
+  if(j_tmp == NULL) {
+    return sip_create_peer_info(j_data);
+  }
+
+  ret = utils_is_item_changed(j_tmp, j_data);
+  json_decref(j_tmp);
+  if(ret == false) {
+    return true;
+  }
+  slog(LOG_DEBUG, "The sip peer info has been changed. peer[%s]", peer);
+
+  return sip_update_peer_info(j_data);
+}
+
+/**
+ * Create or update the sip registry info with the given data.
+ * Updates and publishes only if the data has been changed.
+ * The account is marked as seen if the reload is in progress.
+ * @param j_data
+ * @return
+ */
+bool sip_sync_registry_info(const json_t* j_data)
+{
+  const char* account;
+  json_t* j_tmp;
+  int ret;
+
+  if(j_data == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return false;
+  }
+
+  account = json_string_value(json_object_get(j_data, "account"));
+  if(account == NULL) {
+    slog(LOG_NOTICE, "Could not get account info.");
+    return false;
+  }
+
+  if(g_reload.j_registries != NULL) {
+    json_object_set_new(g_reload.j_registries, account, json_true());
+  }
+
+  j_tmp = sip_get_registry_info(account);
+  if(j_tmp == NULL) {
+    return sip_create_registry_info(j_data);
+  }
+
+  ret = utils_is_item_changed(j_tmp, j_data);
+  json_decref(j_tmp);
+  if(ret == false) {
+    return true;
+  }
+  slog(LOG_DEBUG, "The sip registry info has been changed. account[%s]", account);
+
+  return sip_update_registry_info(j_data);
+}
+
+/**
+ * Event: PeerlistComplete
+ * Deletes the peers which were not received in the reload.
+ */
+void sip_complete_peer_list(void)
+{
+  json_t* j_items;
+  int count;
+
+  if(g_reload.j_peers == NULL) {
+    return;
+  }
+
+  j_items = sip_get_peers_all_peer();
+  count = sweep_items(g_reload.j_peers, j_items, "peer", sip_delete_peer_info);
+  json_decref(j_items);
+  slog(LOG_INFO, "Swept the sip peer info. seen[%d], deleted[%d]", (int)json_object_size(g_reload.j_peers), count);
+
+  json_decref(g_reload.j_peers);
+  g_reload.j_peers = NULL;
+}
+
+/**
+ * Event: RegistrationsComplete
+ * Deletes the registries which were not received in the reload.
+ */
+void sip_complete_registry_list(void)
+{
+  json_t* j_items;
+  int count;
+
+  if(g_reload.j_registries == NULL) {
+    return;
+  }
+
+  j_items = sip_get_registries_all_account();
+  count = sweep_items(g_reload.j_registries, j_items, "account", sip_delete_registry_info);
+  json_decref(j_items);
+  slog(LOG_INFO, "Swept the sip registry info. seen[%d], deleted[%d]", (int)json_object_size(g_reload.j_registries), count);
+
+  json_decref(g_reload.j_registries);
+  g_reload.j_registries = NULL;
+}
+
+/**
+ * Start the reload snapshot.
+ */
+static void begin_reload(void)
+{
+  clear_reload();
+
+  g_reload.j_peers = json_object();
+  g_reload.j_registries = json_object();
+}
+
+static void clear_reload(void)
+{
+  json_decref(g_reload.j_peers);
+  json_decref(g_reload.j_registries);
+  memset(&g_reload, 0x00, sizeof(g_reload));
+}
+
+/**
+ * Delete the items which are not in the seens.
+ * @param j_seens
+ * @param j_items
+ * @param key
+ * @param func_delete
+ * @return deleted count
+ */
+static int sweep_items(json_t* j_seens, json_t* j_items, const char* key, bool (*func_delete)(const char* key))
+{
+  json_t* j_item;
+  const char* val;
+  int count;
+  int idx;
+
+  if((j_seens == NULL) || (key == NULL) || (func_delete == NULL)) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return 0;
+  }
+
+  count = 0;
+  json_array_foreach(j_items, idx, j_item) {
+    val = json_string_value(json_object_get(j_item, key));
+    if((val == NULL) || (json_object_get(j_seens, val) != NULL)) {
+      continue;
+    }
+
+    func_delete(val);
+    count++;
+  }
+
+  return count;
+}
+
 /**
  * Clear all sip resources.
  * @return
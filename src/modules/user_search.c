@@ -0,0 +1,763 @@
+/*
+ * user_search.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "user_search.h"
+
+#define DEF_SEARCH_SEPARATOR      '\n'  // field separator of the entry text
+#define DEF_SEARCH_MAX_GRAM       3
+#define DEF_SEARCH_MAX_QUERY      255
+#define DEF_SEARCH_INIT_TABLE     1024  // must be power of 2
+#define DEF_SEARCH_PREFIX_KEY     0x80000000u // gram key flag for the field start
+
+typedef struct _search_list {
+  uint32_t* items;
+  int count;
+  int size;
+} search_list;
+
+typedef struct _search_entry {
+  char* uuid;     ///< NULL if the slot is free
+  char* text;     ///< lower cased fields joined by the DEF_SEARCH_SEPARATOR
+} search_entry;
+
+typedef struct _search_gram {
+  uint32_t key;       ///< 0 if empty
+  search_list list;   ///< entry slots
+} search_gram;
+
+struct _user_search {
+  search_entry* entries;
+  int entry_count;    ///< used slots. includes free slots.
+  int entry_size;
+  search_list frees;  ///< free slots
+  int count;          ///< live entries
+
+  uint32_t* uuids;    ///< uuid hash table. slot + 1. 0 if empty.
+  int uuid_size;
+
+  search_gram* grams; ///< gram hash table
+  int gram_size;
+  int gram_count;
+};
+
+static bool list_append(search_list* list, uint32_t item);
+static void list_remove(search_list* list, uint32_t item);
+
+static uint32_t hash_string(const char* str);
+static uint32_t hash_gram(uint32_t key);
+static uint32_t create_gram_key(const char* str, int len);
+static int get_gram_len(const char* str);
+
+static int find_uuid(const user_search* idx, const char* uuid);
+static bool insert_uuid(user_search* idx, uint32_t slot);
+static void delete_uuid(user_search* idx, uint32_t slot);
+
+static search_gram* find_gram(const user_search* idx, uint32_t key);
+static search_gram* get_gram(user_search* idx, uint32_t key);
+static bool grow_grams(user_search* idx);
+
+static bool add_grams(user_search* idx, uint32_t slot);
+static void remove_grams(user_search* idx, uint32_t slot);
+static void remove_entry(user_search* idx, uint32_t slot);
+
+static char* create_entry_text(const char* const* fields, int count);
+static bool is_prefix_match(const char* text, const char* query, int len);
+
+
+/**
+ * Create the search index.
+ * @return
+ */
+user_search* user_search_create(void)
+{
+  user_search* idx;
+
+  idx = calloc(1, sizeof(user_search));
+  if(idx == NULL) {
+    return NULL;
+  }
+
+  idx->uuid_size = DEF_SEARCH_INIT_TABLE;
+  idx->uuids = calloc(idx->uuid_size, sizeof(uint32_t));
+
+  idx->gram_size = DEF_SEARCH_INIT_TABLE;
+  idx->grams = calloc(idx->gram_size, sizeof(search_gram));
+
+  if((idx->uuids == NULL) || (idx->grams == NULL)) {
+    user_search_destroy(idx);
+    return NULL;
+  }
+
+  return idx;
+}
+
+void user_search_destroy(user_search* idx)
+{
+  int i;
+
+  if(idx == NULL) {
+    return;
+  }
+
+  user_search_clear(idx);
+
+  for(i = 0; i < idx->gram_size; i++) {
+    free(idx->grams[i].list.items);
+  }
+  free(idx->grams);
+  free(idx->uuids);
+  free(idx->entries);
+  free(idx->frees.items);
+  free(idx);
+}
+
+/**
+ * Remove all of the entries.
+ * Keeps the allocated tables for the next use.
+ * @param idx
+ */
+void user_search_clear(user_search* idx)
+{
+  int i;
+
+  if(idx == NULL) {
+    return;
+  }
+
+  for(i = 0; i < idx->entry_count; i++) {
+    free(idx->entries[i].uuid);
+    free(idx->entries[i].text);
+  }
+  idx->entry_count = 0;
+  idx->frees.count = 0;
+  idx->count = 0;
+
+  memset(idx->uuids, 0x00, idx->uuid_size * sizeof(uint32_t));
+  for(i = 0; i < idx->gram_size; i++) {
+    idx->grams[i].list.count = 0;
+  }
+}
+
+/**
+ * Add or replace the entry of the given uuid.
+ * @param idx
+ * @param uuid
+ * @param fields: searchable fields. NULL field is skipped.
+ * @param count: count of fields.
+ * @return
+ */
+bool user_search_set(user_search* idx, const char* uuid, const char* const* fields, int count)
+{
+  search_entry* entry;
+  search_entry* tmp;
+  uint32_t slot;
+  int pos;
+  int size;
+
+  if((idx == NULL) || (uuid == NULL) || ((fields == NULL) && (count > 0))) {
+    return false;
+  }
+
+  pos = find_uuid(idx, uuid);
+  if(pos >= 0) {
+    // replace the text only
+    slot = idx->uuids[pos] - 1;
+    entry = &idx->entries[slot];
+    remove_grams(idx, slot);
+    free(entry->text);
+
+    entry->text = create_entry_text(fields, count);
+    if(entry->text == NULL) {
+      remove_entry(idx, slot);
+      return false;
+    }
+    return add_grams(idx, slot);
+  }
+
+  // get slot
+  if(idx->frees.count > 0) {
+    idx->frees.count--;
+    slot = idx->frees.items[idx->frees.count];
+  }
+  else {
+    if(idx->entry_count == idx->entry_size) {
+      size = (idx->entry_size == 0)? DEF_SEARCH_INIT_TABLE : idx->entry_size * 2;
+      tmp = realloc(idx->entries, size * sizeof(search_entry));
+      if(tmp == NULL) {
+        return false;
+      }
+      idx->entries = tmp;
+      idx->entry_size = size;
+    }
+    slot = idx->entry_count;
+    idx->entry_count++;
+  }
+
+  entry = &idx->entries[slot];
+  entry->uuid = strdup(uuid);
+  entry->text = create_entry_text(fields, count);
+  if((entry->uuid == NULL) || (entry->text == NULL)) {
+    free(entry->uuid);
+    free(entry->text);
+    entry->uuid = NULL;
+    entry->text = NULL;
+    list_append(&idx->frees, slot);
+    return false;
+  }
+  idx->count++;
+
+  if(insert_uuid(idx, slot) == false) {
+    remove_entry(idx, slot);
+    return false;
+  }
+
+  return add_grams(idx, slot);
+}
+
+/**
+ * Remove the entry of the given uuid.
+ * @param idx
+ * @param uuid
+ * @return false if there's no entry.
+ */
+bool user_search_remove(user_search* idx, const char* uuid)
+{
+  int pos;
+
+  if((idx == NULL) || (uuid == NULL)) {
+    return false;
+  }
+
+  pos = find_uuid(idx, uuid);
+  if(pos < 0) {
+    return false;
+  }
+
+  remove_entry(idx, idx->uuids[pos] - 1);
+  return true;
+}
+
+/**
+ * Find the entries which have the given query in any of the fields.
+ * The entries which have the field starting with the query come first.
+ * The returned uuids are valid until the next change of the index.
+ * @param idx
+ * @param query
+ * @param res: result uuids.
+ * @param max: max count of result.
+ * @return count of result.
+ */
+int user_search_find(const user_search* idx, const char* query, const char** res, int max)
+{
+  const search_gram* gram;
+  const search_gram* gram_prefix;
+  const search_gram* tmp;
+  const search_entry* entry;
+  char lower[DEF_SEARCH_MAX_QUERY + 1];
+  bool verify;
+  int len;
+  int cnt;
+  int i;
+
+  if((idx == NULL) || (query == NULL) || (res == NULL) || (max <= 0)) {
+    return 0;
+  }
+
+  len = strnlen(query, DEF_SEARCH_MAX_QUERY + 1);
+  if((len == 0) || (len > DEF_SEARCH_MAX_QUERY)) {
+    return 0;
+  }
+  for(i = 0; i < len; i++) {
+    if(query[i] == DEF_SEARCH_SEPARATOR) {
+      return 0;
+    }
+    lower[i] = tolower((unsigned char)query[i]);
+  }
+  lower[len] = '\0';
+
+  // get the candidate lists.
+  // the prefix list has the entries which have the field starting with the first gram of the query.
+  // if the query is short enough, the lists are the exact result.
+  if(len <= DEF_SEARCH_MAX_GRAM) {
+    gram = find_gram(idx, create_gram_key(lower, len));
+    verify = false;
+  }
+  else {
+    gram = NULL;
+    for(i = 0; i + DEF_SEARCH_MAX_GRAM <= len; i++) {
+      tmp = find_gram(idx, create_gram_key(lower + i, DEF_SEARCH_MAX_GRAM));
+      if(tmp == NULL) {
+        return 0;
+      }
+      if((gram == NULL) || (tmp->list.count < gram->list.count)) {
+        gram = tmp;
+      }
+    }
+    verify = true;
+  }
+  if(gram == NULL) {
+    return 0;
+  }
+  gram_prefix = find_gram(idx, create_gram_key(lower, (len < DEF_SEARCH_MAX_GRAM)? len : DEF_SEARCH_MAX_GRAM) | DEF_SEARCH_PREFIX_KEY);
+  if((verify == true) && (gram_prefix != NULL) && (gram_prefix->list.count > gram->list.count)) {
+    // the prefix matches are in the shorter list also.
+    gram_prefix = gram;
+  }
+
+  // prefix matches
+  cnt = 0;
+  for(i = 0; (gram_prefix != NULL) && (i < gram_prefix->list.count) && (cnt < max); i++) {
+    entry = &idx->entries[gram_prefix->list.items[i]];
+    if((verify == true) && (is_prefix_match(entry->text, lower, len) == false)) {
+      continue;
+    }
+
+    res[cnt] = entry->uuid;
+    cnt++;
+  }
+
+  // the others
+  for(i = 0; (i < gram->list.count) && (cnt < max); i++) {
+    entry = &idx->entries[gram->list.items[i]];
+    if(is_prefix_match(entry->text, lower, len) == true) {
+      continue;
+    }
+    if((verify == true) && (strstr(entry->text, lower) == NULL)) {
+      continue;
+    }
+
+    res[cnt] = entry->uuid;
+    cnt++;
+  }
+
+  return cnt;
+}
+
+int user_search_get_count(const user_search* idx)
+{
+  if(idx == NULL) {
+    return 0;
+  }
+
+  return idx->count;
+}
+
+static bool list_append(search_list* list, uint32_t item)
+{
+  uint32_t* tmp;
+  int size;
+
+  if(list->count == list->size) {
+    size = (list->size == 0)? 4 : list->size * 2;
+    tmp = realloc(list->items, size * sizeof(uint32_t));
+    if(tmp == NULL) {
+      return false;
+    }
+    list->items = tmp;
+    list->size = size;
+  }
+
+  list->items[list->count] = item;
+  list->count++;
+
+  return true;
+}
+
+/**
+ * Remove the item from the list.
+ * The order of the list is not kept.
+ */
+static void list_remove(search_list* list, uint32_t item)
+{
+  int i;
+
+  for(i = 0; i < list->count; i++) {
+    if(list->items[i] != item) {
+      continue;
+    }
+
+    list->count--;
+    list->items[i] = list->items[list->count];
+    return;
+  }
+}
+
+/**
+ * FNV-1a
+ */
+static uint32_t hash_string(const char* str)
+{
+  uint32_t hash;
+
+  hash = 2166136261u;
+  for(; *str != '\0'; str++) {
+    hash ^= (unsigned char)*str;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static uint32_t hash_gram(uint32_t key)
+{
+  key ^= key >> 16;
+  key *= 0x45d9f3bu;
+  key ^= key >> 16;
+
+  return key;
+}
+
+/**
+ * Create gram key. len(1 byte) + gram(3 bytes).
+ * Never returns 0.
+ */
+static uint32_t create_gram_key(const char* str, int len)
+{
+  uint32_t key;
+  int i;
+
+  key = (uint32_t)len << 24;
+  for(i = 0; i < len; i++) {
+    key |= (uint32_t)(unsigned char)str[i] << (8 * (DEF_SEARCH_MAX_GRAM - 1 - i));
+  }
+
+  return key;
+}
+
+/**
+ * Returns the position of the given uuid in the uuid table.
+ * -1 if not found.
+ */
+static int find_uuid(const user_search* idx, const char* uuid)
+{
+  uint32_t mask;
+  uint32_t pos;
+  uint32_t slot;
+
+  mask = idx->uuid_size - 1;
+  for(pos = hash_string(uuid) & mask; idx->uuids[pos] != 0; pos = (pos + 1) & mask) {
+    slot = idx->uuids[pos] - 1;
+    if(strcmp(idx->entries[slot].uuid, uuid) == 0) {
+      return pos;
+    }
+  }
+
+  return -1;
+}
+
+static bool insert_uuid(user_search* idx, uint32_t slot)
+{
+  uint32_t* old;
+  uint32_t mask;
+  uint32_t pos;
+  int old_size;
+  int i;
+
+  // keep the load factor under 0.5
+  if(idx->count * 2 > idx->uuid_size) {
+    old = idx->uuids;
+    old_size = idx->uuid_size;
+
+    idx->uuids = calloc(old_size * 2, sizeof(uint32_t));
+    if(idx->uuids == NULL) {
+      idx->uuids = old;
+      return false;
+    }
+    idx->uuid_size = old_size * 2;
+
+    mask = idx->uuid_size - 1;
+    for(i = 0; i < old_size; i++) {
+      if(old[i] == 0) {
+        continue;
+      }
+      for(pos = hash_string(idx->entries[old[i] - 1].uuid) & mask; idx->uuids[pos] != 0; pos = (pos + 1) & mask);
+      idx->uuids[pos] = old[i];
+    }
+    free(old);
+  }
+
+  mask = idx->uuid_size - 1;
+  for(pos = hash_string(idx->entries[slot].uuid) & mask; idx->uuids[pos] != 0; pos = (pos + 1) & mask);
+  idx->uuids[pos] = slot + 1;
+
+  return true;
+}
+
+/**
+ * Delete the slot from the uuid table.
+ * Shifts back the following items, so doesn't need tombstones.
+ */
+static void delete_uuid(user_search* idx, uint32_t slot)
+{
+  uint32_t mask;
+  uint32_t pos;
+  uint32_t next;
+  uint32_t home;
+  int ret;
+
+  ret = find_uuid(idx, idx->entries[slot].uuid);
+  if(ret < 0) {
+    return;
+  }
+  pos = ret;
+
+  mask = idx->uuid_size - 1;
+  idx->uuids[pos] = 0;
+  for(next = (pos + 1) & mask; idx->uuids[next] != 0; next = (next + 1) & mask) {
+    home = hash_string(idx->entries[idx->uuids[next] - 1].uuid) & mask;
+
+    // move it if the home is not in (pos, next]
+    if(((next - home) & mask) >= ((next - pos) & mask)) {
+      idx->uuids[pos] = idx->uuids[next];
+      idx->uuids[next] = 0;
+      pos = next;
+    }
+  }
+}
+
+static search_gram* find_gram(const user_search* idx, uint32_t key)
+{
+  uint32_t mask;
+  uint32_t pos;
+
+  mask = idx->gram_size - 1;
+  for(pos = hash_gram(key) & mask; idx->grams[pos].key != 0; pos = (pos + 1) & mask) {
+    if(idx->grams[pos].key == key) {
+      return &idx->grams[pos];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Returns the gram of the given key. Creates it if not exist.
+ */
+static search_gram* get_gram(user_search* idx, uint32_t key)
+{
+  search_gram* gram;
+  uint32_t mask;
+  uint32_t pos;
+
+  gram = find_gram(idx, key);
+  if(gram != NULL) {
+    return gram;
+  }
+
+  if((idx->gram_count + 1) * 2 > idx->gram_size) {
+    if(grow_grams(idx) == false) {
+      return NULL;
+    }
+  }
+
+  mask = idx->gram_size - 1;
+  for(pos = hash_gram(key) & mask; idx->grams[pos].key != 0; pos = (pos + 1) & mask);
+  idx->grams[pos].key = key;
+  idx->gram_count++;
+
+  return &idx->grams[pos];
+}
+
+static bool grow_grams(user_search* idx)
+{
+  search_gram* old;
+  uint32_t mask;
+  uint32_t pos;
+  int old_size;
+  int i;
+
+  old = idx->grams;
+  old_size = idx->gram_size;
+
+  idx->grams = calloc(old_size * 2, sizeof(search_gram));
+  if(idx->grams == NULL) {
+    idx->grams = old;
+    return false;
+  }
+  idx->gram_size = old_size * 2;
+
+  mask = idx->gram_size - 1;
+  for(i = 0; i < old_size; i++) {
+    if(old[i].key == 0) {
+      continue;
+    }
+    for(pos = hash_gram(old[i].key) & mask; idx->grams[pos].key != 0; pos = (pos + 1) & mask);
+    idx->grams[pos] = old[i];
+  }
+  free(old);
+
+  return true;
+}
+
+/**
+ * Add the slot to the all grams of the entry text.
+ * The grams don't cross over the fields.
+ * The grams at the field start are added to the prefix grams also.
+ */
+static bool add_grams(user_search* idx, uint32_t slot)
+{
+  search_gram* gram;
+  const char* text;
+  uint32_t key;
+  bool start;
+  int len;
+  int i;
+
+  text = idx->entries[slot].text;
+  for(i = 0; text[i] != '\0'; i++) {
+    start = ((i == 0) || (text[i - 1] == DEF_SEARCH_SEPARATOR))? true : false;
+    for(len = 1; len <= get_gram_len(text + i); len++) {
+      key = create_gram_key(text + i, len);
+      for(; key != 0; key = ((start == true) && !(key & DEF_SEARCH_PREFIX_KEY))? (key | DEF_SEARCH_PREFIX_KEY) : 0) {
+        gram = get_gram(idx, key);
+        if(gram == NULL) {
+          return false;
+        }
+
+        // the same gram in the entry is added in a row.
+        if((gram->list.count > 0) && (gram->list.items[gram->list.count - 1] == slot)) {
+          continue;
+        }
+        if(list_append(&gram->list, slot) == false) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static void remove_grams(user_search* idx, uint32_t slot)
+{
+  search_gram* gram;
+  const char* text;
+  uint32_t key;
+  bool start;
+  int len;
+  int i;
+
+  text = idx->entries[slot].text;
+  for(i = 0; text[i] != '\0'; i++) {
+    start = ((i == 0) || (text[i - 1] == DEF_SEARCH_SEPARATOR))? true : false;
+    for(len = 1; len <= get_gram_len(text + i); len++) {
+      key = create_gram_key(text + i, len);
+      for(; key != 0; key = ((start == true) && !(key & DEF_SEARCH_PREFIX_KEY))? (key | DEF_SEARCH_PREFIX_KEY) : 0) {
+        gram = find_gram(idx, key);
+        if(gram == NULL) {
+          continue;
+        }
+        list_remove(&gram->list, slot);
+      }
+    }
+  }
+}
+
+/**
+ * Returns the max gram length at the given position.
+ * The gram doesn't cross over the field separator.
+ */
+static int get_gram_len(const char* str)
+{
+  int len;
+
+  for(len = 0; len < DEF_SEARCH_MAX_GRAM; len++) {
+    if((str[len] == '\0') || (str[len] == DEF_SEARCH_SEPARATOR)) {
+      break;
+    }
+  }
+
+  return len;
+}
+
+static void remove_entry(user_search* idx, uint32_t slot)
+{
+  search_entry* entry;
+
+  entry = &idx->entries[slot];
+  if(entry->text != NULL) {
+    remove_grams(idx, slot);
+  }
+  delete_uuid(idx, slot);
+
+  free(entry->uuid);
+  free(entry->text);
+  entry->uuid = NULL;
+  entry->text = NULL;
+
+  list_append(&idx->frees, slot);
+  idx->count--;
+}
+
+/**
+ * Create lower cased entry text.
+ * The separator in the field is replaced to the space.
+ */
+static char* create_entry_text(const char* const* fields, int count)
+{
+  char* res;
+  int len;
+  int pos;
+  int i;
+  int j;
+
+  len = 0;
+  for(i = 0; i < count; i++) {
+    if(fields[i] != NULL) {
+      len += strlen(fields[i]) + 1;
+    }
+  }
+
+  res = malloc(len + 1);
+  if(res == NULL) {
+    return NULL;
+  }
+
+  pos = 0;
+  for(i = 0; i < count; i++) {
+    if(fields[i] == NULL) {
+      continue;
+    }
+    if(pos > 0) {
+      res[pos++] = DEF_SEARCH_SEPARATOR;
+    }
+    for(j = 0; fields[i][j] != '\0'; j++) {
+      res[pos++] = (fields[i][j] == DEF_SEARCH_SEPARATOR)? ' ' : tolower((unsigned char)fields[i][j]);
+    }
+  }
+  res[pos] = '\0';
+
+  return res;
+}
+
+/**
+ * Returns true if any field of the text starts with the query.
+ */
+static bool is_prefix_match(const char* text, const char* query, int len)
+{
+  const char* field;
+
+  for(field = text; field != NULL; field = strchr(field, DEF_SEARCH_SEPARATOR)) {
+    if(*field == DEF_SEARCH_SEPARATOR) {
+      field++;
+    }
+    if(strncmp(field, query, len) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
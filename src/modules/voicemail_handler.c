@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <evhtp.h>
 #include <jansson.h>
 #include <errno.h>
@@ -11,6 +12,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/inotify.h>
+#include <event2/event.h>
 
 
 #include "common.h"
@@ -20,6 +23,8 @@
 #include "http_handler.h"
 #include "ami_handler.h"
 #include "conf_handler.h"
+#include "event_handler.h"
+#include "http_range.h"
 
 //#include "ini.h"
 #include "minIni.h"
@@ -28,13 +33,40 @@
 #define DEF_SETTING_CONTEXT     "general"
 #define DEF_VOICEMAIL_CONFNAME  "voicemail.conf"
 
+#define DEF_VM_INOTIFY_MASK     (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF)
+
 extern app* g_app;
 
+/**
+ * get_vm_info() browsing state.
+ */
+struct vm_info_browse {
+  json_t* j_res;      ///< message items. key: item name.
+  json_t* j_founds;   ///< items already set. keeps the first occurrence.
+  bool is_message;    ///< in the [message] section.
+};
+
+static json_t* g_vm_cache = NULL;     ///< vm directory cache. key: directory path.
+static json_t* g_vm_watches = NULL;   ///< inotify watch descriptors. key: wd, value: directory path.
+static int g_vm_inotify_fd = -1;      ///< -1 if the inotify is not available. Uses mtime check instead.
+
 static json_t* get_vm_info(const char* filename);
 static json_t* get_vms_info_all(const char* context, const char* mailbox);
 static json_t* get_vms_status(const char* directory, const char* status, const char* dir);
 static char* get_vm_filename(const char* context, const char* mailbox, const char* dir, const char* msgname);
 
+static json_t* get_vms_status_cache(const char* directory);
+static bool watch_vms_status_cache(const char* directory);
+static void add_vms_status_cache(const char* directory, json_t* j_vms, const struct stat* sb, json_t* j_mtimes);
+static json_t* get_vms_status_mtimes(const char* directory);
+static void clear_vms_status_cache(const char* directory);
+static void process_vm_inotify(void);
+static void cb_vm_inotify(evutil_socket_t fd, short what, void* arg);
+static int cb_vm_info_browse(const char* section, const char* key, const char* value, void* data);
+
+static bool is_vm_if_range_match(evhtp_request_t* req, const char* etag, time_t mtime);
+static bool add_vm_file(evhtp_request_t* req, int fd, const struct stat* sb, const http_range* ranges, int count);
+
 static int delete_voicemail_user(const char* context, const char* mailbox);
 static bool remove_vm(const char* context, const char* mailbox, const char* dir, const char* msgname);
 static bool create_voicemail_user(json_t* j_data);
@@ -44,6 +76,52 @@ static bool is_setting_context(const char* context);
 
 static bool parse_voicemail_id(const char* str, char** mailbox, char** context);
 
+bool voicemail_init_handler(void)
+{
+  struct event* ev;
+
+  slog(LOG_DEBUG, "Fired voicemail_init_handler.");
+
+  g_vm_cache = json_object();
+  g_vm_watches = json_object();
+
+  // use the inotify for the cache invalidation if possible.
+  g_vm_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(g_vm_inotify_fd < 0) {
+    slog(LOG_NOTICE, "Could not initiate inotify. Use mtime check for the vm cache. err[%d:%s]", errno, strerror(errno));
+    return true;
+  }
+
+  ev = event_new(g_app->evt_base, g_vm_inotify_fd, EV_READ | EV_PERSIST, cb_vm_inotify, NULL);
+  if(ev == NULL) {
+    slog(LOG_ERR, "Could not create event for the vm inotify.");
+    close(g_vm_inotify_fd);
+    g_vm_inotify_fd = -1;
+    return true;
+  }
+  event_add(ev, NULL);
+  event_add_handler(ev);
+
+  return true;
+}
+
+void voicemail_term_handler(void)
+{
+  slog(LOG_DEBUG, "Fired voicemail_term_handler.");
+
+  if(g_vm_inotify_fd >= 0) {
+    close(g_vm_inotify_fd);
+    g_vm_inotify_fd = -1;
+  }
+
+  json_decref(g_vm_cache);
+  json_decref(g_vm_watches);
+  g_vm_cache = NULL;
+  g_vm_watches = NULL;
+
+  return;
+}
+
 /**
  * GET ^/voicemail/users request handler.
  * @param req
@@ -51,30 +129,14 @@ static bool parse_voicemail_id(const char* str, char** mailbox, char** context);
  */
 void voicemail_htp_get_voicemail_users(evhtp_request_t *req, void *data)
 {
-  json_t* j_tmp;
-  json_t* j_res;
-
   if(req == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
     return;
   }
   slog(LOG_DEBUG, "Fired htp_get_voicemail_mailboxes.");
 
-  // get info
-  j_tmp = get_voicemail_users_all();
-  if(j_tmp == NULL) {
-    http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
-    return;
-  }
-
-  // create result
-  j_res = http_create_default_result(EVHTP_RES_OK);
-  json_object_set_new(j_res, "result", json_object());
-  json_object_set_new(json_object_get(j_res, "result"), "list", j_tmp);
-
   // response
-  http_simple_response_normal(req, j_res);
-  json_decref(j_res);
+  http_simple_response_page(req, get_voicemail_users_page, "id");
 
   return;
 }
@@ -341,7 +403,12 @@ void voicemail_htp_get_voicemail_vms_msgname(evhtp_request_t *req, void *data)
   const char* mailbox;
   const char* msgname;
   const char* dir;
+  const char* tmp_const;
   char* filename;
+  char* etag;
+  char* last_modified;
+  http_range ranges[DEF_HTTP_RANGE_MAX];
+  int range_count;
   int fd;
   int ret;
   struct stat sb;
@@ -363,7 +430,7 @@ void voicemail_htp_get_voicemail_vms_msgname(evhtp_request_t *req, void *data)
 
   // get mailbox
   mailbox = evhtp_kv_find(req->uri->query, "mailbox");
-  if(context == NULL) {
+  if(mailbox == NULL) {
     slog(LOG_ERR, "Could not get mailbox info.");
     http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
     return;
@@ -371,7 +438,7 @@ void voicemail_htp_get_voicemail_vms_msgname(evhtp_request_t *req, void *data)
 
   // get dir
   dir = evhtp_kv_find(req->uri->query, "dir");
-  if(context == NULL) {
+  if(dir == NULL) {
     slog(LOG_ERR, "Could not get dir info.");
     http_simple_response_error(req, EVHTP_RES_BADREQ, 0, NULL);
     return;
@@ -412,34 +479,66 @@ void voicemail_htp_get_voicemail_vms_msgname(evhtp_request_t *req, void *data)
   ret = fstat(fd, &sb);
   if(ret < 0) {
     slog(LOG_ERR, "Could not get stat info. err[%d:%s]", errno, strerror(errno));
+    close(fd);
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
   if(S_ISREG(sb.st_mode) != 1) {
-//  if((sb.st_mode & S_IFREG) != 1) {
     slog(LOG_ERR, "Opened file is not voicemail file.");
     close(fd);
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
 
-  // add file
-  ret = evbuffer_add_file(req->buffer_out, fd, 0, sb.st_size);
-  close(fd);
-  if(ret != 0) {
+  // validators
+  etag = http_range_create_etag(sb.st_size, sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+  last_modified = http_range_create_date(sb.st_mtim.tv_sec);
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("ETag", etag, 0, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Last-Modified", last_modified, 0, 1));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Accept-Ranges", "bytes", 0, 0));
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Origin", "*", 0, 0));
+  sfree(last_modified);
+
+  // conditional request
+  ret = http_is_request_not_modified(req, etag, sb.st_mtim.tv_sec);
+  if(ret == true) {
+    sfree(etag);
+    close(fd);
+    evhtp_send_reply(req, EVHTP_RES_NOTMOD);
+    return;
+  }
+
+  // range request
+  range_count = 0;
+  tmp_const = evhtp_header_find(req->headers_in, "Range");
+  if((tmp_const != NULL) && (is_vm_if_range_match(req, etag, sb.st_mtim.tv_sec) == true)) {
+    range_count = http_range_parse(tmp_const, sb.st_size, ranges, DEF_HTTP_RANGE_MAX);
+  }
+  sfree(etag);
+
+  if(range_count < 0) {
+    slog(LOG_NOTICE, "Could not satisfy the range. range[%s], size[%lld]", tmp_const, (long long)sb.st_size);
+    close(fd);
+    asprintf(&tmp, "bytes */%lld", (long long)sb.st_size);
+    evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Range", tmp, 0, 1));
+    sfree(tmp);
+    evhtp_send_reply(req, EVHTP_RES_RANGENOTSC);
+    return;
+  }
+
+  // add file. the fd is closed by the file segment.
+  ret = add_vm_file(req, fd, &sb, ranges, range_count);
+  if(ret == false) {
     slog(LOG_ERR, "Could not add the file.");
     http_simple_response_error(req, EVHTP_RES_SERVERR, 0, NULL);
     return;
   }
 
   // reply
-  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Type", "application/octet-stream", 0, 0));
-  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Access-Control-Allow-Origin", "*", 0, 0));
   asprintf(&tmp, "attachment; filename=%s.wav", msgname);
-  evhtp_headers_add_header(req->headers_out, evhtp_header_new("content-disposition", tmp, 0, 0));
-  evhtp_send_reply(req, EVHTP_RES_OK);
-
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("content-disposition", tmp, 0, 1));
   sfree(tmp);
+  evhtp_send_reply(req, (range_count > 0)? EVHTP_RES_PARTIAL : EVHTP_RES_OK);
 
   return;
 }
@@ -719,6 +818,120 @@ void voicemail_htp_delete_voicemail_configs_detail(evhtp_request_t *req, void *d
   return;
 }
 
+/**
+ * Returns true if the range request should be applied.
+ * If the If-Range doesn't match to the current file, the whole file should be sent.
+ * @param req
+ * @param etag
+ * @param mtime
+ * @return
+ */
+static bool is_vm_if_range_match(evhtp_request_t* req, const char* etag, time_t mtime)
+{
+  const char* tmp_const;
+
+  tmp_const = evhtp_header_find(req->headers_in, "If-Range");
+  if(tmp_const == NULL) {
+    return true;
+  }
+
+  // entity tag. strong comparison.
+  if((tmp_const[0] == '"') || (strncmp(tmp_const, "W/", 2) == 0)) {
+    return http_range_is_etag_match(tmp_const, etag, false);
+  }
+
+  // http date
+  if(http_range_parse_date(tmp_const) == mtime) {
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Add the vm file to the response buffer.
+ * Uses the file segment, so the file could be sent without the copy(sendfile) if possible.
+ * The fd is closed when the segment is freed.
+ * @param req
+ * @param fd
+ * @param sb
+ * @param ranges
+ * @param count: count of ranges. 0 for the whole file.
+ * @return
+ */
+static bool add_vm_file(evhtp_request_t* req, int fd, const struct stat* sb, const http_range* ranges, int count)
+{
+  struct evbuffer_file_segment* seg;
+  char* boundary;
+  char* tmp;
+  int ret;
+  int i;
+
+  seg = evbuffer_file_segment_new(fd, 0, sb->st_size, EVBUF_FS_CLOSE_ON_FREE);
+  if(seg == NULL) {
+    slog(LOG_ERR, "Could not create file segment.");
+    close(fd);
+    return false;
+  }
+
+  // whole file
+  if(count == 0) {
+    ret = evbuffer_add_file_segment(req->buffer_out, seg, 0, sb->st_size);
+    evbuffer_file_segment_free(seg);
+    if(ret != 0) {
+      return false;
+    }
+    evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Type", "application/octet-stream", 0, 0));
+    return true;
+  }
+
+  // single range
+  if(count == 1) {
+    ret = evbuffer_add_file_segment(req->buffer_out, seg, ranges[0].start, ranges[0].end - ranges[0].start + 1);
+    evbuffer_file_segment_free(seg);
+    if(ret != 0) {
+      return false;
+    }
+
+    asprintf(&tmp, "bytes %lld-%lld/%lld", (long long)ranges[0].start, (long long)ranges[0].end, (long long)sb->st_size);
+    evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Range", tmp, 0, 1));
+    sfree(tmp);
+    evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Type", "application/octet-stream", 0, 0));
+    return true;
+  }
+
+  // multi ranges. multipart/byteranges
+  boundary = utils_gen_uuid();
+  for(i = 0; i < count; i++) {
+    evbuffer_add_printf(req->buffer_out,
+        "\r\n--%s\r\n"
+        "Content-Type: application/octet-stream\r\n"
+        "Content-Range: bytes %lld-%lld/%lld\r\n"
+        "\r\n",
+        boundary,
+        (long long)ranges[i].start,
+        (long long)ranges[i].end,
+        (long long)sb->st_size
+        );
+
+    ret = evbuffer_add_file_segment(req->buffer_out, seg, ranges[i].start, ranges[i].end - ranges[i].start + 1);
+    if(ret != 0) {
+      evbuffer_file_segment_free(seg);
+      sfree(boundary);
+      return false;
+    }
+  }
+  evbuffer_add_printf(req->buffer_out, "\r\n--%s--\r\n", boundary);
+  evbuffer_file_segment_free(seg);
+
+  asprintf(&tmp, "multipart/byteranges; boundary=%s", boundary);
+  evhtp_headers_add_header(req->headers_out, evhtp_header_new("Content-Type", tmp, 0, 1));
+  sfree(tmp);
+  sfree(boundary);
+
+  return true;
+}
+
 static char* get_vm_filename(const char* context, const char* mailbox, const char* dir, const char* msgname)
 {
   char* res;
@@ -746,14 +959,21 @@ static char* get_vm_filename(const char* context, const char* mailbox, const cha
   return res;
 }
 
+/**
+ * Parse the [message] section of the given vm txt file.
+ * Reads the file once with ini_browse(). Keeps the ini_gets() semantics,
+ * the first [message] section and the first occurrence of the key.
+ * @param filename
+ * @return
+ */
 static json_t* get_vm_info(const char* filename)
 {
+  int ret;
   json_t* j_res;
   json_t* j_tmp;
   int idx;
-  char tmp_data[2048];
-  const char* tmp_const;
   json_t* j_message_items;
+  struct vm_info_browse browse;
 
   if(filename == NULL) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -788,18 +1008,71 @@ static json_t* get_vm_info(const char* filename)
       "duration"
       );
 
-  // get [message] info.
+  // set default
   j_res = json_object();
   json_array_foreach(j_message_items, idx, j_tmp) {
-    tmp_const = json_string_value(j_tmp);
-    ini_gets("message", tmp_const, "", tmp_data, sizeof(tmp_data), filename);
-    json_object_set_new(j_res, tmp_const, json_string(tmp_data));
+    json_object_set_new(j_res, json_string_value(j_tmp), json_string(""));
   }
   json_decref(j_message_items);
 
+  // get [message] info.
+  browse.j_res = j_res;
+  browse.j_founds = json_object();
+  browse.is_message = false;
+  ret = ini_browse(cb_vm_info_browse, &browse, filename);
+  json_decref(browse.j_founds);
+  if(ret == 0) {
+    slog(LOG_NOTICE, "Could not read vm file. filename[%s], err[%d:%s]", filename, errno, strerror(errno));
+  }
+
   return j_res;
 }
 
+/**
+ * ini_browse() callback of the get_vm_info().
+ * Returns 0 to stop the browsing.
+ */
+static int cb_vm_info_browse(const char* section, const char* key, const char* value, void* data)
+{
+  struct vm_info_browse* browse;
+  const char* item;
+  json_t* j_tmp;
+
+  browse = data;
+  if((browse == NULL) || (section == NULL)) {
+    return 0;
+  }
+
+  // new section
+  if(key == NULL) {
+    if(browse->is_message == true) {
+      // the first [message] section is done.
+      return 0;
+    }
+    browse->is_message = (strcasecmp(section, "message") == 0)? true : false;
+    return 1;
+  }
+
+  if(browse->is_message == false) {
+    return 1;
+  }
+
+  // set only known items. keys are case insensitive.
+  json_object_foreach(browse->j_res, item, j_tmp) {
+    if(strcasecmp(item, key) != 0) {
+      continue;
+    }
+
+    if(json_object_get(browse->j_founds, item) == NULL) {
+      json_object_set_new(browse->j_res, item, json_string(value? : ""));
+      json_object_set_new(browse->j_founds, item, json_true());
+    }
+    break;
+  }
+
+  return 1;
+}
+
 /**
  * Get given mailbox@context's all vm info
  * @param context
@@ -902,6 +1175,11 @@ static bool remove_vm(const char* context, const char* mailbox, const char* dir,
     free(filename);
   }
 
+  // invalidate the cache
+  asprintf(&filename, "%s/%s/%s/%s", vm_dir, context, mailbox, dir);
+  clear_vms_status_cache(filename);
+  sfree(filename);
+
   // create refresh request
   j_tmp = json_pack("{s:s, s:s, s:s}",
       "Action",   "VoicemailRefresh",
@@ -937,7 +1215,11 @@ static json_t* get_vms_status(const char* directory, const char* status, const c
   char* msgname;
   DIR* d_dir;
   struct dirent* ent;
+  struct stat sb;
+  bool is_cacheable;
+  json_t* j_mtimes;
   char* tmp;
+  int ret;
 
   if((directory == NULL) || (status == NULL) || (dir == NULL)) {
     slog(LOG_WARNING, "Wrong input parameter.");
@@ -945,12 +1227,39 @@ static json_t* get_vms_status(const char* directory, const char* status, const c
   }
   slog(LOG_DEBUG, "Fired get_vms_status. directory[%s], status[%s]", directory, status);
 
+  // get from the cache
+  j_res = get_vms_status_cache(directory);
+  if(j_res != NULL) {
+    return j_res;
+  }
+
+  // watch the directory before read it.
+  // so the change in the middle of reading invalidates the cache.
+  is_cacheable = watch_vms_status_cache(directory);
+
+  // the message files could be changed without the directory change.
+  // keeps the mtimes of them if the inotify is not available.
+  j_mtimes = NULL;
+  if((is_cacheable == true) && (g_vm_inotify_fd < 0)) {
+    j_mtimes = get_vms_status_mtimes(directory);
+    if(j_mtimes == NULL) {
+      is_cacheable = false;
+    }
+  }
+
   d_dir = opendir(directory);
   if(d_dir == NULL) {
     slog(LOG_ERR, "Could not open directory. err[%d:%s]", errno, strerror(errno));
+    json_decref(j_mtimes);
     return NULL;
   }
 
+  ret = fstat(dirfd(d_dir), &sb);
+  if(ret < 0) {
+    slog(LOG_NOTICE, "Could not get directory stat. err[%d:%s]", errno, strerror(errno));
+    is_cacheable = false;
+  }
+
   j_res = json_array();
   while(1) {
     ent = readdir(d_dir);
@@ -991,9 +1300,246 @@ static json_t* get_vms_status(const char* directory, const char* status, const c
   }
   closedir(d_dir);
 
+  // add to the cache
+  if(is_cacheable == true) {
+    add_vms_status_cache(directory, j_res, &sb, j_mtimes);
+  }
+  json_decref(j_mtimes);
+
   return j_res;
 }
 
+/**
+ * Returns the cached vms of the given directory.
+ * Returns NULL if there's no valid cache.
+ * @param directory
+ * @return
+ */
+static json_t* get_vms_status_cache(const char* directory)
+{
+  json_t* j_cache;
+  json_t* j_mtimes;
+  struct stat sb;
+  int ret;
+
+  if((directory == NULL) || (g_vm_cache == NULL)) {
+    return NULL;
+  }
+
+  // apply the pending changes
+  process_vm_inotify();
+
+  j_cache = json_object_get(g_vm_cache, directory);
+  if(j_cache == NULL) {
+    return NULL;
+  }
+
+  // check the mtime if the inotify is not available
+  if(g_vm_inotify_fd < 0) {
+    ret = stat(directory, &sb);
+    if((ret < 0)
+        || (json_integer_value(json_object_get(j_cache, "mtime_sec")) != sb.st_mtim.tv_sec)
+        || (json_integer_value(json_object_get(j_cache, "mtime_nsec")) != sb.st_mtim.tv_nsec)
+        ) {
+      clear_vms_status_cache(directory);
+      return NULL;
+    }
+
+    // the message file could be edited in place
+    j_mtimes = get_vms_status_mtimes(directory);
+    ret = json_equal(j_mtimes, json_object_get(j_cache, "mtimes"));
+    json_decref(j_mtimes);
+    if(ret != 1) {
+      clear_vms_status_cache(directory);
+      return NULL;
+    }
+  }
+  slog(LOG_DEBUG, "Found vms cache. directory[%s]", directory);
+
+  return json_deep_copy(json_object_get(j_cache, "list"));
+}
+
+/**
+ * Add the inotify watch for the given directory.
+ * Returns false if the directory's cache could not be invalidated.
+ * @param directory
+ * @return
+ */
+static bool watch_vms_status_cache(const char* directory)
+{
+  char* key;
+  int wd;
+
+  if((directory == NULL) || (g_vm_cache == NULL)) {
+    return false;
+  }
+
+  // uses mtime check
+  if(g_vm_inotify_fd < 0) {
+    return true;
+  }
+
+  wd = inotify_add_watch(g_vm_inotify_fd, directory, DEF_VM_INOTIFY_MASK);
+  if(wd < 0) {
+    slog(LOG_NOTICE, "Could not add inotify watch. directory[%s], err[%d:%s]", directory, errno, strerror(errno));
+    return false;
+  }
+
+  asprintf(&key, "%d", wd);
+  json_object_set_new(g_vm_watches, key, json_string(directory));
+  sfree(key);
+
+  return true;
+}
+
+/**
+ * Add the vms to the cache.
+ * @param directory
+ * @param j_vms
+ * @param sb        directory stat
+ * @param j_mtimes  message file mtimes. Only for the mtime check. Could be NULL.
+ */
+static void add_vms_status_cache(const char* directory, json_t* j_vms, const struct stat* sb, json_t* j_mtimes)
+{
+  json_t* j_cache;
+
+  if((directory == NULL) || (j_vms == NULL) || (sb == NULL) || (g_vm_cache == NULL)) {
+    return;
+  }
+
+  j_cache = json_pack("{s:o, s:I, s:I}",
+      "list",       json_deep_copy(j_vms),
+      "mtime_sec",  (json_int_t)sb->st_mtim.tv_sec,
+      "mtime_nsec", (json_int_t)sb->st_mtim.tv_nsec
+      );
+  if(j_mtimes != NULL) {
+    json_object_set(j_cache, "mtimes", j_mtimes);
+  }
+  json_object_set_new(g_vm_cache, directory, j_cache);
+
+  return;
+}
+
+/**
+ * Returns the mtimes of the message files in the given directory.
+ * key: file name, value: [mtime_sec, mtime_nsec]
+ * @param directory
+ * @return
+ */
+static json_t* get_vms_status_mtimes(const char* directory)
+{
+  json_t* j_res;
+  char* filename;
+  DIR* d_dir;
+  struct dirent* ent;
+  struct stat sb;
+  int ret;
+
+  if(directory == NULL) {
+    slog(LOG_WARNING, "Wrong input parameter.");
+    return NULL;
+  }
+
+  d_dir = opendir(directory);
+  if(d_dir == NULL) {
+    slog(LOG_NOTICE, "Could not open directory. directory[%s], err[%d:%s]", directory, errno, strerror(errno));
+    return NULL;
+  }
+
+  j_res = json_object();
+  while(1) {
+    ent = readdir(d_dir);
+    if(ent == NULL) {
+      break;
+    }
+
+    if(strstr(ent->d_name, ".txt") == NULL) {
+      continue;
+    }
+
+    asprintf(&filename, "%s/%s", directory, ent->d_name);
+    ret = stat(filename, &sb);
+    sfree(filename);
+    if(ret < 0) {
+      continue;
+    }
+
+    json_object_set_new(j_res, ent->d_name, json_pack("[I, I]",
+        (json_int_t)sb.st_mtim.tv_sec,
+        (json_int_t)sb.st_mtim.tv_nsec
+        ));
+  }
+  closedir(d_dir);
+
+  return j_res;
+}
+
+static void clear_vms_status_cache(const char* directory)
+{
+  if((directory == NULL) || (g_vm_cache == NULL)) {
+    return;
+  }
+  slog(LOG_DEBUG, "Fired clear_vms_status_cache. directory[%s]", directory);
+
+  json_object_del(g_vm_cache, directory);
+
+  return;
+}
+
+/**
+ * Read all of the pending inotify events and invalidate the changed directories.
+ */
+static void process_vm_inotify(void)
+{
+  char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  const struct inotify_event* event;
+  const char* directory;
+  char* key;
+  ssize_t len;
+  char* ptr;
+
+  if(g_vm_inotify_fd < 0) {
+    return;
+  }
+
+  while(1) {
+    len = read(g_vm_inotify_fd, buf, sizeof(buf));
+    if(len <= 0) {
+      break;
+    }
+
+    for(ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + event->len) {
+      event = (const struct inotify_event*)ptr;
+
+      // events were dropped. clear all.
+      if(event->mask & IN_Q_OVERFLOW) {
+        slog(LOG_NOTICE, "The inotify queue overflowed. Clear all vms cache.");
+        json_object_clear(g_vm_cache);
+        continue;
+      }
+
+      asprintf(&key, "%d", event->wd);
+      directory = json_string_value(json_object_get(g_vm_watches, key));
+      if(directory != NULL) {
+        clear_vms_status_cache(directory);
+      }
+
+      // the watch has been removed.
+      if(event->mask & IN_IGNORED) {
+        json_object_del(g_vm_watches, key);
+      }
+      sfree(key);
+    }
+  }
+
+  return;
+}
+
+static void cb_vm_inotify(evutil_socket_t fd, short what, void* arg)
+{
+  process_vm_inotify();
+}
+
 static char* create_voicemail_user_info_string(json_t* j_data)
 {
   // check mandatory items
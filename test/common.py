@@ -52,3 +52,47 @@ def http_send(url, method, data):
     # return    
     return conn.getinfo(pycurl.HTTP_CODE), response.getvalue()
 
+
+def http_send_headers(url, method, data, headers):
+    '''
+    Same as the http_send, but sends the given request headers and returns the response headers.
+    @param headers: list of request header strings. ex) ["Range: bytes=0-99"]
+
+    @return: code, response headers(lower cased key), get_data.
+    '''
+    conn = pycurl.Curl()
+    conn.setopt(pycurl.URL, url)
+
+    response = cStringIO.StringIO()
+    conn.setopt(pycurl.WRITEFUNCTION, response.write)
+
+    res_headers = {}
+    def header_function(line):
+        if ":" not in line:
+            return
+        key, val = line.split(":", 1)
+        res_headers[key.strip().lower()] = val.strip()
+    conn.setopt(pycurl.HEADERFUNCTION, header_function)
+
+    if headers is not None:
+        conn.setopt(pycurl.HTTPHEADER, headers)
+
+    if data is not None:
+        conn.setopt(pycurl.POST, 1)
+        conn.setopt(pycurl.POSTFIELDSIZE, len(data))
+        conn.setopt(pycurl.POSTFIELDS, data)
+
+    if method == "GET":
+        conn.setopt(pycurl.HTTPGET, 1)
+    elif method == "POST":
+        conn.setopt(pycurl.POST, 1)
+    elif method == "PUT":
+        conn.setopt(pycurl.CUSTOMREQUEST, "PUT")
+    elif method == "DELETE":
+        conn.setopt(pycurl.CUSTOMREQUEST, "DELETE")
+    else:
+        raise Exception("Unsupported method.")
+
+    conn.perform()
+
+    return conn.getinfo(pycurl.HTTP_CODE), res_headers, response.getvalue()
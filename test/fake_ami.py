@@ -0,0 +1,173 @@
+import socket
+import sys
+import threading
+
+# Fake AMI server for the pjsip endpoint detail sync and the sip reload test.
+# Answers the PJSIPShowEndpoints with the given count of endpoints
+# and the PJSIPShowEndpoint after the given delay.
+# Answers the SIPpeers with the given count of sip peers.
+# The ModuleLoad of res_pjsip or chan_sip fires the Reload event.
+# Each chan_sip reload removes the last sip peer, and the next one restores it.
+#
+# Set the jade's ami_serv_addr/ami_serv_port to this server.
+#   $ python fake_ami.py [port] [endpoints] [delay_sec] [sip_peers]
+
+port = int(sys.argv[1]) if len(sys.argv) > 1 else 5039
+endpoint_count = int(sys.argv[2]) if len(sys.argv) > 2 else 5000
+delay = float(sys.argv[3]) if len(sys.argv) > 3 else 0.01
+sip_peer_count = int(sys.argv[4]) if len(sys.argv) > 4 else 10
+
+lock = threading.Lock()
+stats = {"detail_requests": 0, "in_flight": 0, "max_in_flight": 0}
+sip_state = {"removed": False}
+
+
+def send_msg(conn, items):
+    data = "".join(["%s: %s\r\n" % (key, val) for key, val in items]) + "\r\n"
+    with lock:
+        conn.sendall(data)
+
+
+def endpoint_name(idx):
+    return "fake-%05d" % (idx)
+
+
+def send_endpoint_list(conn):
+    send_msg(conn, [("Response", "Success"), ("EventList", "start"), ("Message", "Following are Events for each object")])
+    for i in range(endpoint_count):
+        name = endpoint_name(i)
+        send_msg(conn, [
+            ("Event", "EndpointList"),
+            ("ObjectType", "endpoint"),
+            ("ObjectName", name),
+            ("Transport", "jade-transport-udp"),
+            ("Aor", name),
+            ("Auths", name),
+            ("OutboundAuths", ""),
+            ("Contacts", ""),
+            ("DeviceState", "Unavailable"),
+            ("ActiveChannels", ""),
+        ])
+    send_msg(conn, [("Event", "EndpointListComplete"), ("EventList", "Complete"), ("ListItems", str(endpoint_count))])
+
+
+def send_endpoint_detail(conn, name):
+    send_msg(conn, [
+        ("Event", "EndpointDetail"),
+        ("ObjectType", "endpoint"),
+        ("ObjectName", name),
+        ("Transport", "jade-transport-udp"),
+        ("Aors", name),
+        ("Auth", name),
+        ("OutboundAuth", ""),
+        ("Context", "demo"),
+        ("DeviceState", "Unavailable"),
+    ])
+    send_msg(conn, [("Event", "AorDetail"), ("ObjectType", "aor"), ("ObjectName", name), ("EndpointName", name)])
+    send_msg(conn, [("Event", "AuthDetail"), ("ObjectType", "auth"), ("ObjectName", name), ("EndpointName", name)])
+    send_msg(conn, [("Event", "EndpointDetailComplete"), ("EventList", "Complete"), ("ListItems", "3")])
+
+    with lock:
+        stats["in_flight"] -= 1
+        if stats["in_flight"] == 0:
+            print("detail_requests[%d], max_in_flight[%d]" % (stats["detail_requests"], stats["max_in_flight"]))
+
+
+def sip_peer_name(idx):
+    return "fake-sip-%03d" % (idx)
+
+
+def send_sip_peer_list(conn, action_id):
+    count = sip_peer_count - 1 if sip_state["removed"] == True else sip_peer_count
+
+    res = [("Response", "Success"), ("EventList", "start"), ("Message", "Peer status list will follow")]
+    if action_id is not None:
+        res.append(("ActionID", action_id))
+    send_msg(conn, res)
+
+    for i in range(count):
+        send_msg(conn, [
+            ("Event", "PeerEntry"),
+            ("Channeltype", "SIP"),
+            ("ObjectName", sip_peer_name(i)),
+            ("ChanObjectType", "peer"),
+            ("IPaddress", "127.0.0.1"),
+            ("IPport", str(5060 + i)),
+            ("Dynamic", "no"),
+            ("AutoForcerport", "no"),
+            ("Forcerport", "no"),
+            ("AutoComedia", "no"),
+            ("Comedia", "no"),
+            ("VideoSupport", "no"),
+            ("TextSupport", "no"),
+            ("ACL", "no"),
+            ("Status", "Unmonitored"),
+            ("RealtimeDevice", "no"),
+            ("Description", ""),
+        ])
+    send_msg(conn, [("Event", "PeerlistComplete"), ("EventList", "Complete"), ("ListItems", str(count))])
+
+
+def handle_action(conn, msg):
+    action = msg.get("action", "").lower()
+    action_id = msg.get("actionid")
+
+    if action == "pjsipshowendpoints":
+        send_endpoint_list(conn)
+        return
+
+    if action == "pjsipshowendpoint":
+        with lock:
+            stats["detail_requests"] += 1
+            stats["in_flight"] += 1
+            stats["max_in_flight"] = max(stats["max_in_flight"], stats["in_flight"])
+        send_msg(conn, [("Response", "Success"), ("EventList", "start")])
+        threading.Timer(delay, send_endpoint_detail, [conn, msg.get("endpoint", "")]).start()
+        return
+
+    if action == "sippeers":
+        send_sip_peer_list(conn, action_id)
+        return
+
+    res = [("Response", "Success")]
+    if action_id is not None:
+        res.append(("ActionID", action_id))
+    send_msg(conn, res)
+
+    if (action == "moduleload") and ("res_pjsip" in msg.get("module", "")):
+        send_msg(conn, [("Event", "Reload"), ("Module", "res_pjsip.so"), ("Status", "0")])
+
+    if (action == "moduleload") and ("chan_sip" in msg.get("module", "")):
+        sip_state["removed"] = not sip_state["removed"]
+        send_msg(conn, [("Event", "Reload"), ("Module", "chan_sip.so"), ("Status", "0")])
+
+
+def serve(conn):
+    buf = ""
+    conn.sendall("Asterisk Call Manager/2.10.3\r\n")
+    while True:
+        data = conn.recv(65536)
+        if not data:
+            break
+
+        buf += data
+        while "\r\n\r\n" in buf:
+            block, buf = buf.split("\r\n\r\n", 1)
+            msg = {}
+            for line in block.split("\r\n"):
+                if ":" not in line:
+                    continue
+                key, val = line.split(":", 1)
+                msg[key.strip().lower()] = val.strip()
+            handle_action(conn, msg)
+
+
+sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+sock.bind(("127.0.0.1", port))
+sock.listen(1)
+print("Listening. port[%d], endpoints[%d], delay[%f], sip_peers[%d]" % (port, endpoint_count, delay, sip_peer_count))
+
+while True:
+    conn, addr = sock.accept()
+    threading.Thread(target=serve, args=(conn,)).start()
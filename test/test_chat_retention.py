@@ -0,0 +1,239 @@
+import common
+import json
+import os
+import sqlite3
+import time
+import uuid
+
+# The chat retention status should have all the counters,
+# and the retention step should run periodically.
+# The old messages and the exceeded messages should be deleted,
+# and the message summary of the userrooms should follow the remaining messages.
+# The messages are seeded into the jade database of the backend directly,
+# because the create time of the message can not be given by the api.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+jade_database = os.environ.get("JADE_DATABASE", "./jade_database.db")
+
+DEF_WAIT_TIMEOUT = 30
+
+
+def get_retention_status():
+    url = "127.0.0.1:8081/v1/admin/chat/retention?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get chat retention status. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def get_tm(days):
+    return time.strftime("%Y-%m-%dT%H:%M:%S", time.gmtime(time.time() - (days * 86400)))
+
+
+def seed_room(db, tms):
+    '''
+    Create the room of two users and the messages of the given create times.
+    Returns the uuid of the room.
+    '''
+    uuid_room = str(uuid.uuid4())
+    uuid_owner = str(uuid.uuid4())
+    uuid_other = str(uuid.uuid4())
+    tm = get_tm(0)
+
+    db.execute("insert into chat_room(uuid, type, uuid_creator, uuid_owner, members, tm_create) values (?, 1, ?, ?, ?, ?)",
+        (uuid_room, uuid_owner, uuid_owner, json.dumps([uuid_owner, uuid_other]), tm))
+
+    db.execute("insert into chat_userroom(uuid, uuid_user, uuid_room, name, unread_count, tm_create) values (?, ?, ?, 'retention', 0, ?)",
+        (str(uuid.uuid4()), uuid_owner, uuid_room, tm))
+    db.execute("insert into chat_userroom(uuid, uuid_user, uuid_room, name, unread_count, tm_create) values (?, ?, ?, 'retention', ?, ?)",
+        (str(uuid.uuid4()), uuid_other, uuid_room, len(tms), tm))
+
+    for i, tm_create in enumerate(sorted(tms)):
+        j_message = {"uuid": str(uuid.uuid4()), "uuid_room": uuid_room, "uuid_owner": uuid_owner, "message": "retention %d" % (i), "tm_create": tm_create}
+        db.execute("insert into chat_message(uuid, uuid_room, uuid_owner, message, tm_create) values (?, ?, ?, ?, ?)",
+            (j_message["uuid"], uuid_room, uuid_owner, j_message["message"], tm_create))
+        db.execute("update chat_userroom set last_message = ?, last_message_tm = ? where uuid_room = ?",
+            (json.dumps(j_message), tm_create, uuid_room))
+
+    db.commit()
+    return uuid_room
+
+
+def get_messages(db, uuid_room):
+    return [row[0] for row in db.execute("select tm_create from chat_message where uuid_room = ? order by tm_create", (uuid_room,))]
+
+
+def get_userrooms(db, uuid_room):
+    return db.execute("select unread_count, last_message, last_message_tm from chat_userroom where uuid_room = ? order by unread_count", (uuid_room,)).fetchall()
+
+
+def wait_messages(db, uuid_room, count):
+    '''
+    Wait until the retention steps leave the given count of messages.
+    '''
+    for i in range(DEF_WAIT_TIMEOUT):
+        tms = get_messages(db, uuid_room)
+        if len(tms) <= count:
+            return tms
+        time.sleep(1)
+
+    print("The messages were not deleted. uuid_room[%s], count[%d], expect[%d]" % (uuid_room, len(tms), count))
+    return None
+
+
+def check_userrooms(db, uuid_room, tms):
+    '''
+    The userroom summary should follow the remaining messages.
+    '''
+    last_tm = tms[-1] if len(tms) > 0 else None
+    for unread_count, last_message, last_message_tm in get_userrooms(db, uuid_room):
+        if last_message_tm != last_tm:
+            print("Wrong last_message_tm. uuid_room[%s], last_message_tm[%s], expect[%s]" % (uuid_room, last_message_tm, last_tm))
+            return False
+
+        if (last_tm is None) != (last_message is None):
+            print("Wrong last_message. uuid_room[%s], last_message[%s]" % (uuid_room, last_message))
+            return False
+
+        if (last_message is not None) and (json.loads(last_message)["tm_create"] != last_tm):
+            print("Wrong last_message. uuid_room[%s], last_message[%s]" % (uuid_room, last_message))
+            return False
+
+        if unread_count > len(tms):
+            print("Wrong unread_count. uuid_room[%s], unread_count[%d], messages[%d]" % (uuid_room, unread_count, len(tms)))
+            return False
+
+    return True
+
+
+def test_retention_status():
+    keys = [
+        "retention_days", "retention_count", "retention_batch_size", "retention_room_count", "vacuum_pages",
+        "steps", "deleted_room", "deleted_days", "deleted_count", "vacuumed_pages",
+        "pending_rooms", "auto_vacuum", "page_count", "freelist_count"
+    ]
+
+    j_status = get_retention_status()
+    if j_status is None:
+        return False
+
+    for key in keys:
+        if key not in j_status:
+            print("Could not find the key. key[%s]" % (key))
+            return False
+
+    if j_status["retention_batch_size"] <= 0:
+        print("Wrong batch size. retention_batch_size[%d]" % (j_status["retention_batch_size"]))
+        return False
+
+    return True
+
+
+def test_retention_steps():
+    j_before = get_retention_status()
+    if j_before is None:
+        return False
+
+    time.sleep(3)
+
+    j_after = get_retention_status()
+    if j_after is None:
+        return False
+
+    if j_after["steps"] <= j_before["steps"]:
+        print("The retention step is not running. before[%d], after[%d]" % (j_before["steps"], j_after["steps"]))
+        return False
+
+    return True
+
+
+def test_retention_days():
+    j_status = get_retention_status()
+    if j_status is None:
+        return False
+
+    days = j_status["retention_days"]
+    if days <= 0:
+        print("Skip. The retention_days is disabled.")
+        return True
+
+    db = sqlite3.connect(jade_database, timeout=10)
+
+    # all old messages. the room becomes empty.
+    uuid_room_old = seed_room(db, [get_tm(days + 10 + i) for i in range(3)])
+
+    # old and new messages
+    tms_new = [get_tm(0), get_tm(1.0 / 24)]
+    uuid_room_mixed = seed_room(db, tms_new + [get_tm(days + 1 + i) for i in range(5)])
+
+    for uuid_room, count in [(uuid_room_old, 0), (uuid_room_mixed, len(tms_new))]:
+        tms = wait_messages(db, uuid_room, count)
+        if tms is None:
+            return False
+
+        if check_userrooms(db, uuid_room, tms) != True:
+            return False
+
+    if get_messages(db, uuid_room_mixed) != sorted(tms_new):
+        print("The new messages were deleted. uuid_room[%s]" % (uuid_room_mixed))
+        return False
+
+    db.close()
+    return True
+
+
+def test_retention_count():
+    j_status = get_retention_status()
+    if j_status is None:
+        return False
+
+    count = j_status["retention_count"]
+    if count <= 0:
+        print("Skip. The retention_count is disabled.")
+        return True
+
+    db = sqlite3.connect(jade_database, timeout=10)
+
+    # more than the retention count. only the newest ones remain.
+    tms_seed = sorted(["%s.%06d" % (get_tm(0), i) for i in range(count + 10)])
+    uuid_room = seed_room(db, tms_seed)
+
+    tms = wait_messages(db, uuid_room, count)
+    if tms is None:
+        return False
+
+    if tms != tms_seed[-count:]:
+        print("The newest messages were not kept. uuid_room[%s]" % (uuid_room))
+        return False
+
+    if check_userrooms(db, uuid_room, tms) != True:
+        return False
+
+    db.close()
+    return True
+
+
+#### Test
+
+
+print("test_retention_status")
+ret = test_retention_status()
+if ret != True:
+    raise
+
+print("test_retention_steps")
+ret = test_retention_steps()
+if ret != True:
+    raise
+
+print("test_retention_days")
+ret = test_retention_days()
+if ret != True:
+    raise
+
+print("test_retention_count")
+ret = test_retention_count()
+if ret != True:
+    raise
@@ -0,0 +1,72 @@
+import common
+import json
+import os
+
+# The config update should not create a new backup if the file has not been
+# changed since the last backup.
+# The queue config file is rewritten with the same data in the test.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_configurations():
+    url = "127.0.0.1:8081/v1/admin/queue/configurations?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get queue configurations. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]["list"]
+
+
+def put_configuration(name, data):
+    url = "127.0.0.1:8081/v1/admin/queue/configurations/%s?authtoken=%s" % (name, admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "PUT", json.dumps({"data": data}))
+    if ret_code != 200:
+        print("Could not update queue configuration. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def test_backup_dedup():
+    j_confs = get_configurations()
+    if j_confs is None:
+        return False
+
+    current = None
+    for j_conf in j_confs:
+        if j_conf["name"] == "queues.conf":
+            current = j_conf["data"]
+    if current is None:
+        print("Could not find the current config.")
+        return False
+
+    if put_configuration("queues.conf", current) != True:
+        return False
+    j_first = get_configurations()
+
+    if put_configuration("queues.conf", current) != True:
+        return False
+    j_second = get_configurations()
+
+    if len(j_second) != len(j_first):
+        print("The unchanged config should not be backed up. before[%d], after[%d]" % (len(j_first), len(j_second)))
+        return False
+
+    # the latest backup should have the current data
+    for j_conf in j_second:
+        if j_conf["name"] != "queues.conf" and j_conf["data"] == current:
+            return True
+
+    print("Could not find the backup of the current config.")
+    return False
+
+
+#### Test
+
+
+print("test_backup_dedup")
+ret = test_backup_dedup()
+if ret != True:
+    raise
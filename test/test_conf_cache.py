@@ -0,0 +1,79 @@
+import common
+import json
+import os
+
+# The repeated config reads should be served from the config cache.
+# The queue config file should not be changed in the test.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_stats():
+    url = "127.0.0.1:8081/v1/admin/resource/stats?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get resource stats. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def get_cfg_queues():
+    url = "127.0.0.1:8081/v1/admin/queue/cfg_queues?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get queue config. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def test_cache_stats():
+    j_stats = get_stats()
+    if j_stats is None:
+        return False
+
+    for key in ["conf_cache_hit", "conf_cache_miss", "conf_cache_invalidate", "conf_cache_file_count"]:
+        if key not in j_stats:
+            print("Could not find the key. key[%s]" % (key))
+            return False
+
+    return True
+
+
+def test_cache_hit():
+    j_first = get_cfg_queues()
+    if j_first is None:
+        return False
+
+    j_stats = get_stats()
+    for i in range(10):
+        j_res = get_cfg_queues()
+        if j_res != j_first:
+            print("The cached config is different. res[%s], expect[%s]" % (j_res, j_first))
+            return False
+
+    j_stats_after = get_stats()
+    if j_stats_after["conf_cache_hit"] - j_stats["conf_cache_hit"] < 10:
+        print("Wrong hit count. before[%d], after[%d]" % (j_stats["conf_cache_hit"], j_stats_after["conf_cache_hit"]))
+        return False
+
+    if j_stats_after["conf_cache_miss"] != j_stats["conf_cache_miss"]:
+        print("Wrong miss count. before[%d], after[%d]" % (j_stats["conf_cache_miss"], j_stats_after["conf_cache_miss"]))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_cache_stats")
+ret = test_cache_stats()
+if ret != True:
+    raise
+
+print("test_cache_hit")
+ret = test_cache_hit()
+if ret != True:
+    raise
@@ -0,0 +1,332 @@
+/*
+ * test_conf_doc.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Asterisk config document edit test.
+ *  The untouched lines should be kept byte for byte.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#include "conf_doc.h"
+
+static int g_fail = 0;
+
+static const char* g_base =
+    "; queue config\n"
+    "#include \"queues_custom.conf\"\n"
+    "\n"
+    "[general]\n"
+    "persistentmembers = yes ; keep members\n"
+    ";--\n"
+    "[commented]\n"
+    "key = value\n"
+    "--;\n"
+    "\n"
+    "[sales](!)\n"
+    "strategy=ringall\n"
+    "member => SIP/100\n"
+    "member => SIP/200\n"
+    "; end of sales\n"
+    "\n"
+    "[support]\n"
+    "strategy = leastrecent\n"
+    "musicclass = default\n";
+
+static void check_text(const char* name, conf_doc* doc, const char* expect)
+{
+  char* tmp;
+
+  tmp = conf_doc_get_text(doc, NULL);
+  if(strcmp(tmp, expect) != 0) {
+    printf("Fail. name[%s]\nresult[%s]\nexpect[%s]\n", name, tmp, expect);
+    g_fail++;
+  }
+  else {
+    printf("Pass. name[%s]\n", name);
+  }
+  free(tmp);
+}
+
+static void check_bool(const char* name, bool ret, bool expect)
+{
+  if(ret != expect) {
+    printf("Fail. name[%s], result[%d], expect[%d]\n", name, ret, expect);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void test_parse(void)
+{
+  conf_doc* doc;
+
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  check_text("parse roundtrip", doc, g_base);
+  check_bool("parse section", conf_doc_has_section(doc, "sales"), true);
+  check_bool("parse block comment", conf_doc_has_section(doc, "commented"), false);
+  check_bool("parse key", conf_doc_has_key(doc, "general", "persistentmembers"), true);
+  check_bool("parse arrow key", conf_doc_has_key(doc, "sales", "member"), true);
+  check_bool("parse no key", conf_doc_has_key(doc, "support", "member"), false);
+  check_bool("parse changes", conf_doc_get_changes(doc) == 0, true);
+  conf_doc_free(doc);
+}
+
+static void test_set_items(void)
+{
+  conf_doc* doc;
+  const char* values[] = {"no", "SIP/300", "SIP/400", "SIP/500"};
+
+  // value only. the comment is kept.
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  conf_doc_set_items(doc, "general", "persistentmembers", values, 1);
+  check_text("set value", doc,
+      "; queue config\n"
+      "#include \"queues_custom.conf\"\n"
+      "\n"
+      "[general]\n"
+      "persistentmembers = no ; keep members\n"
+      ";--\n"
+      "[commented]\n"
+      "key = value\n"
+      "--;\n"
+      "\n"
+      "[sales](!)\n"
+      "strategy=ringall\n"
+      "member => SIP/100\n"
+      "member => SIP/200\n"
+      "; end of sales\n"
+      "\n"
+      "[support]\n"
+      "strategy = leastrecent\n"
+      "musicclass = default\n");
+  conf_doc_free(doc);
+
+  // same value makes no change
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  values[0] = "yes";
+  conf_doc_set_items(doc, "general", "persistentmembers", values, 1);
+  check_bool("set same value", conf_doc_get_changes(doc) == 0, true);
+  check_text("set same text", doc, g_base);
+  conf_doc_free(doc);
+
+  // multi values. reuse, then append after the last one.
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  conf_doc_set_items(doc, "sales", "member", values + 1, 3);
+  conf_doc_set_items(doc, "support", "member", values + 1, 1);
+  check_text("set multi values", doc,
+      "; queue config\n"
+      "#include \"queues_custom.conf\"\n"
+      "\n"
+      "[general]\n"
+      "persistentmembers = yes ; keep members\n"
+      ";--\n"
+      "[commented]\n"
+      "key = value\n"
+      "--;\n"
+      "\n"
+      "[sales](!)\n"
+      "strategy=ringall\n"
+      "member => SIP/300\n"
+      "member => SIP/400\n"
+      "member=SIP/500\n"
+      "; end of sales\n"
+      "\n"
+      "[support]\n"
+      "strategy = leastrecent\n"
+      "musicclass = default\n"
+      "member=SIP/300\n");
+  conf_doc_free(doc);
+
+  // less values remove the rest
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  conf_doc_set_items(doc, "sales", "member", values + 1, 1);
+  conf_doc_set_items(doc, "support", "musicclass", NULL, 0);
+  check_text("set remove values", doc,
+      "; queue config\n"
+      "#include \"queues_custom.conf\"\n"
+      "\n"
+      "[general]\n"
+      "persistentmembers = yes ; keep members\n"
+      ";--\n"
+      "[commented]\n"
+      "key = value\n"
+      "--;\n"
+      "\n"
+      "[sales](!)\n"
+      "strategy=ringall\n"
+      "member => SIP/300\n"
+      "; end of sales\n"
+      "\n"
+      "[support]\n"
+      "strategy = leastrecent\n");
+
+  check_bool("set no section", conf_doc_set_items(doc, "commented", "key", values, 1), false);
+  conf_doc_free(doc);
+}
+
+static void test_retain_replace(void)
+{
+  conf_doc* doc;
+  const char* keys[] = {"strategy", "timeout"};
+  const char* values[] = {"linear", "15"};
+
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  conf_doc_retain_keys(doc, "sales", keys, 1);
+  conf_doc_replace_items(doc, "support", keys, values, 2);
+  check_text("retain replace", doc,
+      "; queue config\n"
+      "#include \"queues_custom.conf\"\n"
+      "\n"
+      "[general]\n"
+      "persistentmembers = yes ; keep members\n"
+      ";--\n"
+      "[commented]\n"
+      "key = value\n"
+      "--;\n"
+      "\n"
+      "[sales](!)\n"
+      "strategy=ringall\n"
+      "; end of sales\n"
+      "\n"
+      "[support]\n"
+      "strategy = linear\n"
+      "timeout=15\n");
+  conf_doc_free(doc);
+}
+
+static void test_section(void)
+{
+  conf_doc* doc;
+  const char* values[] = {"ringall"};
+
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  conf_doc_delete_section(doc, "sales");
+  conf_doc_add_section(doc, "new");
+  conf_doc_set_items(doc, "new", "strategy", values, 1);
+  check_text("section add delete", doc,
+      "; queue config\n"
+      "#include \"queues_custom.conf\"\n"
+      "\n"
+      "[general]\n"
+      "persistentmembers = yes ; keep members\n"
+      ";--\n"
+      "[commented]\n"
+      "key = value\n"
+      "--;\n"
+      "\n"
+      "; end of sales\n"
+      "\n"
+      "[support]\n"
+      "strategy = leastrecent\n"
+      "musicclass = default\n"
+      "\n"
+      "[new]\n"
+      "strategy=ringall\n");
+  check_bool("section deleted", conf_doc_has_section(doc, "sales"), false);
+  check_bool("section delete none", conf_doc_delete_section(doc, "sales"), false);
+  conf_doc_free(doc);
+
+  // no line terminator at the end of the file
+  doc = conf_doc_parse("[a]\nk=v", 7);
+  conf_doc_set_items(doc, "a", "x", values, 1);
+  check_text("section no eol", doc, "[a]\nk=v\nx=ringall\n");
+  conf_doc_free(doc);
+
+  // crlf file
+  doc = conf_doc_parse("[a]\r\nk = v\r\n", 12);
+  values[0] = "w";
+  conf_doc_set_items(doc, "a", "k", values, 1);
+  conf_doc_add_section(doc, "b");
+  check_text("section crlf", doc, "[a]\r\nk = w\r\n\r\n[b]\r\n");
+  conf_doc_free(doc);
+
+  // same name sections
+  doc = conf_doc_parse("[a]\nk=1\n[b]\n[a]\nk=2\n", 20);
+  values[0] = "3";
+  conf_doc_set_items(doc, "a", "k", values, 1);
+  check_text("section same name", doc, "[a]\nk=3\n[b]\n[a]\n");
+  conf_doc_free(doc);
+
+  // wrong section name. the document is not changed.
+  doc = conf_doc_parse("[a]\nk=v\n", 8);
+  check_bool("section wrong name", conf_doc_add_section(doc, "b]"), false);
+  check_bool("section wrong name set", conf_doc_set_items(doc, "b]", "k", values, 1), false);
+  check_bool("section wrong name changes", conf_doc_get_changes(doc) == 0, true);
+  check_text("section wrong name text", doc, "[a]\nk=v\n");
+  conf_doc_free(doc);
+}
+
+/**
+ * The save should replace the file and should not leave the temp file.
+ */
+static void test_save(void)
+{
+  char dir[] = "/tmp/test_conf_doc.XXXXXX";
+  char* filename;
+  conf_doc* doc;
+  DIR* dp;
+  struct dirent* entry;
+  int count;
+
+  if(mkdtemp(dir) == NULL) {
+    printf("Fail. name[save mkdtemp]\n");
+    g_fail++;
+    return;
+  }
+  asprintf(&filename, "%s/queues.conf", dir);
+
+  doc = conf_doc_parse(g_base, strlen(g_base));
+  check_bool("save new", conf_doc_save(doc, filename), true);
+  conf_doc_free(doc);
+
+  doc = conf_doc_load(filename);
+  check_bool("save load", doc != NULL, true);
+  if(doc != NULL) {
+    check_text("save text", doc, g_base);
+    conf_doc_delete_section(doc, "support");
+    check_bool("save again", conf_doc_save(doc, filename), true);
+    conf_doc_free(doc);
+  }
+
+  count = 0;
+  dp = opendir(dir);
+  while((entry = readdir(dp)) != NULL) {
+    if(entry->d_name[0] == '.') {
+      continue;
+    }
+    count++;
+  }
+  closedir(dp);
+  check_bool("save no temp file", count == 1, true);
+
+  unlink(filename);
+  rmdir(dir);
+  free(filename);
+}
+
+int main(void)
+{
+  test_parse();
+  test_set_items();
+  test_retain_replace();
+  test_section();
+  test_save();
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+import common
+import json
+import os
+
+# The raw config text should be same with the json wrapped text,
+# and should be validated with the etag.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+url_base = "127.0.0.1:8081/v1/admin/dialplan/configurations/extensions.conf?authtoken=%s" % (admin_authtoken)
+
+
+def test_raw_same_with_json():
+    ret_code, ret_data = common.http_send(url_base, "GET", None)
+    if ret_code != 200:
+        print("Could not get config. code[%d]" % (ret_code))
+        return False
+    data = json.loads(ret_data)["result"]["data"]
+
+    ret_code, headers, body = common.http_send_headers(url_base + "&format=raw", "GET", None, None)
+    if ret_code != 200:
+        print("Could not get raw config. code[%d]" % (ret_code))
+        return False
+
+    if int(headers.get("content-length", -1)) != len(body):
+        print("Wrong content length. header[%s], body[%d]" % (headers.get("content-length"), len(body)))
+        return False
+
+    if body.decode("utf-8") != data:
+        print("The raw config is different.")
+        return False
+
+    return True
+
+
+def test_raw_not_modified():
+    ret_code, headers, body = common.http_send_headers(url_base + "&format=raw", "GET", None, None)
+    if (ret_code != 200) or ("etag" not in headers):
+        print("Could not get the etag. code[%d], headers[%s]" % (ret_code, headers))
+        return False
+
+    ret_code, headers, body = common.http_send_headers(url_base + "&format=raw", "GET", None, ["If-None-Match: %s" % (headers["etag"])])
+    if ret_code != 304:
+        print("Wrong code. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def test_raw_wrong_name():
+    url = "127.0.0.1:8081/v1/admin/dialplan/configurations/queues.conf?authtoken=%s&format=raw" % (admin_authtoken)
+    ret_code, headers, body = common.http_send_headers(url, "GET", None, None)
+    if ret_code != 404:
+        print("Wrong code. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_raw_same_with_json")
+ret = test_raw_same_with_json()
+if ret != True:
+    raise
+
+print("test_raw_not_modified")
+ret = test_raw_not_modified()
+if ret != True:
+    raise
+
+print("test_raw_wrong_name")
+ret = test_raw_wrong_name()
+if ret != True:
+    raise
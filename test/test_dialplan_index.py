@@ -0,0 +1,122 @@
+import common
+import json
+import os
+import time
+
+# The adps of the adpma from the dpma index should be same with
+# the adps from the database in the sequence order,
+# after every create, update and delete.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_list(url):
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get list. url[%s], code[%d]" % (url, ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]["list"]
+
+
+def send(url, method, j_data):
+    data = json.dumps(j_data) if j_data is not None else None
+    ret_code, ret_data = common.http_send(url, method, data)
+    if ret_code != 200:
+        print("Could not send request. url[%s], method[%s], code[%d]" % (url, method, ret_code))
+        return False
+
+    return True
+
+
+def get_adps_index(dpma_uuid):
+    url = "127.0.0.1:8081/v1/admin/dialplan/adps?authtoken=%s&dpma_uuid=%s" % (admin_authtoken, dpma_uuid)
+    return get_list(url)
+
+
+def get_adps_db(dpma_uuid):
+    url = "127.0.0.1:8081/v1/admin/dialplan/adps?authtoken=%s" % (admin_authtoken)
+    j_list = get_list(url)
+    if j_list is None:
+        return None
+
+    j_list = [j_adp for j_adp in j_list if j_adp["dpma_uuid"] == dpma_uuid]
+    return sorted(j_list, key=lambda j_adp: j_adp["sequence"])
+
+
+def is_consistent(dpma_uuid, sequences):
+    j_index = get_adps_index(dpma_uuid)
+    j_db = get_adps_db(dpma_uuid)
+    if (j_index is None) or (j_db is None):
+        return False
+
+    if j_index != j_db:
+        print("The index is different with the db. index[%s], db[%s]" % (j_index, j_db))
+        return False
+
+    if [j_adp["sequence"] for j_adp in j_index] != sequences:
+        print("Wrong sequences. res[%s], expect[%s]" % ([j_adp["sequence"] for j_adp in j_index], sequences))
+        return False
+
+    return True
+
+
+def create_adpma(name):
+    url = "127.0.0.1:8081/v1/admin/dialplan/adpmas?authtoken=%s" % (admin_authtoken)
+    if send(url, "POST", {"name": name}) != True:
+        return None
+
+    for j_dpma in get_list(url):
+        if j_dpma["name"] == name:
+            return j_dpma["uuid"]
+
+    return None
+
+
+def test_dpma_index():
+    dpma_uuid = create_adpma("test_dpma_index_%d" % (int(time.time())))
+    if dpma_uuid is None:
+        return False
+
+    url_adps = "127.0.0.1:8081/v1/admin/dialplan/adps?authtoken=%s" % (admin_authtoken)
+    url_adp = "127.0.0.1:8081/v1/admin/dialplan/adps/%s?authtoken=" + admin_authtoken
+    url_dpma = "127.0.0.1:8081/v1/admin/dialplan/adpmas/%s?authtoken=%s" % (dpma_uuid, admin_authtoken)
+
+    if is_consistent(dpma_uuid, []) != True:
+        return False
+
+    # create
+    for seq in [3, 1, 2]:
+        j_data = {"dpma_uuid": dpma_uuid, "sequence": seq, "name": "seq %d" % (seq), "command": "exec Playback demo-congrats"}
+        if send(url_adps, "POST", j_data) != True:
+            return False
+    if is_consistent(dpma_uuid, [1, 2, 3]) != True:
+        return False
+
+    # update
+    j_adps = get_adps_index(dpma_uuid)
+    if send(url_adp % (j_adps[0]["uuid"]), "PUT", {"dpma_uuid": dpma_uuid, "sequence": 5}) != True:
+        return False
+    if is_consistent(dpma_uuid, [2, 3, 5]) != True:
+        return False
+
+    # delete
+    for j_adp in get_adps_index(dpma_uuid):
+        if send(url_adp % (j_adp["uuid"]), "DELETE", None) != True:
+            return False
+    if is_consistent(dpma_uuid, []) != True:
+        return False
+
+    if send(url_dpma, "DELETE", None) != True:
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_dpma_index")
+ret = test_dpma_index()
+if ret != True:
+    raise
@@ -0,0 +1,123 @@
+/*
+ * test_http_page.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Cursor pagination parameter test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "http_page.h"
+
+static int g_fail = 0;
+
+static void check_limit(const char* name, const char* str, int expect)
+{
+  int ret;
+
+  ret = http_page_parse_limit(str);
+  if(ret != expect) {
+    printf("Fail. name[%s], limit[%s], expect[%d], result[%d]\n", name, str? : "(null)", expect, ret);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void check_cursor_invalid(const char* name, const char* str)
+{
+  char* tmp;
+
+  tmp = http_page_parse_cursor(str);
+  if(tmp != NULL) {
+    printf("Fail. name[%s], cursor[%s], result[%s]\n", name, str, tmp);
+    free(tmp);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+/**
+ * The parsed cursor should be same as the original key.
+ */
+static void check_cursor_roundtrip(const char* name, const char* key)
+{
+  char* cursor;
+  char* tmp;
+
+  cursor = http_page_create_cursor(key);
+  tmp = http_page_parse_cursor(cursor);
+  if((tmp == NULL) || (strcmp(tmp, key) != 0)) {
+    printf("Fail. name[%s], key[%s], cursor[%s], result[%s]\n", name, key, cursor, tmp? : "(null)");
+    g_fail++;
+  }
+  else {
+    printf("Pass. name[%s]\n", name);
+  }
+
+  free(cursor);
+  free(tmp);
+}
+
+static void test_limit(void)
+{
+  check_limit("limit", "10", 10);
+  check_limit("limit one", "1", 1);
+  check_limit("limit max", "1000", DEF_HTTP_PAGE_LIMIT_MAX);
+  check_limit("limit clamp", "1001", DEF_HTTP_PAGE_LIMIT_MAX);
+  check_limit("limit overflow", "99999999999999999999", DEF_HTTP_PAGE_LIMIT_MAX);
+
+  check_limit("limit null", NULL, -1);
+  check_limit("limit empty", "", -1);
+  check_limit("limit zero", "0", -1);
+  check_limit("limit negative", "-1", -1);
+  check_limit("limit plus", "+10", -1);
+  check_limit("limit space", " 10", -1);
+  check_limit("limit garbage", "10a", -1);
+}
+
+static void test_cursor(void)
+{
+  char* tmp;
+
+  tmp = http_page_create_cursor("ab");
+  if(strcmp(tmp, "6162") != 0) {
+    printf("Fail. name[cursor create], result[%s]\n", tmp);
+    g_fail++;
+  }
+  else {
+    printf("Pass. name[cursor create]\n");
+  }
+  free(tmp);
+
+  check_cursor_roundtrip("cursor uuid", "1a9b8f64-2f6c-4d5e-8a3b-0c1d2e3f4a5b");
+  check_cursor_roundtrip("cursor channel", "1508922338.16");
+  check_cursor_roundtrip("cursor special", "a' or '1'='1\"; -- /?&=%");
+  check_cursor_roundtrip("cursor utf8", "\xec\x95\x88\xeb\x85\x95");
+
+  check_cursor_invalid("cursor null", NULL);
+  check_cursor_invalid("cursor empty", "");
+  check_cursor_invalid("cursor odd", "616");
+  check_cursor_invalid("cursor not hex", "6g");
+  check_cursor_invalid("cursor upper", "6A");
+  check_cursor_invalid("cursor null char", "6100");
+}
+
+int main(void)
+{
+  test_limit();
+  test_cursor();
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * test_http_range.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Range request and validator test.
+ *  The etag test uses a file in the temp spool directory.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "http_range.h"
+
+static int g_fail = 0;
+
+/**
+ * Check the parse result.
+ * @param expect: expected ranges string. ex) "0-99,200-299". Empty if no range.
+ */
+static void check_range(const char* name, const char* str, off_t size, int expect_ret, const char* expect)
+{
+  http_range ranges[DEF_HTTP_RANGE_MAX];
+  char res[1024];
+  int ret;
+  int len;
+  int i;
+
+  ret = http_range_parse(str, size, ranges, DEF_HTTP_RANGE_MAX);
+
+  res[0] = '\0';
+  len = 0;
+  for(i = 0; i < ret; i++) {
+    len += snprintf(res + len, sizeof(res) - len, "%s%lld-%lld", (i == 0)? "" : ",", (long long)ranges[i].start, (long long)ranges[i].end);
+  }
+
+  if((ret != expect_ret) || (strcmp(res, expect) != 0)) {
+    printf("Fail. name[%s], range[%s], size[%lld], expect[%d:%s], result[%d:%s]\n", name, str, (long long)size, expect_ret, expect, ret, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void check_bool(const char* name, bool res, bool expect)
+{
+  if(res != expect) {
+    printf("Fail. name[%s], expect[%d], result[%d]\n", name, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void test_range(void)
+{
+  // single
+  check_range("first", "bytes=0-0", 100, 1, "0-0");
+  check_range("middle", "bytes=10-19", 100, 1, "10-19");
+  check_range("open end", "bytes=90-", 100, 1, "90-99");
+  check_range("end over size", "bytes=90-200", 100, 1, "90-99");
+  check_range("suffix", "bytes=-10", 100, 1, "90-99");
+  check_range("suffix over size", "bytes=-200", 100, 1, "0-99");
+  check_range("whole", "bytes=0-", 100, 1, "0-99");
+  check_range("last byte", "bytes=99-99", 100, 1, "99-99");
+  check_range("spaces", " bytes = 0-9 , 20-29 ", 100, 2, "0-9,20-29");
+  check_range("unit case", "Bytes=0-9", 100, 1, "0-9");
+
+  // multi
+  check_range("multi", "bytes=0-9,50-59", 100, 2, "0-9,50-59");
+  check_range("multi sorted", "bytes=50-59,0-9", 100, 2, "0-9,50-59");
+  check_range("multi overlap", "bytes=0-49,40-59", 100, 1, "0-59");
+  check_range("multi adjacent", "bytes=0-9,10-19", 100, 1, "0-19");
+  check_range("multi suffix", "bytes=0-9,-10", 100, 2, "0-9,90-99");
+  check_range("multi partly unsatisfiable", "bytes=0-9,200-300", 100, 1, "0-9");
+  check_range("multi empty element", "bytes=0-9,,20-29,", 100, 2, "0-9,20-29");
+
+  // unsatisfiable. 416
+  check_range("start over size", "bytes=100-", 100, -1, "");
+  check_range("start over size 2", "bytes=100-200", 100, -1, "");
+  check_range("suffix zero", "bytes=-0", 100, -1, "");
+  check_range("empty file", "bytes=0-", 0, -1, "");
+  check_range("empty file suffix", "bytes=-10", 0, -1, "");
+  check_range("multi unsatisfiable", "bytes=100-,200-300", 100, -1, "");
+
+  // ignored. 200
+  check_range("unknown unit", "items=0-9", 100, 0, "");
+  check_range("no equal", "bytes 0-9", 100, 0, "");
+  check_range("no spec", "bytes=", 100, 0, "");
+  check_range("no dash", "bytes=10", 100, 0, "");
+  check_range("no pos", "bytes=-", 100, 0, "");
+  check_range("reversed", "bytes=20-10", 100, 0, "");
+  check_range("reversed in multi", "bytes=0-9,20-10", 100, 0, "");
+  check_range("negative", "bytes=--10", 100, 0, "");
+  check_range("garbage", "bytes=0-9x", 100, 0, "");
+  check_range("overflow", "bytes=0-99999999999999999999999", 100, 0, "");
+  check_range("too many", "bytes=0-0,2-2,4-4,6-6,8-8,10-10,12-12,14-14,16-16,18-18,20-20,22-22,24-24,26-26,28-28,30-30,32-32", 100, 0, "");
+}
+
+static void test_etag(void)
+{
+  check_bool("etag same", http_range_is_etag_match("\"abc\"", "\"abc\"", false), true);
+  check_bool("etag differ", http_range_is_etag_match("\"abc\"", "\"abd\"", false), false);
+  check_bool("etag list", http_range_is_etag_match("\"x\", \"abc\"", "\"abc\"", true), true);
+  check_bool("etag star", http_range_is_etag_match("*", "\"abc\"", true), true);
+  check_bool("etag weak compare", http_range_is_etag_match("W/\"abc\"", "\"abc\"", true), true);
+  check_bool("etag strong compare", http_range_is_etag_match("W/\"abc\"", "\"abc\"", false), false);
+  check_bool("etag unquoted", http_range_is_etag_match("abc", "\"abc\"", true), false);
+  check_bool("etag prefix", http_range_is_etag_match("\"ab\"", "\"abc\"", true), false);
+}
+
+static void test_date(void)
+{
+  char* tmp;
+
+  tmp = http_range_create_date(784111777);
+  check_bool("date create", (strcmp(tmp, "Sun, 06 Nov 1994 08:49:37 GMT") == 0)? true : false, true);
+  free(tmp);
+
+  check_bool("date parse", (http_range_parse_date("Sun, 06 Nov 1994 08:49:37 GMT") == 784111777)? true : false, true);
+  check_bool("date parse invalid", (http_range_parse_date("yesterday") == -1)? true : false, true);
+}
+
+/**
+ * The etag should be changed when the file is changed.
+ */
+static void test_etag_file(void)
+{
+  char dirname[] = "/tmp/test_http_range_XXXXXX";
+  char* filename;
+  struct stat sb;
+  char* etag_1;
+  char* etag_2;
+  char* etag_3;
+  FILE* fp;
+
+  if(mkdtemp(dirname) == NULL) {
+    printf("Fail. name[etag file], Could not create temp directory.\n");
+    g_fail++;
+    return;
+  }
+  asprintf(&filename, "%s/msg0000.wav", dirname);
+
+  fp = fopen(filename, "w");
+  fputs("0123456789", fp);
+  fclose(fp);
+  stat(filename, &sb);
+  etag_1 = http_range_create_etag(sb.st_size, sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+
+  // same file
+  stat(filename, &sb);
+  etag_2 = http_range_create_etag(sb.st_size, sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+  check_bool("etag file same", (strcmp(etag_1, etag_2) == 0)? true : false, true);
+
+  // changed file. different size
+  fp = fopen(filename, "a");
+  fputs("0123456789", fp);
+  fclose(fp);
+  stat(filename, &sb);
+  etag_3 = http_range_create_etag(sb.st_size, sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+  check_bool("etag file changed", (strcmp(etag_1, etag_3) != 0)? true : false, true);
+  check_bool("etag file if-none-match", http_range_is_etag_match(etag_1, etag_3, true), false);
+
+  free(etag_1);
+  free(etag_2);
+  free(etag_3);
+
+  unlink(filename);
+  rmdir(dirname);
+  free(filename);
+}
+
+int main(void)
+{
+  test_range();
+  test_etag();
+  test_date();
+  test_etag_file();
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+import common
+import json
+import os
+
+# Cursor pagination test of the list requests.
+# The request with limit or cursor is paged. The default page size is 100, and the max is 1000.
+# The request without them gets the whole list, which is streamed batch by batch.
+# The paged items should be same as the whole list in the order of the key.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+DEF_LIMIT_DEFAULT = 100
+DEF_LIMIT_MAX = 1000
+
+lists = [
+    ("admin/core/channels", "unique_id"),
+    ("admin/core/modules", "name"),
+    ("admin/core/systems", "id"),
+    ("admin/queue/members", "id"),
+    ("admin/queue/queues", "name"),
+    ("admin/queue/entries", "unique_id"),
+    ("admin/park/parkinglots", "name"),
+    ("admin/park/parkedcalls", "parkee_unique_id"),
+    ("admin/pjsip/endpoints", "object_name"),
+    ("admin/pjsip/aors", "object_name"),
+    ("admin/pjsip/auths", "object_name"),
+    ("admin/pjsip/contacts", "uri"),
+    ("admin/pjsip/registration_outbounds", "object_name"),
+    ("admin/dialplan/adpmas", "uuid"),
+    ("admin/dialplan/adps", "uuid"),
+    ("admin/user/users", "uuid"),
+    ("admin/user/contacts", "uuid"),
+    ("admin/user/permissions", "uuid"),
+    ("manager/users", "uuid"),
+    ("agent/agents", "id"),
+    ("voicemail/users", "id"),
+    ("ob/destinations", "uuid"),
+    ("ob/plans", "uuid"),
+    ("ob/campaigns", "uuid"),
+    ("ob/dlmas", "uuid"),
+    ("ob/dialings", "uuid"),
+]
+
+
+def get_list(uri, params):
+    url = "127.0.0.1:8081/v1/%s?authtoken=%s%s" % (uri, admin_authtoken, params)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        return ret_code, None
+
+    return ret_code, json.loads(ret_data)["result"]
+
+
+def get_pages(uri, limit):
+    res = []
+    params = "&limit=%d" % (limit)
+    while True:
+        ret_code, j_res = get_list(uri, params)
+        if ret_code != 200:
+            print("Could not get the page. uri[%s], code[%d]" % (uri, ret_code))
+            return None
+
+        if len(j_res["list"]) > limit:
+            print("Wrong page size. uri[%s], size[%d]" % (uri, len(j_res["list"])))
+            return None
+        res += j_res["list"]
+
+        if j_res["next_cursor"] is None:
+            break
+        params = "&limit=%d&cursor=%s" % (limit, j_res["next_cursor"])
+
+    return res
+
+
+def test_list_whole():
+    for uri, key in lists:
+        ret_code, j_res = get_list(uri, "")
+        if ret_code != 200:
+            print("Could not get the list. uri[%s], code[%d]" % (uri, ret_code))
+            return False
+
+        if "next_cursor" in j_res:
+            print("The whole list should not have the cursor. uri[%s]" % (uri))
+            return False
+
+        # the bigger limit is clamped.
+        ret_code, j_res = get_list(uri, "&limit=%d" % (DEF_LIMIT_MAX * 10))
+        if ret_code != 200:
+            print("Could not get the list. uri[%s], code[%d]" % (uri, ret_code))
+            return False
+
+        if len(j_res["list"]) > DEF_LIMIT_MAX:
+            print("Wrong max page size. uri[%s], size[%d]" % (uri, len(j_res["list"])))
+            return False
+
+    return True
+
+
+def test_list_default_limit():
+    for uri, key in lists:
+        ret_code, j_res = get_list(uri, "")
+        if ret_code != 200:
+            return False
+        count = len(j_res["list"])
+
+        # cursor only request has the default page size.
+        if count == 0:
+            continue
+        # "01": the cursor of "\x01". lower than any key.
+        ret_code, j_res = get_list(uri, "&cursor=01")
+        if ret_code != 200:
+            print("Could not get the page. uri[%s], code[%d]" % (uri, ret_code))
+            return False
+
+        if len(j_res["list"]) != min(count, DEF_LIMIT_DEFAULT):
+            print("Wrong default page size. uri[%s], size[%d], count[%d]" % (uri, len(j_res["list"]), count))
+            return False
+
+        if (count > DEF_LIMIT_DEFAULT) != (j_res["next_cursor"] is not None):
+            print("Wrong next_cursor. uri[%s], count[%d]" % (uri, count))
+            return False
+
+    return True
+
+
+def test_list_pages():
+    for uri, key in lists:
+        ret_code, j_res = get_list(uri, "")
+        if ret_code != 200:
+            return False
+        expect = sorted([item[key] for item in j_res["list"]])
+
+        for limit in [1, 2, DEF_LIMIT_DEFAULT, DEF_LIMIT_MAX]:
+            j_items = get_pages(uri, limit)
+            if j_items is None:
+                return False
+
+            keys = [item[key] for item in j_items]
+            if keys != expect:
+                print("Wrong page items. uri[%s], limit[%d], keys[%s], expect[%s]" % (uri, limit, keys, expect))
+                return False
+
+    return True
+
+
+def test_list_wrong_param():
+    for params in ["&limit=0", "&limit=-1", "&limit=abc", "&cursor=xyz", "&cursor=616"]:
+        for uri, key in lists:
+            ret_code, j_res = get_list(uri, params)
+            if ret_code != 400:
+                print("Wrong result code. uri[%s], params[%s], code[%d]" % (uri, params, ret_code))
+                return False
+
+    return True
+
+
+#### Test
+
+
+print("test_list_whole")
+ret = test_list_whole()
+if ret != True:
+    raise
+
+print("test_list_default_limit")
+ret = test_list_default_limit()
+if ret != True:
+    raise
+
+print("test_list_pages")
+ret = test_list_pages()
+if ret != True:
+    raise
+
+print("test_list_wrong_param")
+ret = test_list_wrong_param()
+if ret != True:
+    raise
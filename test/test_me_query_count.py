@@ -0,0 +1,229 @@
+import common
+import json
+import os
+import time
+
+# The /me list requests should not issue the queries per item.
+# Seeds N and 2N items and checks the count of queries does not grow
+# with the count of items.
+DEF_SEED_COUNT = 10
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+me_authtoken = os.environ.get("JADE_ME_AUTHTOKEN", "")
+
+
+def get_result(url):
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get result. url[%s], code[%d]" % (url, ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def get_list(url):
+    '''
+    Get the whole list. Follows the next_cursor of the paged list.
+    '''
+    res = []
+    params = ""
+    while True:
+        j_res = get_result(url + params)
+        if j_res is None:
+            return None
+
+        if not isinstance(j_res, dict):
+            return j_res
+        res += j_res["list"]
+
+        if j_res.get("next_cursor") is None:
+            return res
+        params = "&cursor=%s" % (j_res["next_cursor"])
+
+
+def send(url, method, j_data):
+    data = json.dumps(j_data) if j_data is not None else None
+    ret_code, ret_data = common.http_send(url, method, data)
+    if ret_code != 200:
+        print("Could not send request. url[%s], method[%s], code[%d]" % (url, method, ret_code))
+        return False
+
+    return True
+
+
+def get_resource_stats():
+    url = "127.0.0.1:8081/v1/admin/resource/stats?authtoken=%s" % (admin_authtoken)
+    return get_result(url)
+
+
+def get_query_count(path, key):
+    '''
+    Get the given /me list and return the count of items and queries it made.
+    '''
+    j_before = get_resource_stats()
+    if j_before is None:
+        return None
+
+    url = "127.0.0.1:8081/v1/me/%s?authtoken=%s" % (path, me_authtoken)
+    j_list = get_list(url)
+    if j_list is None:
+        return None
+
+    j_after = get_resource_stats()
+    if j_after is None:
+        return None
+
+    count = j_after[key] - j_before[key]
+    print("Query count. path[%s], items[%d], %s[%d]" % (path, len(j_list), key, count))
+    return (len(j_list), count)
+
+
+def check_query_count(path, key, seed):
+    '''
+    Seed the items twice and check the count of queries stays flat.
+    '''
+    ret = seed(DEF_SEED_COUNT)
+    if ret != True:
+        return False
+
+    res_n = get_query_count(path, key)
+    if res_n is None:
+        return False
+
+    ret = seed(DEF_SEED_COUNT)
+    if ret != True:
+        return False
+
+    res_2n = get_query_count(path, key)
+    if res_2n is None:
+        return False
+
+    if res_2n[0] < res_n[0] + DEF_SEED_COUNT:
+        print("The items were not seeded. path[%s], n[%d], 2n[%d]" % (path, res_n[0], res_2n[0]))
+        return False
+
+    if res_2n[1] > res_n[1]:
+        print("The queries grow with the items. path[%s], %s n[%d], 2n[%d]" % (path, key, res_n[1], res_2n[1]))
+        return False
+
+    return True
+
+
+def get_me_uuid():
+    url = "127.0.0.1:8081/v1/me/info?authtoken=%s" % (me_authtoken)
+    j_res = get_result(url)
+    if j_res is None:
+        return None
+
+    return j_res["uuid"]
+
+
+def create_user():
+    '''
+    Create the user and return the uuid of it.
+    '''
+    username = "query-count-%f" % (time.time())
+    url = "127.0.0.1:8081/v1/admin/user/users?authtoken=%s" % (admin_authtoken)
+    if send(url, "POST", {"username": username, "password": username, "name": username}) != True:
+        return None
+
+    for j_user in get_list(url):
+        if j_user["username"] == username:
+            return j_user["uuid"]
+
+    return None
+
+
+def seed_users(count):
+    j_uuids = []
+    for i in range(count):
+        uuid = create_user()
+        if uuid is None:
+            return None
+        j_uuids.append(uuid)
+
+    return j_uuids
+
+
+def seed_buddies(count):
+    j_uuids = seed_users(count)
+    if j_uuids is None:
+        return False
+
+    url = "127.0.0.1:8081/v1/me/buddies?authtoken=%s" % (me_authtoken)
+    for uuid in j_uuids:
+        if send(url, "POST", {"uuid_user": uuid}) != True:
+            return False
+
+    return True
+
+
+def seed_chats(count):
+    j_uuids = seed_users(count)
+    if j_uuids is None:
+        return False
+
+    url = "127.0.0.1:8081/v1/me/chats?authtoken=%s" % (me_authtoken)
+    for uuid in j_uuids:
+        j_data = {"name": "query count", "detail": "query count", "type": 1, "members": [uuid]}
+        if send(url, "POST", j_data) != True:
+            return False
+
+    return True
+
+
+def seed_contacts(count):
+    me_uuid = get_me_uuid()
+    if me_uuid is None:
+        return False
+
+    # the contact's target should be the existing endpoint.
+    url = "127.0.0.1:8081/v1/admin/pjsip/endpoints?authtoken=%s" % (admin_authtoken)
+    j_endpoints = get_list(url)
+    if (j_endpoints is None) or (len(j_endpoints) == 0):
+        print("Could not get the endpoint for the contact target.")
+        return False
+    target = j_endpoints[0]["object_name"]
+
+    url = "127.0.0.1:8081/v1/admin/user/contacts?authtoken=%s" % (admin_authtoken)
+    for i in range(count):
+        j_data = {"user_uuid": me_uuid, "target": target, "name": "query count %d" % (i)}
+        if send(url, "POST", j_data) != True:
+            return False
+
+    return True
+
+
+def test_me_chats_query_count():
+    return check_query_count("chats", "file_query_count", seed_chats)
+
+
+def test_me_buddies_query_count():
+    return check_query_count("buddies", "file_query_count", seed_buddies)
+
+
+def test_me_contacts_query_count():
+    ret = check_query_count("contacts", "file_query_count", seed_contacts)
+    if ret != True:
+        return False
+
+    return check_query_count("contacts", "memory_query_count", seed_contacts)
+
+
+#### Test
+
+
+print("test_me_chats_query_count")
+ret = test_me_chats_query_count()
+if ret != True:
+    raise
+
+print("test_me_buddies_query_count")
+ret = test_me_buddies_query_count()
+if ret != True:
+    raise
+
+print("test_me_contacts_query_count")
+ret = test_me_contacts_query_count()
+if ret != True:
+    raise
@@ -0,0 +1,122 @@
+import common
+import json
+import os
+import time
+
+# The pjsip config changes in the delay should be coalesced
+# into one res_pjsip reload.
+# The test adds the aor sections to the jade.pjsip.aor.conf.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_reload_status():
+    url = "127.0.0.1:8081/v1/admin/core/reloads?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get reload status. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def create_aor(name):
+    url = "127.0.0.1:8081/v1/admin/pjsip/batch?authtoken=%s" % (admin_authtoken)
+    j_data = {"aors": [{"name": name, "data": {"max_contacts": "1"}}]}
+    ret_code, ret_data = common.http_send(url, "POST", json.dumps(j_data))
+    if ret_code != 200:
+        print("Could not create aor. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def get_pending(j_status, name):
+    for j_pending in j_status["pendings"]:
+        if j_pending["name"] == name:
+            return j_pending
+    return None
+
+
+def test_reload_coalesce():
+    j_status = get_reload_status()
+    if j_status is None:
+        return False
+    sent = j_status["sent"]
+
+    for i in range(5):
+        if create_aor("reload-%d-%d" % (int(time.time()), i)) != True:
+            return False
+
+    j_status = get_reload_status()
+    j_pending = get_pending(j_status, "res_pjsip")
+    if (j_pending is None) or (j_pending["requests"] < 5):
+        print("Wrong pending reload. status[%s]" % (j_status))
+        return False
+
+    # wait the delay
+    time.sleep(j_status["delay"] / 1000000.0 + 1)
+
+    j_status = get_reload_status()
+    if get_pending(j_status, "res_pjsip") is not None:
+        print("The reload is still pending. status[%s]" % (j_status))
+        return False
+
+    if j_status["sent"] != sent + 1:
+        print("Wrong sent count. before[%d], after[%d]" % (sent, j_status["sent"]))
+        return False
+
+    return True
+
+
+def reload_module(name):
+    url = "127.0.0.1:8081/v1/admin/core/modules/%s?authtoken=%s" % (name, admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "PUT", None)
+    if ret_code != 200:
+        print("Could not reload the module. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def test_reload_drops_pending():
+    if create_aor("reload-%d" % (int(time.time()))) != True:
+        return False
+
+    j_status = get_reload_status()
+    if get_pending(j_status, "res_pjsip") is None:
+        print("Could not find the pending reload. status[%s]" % (j_status))
+        return False
+    sent = j_status["sent"]
+
+    # the reload of the .so name drops the pending reload of the module.
+    if reload_module("res_pjsip.so") != True:
+        return False
+
+    j_status = get_reload_status()
+    if get_pending(j_status, "res_pjsip") is not None:
+        print("The reload is still pending. status[%s]" % (j_status))
+        return False
+
+    time.sleep(j_status["delay"] / 1000000.0 + 1)
+
+    j_status = get_reload_status()
+    if j_status["sent"] != sent:
+        print("The dropped reload was sent. before[%d], after[%d]" % (sent, j_status["sent"]))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_reload_coalesce")
+ret = test_reload_coalesce()
+if ret != True:
+    raise
+
+print("test_reload_drops_pending")
+ret = test_reload_drops_pending()
+if ret != True:
+    raise
@@ -0,0 +1,234 @@
+/*
+ * test_ob_result.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Outbound result sink test.
+ *  Checks the flush, size rotation and retention of the result file.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <event2/event.h>
+#include <jansson.h>
+
+#include "common.h"
+#include "config.h"
+#include "ob_result_handler.h"
+
+#define DEF_TEST_DIR  "/tmp/jade_test_ob_result"
+#define DEF_TEST_FILE DEF_TEST_DIR "/outbound_result.json"
+
+app* g_app = NULL;
+db_ctx_t* g_db_memory = NULL;
+
+static app g_test_app;
+static int g_fail = 0;
+
+/**
+ * Stands for the shared config getter.
+ * The test sets the ob section values directly.
+ */
+const char* config_get_value(const char* section, const char* key)
+{
+  return json_string_value(json_object_get(json_object_get(g_app->j_conf, section), key));
+}
+
+long long config_get_value_number(const char* section, const char* key, long long min)
+{
+  const char* tmp_const;
+  long long ret;
+
+  tmp_const = config_get_value(section, key);
+  if(tmp_const == NULL) {
+    return min;
+  }
+
+  ret = strtoll(tmp_const, NULL, 10);
+  if(ret < min) {
+    return min;
+  }
+
+  return ret;
+}
+
+static void check_int(const char* name, long long res, long long expect)
+{
+  if(res != expect) {
+    printf("Fail. name[%s], expect[%lld], result[%lld]\n", name, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static long long get_file_size(const char* filename)
+{
+  struct stat st;
+  int ret;
+
+  ret = stat(filename, &st);
+  if(ret != 0) {
+    return -1;
+  }
+
+  return st.st_size;
+}
+
+static void clear_files(void)
+{
+  char* filename;
+  int idx;
+
+  unlink(DEF_TEST_FILE);
+  for(idx = 1; idx < 10; idx++) {
+    asprintf(&filename, "%s.%d", DEF_TEST_FILE, idx);
+    unlink(filename);
+    free(filename);
+  }
+}
+
+static void set_conf(const char* flush_size, const char* rotate_size, const char* retention)
+{
+  json_t* j_ob;
+
+  j_ob = json_pack("{s:s, s:s, s:s, s:s, s:s, s:s}",
+      "dialing_result_filename",        DEF_TEST_FILE,
+      "dialing_result_flush_size",      flush_size,
+      "dialing_result_flush_interval",  "1000000",
+      "dialing_result_rotate_size",     rotate_size,
+      "dialing_result_rotate_daily",    "0",
+      "dialing_result_retention",       retention
+      );
+  json_object_set_new(g_app->j_conf, "ob", j_ob);
+}
+
+/**
+ * Writes one result. Each result line is 23 bytes.
+ * {"uuid": "result-000"}\n
+ * @param idx
+ */
+static void write_result(int idx)
+{
+  json_t* j_res;
+  char* uuid;
+
+  asprintf(&uuid, "result-%03d", idx);
+  j_res = json_pack("{s:s}", "uuid", uuid);
+  ob_result_write(j_res);
+  json_decref(j_res);
+  free(uuid);
+}
+
+static void test_flush(void)
+{
+  int i;
+
+  clear_files();
+  set_conf("1000", "0", "7");
+  ob_result_init_handler();
+
+  // kept in the buffer until the flush size
+  write_result(1);
+  check_int("flush pending", get_file_size(DEF_TEST_FILE), 0);
+
+  ob_result_flush();
+  check_int("flush written", get_file_size(DEF_TEST_FILE), 23);
+
+  // reached the flush size
+  for(i = 0; i < 50; i++) {
+    write_result(i);
+  }
+  check_int("flush size", get_file_size(DEF_TEST_FILE) >= 1000, 1);
+
+  // the pending results are written on term
+  write_result(51);
+  ob_result_term_handler();
+  check_int("flush term", get_file_size(DEF_TEST_FILE), 23 * 52);
+}
+
+static void test_rotate(void)
+{
+  clear_files();
+  set_conf("0", "50", "7");
+  ob_result_init_handler();
+
+  write_result(1);
+  write_result(2);
+  check_int("rotate not yet", get_file_size(DEF_TEST_FILE ".1"), -1);
+
+  // 69 bytes exceeds the rotate size
+  write_result(3);
+  check_int("rotate size", get_file_size(DEF_TEST_FILE ".1"), 46);
+  check_int("rotate new", get_file_size(DEF_TEST_FILE), 23);
+
+  write_result(4);
+  write_result(5);
+  check_int("rotate shift", get_file_size(DEF_TEST_FILE ".2"), 46);
+  check_int("rotate shift new", get_file_size(DEF_TEST_FILE ".1"), 46);
+
+  ob_result_term_handler();
+}
+
+static void test_retention(void)
+{
+  int i;
+
+  clear_files();
+  set_conf("0", "20", "2");
+  ob_result_init_handler();
+
+  // every write rotates the previous one
+  for(i = 0; i < 5; i++) {
+    write_result(i);
+  }
+  check_int("retention current", get_file_size(DEF_TEST_FILE), 23);
+  check_int("retention 1", get_file_size(DEF_TEST_FILE ".1"), 23);
+  check_int("retention 2", get_file_size(DEF_TEST_FILE ".2"), 23);
+  check_int("retention 3", get_file_size(DEF_TEST_FILE ".3"), -1);
+  ob_result_term_handler();
+
+  // no retention removes the old one
+  clear_files();
+  set_conf("0", "20", "0");
+  ob_result_init_handler();
+
+  write_result(1);
+  write_result(2);
+  check_int("retention none", get_file_size(DEF_TEST_FILE), 23);
+  check_int("retention none 1", get_file_size(DEF_TEST_FILE ".1"), -1);
+  ob_result_term_handler();
+}
+
+int main(void)
+{
+  mkdir(DEF_TEST_DIR, 0755);
+
+  g_test_app.j_conf = json_object();
+  g_test_app.evt_base = event_base_new();
+  g_app = &g_test_app;
+
+  test_flush();
+  test_rotate();
+  test_retention();
+
+  clear_files();
+  rmdir(DEF_TEST_DIR);
+
+  event_base_free(g_test_app.evt_base);
+  json_decref(g_test_app.j_conf);
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+  printf("All passed.\n");
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * test_ob_schedule.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Campaign schedule calculation test.
+ *  Evaluates the transitions with fixed timestamps, so doesn't need to wait.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ob_schedule.h"
+
+static int g_fail = 0;
+
+static void check_transition(const char* name, const ob_schedule* sc, time_t t, time_t expect)
+{
+  time_t res;
+
+  res = ob_schedule_get_next_transition(sc, t);
+  if(res != expect) {
+    printf("Fail. name[%s], now[%ld], expect[%ld], result[%ld]\n", name, (long)t, (long)expect, (long)res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void check_open(const char* name, const ob_schedule* sc, time_t t, int expect)
+{
+  int res;
+
+  res = ob_schedule_is_open(sc, t);
+  if(res != expect) {
+    printf("Fail. name[%s], now[%ld], expect[%d], result[%d]\n", name, (long)t, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+int main(void)
+{
+  ob_schedule sc;
+  int i;
+  const char* zones[] = {
+      "America/New_York", "America/Chicago", "America/Denver", "America/Los_Angeles",
+      "America/Sao_Paulo", "Europe/London", "Europe/Berlin", "Europe/Paris",
+      "Europe/Moscow", "Africa/Cairo", "Asia/Dubai", "Asia/Kolkata",
+      "Asia/Shanghai", "Asia/Seoul", "Asia/Tokyo", "Australia/Sydney",
+      "Pacific/Auckland", "Pacific/Honolulu", "UTC", ""
+  };
+
+  // New York business hours. Weekdays 09:00:00 ~ 17:00:00.
+  memset(&sc, 0x00, sizeof(sc));
+  sc.time_start = "09:00:00";
+  sc.time_end = "17:00:00";
+  sc.day_list = "1, 2, 3, 4, 5";
+  sc.timezone = "America/New_York";
+
+  // 2026-03-06 Fri 22:00:00 UTC(17:00 EST). Still open. Closes at 17:00:01 EST.
+  check_open("ny end time inclusive", &sc, 1772834400, 1);
+  check_transition("ny close", &sc, 1772834400, 1772834401);
+
+  // 2026-03-06 Fri 23:00:00 UTC. Closed over the weekend and DST starts on 2026-03-08.
+  // Opens 2026-03-09 Mon 09:00 EDT = 13:00 UTC.
+  check_open("ny weekend closed", &sc, 1772838000, 0);
+  check_transition("ny open after dst start", &sc, 1772838000, 1773061200);
+
+  // 2026-10-30 Fri 21:00:01 UTC(17:00:01 EDT). DST ends on 2026-11-01.
+  // Opens 2026-11-02 Mon 09:00 EST = 14:00 UTC.
+  check_transition("ny open after dst end", &sc, 1793394001, 1793628000);
+
+  // Whole day schedule on the DST start day.
+  // 2026-03-08 has only 23 hours in New York, closes at 2026-03-09 00:00 EDT = 04:00 UTC.
+  memset(&sc, 0x00, sizeof(sc));
+  sc.date_list = "2026-03-08";
+  sc.date_start = "2026-03-09";
+  sc.date_end = "2026-03-01";
+  sc.timezone = "America/New_York";
+  check_open("ny date list", &sc, 1772960400, 1);
+  check_transition("ny date list close", &sc, 1772960400, 1773028800);
+
+  // Berlin. Start time is in the skipped hour. 2026-03-29 02:00 ~ 03:00 CET doesn't exist.
+  memset(&sc, 0x00, sizeof(sc));
+  sc.time_start = "02:30:00";
+  sc.time_end = "04:00:00";
+  sc.timezone = "Europe/Berlin";
+
+  // 2026-03-28 Sat 12:00:00 UTC. Opens at 2026-03-29 03:00 CEST(01:00 UTC) which is right after the gap.
+  check_transition("berlin open in dst gap", &sc, 1774699200, 1774746000);
+
+  // 2026-03-29 01:00:00 UTC(03:00 CEST). Closes at 04:00:01 CEST = 02:00:01 UTC.
+  check_open("berlin open after gap", &sc, 1774746000, 1);
+  check_transition("berlin close after gap", &sc, 1774746000, 1774749601);
+
+  // No timezone. UTC.
+  memset(&sc, 0x00, sizeof(sc));
+  sc.date_start = "2026-10-20";
+  sc.date_end = "2026-10-21";
+
+  // 2026-10-19 00:00:00 UTC. Opens at 2026-10-20 00:00 UTC, closes at 2026-10-22 00:00 UTC.
+  check_transition("utc open", &sc, 1792368000, 1792454400);
+  check_transition("utc close", &sc, 1792454400, 1792627200);
+
+  // 2026-10-22 00:00:00 UTC. Never opens again.
+  check_transition("utc no more transition", &sc, 1792627200, -1);
+
+  // More time zones than the cached offset periods.
+  // The evicted time zone is loaded again.
+  memset(&sc, 0x00, sizeof(sc));
+  sc.time_start = "09:00:00";
+  sc.time_end = "17:00:00";
+  for(i = 0; i < (int)(sizeof(zones) / sizeof(zones[0])); i++) {
+    sc.timezone = zones[i];
+    ob_schedule_is_open(&sc, 1772834400);
+  }
+  sc.day_list = "1, 2, 3, 4, 5";
+  sc.timezone = "America/New_York";
+  check_transition("ny open after evicted", &sc, 1772838000, 1773061200);
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
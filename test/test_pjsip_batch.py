@@ -0,0 +1,99 @@
+import common
+import json
+import os
+import time
+
+# The pjsip batch should create the valid items at once
+# and should report the invalid items without stopping the others.
+# The test adds the sections to the jade.pjsip.*.conf files.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def post_batch(j_data):
+    url = "127.0.0.1:8081/v1/admin/pjsip/batch?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "POST", json.dumps(j_data))
+    if ret_code != 200:
+        print("Could not post batch. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def get_results(j_res, key):
+    return dict([(item["name"], item["result"]) for item in j_res[key]])
+
+
+def test_batch_create():
+    name = "batch-%d" % (int(time.time()))
+    j_data = {
+        "aors": [
+            {"name": name, "data": {"max_contacts": "1"}},
+            {"name": name, "data": {"max_contacts": "1"}},
+        ],
+        "auths": [
+            {"name": name, "data": {"auth_type": "userpass", "username": name, "password": name}},
+        ],
+        "endpoints": [
+            {"name": name, "data": {"aors": name, "auth": name, "context": "demo"}},
+            {"name": name + "-noaor", "data": {"aors": name + "-noaor"}},
+            {"name": name + "[bad]", "data": {}},
+        ],
+        "identifies": [
+            {"name": name, "data": {"endpoint": name, "match": "127.0.0.1"}},
+        ],
+    }
+
+    j_res = post_batch(j_data)
+    if j_res is None:
+        return False
+
+    # the second aor is duplicated
+    if [item["result"] for item in j_res["aors"]] != [True, False]:
+        print("Wrong aor results. res[%s]" % (j_res["aors"]))
+        return False
+
+    j_endpoints = get_results(j_res, "endpoints")
+    if j_endpoints != {name: True, name + "-noaor": False, name + "[bad]": False}:
+        print("Wrong endpoint results. res[%s]" % (j_res["endpoints"]))
+        return False
+
+    if get_results(j_res, "identifies") != {name: True}:
+        print("Wrong identify results. res[%s]" % (j_res["identifies"]))
+        return False
+
+    if (j_res["created"] != 4) or (j_res["failed"] != 3) or (j_res["reloaded"] != True):
+        print("Wrong counts. res[%s]" % (j_res))
+        return False
+
+    # already exist
+    j_res = post_batch({"auths": j_data["auths"]})
+    if (j_res is None) or (j_res["created"] != 0) or (j_res["reloaded"] != False):
+        print("The existing auth should fail. res[%s]" % (j_res))
+        return False
+
+    return True
+
+
+def test_batch_wrong_input():
+    url = "127.0.0.1:8081/v1/admin/pjsip/batch?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "POST", json.dumps({"aors": "wrong"}))
+    if ret_code != 400:
+        print("Wrong code. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_batch_create")
+ret = test_batch_create()
+if ret != True:
+    raise
+
+print("test_batch_wrong_input")
+ret = test_batch_wrong_input()
+if ret != True:
+    raise
@@ -0,0 +1,57 @@
+import common
+import json
+import os
+import time
+
+# The pjsip reload should keep the current objects visible
+# until the new snapshot is complete.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_endpoint_names():
+    url = "127.0.0.1:8081/v1/admin/pjsip/endpoints?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get endpoints. code[%d]" % (ret_code))
+        return None
+
+    return sorted([item["object_name"] for item in json.loads(ret_data)["result"]["list"]])
+
+
+def reload_pjsip():
+    url = "127.0.0.1:8081/v1/admin/core/modules/res_pjsip.so?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "PUT", None)
+    if ret_code != 200:
+        print("Could not reload the module. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def test_reload_keeps_endpoints():
+    names = get_endpoint_names()
+    if names is None:
+        return False
+
+    if reload_pjsip() != True:
+        return False
+
+    # the endpoints should not vanish during the reload
+    for i in range(30):
+        res = get_endpoint_names()
+        if res != names:
+            print("The endpoints have been changed during the reload. res[%s], expect[%s]" % (res, names))
+            return False
+        time.sleep(0.1)
+
+    return True
+
+
+#### Test
+
+
+print("test_reload_keeps_endpoints")
+ret = test_reload_keeps_endpoints()
+if ret != True:
+    raise
@@ -0,0 +1,125 @@
+import common
+import json
+import os
+import time
+
+# The pjsip endpoint detail sync should keep the in flight requests
+# under the concurrency, and should skip the unchanged endpoints.
+# Run the fake_ami.py as the AMI server to measure the sync time
+# of the big endpoint list.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_sync_status():
+    url = "127.0.0.1:8081/v1/admin/pjsip/sync?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get sync status. code[%d]" % (ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]
+
+
+def reload_pjsip():
+    url = "127.0.0.1:8081/v1/admin/core/modules/res_pjsip.so?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "PUT", None)
+    if ret_code != 200:
+        print("Could not reload the module. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def wait_sync():
+    '''
+    Reload the pjsip and wait until the sync is complete.
+    @return: status, max in flight.
+    '''
+    j_status = get_sync_status()
+    if j_status is None:
+        return None, 0
+    rounds = j_status["rounds"]
+
+    if reload_pjsip() != True:
+        return None, 0
+
+    max_in_flight = 0
+    for i in range(600):
+        time.sleep(0.1)
+        j_status = get_sync_status()
+        if j_status is None:
+            return None, 0
+
+        max_in_flight = max(max_in_flight, j_status["in_flight"])
+        if j_status["rounds"] > rounds:
+            return j_status, max_in_flight
+
+    print("The sync is not complete. status[%s]" % (j_status))
+    return None, 0
+
+
+def test_sync_status():
+    j_status = get_sync_status()
+    if j_status is None:
+        return False
+
+    for key in ["concurrency", "timeout", "skip_unchanged", "running", "queued", "in_flight", "elapsed", "rounds",
+                "endpoints", "skipped", "sent", "completed", "timeouts", "failed"]:
+        if key not in j_status:
+            print("Could not find the key. key[%s]" % (key))
+            return False
+
+    return True
+
+
+def test_sync_concurrency():
+    j_status, max_in_flight = wait_sync()
+    if j_status is None:
+        return False
+
+    if max_in_flight > j_status["concurrency"]:
+        print("Too many in flight requests. max[%d], concurrency[%d]" % (max_in_flight, j_status["concurrency"]))
+        return False
+
+    if j_status["sent"] + j_status["skipped"] + j_status["failed"] != j_status["endpoints"]:
+        print("Wrong sync count. status[%s]" % (j_status))
+        return False
+
+    print("Sync time. endpoints[%d], sent[%d], skipped[%d], elapsed[%f]" % (j_status["endpoints"], j_status["sent"], j_status["skipped"], j_status["elapsed"]))
+    return True
+
+
+def test_sync_skip_unchanged():
+    j_status, max_in_flight = wait_sync()
+    if j_status is None:
+        return False
+
+    if j_status["skip_unchanged"] != True:
+        return True
+
+    # nothing has been changed since the last sync
+    if j_status["skipped"] != j_status["endpoints"]:
+        print("The unchanged endpoints are not skipped. status[%s]" % (j_status))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_sync_status")
+ret = test_sync_status()
+if ret != True:
+    raise
+
+print("test_sync_concurrency")
+ret = test_sync_concurrency()
+if ret != True:
+    raise
+
+print("test_sync_skip_unchanged")
+ret = test_sync_skip_unchanged()
+if ret != True:
+    raise
@@ -0,0 +1,103 @@
+import common
+import json
+import os
+
+# queue member status. ast_header.h
+AST_DEVICE_NOT_INUSE = 1
+AST_DEVICE_INUSE = 2
+AST_DEVICE_BUSY = 3
+AST_DEVICE_RINGING = 6
+AST_DEVICE_RINGINUSE = 7
+AST_DEVICE_ONHOLD = 8
+
+authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+
+
+def get_list(path):
+    url = "127.0.0.1:8081/v1/admin/queue/%s?authtoken=%s" % (path, authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get list. path[%s], code[%d]" % (path, ret_code))
+        return None
+
+    return json.loads(ret_data)["result"]["list"]
+
+
+def check_queue_stat_data_types(j_stat):
+    if j_stat["name"] == None or isinstance(j_stat["name"], unicode) != True:
+        print("Type error. name. type[%s]" % type(j_stat["name"]))
+        return False
+
+    for key in ["ready", "paused", "in_use", "total"]:
+        if isinstance(j_stat[key], int) != True:
+            print("Type error. %s. type[%s]" % (key, type(j_stat[key])))
+            return False
+
+    if isinstance(j_stat["service_level_perf"], float) != True:
+        print("Type error. service_level_perf. type[%s]" % type(j_stat["service_level_perf"]))
+        return False
+
+    return True
+
+
+def test_queue_stats_consistency():
+    '''
+    The queue stats are maintained by the events.
+    Compare them with the counts from the queue_member and queue_param tables.
+    '''
+    j_stats = get_list("stats")
+    j_members = get_list("members")
+    j_queues = get_list("queues")
+    if j_stats is None or j_members is None or j_queues is None:
+        return False
+
+    # count from the tables
+    counts = {}
+    for j_member in j_members:
+        count = counts.setdefault(j_member["queue_name"], {"ready": 0, "paused": 0, "in_use": 0, "total": 0})
+        count["total"] += 1
+        if j_member["paused"] != 0:
+            count["paused"] += 1
+        if j_member["status"] == AST_DEVICE_NOT_INUSE and j_member["paused"] == 0:
+            count["ready"] += 1
+        if j_member["status"] in [AST_DEVICE_INUSE, AST_DEVICE_BUSY, AST_DEVICE_RINGING, AST_DEVICE_RINGINUSE, AST_DEVICE_ONHOLD]:
+            count["in_use"] += 1
+
+    perfs = {}
+    for j_queue in j_queues:
+        perfs[j_queue["name"]] = j_queue["service_level_perf"]
+
+    for j_stat in j_stats:
+        ret = check_queue_stat_data_types(j_stat)
+        if ret != True:
+            return False
+
+        name = j_stat["name"]
+        count = counts.get(name, {"ready": 0, "paused": 0, "in_use": 0, "total": 0})
+        for key in ["ready", "paused", "in_use", "total"]:
+            if j_stat[key] != count[key]:
+                print("Count mismatch. queue[%s], key[%s], stat[%d], table[%d]" % (name, key, j_stat[key], count[key]))
+                return False
+
+        if name in perfs and j_stat["service_level_perf"] != perfs[name]:
+            print("Perf mismatch. queue[%s], stat[%f], table[%f]" % (name, j_stat["service_level_perf"], perfs[name]))
+            return False
+
+    # every queue which has member should have stat
+    names = [j_stat["name"] for j_stat in j_stats]
+    for name in counts:
+        if name not in names:
+            print("No stat for the queue. queue[%s]" % name)
+            return False
+
+    print("Finished test_queue_stats_consistency.")
+    return True
+
+
+#### Test
+
+
+print("test_queue_stats")
+ret = test_queue_stats_consistency()
+if ret != True:
+    raise
@@ -0,0 +1,235 @@
+/*
+ * test_session_index.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  Session user and group index test.
+ *  Follows the websocket session's life cycle.
+ *  connect(set user, join groups), userroom create/delete and destroy.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "session_index.h"
+
+#define DEF_TEST_MAX_MEMBER   16
+
+static int g_fail = 0;
+
+/**
+ * Stands for the websocket client session.
+ */
+struct test_session {
+  const char* name;
+};
+
+struct test_members {
+  int count;
+  const char* names[DEF_TEST_MAX_MEMBER];
+};
+
+static void check_int(const char* name, int res, int expect)
+{
+  if(res != expect) {
+    printf("Fail. name[%s], expect[%d], result[%d]\n", name, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void cb_collect(void* session, void* data)
+{
+  struct test_members* members;
+
+  members = data;
+  if(members->count < DEF_TEST_MAX_MEMBER) {
+    members->names[members->count] = ((struct test_session*)session)->name;
+  }
+  members->count++;
+}
+
+static int compare_name(const void* e1, const void* e2)
+{
+  return strcmp(*(const char* const*)e1, *(const char* const*)e2);
+}
+
+/**
+ * Check the member sessions of the group. expect: sorted, comma separated names.
+ */
+static void check_members(const char* name, const session_index* idx, const char* group, const char* expect)
+{
+  struct test_members members;
+  char res[1024];
+  int ret;
+  int i;
+
+  memset(&members, 0, sizeof(members));
+  ret = session_index_foreach_group(idx, group, cb_collect, &members);
+  if(ret != members.count) {
+    printf("Fail. name[%s], wrong return. ret[%d], count[%d]\n", name, ret, members.count);
+    g_fail++;
+    return;
+  }
+
+  qsort(members.names, members.count, sizeof(const char*), compare_name);
+  res[0] = '\0';
+  for(i = 0; i < members.count; i++) {
+    if(i != 0) {
+      strcat(res, ",");
+    }
+    strcat(res, members.names[i]);
+  }
+
+  if(strcmp(res, expect) != 0) {
+    printf("Fail. name[%s], group[%s], expect[%s], result[%s]\n", name, group, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+/**
+ * Connected session sets its user and joins the user's groups.
+ */
+static void connect_session(session_index* idx, struct test_session* session, const char* uuid_user, const char* const* groups, int count)
+{
+  int i;
+
+  session_index_set_user(idx, session, uuid_user);
+  for(i = 0; i < count; i++) {
+    session_index_join_group(idx, session, groups[i]);
+  }
+}
+
+static void test_connect(void)
+{
+  session_index* idx;
+  struct test_session a1 = {"a1"};
+  struct test_session a2 = {"a2"};
+  struct test_session b1 = {"b1"};
+  const char* groups_a[] = {"/me/chats/room-1", "/me/chats/room-2"};
+  const char* groups_b[] = {"/me/chats/room-1"};
+
+  idx = session_index_create();
+
+  connect_session(idx, &a1, "user-a", groups_a, 2);
+  connect_session(idx, &a2, "user-a", groups_a, 2);
+  connect_session(idx, &b1, "user-b", groups_b, 1);
+
+  check_int("connect users", session_index_get_user_count(idx), 2);
+  check_int("connect groups", session_index_get_group_count(idx), 2);
+  check_members("connect room-1", idx, "/me/chats/room-1", "a1,a2,b1");
+  check_members("connect room-2", idx, "/me/chats/room-2", "a1,a2");
+  check_members("connect no group", idx, "/me/chats/room-3", "");
+
+  // join again does nothing
+  session_index_join_group(idx, &a1, "/me/chats/room-1");
+  check_members("connect join again", idx, "/me/chats/room-1", "a1,a2,b1");
+
+  session_index_destroy(idx);
+}
+
+static void test_destroy(void)
+{
+  session_index* idx;
+  struct test_session a1 = {"a1"};
+  struct test_session a2 = {"a2"};
+  struct test_session b1 = {"b1"};
+  const char* groups_a[] = {"/me/chats/room-1", "/me/chats/room-2"};
+  const char* groups_b[] = {"/me/chats/room-1"};
+
+  idx = session_index_create();
+
+  connect_session(idx, &a1, "user-a", groups_a, 2);
+  connect_session(idx, &a2, "user-a", groups_a, 2);
+  connect_session(idx, &b1, "user-b", groups_b, 1);
+
+  // a1 leaves all of its groups. user-a still has a2.
+  session_index_remove_session(idx, &a1);
+  check_members("destroy a1 room-1", idx, "/me/chats/room-1", "a2,b1");
+  check_members("destroy a1 room-2", idx, "/me/chats/room-2", "a2");
+  check_int("destroy a1 is member", session_index_is_member(idx, &a1, "/me/chats/room-1"), 0);
+  check_int("destroy a1 users", session_index_get_user_count(idx), 2);
+
+  // the last session of user-a. room-2 has no more member.
+  session_index_remove_session(idx, &a2);
+  check_members("destroy a2 room-1", idx, "/me/chats/room-1", "b1");
+  check_members("destroy a2 room-2", idx, "/me/chats/room-2", "");
+  check_int("destroy a2 users", session_index_get_user_count(idx), 1);
+  check_int("destroy a2 groups", session_index_get_group_count(idx), 1);
+
+  // the user-a's new room is not joined by anyone.
+  check_int("destroy a2 join user", session_index_join_group_user(idx, "user-a", "/me/chats/room-3"), 0);
+  check_int("destroy a2 join user groups", session_index_get_group_count(idx), 1);
+
+  session_index_remove_session(idx, &b1);
+  check_int("destroy all users", session_index_get_user_count(idx), 0);
+  check_int("destroy all groups", session_index_get_group_count(idx), 0);
+
+  // remove again does nothing
+  session_index_remove_session(idx, &b1);
+
+  session_index_destroy(idx);
+}
+
+static void test_userroom(void)
+{
+  session_index* idx;
+  struct test_session a1 = {"a1"};
+  struct test_session a2 = {"a2"};
+  struct test_session b1 = {"b1"};
+  const char* groups_a[] = {"/me/chats/room-1"};
+  const char* groups_b[] = {"/me/chats/room-1"};
+
+  idx = session_index_create();
+
+  connect_session(idx, &a1, "user-a", groups_a, 1);
+  connect_session(idx, &a2, "user-a", groups_a, 1);
+  connect_session(idx, &b1, "user-b", groups_b, 1);
+
+  // userroom create. all of the user-a's sessions join.
+  check_int("userroom create", session_index_join_group_user(idx, "user-a", "/me/chats/room-2"), 2);
+  check_members("userroom create room-2", idx, "/me/chats/room-2", "a1,a2");
+  check_int("userroom create b1", session_index_is_member(idx, &b1, "/me/chats/room-2"), 0);
+
+  // userroom create of the offline user.
+  check_int("userroom create offline", session_index_join_group_user(idx, "user-c", "/me/chats/room-2"), 0);
+  check_members("userroom create offline room-2", idx, "/me/chats/room-2", "a1,a2");
+
+  // userroom delete. only the user-a's sessions leave.
+  check_int("userroom delete", session_index_leave_group_user(idx, "user-a", "/me/chats/room-1"), 2);
+  check_members("userroom delete room-1", idx, "/me/chats/room-1", "b1");
+  check_members("userroom delete room-2", idx, "/me/chats/room-2", "a1,a2");
+
+  // userroom delete of the last member removes the group.
+  session_index_leave_group_user(idx, "user-b", "/me/chats/room-1");
+  check_members("userroom delete last", idx, "/me/chats/room-1", "");
+  check_int("userroom delete last groups", session_index_get_group_count(idx), 1);
+
+  // the moved session leaves the old user's groups by userroom delete no more.
+  session_index_set_user(idx, &a2, "user-b");
+  session_index_leave_group_user(idx, "user-a", "/me/chats/room-2");
+  check_members("userroom moved session", idx, "/me/chats/room-2", "a2");
+
+  session_index_destroy(idx);
+}
+
+int main(int argc, char** argv)
+{
+  test_connect();
+  test_destroy();
+  test_userroom();
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+import common
+import json
+import os
+import time
+import zmq
+
+# The sip reload should not delete nor republish the unchanged peers,
+# and should delete the removed peers after the new peer list is complete.
+# Run the fake_ami.py as the AMI server. Each chan_sip reload of it
+# removes the last sip peer, and the next one restores it.
+
+admin_authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+zmq_addr = os.environ.get("JADE_ZMQ_ADDR", "tcp://127.0.0.1:8082")
+
+
+def reload_sip():
+    url = "127.0.0.1:8081/v1/admin/core/modules/chan_sip.so?authtoken=%s" % (admin_authtoken)
+    ret_code, ret_data = common.http_send(url, "PUT", None)
+    if ret_code != 200:
+        print("Could not reload the module. code[%d]" % (ret_code))
+        return False
+
+    return True
+
+
+def recv_peer_events(sock, wait_sec):
+    '''
+    Receive the sip peer events for the given seconds.
+    @return: list of (event name, peer).
+    '''
+    res = []
+    end = time.time() + wait_sec
+    while time.time() < end:
+        if sock.poll(100) == 0:
+            continue
+
+        topic, data = sock.recv_multipart()
+        for event, j_data in json.loads(data).items():
+            res.append((event, j_data["peer"]))
+
+    return res
+
+
+def test_reload_keeps_peers():
+    ctx = zmq.Context()
+    sock = ctx.socket(zmq.SUB)
+    sock.connect(zmq_addr)
+    sock.setsockopt(zmq.SUBSCRIBE, "/sip/statuses/")
+    time.sleep(0.5)
+
+    # removes the last peer and restores it. The order depends on the fake's state.
+    events = []
+    for i in range(2):
+        if reload_sip() != True:
+            sock.close()
+            ctx.term()
+            return False
+        events += recv_peer_events(sock, 3)
+    sock.close()
+    ctx.term()
+
+    deletes = [peer for event, peer in events if event == "sip.peer.delete"]
+    creates = [peer for event, peer in events if event == "sip.peer.create"]
+    updates = [peer for event, peer in events if event == "sip.peer.update"]
+
+    # the unchanged peers should not be republished
+    if len(updates) != 0:
+        print("The unchanged peers have been updated. peers[%s]" % (updates))
+        return False
+
+    # the removed peer should be swept, and created again when it's back
+    if (len(deletes) != 1) or (deletes != creates):
+        print("Wrong sweep events. deletes[%s], creates[%s]" % (deletes, creates))
+        return False
+
+    return True
+
+
+#### Test
+
+
+print("test_reload_keeps_peers")
+ret = test_reload_keeps_peers()
+if ret != True:
+    raise
@@ -0,0 +1,212 @@
+/*
+ * test_user_search.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pchero
+ *
+ *  User search index test.
+ *  Compares the index result with the brute force search,
+ *  and measures the build and the search time with 20k and 100k users.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "user_search.h"
+
+#define DEF_TEST_MAX_RESULT   20
+
+static int g_fail = 0;
+
+static const char* g_first_names[] = {"James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda", "David", "Elizabeth", "Sungtae", "Jiwoo"};
+static const char* g_last_names[] = {"Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Kim", "Lee", "Park", "Choi"};
+
+static double get_elapsed(const struct timespec* start)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + ((now.tv_nsec - start->tv_nsec) / 1000000000.0);
+}
+
+static void check_count(const char* name, int res, int expect)
+{
+  if(res != expect) {
+    printf("Fail. name[%s], expect[%d], result[%d]\n", name, expect, res);
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void check_first(const char* name, const user_search* idx, const char* query, const char* expect)
+{
+  const char* res[DEF_TEST_MAX_RESULT];
+  int cnt;
+
+  cnt = user_search_find(idx, query, res, DEF_TEST_MAX_RESULT);
+  if((cnt == 0) || (strcmp(res[0], expect) != 0)) {
+    printf("Fail. name[%s], query[%s], expect[%s], result[%s]\n", name, query, expect, (cnt > 0)? res[0] : "");
+    g_fail++;
+    return;
+  }
+  printf("Pass. name[%s]\n", name);
+}
+
+static void test_basic(void)
+{
+  user_search* idx;
+  const char* res[DEF_TEST_MAX_RESULT];
+  const char* fields[3];
+
+  idx = user_search_create();
+
+  fields[0] = "agent100";
+  fields[1] = "Alice Kim";
+  fields[2] = "100";
+  user_search_set(idx, "uuid-100", fields, 3);
+
+  fields[0] = "agent1000";
+  fields[1] = "Bob Lee";
+  fields[2] = "1000";
+  user_search_set(idx, "uuid-1000", fields, 3);
+
+  fields[0] = "supervisor";
+  fields[1] = "Carol Agent";
+  fields[2] = NULL;
+  user_search_set(idx, "uuid-sup", fields, 3);
+
+  check_count("count", user_search_get_count(idx), 3);
+  check_count("prefix", user_search_find(idx, "agent", res, DEF_TEST_MAX_RESULT), 3);
+  check_count("case insensitive", user_search_find(idx, "ALICE", res, DEF_TEST_MAX_RESULT), 1);
+  check_count("substring", user_search_find(idx, "kim", res, DEF_TEST_MAX_RESULT), 1);
+  check_count("extension", user_search_find(idx, "100", res, DEF_TEST_MAX_RESULT), 2);
+  check_count("short", user_search_find(idx, "b", res, DEF_TEST_MAX_RESULT), 1);
+  check_count("not cross field", user_search_find(idx, "100\nalice", res, DEF_TEST_MAX_RESULT), 0);
+  check_count("not cross field gram", user_search_find(idx, "0al", res, DEF_TEST_MAX_RESULT), 0);
+  check_count("no match", user_search_find(idx, "zzz", res, DEF_TEST_MAX_RESULT), 0);
+  check_count("limit", user_search_find(idx, "agent", res, 2), 2);
+
+  // prefix matches come first.
+  check_first("prefix first", idx, "agent", "uuid-100");
+
+  // update
+  fields[0] = "agent100";
+  fields[1] = "Alice Park";
+  fields[2] = "100";
+  user_search_set(idx, "uuid-100", fields, 3);
+  check_count("update count", user_search_get_count(idx), 3);
+  check_count("update old", user_search_find(idx, "kim", res, DEF_TEST_MAX_RESULT), 0);
+  check_count("update new", user_search_find(idx, "park", res, DEF_TEST_MAX_RESULT), 1);
+
+  // remove
+  user_search_remove(idx, "uuid-1000");
+  check_count("remove count", user_search_get_count(idx), 2);
+  check_count("remove", user_search_find(idx, "bob", res, DEF_TEST_MAX_RESULT), 0);
+  check_count("remove extension", user_search_find(idx, "100", res, DEF_TEST_MAX_RESULT), 1);
+
+  user_search_destroy(idx);
+}
+
+/**
+ * Compare the index result count with the brute force search.
+ */
+static int brute_force_count(char** texts, int count, const char* query)
+{
+  int res;
+  int i;
+
+  res = 0;
+  for(i = 0; i < count; i++) {
+    if(strcasestr(texts[i], query) != NULL) {
+      res++;
+    }
+  }
+
+  return res;
+}
+
+static void test_bench(int count)
+{
+  static const char* queries[] = {"a", "ki", "jam", "smith", "user1234", "55", "ohnson", "zzz"};
+  user_search* idx;
+  const char** res;
+  const char* fields[3];
+  struct timespec start;
+  char** texts;
+  char uuid[64];
+  char username[64];
+  char name[128];
+  char exten[32];
+  char test_name[128];
+  double elapsed;
+  int expect;
+  int cnt;
+  int loop;
+  int i;
+  int j;
+
+  texts = calloc(count, sizeof(char*));
+  res = calloc(count, sizeof(char*));
+
+  idx = user_search_create();
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0; i < count; i++) {
+    snprintf(uuid, sizeof(uuid), "uuid-%d", i);
+    snprintf(username, sizeof(username), "user%d", i);
+    snprintf(name, sizeof(name), "%s %s", g_first_names[i % 12], g_last_names[(i / 12) % 12]);
+    snprintf(exten, sizeof(exten), "%d", 10000 + i);
+
+    fields[0] = username;
+    fields[1] = name;
+    fields[2] = exten;
+    user_search_set(idx, uuid, fields, 3);
+
+    asprintf(&texts[i], "%s\n%s\n%s", username, name, exten);
+  }
+  elapsed = get_elapsed(&start);
+  printf("Bench. users[%d], build[%.3f sec]\n", count, elapsed);
+
+  for(i = 0; i < (int)(sizeof(queries) / sizeof(queries[0])); i++) {
+    // no false positive and negative
+    expect = brute_force_count(texts, count, queries[i]);
+    cnt = user_search_find(idx, queries[i], res, count);
+    snprintf(test_name, sizeof(test_name), "bench %d %s", count, queries[i]);
+    check_count(test_name, cnt, expect);
+
+    loop = 1000;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(j = 0; j < loop; j++) {
+      user_search_find(idx, queries[i], res, DEF_TEST_MAX_RESULT);
+    }
+    elapsed = get_elapsed(&start);
+    printf("Bench. users[%d], query[%s], matches[%d], avg[%.2f usec]\n", count, queries[i], expect, (elapsed / loop) * 1000000);
+  }
+
+  user_search_destroy(idx);
+  for(i = 0; i < count; i++) {
+    free(texts[i]);
+  }
+  free(texts);
+  free(res);
+}
+
+int main(void)
+{
+  test_basic();
+
+  test_bench(20000);
+  test_bench(100000);
+
+  if(g_fail != 0) {
+    printf("Failed. count[%d]\n", g_fail);
+    return 1;
+  }
+
+  return 0;
+}
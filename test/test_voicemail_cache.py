@@ -0,0 +1,92 @@
+import common
+import json
+import os
+import shutil
+import time
+
+# Cache test of the voicemail list.
+# The changed message should be shown in the next list,
+# with or without the inotify of the backend.
+# Creates a temp mailbox in the voicemail spool directory of the backend.
+
+authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+vm_directory = os.environ.get("JADE_VM_DIRECTORY", "/var/spool/asterisk/voicemail")
+
+context = "jade-test-cache-%d" % (os.getpid())
+mailbox = "1000"
+directory = "%s/%s/%s/INBOX" % (vm_directory, context, mailbox)
+
+
+def write_message(msgname, duration):
+    f = open("%s/%s.txt" % (directory, msgname), "w")
+    f.write("[message]\norigmailbox=1000\nduration=%d\n" % (duration))
+    f.close()
+
+
+def create_spool():
+    os.makedirs(directory)
+    write_message("msg0000", 7)
+
+
+def remove_spool():
+    shutil.rmtree("%s/%s" % (vm_directory, context), True)
+
+
+def get_vms():
+    url = "127.0.0.1:8081/v1/voicemail/vms?context=%s&mailbox=%s&authtoken=%s" % (context, mailbox, authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get vms. code[%d]" % (ret_code))
+        return None
+
+    return dict([(item["msgname"], item["duration"]) for item in json.loads(ret_data)["result"]["list"]])
+
+
+def check_vms(name, expect):
+    res = get_vms()
+    if res != expect:
+        print("Wrong vms. name[%s], vms[%s], expect[%s]" % (name, res, expect))
+        return False
+
+    return True
+
+
+def test_vm_cache():
+    # the second one comes from the cache
+    if check_vms("first", {"msg0000": "7"}) != True:
+        return False
+    if check_vms("cached", {"msg0000": "7"}) != True:
+        return False
+
+    # wait for the coarse mtime resolution
+    time.sleep(1.1)
+
+    # edit the message in place. The directory is not changed.
+    write_message("msg0000", 9)
+    if check_vms("edited", {"msg0000": "9"}) != True:
+        return False
+
+    # add a message
+    write_message("msg0001", 3)
+    if check_vms("added", {"msg0000": "9", "msg0001": "3"}) != True:
+        return False
+
+    # delete a message
+    os.remove("%s/msg0000.txt" % (directory))
+    if check_vms("deleted", {"msg0001": "3"}) != True:
+        return False
+
+    return True
+
+
+#### Test
+
+
+create_spool()
+try:
+    print("test_vm_cache")
+    ret = test_vm_cache()
+    if ret != True:
+        raise
+finally:
+    remove_spool()
@@ -0,0 +1,113 @@
+import common
+import json
+import os
+import shutil
+
+# Message info test of the voicemail list.
+# The message txt files are parsed with the ini_gets() semantics.
+# Creates a temp mailbox in the voicemail spool directory of the backend.
+
+authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+vm_directory = os.environ.get("JADE_VM_DIRECTORY", "/var/spool/asterisk/voicemail")
+
+context = "jade-test-info-%d" % (os.getpid())
+mailbox = "1000"
+
+messages = {
+    # repeated key takes the first one. keys are case insensitive.
+    "msg0000": (
+        ";\n"
+        "; Message Information file\n"
+        ";\n"
+        "[message]\n"
+        "origmailbox=1000\n"
+        "CallerID=\"test\" <2000>\n"
+        "callerid=\"repeated\" <3000>\n"
+        "duration = 7 ; trailing comment\n"
+        "[message]\n"
+        "flag=urgent\n"
+    ),
+
+    # keys out of the [message] are ignored.
+    "msg0001": (
+        "[other]\n"
+        "exten=9999\n"
+        "[message]\n"
+        "exten=1000\n"
+    ),
+}
+
+
+def create_spool():
+    directory = "%s/%s/%s/INBOX" % (vm_directory, context, mailbox)
+    os.makedirs(directory)
+
+    for msgname, data in messages.items():
+        f = open("%s/%s.txt" % (directory, msgname), "w")
+        f.write(data)
+        f.close()
+
+    # unreadable message file
+    os.makedirs("%s/msg0002.txt" % (directory))
+
+
+def remove_spool():
+    shutil.rmtree("%s/%s" % (vm_directory, context), True)
+
+
+def get_vms():
+    url = "127.0.0.1:8081/v1/voicemail/vms?context=%s&mailbox=%s&authtoken=%s" % (context, mailbox, authtoken)
+    ret_code, ret_data = common.http_send(url, "GET", None)
+    if ret_code != 200:
+        print("Could not get vms. code[%d]" % (ret_code))
+        return None
+
+    return dict([(item["msgname"], item) for item in json.loads(ret_data)["result"]["list"]])
+
+
+def check(name, j_vm, key, expect):
+    if j_vm[key] != expect:
+        print("Wrong value. name[%s], key[%s], value[%s], expect[%s]" % (name, key, j_vm[key], expect))
+        return False
+
+    return True
+
+
+def test_vm_info():
+    j_vms = get_vms()
+    if j_vms is None:
+        return False
+
+    if sorted(j_vms.keys()) != ["msg0000", "msg0001", "msg0002"]:
+        print("Wrong messages. msgnames[%s]" % (j_vms.keys()))
+        return False
+
+    j_vm = j_vms["msg0000"]
+    if check("first", j_vm, "callerid", "\"test\" <2000>") != True:
+        return False
+    if check("comment", j_vm, "duration", "7") != True:
+        return False
+    if check("second section", j_vm, "flag", "") != True:
+        return False
+
+    if check("other section", j_vms["msg0001"], "exten", "1000") != True:
+        return False
+
+    # unreadable file has empty items.
+    if check("unreadable", j_vms["msg0002"], "origmailbox", "") != True:
+        return False
+
+    return True
+
+
+#### Test
+
+
+create_spool()
+try:
+    print("test_vm_info")
+    ret = test_vm_info()
+    if ret != True:
+        raise
+finally:
+    remove_spool()
@@ -0,0 +1,230 @@
+import common
+import os
+import shutil
+import time
+
+# Range and conditional request test for the voicemail download.
+# Creates a temp mailbox in the voicemail spool directory of the backend.
+
+authtoken = os.environ.get("JADE_AUTHTOKEN", "")
+vm_directory = os.environ.get("JADE_VM_DIRECTORY", "/var/spool/asterisk/voicemail")
+
+context = "jade-test-range-%d" % (os.getpid())
+mailbox = "1000"
+msgname = "msg0000"
+data = "".join([chr(i % 256) for i in range(1000)])
+
+
+def create_spool():
+    directory = "%s/%s/%s/INBOX" % (vm_directory, context, mailbox)
+    os.makedirs(directory)
+
+    f = open("%s/%s.wav" % (directory, msgname), "wb")
+    f.write(data)
+    f.close()
+
+
+def remove_spool():
+    shutil.rmtree("%s/%s" % (vm_directory, context), True)
+
+
+def get_vm(headers):
+    url = "127.0.0.1:8081/v1/voicemail/vms/%s?context=%s&mailbox=%s&dir=INBOX&authtoken=%s" % (msgname, context, mailbox, authtoken)
+    return common.http_send_headers(url, "GET", None, headers)
+
+
+def check(name, ret_code, expect_code, ret_data=None, expect_data=None):
+    if ret_code != expect_code:
+        print("Wrong code. name[%s], code[%d], expect[%d]" % (name, ret_code, expect_code))
+        return False
+
+    if expect_data is not None and ret_data != expect_data:
+        print("Wrong data. name[%s], len[%d], expect_len[%d]" % (name, len(ret_data), len(expect_data)))
+        return False
+
+    return True
+
+
+def test_vm_whole():
+    ret_code, ret_headers, ret_data = get_vm(None)
+    if check("whole", ret_code, 200, ret_data, data) != True:
+        return False
+
+    for key in ["etag", "last-modified", "accept-ranges"]:
+        if key not in ret_headers:
+            print("No header. key[%s]" % (key))
+            return False
+
+    if ret_headers["accept-ranges"] != "bytes":
+        print("Wrong accept-ranges. value[%s]" % (ret_headers["accept-ranges"]))
+        return False
+
+    return True
+
+
+def test_vm_range_single():
+    cases = [
+        ("bytes=0-99", data[0:100], "bytes 0-99/1000"),
+        ("bytes=900-", data[900:], "bytes 900-999/1000"),
+        ("bytes=-10", data[990:], "bytes 990-999/1000"),
+        ("bytes=990-2000", data[990:], "bytes 990-999/1000"),
+        ("bytes=0-0", data[0:1], "bytes 0-0/1000"),
+        ("bytes=0-49,50-99", data[0:100], "bytes 0-99/1000"),
+    ]
+
+    for val, expect, content_range in cases:
+        ret_code, ret_headers, ret_data = get_vm(["Range: %s" % (val)])
+        if check(val, ret_code, 206, ret_data, expect) != True:
+            return False
+
+        if ret_headers.get("content-range") != content_range:
+            print("Wrong content-range. range[%s], value[%s]" % (val, ret_headers.get("content-range")))
+            return False
+
+    return True
+
+
+def test_vm_range_multi():
+    ret_code, ret_headers, ret_data = get_vm(["Range: bytes=0-9,500-509"])
+    if check("multi", ret_code, 206) != True:
+        return False
+
+    content_type = ret_headers.get("content-type", "")
+    if content_type.startswith("multipart/byteranges; boundary=") != True:
+        print("Wrong content-type. value[%s]" % (content_type))
+        return False
+    boundary = content_type.split("boundary=")[1]
+
+    # parse parts
+    parts = ret_data.split("--%s" % (boundary))
+    if parts[-1].strip() != "--":
+        print("Could not find the close delimiter.")
+        return False
+
+    parts = parts[1:-1]
+    expects = [("bytes 0-9/1000", data[0:10]), ("bytes 500-509/1000", data[500:510])]
+    if len(parts) != len(expects):
+        print("Wrong part count. count[%d]" % (len(parts)))
+        return False
+
+    for part, (content_range, body) in zip(parts, expects):
+        header, part_body = part[2:].split("\r\n\r\n", 1)
+        if "Content-Range: %s" % (content_range) not in header:
+            print("Wrong part header. header[%s]" % (header))
+            return False
+
+        if part_body[:-2] != body:
+            print("Wrong part body. range[%s]" % (content_range))
+            return False
+
+    return True
+
+
+def test_vm_range_unsatisfiable():
+    for val in ["bytes=1000-", "bytes=-0", "bytes=2000-3000"]:
+        ret_code, ret_headers, ret_data = get_vm(["Range: %s" % (val)])
+        if check(val, ret_code, 416) != True:
+            return False
+
+        if ret_headers.get("content-range") != "bytes */1000":
+            print("Wrong content-range. range[%s], value[%s]" % (val, ret_headers.get("content-range")))
+            return False
+
+    return True
+
+
+def test_vm_range_ignored():
+    # wrong syntax or unit. sends the whole file.
+    for val in ["bytes=20-10", "items=0-9", "bytes=abc"]:
+        ret_code, ret_headers, ret_data = get_vm(["Range: %s" % (val)])
+        if check(val, ret_code, 200, ret_data, data) != True:
+            return False
+
+    return True
+
+
+def test_vm_conditional():
+    ret_code, ret_headers, ret_data = get_vm(None)
+    etag = ret_headers["etag"]
+    last_modified = ret_headers["last-modified"]
+
+    # not modified
+    ret_code, ret_headers, ret_data = get_vm(["If-None-Match: %s" % (etag)])
+    if check("if-none-match", ret_code, 304, ret_data, "") != True:
+        return False
+
+    ret_code, ret_headers, ret_data = get_vm(["If-None-Match: \"other\", W/%s" % (etag)])
+    if check("if-none-match weak", ret_code, 304) != True:
+        return False
+
+    ret_code, ret_headers, ret_data = get_vm(["If-Modified-Since: %s" % (last_modified)])
+    if check("if-modified-since", ret_code, 304) != True:
+        return False
+
+    # if-none-match precedes
+    ret_code, ret_headers, ret_data = get_vm(["If-None-Match: \"other\"", "If-Modified-Since: %s" % (last_modified)])
+    if check("if-none-match precedes", ret_code, 200, ret_data, data) != True:
+        return False
+
+    # if-range
+    ret_code, ret_headers, ret_data = get_vm(["Range: bytes=0-9", "If-Range: %s" % (etag)])
+    if check("if-range match", ret_code, 206, ret_data, data[0:10]) != True:
+        return False
+
+    ret_code, ret_headers, ret_data = get_vm(["Range: bytes=0-9", "If-Range: \"other\""])
+    if check("if-range not match", ret_code, 200, ret_data, data) != True:
+        return False
+
+    # changed file
+    time.sleep(0.01)
+    f = open("%s/%s/%s/INBOX/%s.wav" % (vm_directory, context, mailbox, msgname), "ab")
+    f.write("a")
+    f.close()
+
+    ret_code, ret_headers, ret_data = get_vm(["If-None-Match: %s" % (etag)])
+    if check("if-none-match changed", ret_code, 200, ret_data, data + "a") != True:
+        return False
+
+    if ret_headers["etag"] == etag:
+        print("The etag is not changed.")
+        return False
+
+    return True
+
+
+#### Test
+
+
+create_spool()
+try:
+    print("test_vm_whole")
+    ret = test_vm_whole()
+    if ret != True:
+        raise
+
+    print("test_vm_range_single")
+    ret = test_vm_range_single()
+    if ret != True:
+        raise
+
+    print("test_vm_range_multi")
+    ret = test_vm_range_multi()
+    if ret != True:
+        raise
+
+    print("test_vm_range_unsatisfiable")
+    ret = test_vm_range_unsatisfiable()
+    if ret != True:
+        raise
+
+    print("test_vm_range_ignored")
+    ret = test_vm_range_ignored()
+    if ret != True:
+        raise
+
+    print("test_vm_conditional")
+    ret = test_vm_conditional()
+    if ret != True:
+        raise
+finally:
+    remove_spool()